@@ -82,6 +82,7 @@
 ////#include "examples/fsi/beam_aerothermoelastic_flutter_solution/beam_aerothermoelastic_flutter_solution.h"
 #include "examples/thermal/base/thermal_example_1d.h"
 #include "examples/thermal/base/thermal_example_2d.h"
+#include "mesh/fe_cache.h"
 
 
 // libMesh includes
@@ -142,6 +143,9 @@
 int main(int argc, char* const argv[]) {
     
     libMesh::LibMeshInit init(argc, argv);
+
+    // pooled finite element objects are deleted before libMesh is finalized
+    MAST::FECache::Guard fe_cache_guard;
     
     // use to get arguments from the command line
     GetPot command_line(argc, argv);
@@ -19,6 +19,9 @@
 
 // C/C++ includes.
 #include <iostream>
+#include <memory>
+#include <algorithm>
+#include <cmath>
 
 // MAST includes.
 #include "examples/fluid/meshing/cylinder.h"
@@ -40,6 +43,8 @@
 #include "fluid/integrated_force_output.h"
 #include "solver/first_order_newmark_transient_solver.h"
 #include "solver/stabilized_first_order_transient_sensitivity_solver.h"
+#include "solver/transient_checkpoint_store.h"
+#include "mesh/fe_cache.h"
 
 // libMesh includes
 #include "libmesh/libmesh.h"
@@ -1002,6 +1007,21 @@ public:
         transient_output_name = output_name + "_transient.exo";
         
         
+        // the solution of each time step is stored as a binary checkpoint
+        // if a directory is specified, and is otherwise written with
+        // write_out_vector. The stabilized sensitivity analysis reads it
+        // from the same location.
+        std::string
+        checkpoint_dir = _input("checkpoint_dir", "directory for binary checkpoints of the transient solution", "");
+        std::unique_ptr<MAST::DiskCheckpointStore> checkpoints;
+        if (checkpoint_dir.size()) {
+            
+            checkpoints.reset(new MAST::DiskCheckpointStore(_sys->comm(),
+                                                            checkpoint_dir,
+                                                            output_name + "_sol_t"));
+        }
+        
+        
         // create the nonlinear assembly object
         MAST::TransientAssembly                                  assembly;
         MAST::ConservativeFluidTransientAssemblyElemOperations   elem_ops;
@@ -1026,6 +1046,8 @@ public:
         force.set_discipline_and_system(*_discipline, *_sys_init);
         solver.set_discipline_and_system(*_discipline, *_sys_init);
         solver.set_elem_operation_object(elem_ops);
+        if (checkpoints)
+            solver.set_checkpoint_store(*checkpoints);
         
         //this->initialize_solution();
         
@@ -1109,9 +1131,14 @@ public:
                                                 *_eq_sys,
                                                 t_step+1,
                                                 _sys->time);
-                std::ostringstream oss;
-                oss << output_name << "_sol_t_" << t_step;
-                _sys->write_out_vector(*_sys->solution, "data", oss.str(), true);
+                if (checkpoints)
+                    solver.store_solution_checkpoint(t_step);
+                else {
+                    
+                    std::ostringstream oss;
+                    oss << output_name << "_sol_t_" << t_step;
+                    _sys->write_out_vector(*_sys->solution, "data", oss.str(), true);
+                }
             }
             
             // calculate the output quantity
@@ -1268,6 +1295,19 @@ public:
         // the output from analysis should have been saved for sensitivity
         libmesh_assert(output);
         
+        // the primal solution is read from the checkpoints written by the
+        // analysis, if a directory is specified
+        std::string
+        checkpoint_dir = _input("checkpoint_dir", "directory for binary checkpoints of the transient solution", "");
+        std::unique_ptr<MAST::DiskCheckpointStore> checkpoints;
+        if (checkpoint_dir.size()) {
+            
+            checkpoints.reset(new MAST::DiskCheckpointStore(_sys->comm(),
+                                                            checkpoint_dir,
+                                                            output_name + "_sol_t"));
+        }
+        
+        
         // create the nonlinear assembly object
         MAST::TransientAssembly                                     assembly;
         MAST::ConservativeFluidTransientAssemblyElemOperations      elem_ops;
@@ -1292,6 +1332,8 @@ public:
         force.set_discipline_and_system(*_discipline, *_sys_init);
         solver.set_discipline_and_system(*_discipline, *_sys_init);
         solver.set_elem_operation_object(elem_ops);
+        if (checkpoints)
+            solver.set_checkpoint_store(*checkpoints);
         
         // file to write the solution for visualization
         libMesh::ExodusII_IO exodus_writer(*_mesh);
@@ -1314,6 +1356,39 @@ public:
         solver.beta       = _input("sensitivity_beta", "beta for stabilized sensitivity solver",   1.);
         solver.max_index  = n_steps;
         solver.set_nolinear_solution_location(nonlinear_sol_root, nonlinear_sol_dir);
+        bool
+        eig_stabilization = _input("if_eigenvalue_stabilization", "flag to estimate the amplification factor of the stabilized sensitivity solver from eigenvalues", false);
+        solver.set_eigenvalue_stabilization(eig_stabilization);
+        solver.set_time_invariant_operators
+        (_input("if_time_invariant_operators", "flag to assemble the Jacobian and mass matrices once for the stabilized sensitivity solver, which is valid if the flow solution does not change with time", false));
+        solver.set_power_iteration_amplification
+        (_input("if_power_iteration_amplification", "flag to estimate the amplification factor with a warm-started power iteration", false));
+        solver.power_iteration_max_its =
+        _input("power_iteration_max_its", "maximum number of power iterations for the amplification factor", 20);
+        solver.power_iteration_tol     =
+        _input("power_iteration_tol", "relative tolerance of the power iteration for the amplification factor", 1.e-3);
+        
+        // the sensitivity may be compared with that of a solver that
+        // reassembles the operators at each step and uses the eigensolver
+        // for the amplification factor
+        std::unique_ptr<MAST::StabilizedFirstOrderNewmarkTransientSensitivitySolver>
+        reference;
+        const Real
+        reference_tol     = _input("stabilized_sensitivity_check_tol", "relative tolerance for comparison with the reference stabilized sensitivity solver", 1.e-6);
+        if (_input("if_check_stabilized_sensitivity", "flag to compare the stabilized sensitivity with the solver that reassembles the operators at each step", false)) {
+            
+            reference.reset(new MAST::StabilizedFirstOrderNewmarkTransientSensitivitySolver);
+            reference->set_discipline_and_system(*_discipline, *_sys_init);
+            reference->set_elem_operation_object(elem_ops);
+            if (checkpoints)
+                reference->set_checkpoint_store(*checkpoints);
+            reference->dt         = solver.dt;
+            reference->max_amp    = solver.max_amp;
+            reference->beta       = solver.beta;
+            reference->max_index  = solver.max_index;
+            reference->set_nolinear_solution_location(nonlinear_sol_root, nonlinear_sol_dir);
+            reference->set_eigenvalue_stabilization(eig_stabilization);
+        }
         
         // ask the solver to update the initial condition for d2(X)/dt2
         // This is recommended only for the initial time step, since the time
@@ -1354,8 +1429,38 @@ public:
             << std::setw(30) << force.output_total()
             << std::setw(30) << force.output_sensitivity_total(p) << std::endl;
             
+            const Real
+            t0 = _sys->time;
+            
             solver.sensitivity_solve(assembly, p);
             
+            if (reference) {
+                
+                // the reference solver starts from the same time
+                const Real
+                t1 = _sys->time;
+                _sys->time = t0;
+                
+                reference->sensitivity_solve(assembly, p);
+                
+                std::unique_ptr<libMesh::NumericVector<Real>>
+                diff(solver.solution_sensitivity().clone().release());
+                diff->add(-1., reference->solution_sensitivity());
+                diff->close();
+                
+                const Real
+                diff_norm = diff->l2_norm(),
+                ref_norm  = reference->solution_sensitivity().l2_norm();
+                
+                libMesh::out
+                << "stabilized sensitivity difference from reference: "
+                << diff_norm << "  reference norm: " << ref_norm << std::endl;
+                
+                if (fabs(_sys->time - t1) > 1.e-12 * std::max(1., fabs(t1)) ||
+                    diff_norm > reference_tol * ref_norm)
+                    libmesh_error_msg("Stabilized sensitivity does not match the reference solver at time step: " << t_step);
+            }
+            
             // update time step counter
             t_step++;
         }
@@ -1373,6 +1478,9 @@ int main(int argc, const char** argv)
     // Initialize libMesh library.
     libMesh::LibMeshInit init(argc, argv);
 
+    // pooled finite element objects are deleted before libMesh is finalized
+    MAST::FECache::Guard fe_cache_guard;
+
     // initialize the wrapper to read input parameters. This will check
     // if the executable parameters included a parameter of type
     // `input=${filename}`. If included, then the input parameters will be read
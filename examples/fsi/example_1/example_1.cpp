@@ -19,6 +19,7 @@
 
 // C++ includes
 #include <vector>
+#include <set>
 
 // MAST includes
 #include "examples/fluid/meshing/panel_mesh_2D.h"
@@ -31,6 +32,7 @@
 #include "base/parameter.h"
 #include "base/constant_field_function.h"
 #include "base/complex_mesh_field_function.h"
+#include "base/mesh_field_transfer_map.h"
 #include "base/complex_assembly_base.h"
 #include "base/eigenproblem_assembly.h"
 #include "fluid/conservative_fluid_system_initialization.h"
@@ -53,6 +55,7 @@
 #include "property_cards/isotropic_material_property_card.h"
 #include "solver/slepc_eigen_solver.h"
 #include "solver/complex_solver_base.h"
+#include "mesh/fe_cache.h"
 
 // libMesh includes
 #include "libmesh/libmesh.h"
@@ -81,6 +84,9 @@ int main(int argc, char* argv[]) {
     // Initialize libMesh library.
     libMesh::LibMeshInit init(argc, argv);
 
+    // pooled finite element objects are deleted before libMesh is finalized
+    MAST::FECache::Guard fe_cache_guard;
+
     // initialize the wrapper to read input parameters. This will check
     // if the executable parameters included a parameter of type
     // `input=${filename}`. If included, then the input parameters will be read
@@ -100,6 +106,7 @@ int main(int argc, char* argv[]) {
     n_divs_ff_to_panel  = input("n_divs_farfield_to_panel", "number of element divisions from far-field to panel", 30),
     n_divs_panel        = input("n_divs_panel", "number of element divisions on panel", 10),
     n_k_divs            = input("n_k_divs", "number of divisions between upper and lower reduced frequencies for search of flutter root", 10),
+    n_gaf_interp_pts    = input("n_gaf_interp_pts", "number of reduced frequencies at which the generalized aerodynamic force matrix is sampled for spline interpolation in the flutter root search (0 to assemble at every reduced frequency)", 0),
     max_bisection_iters = input("flutter_max_bisection_it", "maximum number of bisection iterations to search flutter root after initial sweep of reduced frequencies", 10);
     
     const Real
@@ -305,6 +312,31 @@ int main(int argc, char* argv[]) {
     slip_wall.add(displ);
     slip_wall.add(normal_rot);
     
+    // the fluid pressure is needed at the quadrature points of the
+    // structural elements, and the structural displacement at the
+    // quadrature points of the fluid slip-wall sides. These points are
+    // located once, and the maps are reused for all modes and frequencies.
+    // The Timoshenko beam elements do not use extra quadrature order.
+    MAST::MeshFieldTransferMap
+    pressure_map(fluid_sys),
+    displ_map(structural_sys);
+    
+    pressure_map.add_quadrature_points(structural_sys,
+                                       structural_sys.extra_quadrature_order,
+                                       false);
+    pressure_map.init();
+    
+    std::set<libMesh::boundary_id_type> panel_bids;
+    panel_bids.insert(panel_bc_id);
+    displ_map.add_side_quadrature_points(fluid_sys,
+                                         fluid_sys.extra_quadrature_order,
+                                         panel_bids);
+    displ_map.init();
+    
+    pressure_function.set_transfer_map(pressure_map);
+    freq_domain_pressure_function.set_transfer_map(pressure_map);
+    displ.set_transfer_map(displ_map);
+    
     // set up structural eigenvalue problem
     structural_sys.eigen_solver->set_position_of_spectrum(libMesh::LARGEST_MAGNITUDE);
     structural_sys.set_exchange_A_and_B(true);
@@ -491,6 +523,22 @@ int main(int argc, char* argv[]) {
                               n_k_divs,           // number of divisions
                               basis);             // basis vectors
     
+    // the generalized aerodynamic force matrix can be sampled at a fixed
+    // set of reduced frequencies and interpolated in between, so that the
+    // bisection search does not require new fluid solutions.
+    if (n_gaf_interp_pts > 0) {
+        
+        libmesh_assert_greater(n_gaf_interp_pts, 1);
+        
+        std::vector<Real>
+        kr_interp(n_gaf_interp_pts, 0.);
+        
+        for (unsigned int i=0; i<n_gaf_interp_pts; i++)
+            kr_interp[i] = k_lower + (k_upper-k_lower)*i/(n_gaf_interp_pts-1.);
+        
+        flutter_solver.set_gaf_interpolation_points(kr_interp);
+    }
+    
     std::ostringstream oss;
     oss << "flutter_output_" << init.comm().rank() << ".txt";
     if (init.comm().rank() == 0)
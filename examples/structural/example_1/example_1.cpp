@@ -19,6 +19,7 @@
 
 // C/C++ includes.
 #include <iostream>
+#include <memory>
 
 // libMesh includes.
 #include <libmesh/libmesh.h>
@@ -27,6 +28,7 @@
 #include <libmesh/equation_systems.h>
 #include <libmesh/fe_type.h>
 #include <libmesh/numeric_vector.h>
+#include <libmesh/sparse_matrix.h>
 
 // MAST includes.
 #include "base/nonlinear_system.h"
@@ -39,6 +41,7 @@
 #include "property_cards/solid_1d_section_element_property_card.h"
 #include "base/nonlinear_implicit_assembly.h"
 #include "elasticity/structural_nonlinear_assembly.h"
+#include "mesh/fe_cache.h"
 
 int main(int argc, const char** argv)
 {
@@ -49,6 +52,9 @@ int main(int argc, const char** argv)
     // Initialize libMesh library.
     libMesh::LibMeshInit init(argc, argv);
 
+    // pooled finite element objects are deleted before libMesh is finalized
+    MAST::FECache::Guard fe_cache_guard;
+
     // Create Mesh object on default MPI communicator and generate a line mesh (5 elements, 10 units long).
     //   Note that in libMesh, all meshes are parallel by default in the sense that the equations on the mesh are solved in parallel by PETSc.
     //   A "ReplicatedMesh" is one where all MPI processes have the full mesh in memory, as compared to a "DistributedMesh" where the mesh is
@@ -152,6 +158,103 @@ int main(int argc, const char** argv)
     elem_ops.set_discipline_and_system(discipline, structural_system);
     MAST::NonlinearSystem& nonlinear_system = assembly.system();
 
+    // The element loop can be processed on multiple threads, which are
+    // requested with the libMesh option --n_threads. The elements are
+    // processed in parallel only if the element operation object is marked
+    // as thread-parallel, which is done here with --thread_parallel. The
+    // residual and Jacobian from the threaded loop are first compared with
+    // those from the serial loop at an arbitrary solution.
+    if (libMesh::on_command_line("--thread_parallel")) {
+        
+        std::unique_ptr<libMesh::NumericVector<Real> >
+        X         (nonlinear_system.solution->zero_clone().release()),
+        r_serial  (nonlinear_system.solution->zero_clone().release()),
+        r_threads (nonlinear_system.solution->zero_clone().release()),
+        jx_serial (nonlinear_system.solution->zero_clone().release()),
+        jx_threads(nonlinear_system.solution->zero_clone().release());
+        
+        for (libMesh::dof_id_type i=X->first_local_index(); i<X->last_local_index(); i++)
+            X->set(i, 1.e-3*(i+1));
+        X->close();
+        
+        assembly.set_elem_operation_object(elem_ops);
+        
+        elem_ops.set_thread_parallel(false);
+        assembly.residual_and_jacobian(*X, r_serial.get(), nonlinear_system.matrix, nonlinear_system);
+        nonlinear_system.matrix->vector_mult(*jx_serial, *X);
+        
+        elem_ops.set_thread_parallel(true);
+        assembly.residual_and_jacobian(*X, r_threads.get(), nonlinear_system.matrix, nonlinear_system);
+        nonlinear_system.matrix->vector_mult(*jx_threads, *X);
+        
+        assembly.clear_elem_operation_object();
+        
+        r_threads->add(-1., *r_serial);
+        jx_threads->add(-1., *jx_serial);
+        
+        const Real
+        r_err  = r_threads->l2_norm()/r_serial->l2_norm(),
+        jx_err = jx_threads->l2_norm()/jx_serial->l2_norm();
+        
+        libMesh::out
+        << "Threads: " << libMesh::n_threads()
+        << "  relative difference from serial loop in residual: " << r_err
+        << "  Jacobian: " << jx_err << std::endl;
+        
+        if (r_err > 1.e-12 || jx_err > 1.e-12)
+            libmesh_error_msg("Threaded element loop does not match serial loop.");
+    }
+    
+    // The residual of this problem is linear in the solution, so the
+    // element Jacobians can be cached and reused in all assemblies, which
+    // is done here with --element_matrix_cache. The cache is filled at one
+    // solution and the cached residual and Jacobian at another solution
+    // are compared with those from the element calculations.
+    if (libMesh::on_command_line("--element_matrix_cache")) {
+        
+        std::unique_ptr<libMesh::NumericVector<Real> >
+        X0        (nonlinear_system.solution->zero_clone().release()),
+        X         (nonlinear_system.solution->zero_clone().release()),
+        r_elem    (nonlinear_system.solution->zero_clone().release()),
+        r_cached  (nonlinear_system.solution->zero_clone().release()),
+        jx_elem   (nonlinear_system.solution->zero_clone().release()),
+        jx_cached (nonlinear_system.solution->zero_clone().release());
+        
+        for (libMesh::dof_id_type i=X->first_local_index(); i<X->last_local_index(); i++) {
+            X0->set(i, 1.e-3*(i+1));
+            X->set(i, 1.e-3*(i%7) - 2.e-3);
+        }
+        X0->close();
+        X->close();
+        
+        assembly.set_elem_operation_object(elem_ops);
+        
+        assembly.set_element_matrix_cache(false);
+        assembly.residual_and_jacobian(*X, r_elem.get(), nonlinear_system.matrix, nonlinear_system);
+        nonlinear_system.matrix->vector_mult(*jx_elem, *X);
+        
+        assembly.set_element_matrix_cache(true);
+        assembly.residual_and_jacobian(*X0, r_cached.get(), nullptr, nonlinear_system);
+        assembly.residual_and_jacobian(*X, r_cached.get(), nonlinear_system.matrix, nonlinear_system);
+        nonlinear_system.matrix->vector_mult(*jx_cached, *X);
+        
+        assembly.clear_elem_operation_object();
+        
+        r_cached->add(-1., *r_elem);
+        jx_cached->add(-1., *jx_elem);
+        
+        const Real
+        r_err  = r_cached->l2_norm()/r_elem->l2_norm(),
+        jx_err = jx_cached->l2_norm()/jx_elem->l2_norm();
+        
+        libMesh::out
+        << "Relative difference of cached element matrices in residual: " << r_err
+        << "  Jacobian: " << jx_err << std::endl;
+        
+        if (r_err > 1.e-12 || jx_err > 1.e-12)
+            libmesh_error_msg("Cached element matrices do not match element calculations.");
+    }
+    
     // Zero the solution before solving.
     nonlinear_system.solution->zero();
 
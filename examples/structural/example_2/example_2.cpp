@@ -46,6 +46,7 @@
 #include "elasticity/structural_nonlinear_assembly.h"
 #include "solver/arclength_continuation_solver.h"
 #include "solver/pseudo_arclength_continuation_solver.h"
+#include "mesh/fe_cache.h"
 
 class PointLoad: public MAST::FieldFunction<RealVectorX> {
 public:
@@ -79,6 +80,9 @@ int main(int argc, char* argv[])
     // Initialize libMesh library.
     libMesh::LibMeshInit init(argc, argv);
 
+    // pooled finite element objects are deleted before libMesh is finalized
+    MAST::FECache::Guard fe_cache_guard;
+
     // wapper to GetPot used to read in values for parameters
     MAST::Examples::GetPotWrapper
     input(argc, argv, "input");
@@ -317,6 +321,7 @@ int main(int argc, char* argv[])
         MAST::PseudoArclengthContinuationSolver solver;
         solver.schur_factorization = input("if_schur_factorization", "use Schur-factorization in continuation solver", true);
         solver.min_step            = input("min_step", "minimum arc-length step-size for continuation solver",          10.);
+        solver.lag_jacobian        = input("if_lag_jacobian", "reuse the Jacobian across iterates and load steps of continuation solver", false);
 
         // specify temperature as the load parameter to be changed per
         // load step
@@ -372,6 +377,7 @@ int main(int argc, char* argv[])
         MAST::PseudoArclengthContinuationSolver solver;
         solver.schur_factorization = input("if_schur_factorization", "use Schur-factorization in continuation solver", true);
         solver.min_step            = input("min_step", "minimum arc-length step-size for continuation solver",          10.);
+        solver.lag_jacobian        = input("if_lag_jacobian", "reuse the Jacobian across iterates and load steps of continuation solver", false);
 
         // specify pressure as the load parameter to be changed per
         // load step
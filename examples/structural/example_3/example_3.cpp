@@ -45,6 +45,7 @@
 #include "solver/arclength_continuation_solver.h"
 #include "solver/pseudo_arclength_continuation_solver.h"
 #include "examples/structural/base/thermal_stress_jacobian_scaling_function.h"
+#include "mesh/fe_cache.h"
 
 
 int main(int argc, const char** argv)
@@ -57,6 +58,9 @@ int main(int argc, const char** argv)
     //
     // Initialize libMesh library.
     libMesh::LibMeshInit init(argc, argv);
+
+    // pooled finite element objects are deleted before libMesh is finalized
+    MAST::FECache::Guard fe_cache_guard;
     
     // Create Mesh object on default MPI communicator and generate a 2D mesh of QUAD4 elements. We discretize with
     // 12 elements in the x-direction (0.0 to 36.0 inches) and 40 elements in the y-direction (0.0 to 120.0 inches).
@@ -46,6 +46,7 @@
 #include "property_cards/isotropic_material_property_card.h"
 #include "property_cards/solid_2d_section_element_property_card.h"
 #include "mesh/mesh_coupling_base.h"
+#include "mesh/fe_cache.h"
 
 // BEGIN_TRANSLATE Tie Constraints
 //
@@ -174,6 +175,9 @@ int main(int argc, const char** argv)
     //
     // Initialize libMesh library.
     libMesh::LibMeshInit init(argc, argv);
+
+    // pooled finite element objects are deleted before libMesh is finalized
+    MAST::FECache::Guard fe_cache_guard;
     
     // A replicated mesh is used, which will store the entire mesh on all
     // elements.
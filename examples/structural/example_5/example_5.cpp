@@ -57,6 +57,7 @@
 #include "optimization/gcmma_optimization_interface.h"
 #include "optimization/npsol_optimization_interface.h"
 #include "optimization/function_evaluation.h"
+#include "mesh/fe_cache.h"
 
 
 // libMesh includes
@@ -164,6 +165,7 @@ protected:
     Real                                      _p_val, _vm_rho;
     Real                                      _ref_eig_val;
     unsigned int                              _n_eig_vals;
+    unsigned int                              _n_sens_batch;
     
     libMesh::UnstructuredMesh*                _mesh;
     libMesh::UnstructuredMesh*                _level_set_mesh;
@@ -1949,57 +1951,91 @@ public:
         std::fill(grad.begin(), grad.end(), 0.);
         
         //
-        // iterate over each DV, create a sensitivity vector and calculate the
-        // volume sensitivity explicitly
+        // the DVs are processed in batches. For each DV in a batch a filtered
+        // sensitivity vector is created, and the volume sensitivity of all
+        // DVs in the batch is computed in a single pass over the mesh. Each
+        // element only evaluates the DVs that influence it.
         //
         std::unique_ptr<libMesh::NumericVector<Real>>
-        dphi_base(_level_set_sys->solution->zero_clone().release()),
-        dphi_filtered(_level_set_sys->solution->zero_clone().release());
+        dphi_base(_level_set_sys->solution->zero_clone().release());
+        
+        std::vector<std::unique_ptr<libMesh::NumericVector<Real>>>
+        dphi_filtered;
         
         ElementParameterDependence dep(*_filter);
         assembly.attach_elem_parameter_dependence_object(dep);
         
-        for (unsigned int i=0; i<_n_vars; i++) {
+        // the assembly localizes the solution sensitivities of at most
+        // this many design variables at a time, and the filtered level set
+        // sensitivities are created for the same number of variables
+        assembly.set_sensitivity_batch_size(std::max(1u, _n_sens_batch));
+        
+        const unsigned int
+        n_batch = assembly.sensitivity_batch_size();
+        
+        std::vector<const libMesh::NumericVector<Real>*> dXdp;
+        std::vector<const MAST::FunctionBase*>           params;
+        std::vector<Real>                                sens;
+        
+        for (unsigned int i0=0; i0<_n_vars; i0+=n_batch) {
             
-            dphi_base->zero();
-            dphi_filtered->zero();
-            //
-            // set the value only if the dof corresponds to a local node
-            //
-            if (_dv_params[i].first >=  dphi_base->first_local_index() &&
-                _dv_params[i].first <   dphi_base->last_local_index())
-                dphi_base->set(_dv_params[i].first, 1.);
-            dphi_base->close();
-            _filter->compute_filtered_values(*dphi_base, *dphi_filtered);
+            const unsigned int
+            n = std::min(n_batch, _n_vars-i0);
+            
+            dXdp.resize(n);
+            params.resize(n);
+            
+            for (unsigned int j=0; j<n; j++) {
+                
+                const unsigned int i = i0+j;
+                
+                if (dphi_filtered.size() <= j)
+                    dphi_filtered.push_back
+                    (std::unique_ptr<libMesh::NumericVector<Real>>
+                     (_level_set_sys->solution->zero_clone().release()));
+                
+                dphi_base->zero();
+                //
+                // set the value only if the dof corresponds to a local node
+                //
+                if (_dv_params[i].first >=  dphi_base->first_local_index() &&
+                    _dv_params[i].first <   dphi_base->last_local_index())
+                    dphi_base->set(_dv_params[i].first, 1.);
+                dphi_base->close();
+                _filter->compute_filtered_values(*dphi_base, *dphi_filtered[j]);
+                
+                dXdp[j]   = dphi_filtered[j].get();
+                params[j] = _dv_params[i].second;
+            }
             
-            _level_set_vel->init(*_level_set_sys_init, *_level_set_sys->solution, *dphi_filtered);
-
             // if the volume output was specified then compute the sensitivity
             // and add to the grad vector
             if (volume) {
                 
                 assembly.set_evaluate_output_on_negative_phi(false);
-                assembly.calculate_output_direct_sensitivity(*_level_set_sys->solution,
-                                                             dphi_filtered.get(),
-                                                             *_dv_params[i].second,
-                                                             *volume);
+                assembly.calculate_output_direct_sensitivities(*_level_set_sys->solution,
+                                                               dXdp,
+                                                               params,
+                                                               *volume,
+                                                               sens);
                 
-                grad[i] = _obj_scaling * volume->output_sensitivity_total(*_dv_params[i].second);
-                //grad[i] = volume->output_sensitivity_total(*_dv_params[i].second)/_length/_height;
+                for (unsigned int j=0; j<n; j++)
+                    grad[i0+j] = _obj_scaling * sens[j];
             }
             
             // if the perimeter output was specified then compute the sensitivity
             // and add to the grad vector
             if (perimeter) {
                 assembly.set_evaluate_output_on_negative_phi(true);
-                assembly.calculate_output_direct_sensitivity(*_level_set_sys->solution,
-                                                             dphi_filtered.get(),
-                                                             *_dv_params[i].second,
-                                                             *perimeter);
+                assembly.calculate_output_direct_sensitivities(*_level_set_sys->solution,
+                                                               dXdp,
+                                                               params,
+                                                               *perimeter,
+                                                               sens);
                 assembly.set_evaluate_output_on_negative_phi(false);
                 
-                grad[i] += _obj_scaling * _perimeter_penalty *
-                perimeter->output_sensitivity_total(*_dv_params[i].second);
+                for (unsigned int j=0; j<n; j++)
+                    grad[i0+j] += _obj_scaling * _perimeter_penalty * sens[j];
             }
         }
         
@@ -2268,6 +2304,7 @@ public:
     _vm_rho                              (0.),
     _ref_eig_val                         (0.),
     _n_eig_vals                          (0),
+    _n_sens_batch                        (0),
     _mesh                                (nullptr),
     _level_set_mesh                      (nullptr),
     _eq_sys                              (nullptr),
@@ -2331,6 +2368,7 @@ public:
         _stress_lim            = _input("vm_stress_limit", "limit von-mises stress value", 2.e8);
         _p_val                 = _input("constraint_aggregation_p_val", "value of p in p-norm stress aggregation", 2.0);
         _vm_rho                = _input("constraint_aggregation_rho_val", "value of rho in p-norm stress aggregation", 2.0);
+        _n_sens_batch          = _input("sensitivity_batch_size", "number of design variables processed in one pass over the mesh for volume sensitivity", 100);
         _level_set_vel         = new MAST::LevelSetBoundaryVelocity(2);
         _level_set_function    = new PhiMeshFunction;
         _output                = new libMesh::ExodusII_IO(*_mesh);
@@ -2582,6 +2620,9 @@ int main(int argc, char* argv[]) {
 
     libMesh::LibMeshInit init(argc, argv);
 
+    // pooled finite element objects are deleted before libMesh is finalized
+    MAST::FECache::Guard fe_cache_guard;
+
     MAST::Examples::GetPotWrapper
     input(argc, argv, "input");
 
@@ -19,6 +19,7 @@
 
 // C++ includes
 #include <iomanip>
+#include <map>
 
 // MAST includes
 #include "examples/base/input_wrapper.h"
@@ -39,13 +40,16 @@
 #include "base/transient_assembly.h"
 #include "base/boundary_condition_base.h"
 #include "base/nonlinear_implicit_assembly.h"
+#include "base/parameter_dependency_index.h"
 #include "boundary_condition/dirichlet_boundary_condition.h"
 #include "solver/slepc_eigen_solver.h"
+#include "solver/matrix_free_nonlinear_solver.h"
 #include "property_cards/isotropic_material_property_card.h"
 #include "property_cards/solid_2d_section_element_property_card.h"
 #include "optimization/gcmma_optimization_interface.h"
 #include "optimization/npsol_optimization_interface.h"
 #include "optimization/function_evaluation.h"
+#include "mesh/fe_cache.h"
 
 
 // libMesh includes
@@ -59,6 +63,7 @@
 #include "libmesh/petsc_nonlinear_solver.h"
 #include "libmesh/mesh_refinement.h"
 #include "libmesh/error_vector.h"
+#include "libmesh/fe_interface.h"
 
 
 void
@@ -94,7 +99,7 @@ public MAST::FieldFunction<Real> {
 public:
     ElasticityFunction(Real E0, Real rho_min, Real penalty,
                        MAST::MeshFieldFunction& rho,
-                       MAST::MeshFieldFunction& drho):
+                       MAST::FieldFunction<RealVectorX>& drho):
     MAST::FieldFunction<Real>("E"),
     _E0(E0),
     _rho_min(rho_min),
@@ -104,7 +109,7 @@ public:
     virtual ~ElasticityFunction(){}
     void set_penalty_val(Real penalty) {_penalty = penalty;}
     
-    virtual bool depends_on(const MAST::FunctionBase& f) const { return true;}
+    virtual bool _depends_on(const MAST::FunctionBase& f) const { return true;}
     virtual void operator() (const libMesh::Point& p, const Real t, Real& v) const {
 
         RealVectorX v1;
@@ -128,7 +133,7 @@ protected:
     Real                    _rho_min; // lower limit on density
     Real                    _penalty; // value of penalty term
     MAST::MeshFieldFunction &_rho;
-    MAST::MeshFieldFunction &_drho;
+    MAST::FieldFunction<RealVectorX> &_drho;
 };
 
 
@@ -153,6 +158,98 @@ private:
 
 
 
+//  The nodal values of the filtered density are used as element-local
+//  parameters for the adjoint sensitivity, so that the sensitivity with
+//  respect to all of them is computed in a single loop over the elements.
+//  The sensitivity of the density with respect to the value at the k-th
+//  node of the active element is the shape function of that node. The
+//  sensitivity with respect to the design variables is obtained from these
+//  with the transpose of the filter matrix.
+class NodalDensityParameters:
+public MAST::NonlinearImplicitAssembly::ElemParameters,
+public MAST::FieldFunction<RealVectorX> {
+public:
+    NodalDensityParameters(libMesh::System& density_sys):
+    MAST::NonlinearImplicitAssembly::ElemParameters(),
+    MAST::FieldFunction<RealVectorX>("drho"),
+    _sys(density_sys),
+    _param("rho_node", 0.),
+    _elem(nullptr),
+    _node(0) { }
+    virtual ~NodalDensityParameters() {}
+    
+    virtual unsigned int n_parameters() const { return _sys.n_dofs();}
+    
+    virtual void elem_parameters(const libMesh::Elem& e,
+                                 std::vector<unsigned int>& ids) const {
+        
+        ids.resize(e.n_nodes());
+        for (unsigned int i=0; i<e.n_nodes(); i++)
+            ids[i] = e.node_ptr(i)->dof_number(_sys.number(), 0, 0);
+    }
+    
+    virtual const MAST::FunctionBase& activate(const libMesh::Elem& e,
+                                               const unsigned int id) {
+        
+        // the shape function values are cached at the quadrature points
+        // of the active element, and are reused for all its nodes
+        if (_elem != &e)
+            _shape_cache.clear();
+        
+        _elem = &e;
+        for (_node=0; _node<e.n_nodes(); _node++)
+            if (e.node_ptr(_node)->dof_number(_sys.number(), 0, 0) == id)
+                break;
+        libmesh_assert_less(_node, e.n_nodes());
+        
+        return _param;
+    }
+    
+    void clear() { _elem = nullptr; _shape_cache.clear();}
+    
+    const MAST::Parameter& parameter() const { return _param;}
+    
+    virtual void operator() (const libMesh::Point& p, const Real t, RealVectorX& v) const {
+        
+        libmesh_assert(_elem);
+        
+        std::map<libMesh::Point, RealVectorX>::iterator
+        it = _shape_cache.find(p);
+        
+        if (it == _shape_cache.end()) {
+            
+            const libMesh::FEType
+            &fe_type = _sys.variable_type(0);
+            
+            libMesh::Point
+            xi = libMesh::FEInterface::inverse_map(_elem->dim(), fe_type, _elem, p);
+            
+            RealVectorX
+            phi = RealVectorX::Zero(_elem->n_nodes());
+            
+            for (unsigned int i=0; i<_elem->n_nodes(); i++)
+                phi(i) = libMesh::FEInterface::shape(_elem->dim(), fe_type, _elem, i, xi);
+            
+            it = _shape_cache.insert(std::pair<libMesh::Point, RealVectorX>(p, phi)).first;
+        }
+        
+        v.setZero(1);
+        v(0) = it->second(_node);
+    }
+    
+private:
+    libMesh::System&       _sys;
+    MAST::Parameter        _param;
+    const libMesh::Elem*   _elem;
+    unsigned int           _node;
+    
+    // shape function values of all nodes of the active element at the
+    // points where this function has been evaluated
+    mutable std::map<libMesh::Point, RealVectorX> _shape_cache;
+};
+
+
+
 class TopologyOptimizationSIMP2D:
 public MAST::FunctionEvaluation {
     
@@ -170,6 +267,8 @@ protected:
     Real                                      _p_val, _vm_rho;
     Real                                      _vf;      // volume fraction
     Real                                      _rho_min; // lower limit on density
+    bool                                      _if_streaming_stress;
+    bool                                      _streaming_stress_checked;
 
     ElasticityFunction*                       _Ef;
     libMesh::UnstructuredMesh*                _mesh;
@@ -189,7 +288,8 @@ protected:
     MAST::ElementPropertyCardBase*            _p_card;
     
     MAST::MeshFieldFunction*                  _density_function;
-    MAST::MeshFieldFunction*                  _density_sens_function;
+    NodalDensityParameters*                   _density_sens_function;
+    MAST::ParameterDependencyIndex*           _dependency_index;
     libMesh::ExodusII_IO*                     _output;
     
     libMesh::FEType                           _fetype;
@@ -901,6 +1001,23 @@ public:
         _discipline->set_property_for_subdomain(0, *p_card);
     }
     
+    
+    //
+    //   \subsection  ex_6_parameter_dependency Parameter Dependency
+    //
+    //   The dependency of the property cards on the nodal density parameter
+    //   is queried by each element in the sensitivity analysis. This is
+    //   computed once here, so that each query is a single lookup.
+    //
+    void _init_parameter_dependency() {
+        
+        _dependency_index = new MAST::ParameterDependencyIndex;
+        _dependency_index->add_parameter(_density_sens_function->parameter());
+        _dependency_index->add_function_set(*_m_card);
+        _dependency_index->add_function_set(*_p_card);
+        _dependency_index->init();
+    }
+    
 
     //
     //   \section  ex_6_initial_solution Initial Density field
@@ -1383,6 +1500,7 @@ public:
         stress.set_discipline_and_system(*_discipline, *_sys_init);
         stress.set_participating_elements_to_all();
         stress.set_aggregation_coefficients(_p_val, 1., _vm_rho, _stress_lim) ;
+        stress.set_streaming_aggregation(_if_streaming_stress);
         compliance.set_participating_elements_to_all();
         compliance.set_discipline_and_system(*_discipline, *_sys_init);
 
@@ -1398,16 +1516,39 @@ public:
         // set the elasticity penalty for solution
         _Ef->set_penalty_val(penalty);
         
-        _sys->solve(nonlinear_elem_ops, nonlinear_assembly);
         SNESConvergedReason
-        r = dynamic_cast<libMesh::PetscNonlinearSolver<Real>&>
-        (*_sys->nonlinear_solver).get_converged_reason();
+        r;
+        Real
+        res_norm = 0.;
+        
+        // the matrix-free solver computes the Jacobian-vector products
+        // element-by-element and does not assemble the stiffness matrix
+        if (_input("if_matrix_free", "flag to use the matrix-free nonlinear solver", false)) {
+            
+            MAST::MatrixFreeNonlinearSolver
+            solver(_sys->comm(), "matrix_free");
+            
+            nonlinear_assembly.set_elem_operation_object(nonlinear_elem_ops);
+            solver.set_assembly(nonlinear_assembly);
+            solver.solve();
+            nonlinear_assembly.clear_elem_operation_object();
+            
+            r        = solver.get_converged_reason();
+            res_norm = solver.final_residual_norm();
+        }
+        else {
+            
+            _sys->solve(nonlinear_elem_ops, nonlinear_assembly);
+            r = dynamic_cast<libMesh::PetscNonlinearSolver<Real>&>
+            (*_sys->nonlinear_solver).get_converged_reason();
+            res_norm = _sys->final_nonlinear_residual();
+        }
         
         // if the solver diverged due to linear solve, then there is a problem with
         // this geometry and we need to return with a high value set for the
         // constraints
         if (r == SNES_DIVERGED_LINEAR_SOLVE ||
-            _sys->final_nonlinear_residual() > 1.e-1) {
+            res_norm > 1.e-1) {
             
             obj = 1.e11;
             for (unsigned int i=0; i<_n_ineq; i++)
@@ -1483,6 +1624,20 @@ public:
                                          nonlinear_elem_ops,
                                          nonlinear_assembly,
                                          grads);
+            
+            // the first time the streaming aggregation is used, its
+            // value and gradient are compared with those computed from
+            // the stored stress data
+            if (_if_streaming_stress && !_streaming_stress_checked) {
+                
+                _check_streaming_stress_aggregation(penalty,
+                                                    stress_penalty,
+                                                    vm_agg,
+                                                    grads,
+                                                    nonlinear_elem_ops,
+                                                    nonlinear_assembly);
+                _streaming_stress_checked = true;
+            }
 
             //_evaluate_volume(nullptr, &grads);
             //for (unsigned int i=0; i<grads.size(); i++) grads[i] /= (_length*_height);
@@ -1643,59 +1798,103 @@ public:
         
         _sys->adjoint_solve(nonlinear_elem_ops, stress, nonlinear_assembly, false);
         
-        std::unique_ptr<libMesh::NumericVector<Real>>
-        dphi_base(_density_sys->solution->zero_clone().release()),
-        dphi_filtered(_density_sys->solution->zero_clone().release());
+        std::vector<Real>
+        dq_drho,
+        dq_drho_partial;
+        
+        //////////////////////////////////////////////////////////////////////
+        // stress sensitivity with respect to the nodal filtered densities
+        //////////////////////////////////////////////////////////////////////
+        // set the elasticity penalty for solution, which is needed for
+        // computation of the residual sensitivity
+        _Ef->set_penalty_val(penalty);
+        nonlinear_assembly.calculate_output_adjoint_sensitivities(*_sys->solution,
+                                                                  _sys->get_adjoint_solution(),
+                                                                  *_density_sens_function,
+                                                                  nonlinear_elem_ops,
+                                                                  stress,
+                                                                  dq_drho,
+                                                                  false);
+        
+        _Ef->set_penalty_val(stress_penalty);
+        nonlinear_assembly.calculate_output_partial_sensitivities(*_sys->solution,
+                                                                  *_density_sens_function,
+                                                                  stress,
+                                                                  dq_drho_partial);
+        _density_sens_function->clear();
+        stress.clear_sensitivity_data();
         
-        ElementParameterDependence dep(*_filter);
-        nonlinear_assembly.attach_elem_parameter_dependence_object(dep);
+        for (unsigned int i=0; i<dq_drho.size(); i++)
+            dq_drho[i] += dq_drho_partial[i];
         
         //////////////////////////////////////////////////////////////////
         // indices used by GCMMA follow this rule:
         // grad_k = dfi/dxj  ,  where k = j*NFunc + i
         //////////////////////////////////////////////////////////////////
-        for (unsigned int i=0; i<_n_vars; i++) {
-            
-            dphi_base->zero();
-            dphi_filtered->zero();
-            //
-            // set the value only if the dof corresponds to a local node
-            //
-            if (_dv_params[i].first >=  dphi_base->first_local_index() &&
-                _dv_params[i].first <   dphi_base->last_local_index())
-                dphi_base->set(_dv_params[i].first, 1.);
-            dphi_base->close();
-            _filter->compute_filtered_values(*dphi_base, *dphi_filtered);
-            
-            _density_sens_function->init(*dphi_filtered);
-            
-            //////////////////////////////////////////////////////////////////////
-            // stress sensitivity
-            //////////////////////////////////////////////////////////////////////
-            // set the elasticity penalty for solution, which is needed for
-            // computation of the residual sensitivity
-            _Ef->set_penalty_val(penalty);
-
-            grads[1*i+0] = 1./_stress_lim*
-            nonlinear_assembly.calculate_output_adjoint_sensitivity(*_sys->solution,
-                                                                    _sys->get_adjoint_solution(),
-                                                                    *_dv_params[i].second,
-                                                                    nonlinear_elem_ops,
-                                                                    stress,
-                                                                    false);
-            
-            _Ef->set_penalty_val(stress_penalty);
-            nonlinear_assembly.calculate_output_direct_sensitivity(*_sys->solution,
-                                                                   nullptr,
-                                                                   *_dv_params[i].second,
-                                                                   stress);
-            grads[1*i+0] += 1./_stress_lim* stress.output_sensitivity_total(*_dv_params[i].second);
+        _evaluate_design_variable_gradient(dq_drho, 1./_stress_lim, grads);
+    }
+
+    
+    //
+    //  compares the stress constraint and its gradient computed in the
+    //  streaming aggregation mode with those computed from the stored
+    //  stress data of all elements.
+    //
+    void
+    _check_streaming_stress_aggregation
+    (const Real                       penalty,
+     const Real                       stress_penalty,
+     const Real                       vm_agg,
+     const std::vector<Real>&         grads,
+     MAST::AssemblyElemOperations&    nonlinear_elem_ops,
+     MAST::NonlinearImplicitAssembly& nonlinear_assembly) {
+        
+        const Real
+        tol   = 1.e-8;
+        
+        MAST::StressStrainOutputBase
+        stress;
+        stress.set_discipline_and_system(*_discipline, *_sys_init);
+        stress.set_participating_elements_to_all();
+        stress.set_aggregation_coefficients(_p_val, 1., _vm_rho, _stress_lim) ;
+        
+        _Ef->set_penalty_val(stress_penalty);
+        nonlinear_assembly.calculate_output(*_sys->solution, stress);
+        
+        std::vector<Real>
+        stored_grads(grads.size(), 0.);
+        
+        const Real
+        stored_vm_agg = stress.output_total();
+        
+        _evaluate_stress_sensitivity(penalty,
+                                     stress_penalty,
+                                     stress,
+                                     nonlinear_elem_ops,
+                                     nonlinear_assembly,
+                                     stored_grads);
+        
+        Real
+        grad_norm = 0.,
+        diff_norm = 0.;
+        
+        for (unsigned int i=0; i<grads.size(); i++) {
             
-            stress.clear_sensitivity_data();
-            _density_sens_function->clear();
+            grad_norm += stored_grads[i]*stored_grads[i];
+            diff_norm += (grads[i]-stored_grads[i])*(grads[i]-stored_grads[i]);
         }
         
-        nonlinear_assembly.clear_elem_parameter_dependence_object();
+        grad_norm = sqrt(grad_norm);
+        diff_norm = sqrt(diff_norm);
+        
+        libMesh::out
+        << "streaming stress aggregation: " << vm_agg
+        << "  stored: " << stored_vm_agg
+        << "  gradient difference: " << diff_norm << std::endl;
+        
+        if (fabs(vm_agg-stored_vm_agg) > tol * fabs(stored_vm_agg) ||
+            diff_norm > tol * grad_norm)
+            libmesh_error_msg("Streaming stress aggregation does not match the stored stress data.");
     }
 
     
@@ -1706,47 +1905,51 @@ public:
      MAST::NonlinearImplicitAssembly&         nonlinear_assembly,
      std::vector<Real>& grads) {
         
-        // Adjoint solution for compliance = - X
+        // Adjoint solution for compliance = - X. The loads do not depend
+        // on the density, so the partial sensitivity of compliance is zero.
+        std::vector<Real>
+        dq_drho;
+        
+        nonlinear_assembly.calculate_output_adjoint_sensitivities(*_sys->solution,
+                                                                  *_sys->solution,
+                                                                  *_density_sens_function,
+                                                                  nonlinear_elem_ops,
+                                                                  compliance,
+                                                                  dq_drho,
+                                                                  false);
+        _density_sens_function->clear();
+        
+        _evaluate_design_variable_gradient(dq_drho, -1., grads);
+    }
+    
+    
+    //
+    //  sensitivity with respect to the design variables from the
+    //  sensitivity \p dq_drho with respect to the nodal filtered densities
+    //
+    void
+    _evaluate_design_variable_gradient(const std::vector<Real>& dq_drho,
+                                       const Real scale,
+                                       std::vector<Real>& grads) {
+        
+        libmesh_assert_equal_to(dq_drho.size(), _density_sys->n_dofs());
         
         std::unique_ptr<libMesh::NumericVector<Real>>
-        dphi_base(_density_sys->solution->zero_clone().release()),
-        dphi_filtered(_density_sys->solution->zero_clone().release());
+        dq_dfiltered(_density_sys->solution->zero_clone().release()),
+        dq_dbase(_density_sys->solution->zero_clone().release());
         
-        ElementParameterDependence dep(*_filter);
-        nonlinear_assembly.attach_elem_parameter_dependence_object(dep);
-
-        //////////////////////////////////////////////////////////////////
-        // indices used by GCMMA follow this rule:
-        // grad_k = dfi/dxj  ,  where k = j*NFunc + i
-        //////////////////////////////////////////////////////////////////
-        for (unsigned int i=0; i<_n_vars; i++) {
-            
-            dphi_base->zero();
-            dphi_filtered->zero();
-            //
-            // set the value only if the dof corresponds to a local node
-            //
-            if (_dv_params[i].first >=  dphi_base->first_local_index() &&
-                _dv_params[i].first <   dphi_base->last_local_index())
-                dphi_base->set(_dv_params[i].first, 1.);
-            dphi_base->close();
-            _filter->compute_filtered_values(*dphi_base, *dphi_filtered);
-            
-            _density_sens_function->init(*dphi_filtered);
-            
-            //////////////////////////////////////////////////////////////////////
-            // compliance sensitivity
-            //////////////////////////////////////////////////////////////////////
-            grads[i] = -1. *
-            nonlinear_assembly.calculate_output_adjoint_sensitivity(*_sys->solution,
-                                                                    *_sys->solution,
-                                                                    *_dv_params[i].second,
-                                                                    nonlinear_elem_ops,
-                                                                    compliance);
-            _density_sens_function->clear();
-        }
+        for (libMesh::dof_id_type i=dq_dfiltered->first_local_index();
+             i<dq_dfiltered->last_local_index(); i++)
+            dq_dfiltered->set(i, dq_drho[i]);
+        dq_dfiltered->close();
+        
+        _filter->compute_filter_transpose_product(*dq_dfiltered, *dq_dbase);
+        
+        std::vector<Real> dq_dx;
+        dq_dbase->localize(dq_dx);
         
-        nonlinear_assembly.clear_elem_parameter_dependence_object();
+        for (unsigned int i=0; i<_n_vars; i++)
+            grads[i] = scale * dq_dx[_dv_params[i].first];
     }
 
     //
@@ -1869,6 +2072,8 @@ public:
     _vm_rho                              (0.),
     _vf                                  (0.),
     _rho_min                             (0.),
+    _if_streaming_stress                 (false),
+    _streaming_stress_checked            (false),
     _mesh                                (nullptr),
     _eq_sys                              (nullptr),
     _sys                                 (nullptr),
@@ -1877,6 +2082,7 @@ public:
     _filter                              (nullptr),
     _m_card                              (nullptr),
     _p_card                              (nullptr),
+    _dependency_index                    (nullptr),
     _output                              (nullptr) {
         
         libmesh_assert(!_initialized);
@@ -1893,11 +2099,12 @@ public:
         // density function is used by elasticity modulus function. So, we
         // initialize this here
         _density_function        = new MAST::MeshFieldFunction(*_density_sys, "rho");
-        _density_sens_function   = new MAST::MeshFieldFunction(*_density_sys, "rho");
+        _density_sens_function   = new NodalDensityParameters(*_density_sys);
 
         _init_material();
         _init_loads();
         _init_section_property();
+        _init_parameter_dependency();
         _initialized = true;
         
         //
@@ -1926,6 +2133,7 @@ public:
         _stress_lim            = _input("vm_stress_limit", "limit von-mises stress value", 2.e8);
         _p_val                 = _input("constraint_aggregation_p_val", "value of p in p-norm stress aggregation", 2.0);
         _vm_rho                = _input("constraint_aggregation_rho_val", "value of rho in p-norm stress aggregation", 2.0);
+        _if_streaming_stress   = _input("if_streaming_stress_aggregation", "flag to aggregate the stress constraint without retaining the element stress data", false);
         _output                = new libMesh::ExodusII_IO(*_mesh);
         
         //
@@ -1945,6 +2153,10 @@ public:
     //
     ~TopologyOptimizationSIMP2D() {
         
+        // the index is cleared before the functions registered with it
+        // are deleted
+        delete _dependency_index;
+        
         {
             std::set<MAST::BoundaryConditionBase*>::iterator
             it   = _boundary_conditions.begin(),
@@ -2159,6 +2371,9 @@ int main(int argc, char* argv[]) {
 
     libMesh::LibMeshInit init(argc, argv);
 
+    // pooled finite element objects are deleted before libMesh is finalized
+    MAST::FECache::Guard fe_cache_guard;
+
     MAST::Examples::GetPotWrapper
     input(argc, argv, "input");
 
@@ -2206,9 +2421,17 @@ int main(int argc, char* argv[]) {
         
         optimizer->attach_function_evaluation_object(top_opt);
 
-        //std::vector<Real> xx1(top_opt.n_vars()), xx2(top_opt.n_vars());
-        //top_opt.init_dvar(xx1, xx2, xx2);
-        //top_opt.verify_gradients(xx1);
+        // the adjoint gradients, computed with the nodal density parameters,
+        // can be compared with central finite differences at the initial
+        // design before the optimization
+        if (input("verify_gradients", "compare adjoint gradients with finite differences at the initial design", false)) {
+            
+            std::vector<Real> xx1(top_opt.n_vars()), xx2(top_opt.n_vars());
+            top_opt.init_dvar(xx1, xx2, xx2);
+            if (!top_opt.verify_gradients(xx1))
+                libmesh_error_msg("Adjoint gradients do not match finite differences");
+        }
+        
         optimizer->optimize();
     }
     
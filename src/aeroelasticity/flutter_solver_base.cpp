@@ -17,24 +17,73 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+// C++ includes
+#include <algorithm>
+
+
 // MAST includes
 #include "aeroelasticity/flutter_solver_base.h"
 #include "aeroelasticity/flutter_solution_base.h"
 #include "aeroelasticity/flutter_root_base.h"
 #include "aeroelasticity/flutter_root_crossover_base.h"
 #include "elasticity/structural_fluid_interaction_assembly.h"
+#include "elasticity/fsi_generalized_aero_force_assembly.h"
 #include "elasticity/piston_theory_boundary_condition.h"
 #include "base/physics_discipline_base.h"
 #include "base/boundary_condition_base.h"
 #include "numerics/lapack_dggev_interface.h"
+#include "numerics/lapack_zggev_interface.h"
 #include "base/parameter.h"
+#include "base/nonlinear_system.h"
+
+// libMesh includes
+#include "libmesh/threads.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   computes the eigensolutions for a range of points of a flutter
+     *   scan. This is used with libMesh::Threads::parallel_for.
+     */
+    class FlutterScanEigenSolver {
+    public:
+        
+        FlutterScanEigenSolver(const MAST::FlutterSolverBase::ScanMatrices& mats,
+                               std::vector<MAST::LAPACK_ZGGEV>& ges):
+        _mats(mats),
+        _ges(ges) { }
+        
+        void operator() (const libMesh::Threads::BlockedRange<unsigned int>& range) const {
+            
+            ComplexMatrixX
+            A,
+            B;
+            
+            for (unsigned int i=range.begin(); i<range.end(); i++) {
+                
+                _mats.init(i, A, B);
+                _ges[i].compute(A, B);
+                _ges[i].scale_eigenvectors_to_identity_innerproduct();
+            }
+        }
+        
+    protected:
+        
+        const MAST::FlutterSolverBase::ScanMatrices& _mats;
+        
+        std::vector<MAST::LAPACK_ZGGEV>&             _ges;
+    };
+}
+
 
 
 MAST::FlutterSolverBase::FlutterSolverBase():
 _assembly(nullptr),
 _basis_vectors(nullptr),
 _output(nullptr),
-_steady_solver(nullptr) {
+_steady_solver(nullptr),
+_if_structural_matrices(false) {
     
 }
 
@@ -73,6 +122,9 @@ MAST::FlutterSolverBase::clear() {
         delete _output;
         _output = nullptr;
     }
+    
+    this->clear_reduced_order_matrices();
+    _gaf_interp_kr.clear();
 }
 
 
@@ -90,6 +142,9 @@ MAST::FlutterSolverBase::clear_assembly_object() {
     
     _assembly      = nullptr;
     _steady_solver = nullptr;
+    
+    // matrices from a different assembly object may not be reused
+    this->clear_reduced_order_matrices();
 }
 
 
@@ -101,6 +156,272 @@ initialize(std::vector<libMesh::NumericVector<Real> *>& basis) {
     
     
     _basis_vectors  = &basis;
+    
+    this->clear_reduced_order_matrices();
+}
+
+
+
+void
+MAST::FlutterSolverBase::
+set_gaf_interpolation_points(const std::vector<Real>& kr_vals) {
+    
+    _gaf_interp_kr = kr_vals;
+    std::sort(_gaf_interp_kr.begin(), _gaf_interp_kr.end());
+    _gaf_interp_kr.erase(std::unique(_gaf_interp_kr.begin(),
+                                     _gaf_interp_kr.end()),
+                         _gaf_interp_kr.end());
+    
+    // at least two points are needed for interpolation
+    libmesh_assert(_gaf_interp_kr.empty() || _gaf_interp_kr.size() > 1);
+    
+    _gaf_interp_d2.clear();
+}
+
+
+
+void
+MAST::FlutterSolverBase::clear_reduced_order_matrices() {
+    
+    _if_structural_matrices = false;
+    _reduced_mass.resize(0, 0);
+    _reduced_stiff.resize(0, 0);
+    _gaf_matrices.clear();
+    _gaf_interp_d2.clear();
+}
+
+
+
+void
+MAST::FlutterSolverBase::
+_reduced_order_structural_matrices(const RealMatrixX*& m,
+                                   const RealMatrixX*& k) {
+    
+    libmesh_assert(_assembly);
+    libmesh_assert(_basis_vectors);
+    
+    if (!_if_structural_matrices) {
+        
+        const unsigned int n = (unsigned int)_basis_vectors->size();
+        
+        _reduced_mass   = RealMatrixX::Zero(n, n);
+        _reduced_stiff  = RealMatrixX::Zero(n, n);
+        
+        std::map<MAST::StructuralQuantityType, RealMatrixX*> qty_map;
+        qty_map[MAST::MASS]       = &_reduced_mass;
+        qty_map[MAST::STIFFNESS]  = &_reduced_stiff;
+        
+        _assembly->assemble_reduced_order_quantity(*_basis_vectors, qty_map);
+        
+        _if_structural_matrices = true;
+    }
+    
+    m = &_reduced_mass;
+    k = &_reduced_stiff;
+}
+
+
+
+void
+MAST::FlutterSolverBase::
+_scan_eigensolutions(const unsigned int n_pts,
+                     const unsigned int n,
+                     const MAST::FlutterSolverBase::ScanMatrices& mats,
+                     std::vector<MAST::LAPACK_ZGGEV>& ges) {
+    
+    libmesh_assert(_assembly);
+    
+    const libMesh::Parallel::Communicator&
+    comm = _assembly->system().comm();
+    
+    // each processor computes a contiguous block of points
+    const unsigned int
+    n_procs = comm.size(),
+    rank    = comm.rank(),
+    first   = (unsigned int)(((unsigned long)n_pts * rank)/n_procs),
+    last    = (unsigned int)(((unsigned long)n_pts * (rank+1))/n_procs);
+    
+    ges.clear();
+    ges.resize(n_pts);
+    
+    libMesh::Threads::parallel_for
+    (libMesh::Threads::BlockedRange<unsigned int>(first, last, 1),
+     MAST::FlutterScanEigenSolver(mats, ges));
+    
+    if (n_procs == 1)
+        return;
+    
+    // now gather the solutions from all processors. Each processor packs
+    // only the eigensolutions of its own block of points, and since the
+    // blocks are contiguous and ordered by rank, the gathered vector
+    // lists the points in order. The matrices A and B are recreated
+    // locally since they are much cheaper to initialize than to
+    // communicate.
+    const unsigned int
+    n_vals = MAST::LAPACK_ZGGEV::packed_size(n);
+    
+    std::vector<Real>
+    vals((std::size_t)(last-first) * n_vals, 0.);
+    
+    for (unsigned int i=first; i<last; i++)
+        ges[i].pack(&vals[(std::size_t)(i-first) * n_vals]);
+    
+    comm.allgather(vals, false);
+    libmesh_assert_equal_to(vals.size(), (std::size_t)n_pts * n_vals);
+    
+    ComplexMatrixX
+    A,
+    B;
+    
+    for (unsigned int i=0; i<n_pts; i++)
+        if (i < first || i >= last) {
+            
+            mats.init(i, A, B);
+            ges[i].unpack(A, B, &vals[(std::size_t)i * n_vals]);
+        }
+}
+
+
+
+const ComplexMatrixX&
+MAST::FlutterSolverBase::
+_assembled_generalized_aero_force_matrix(MAST::Parameter& kr_param,
+                                         const Real kr) {
+    
+    libmesh_assert(_assembly);
+    libmesh_assert(_basis_vectors);
+    
+    std::map<Real, ComplexMatrixX>::iterator
+    it = _gaf_matrices.find(kr);
+    
+    if (it != _gaf_matrices.end())
+        return it->second;
+    
+    const unsigned int n = (unsigned int)_basis_vectors->size();
+    
+    ComplexMatrixX
+    a = ComplexMatrixX::Zero(n, n);
+    
+    kr_param = kr;
+    
+    dynamic_cast<MAST::FSIGeneralizedAeroForceAssembly*>(_assembly)->
+    assemble_generalized_aerodynamic_force_matrix(*_basis_vectors, a);
+    
+    return _gaf_matrices.insert(std::make_pair(kr, a)).first->second;
+}
+
+
+
+void
+MAST::FlutterSolverBase::_init_gaf_interpolation(MAST::Parameter& kr_param) {
+    
+    libmesh_assert(_gaf_interp_kr.size() > 1);
+    
+    const unsigned int
+    n_pts = (unsigned int)_gaf_interp_kr.size(),
+    n     = (unsigned int)_basis_vectors->size();
+    
+    // make sure that the matrices at all points are available
+    for (unsigned int i=0; i<n_pts; i++)
+        _assembled_generalized_aero_force_matrix(kr_param, _gaf_interp_kr[i]);
+    
+    // the natural spline has zero second derivatives at the end points.
+    // The remaining values are obtained from the tridiagonal system
+    //   h_{i-1} M_{i-1} + 2 (h_{i-1} + h_i) M_i + h_i M_{i+1} =
+    //     6 ((A_{i+1} - A_i)/h_i - (A_i - A_{i-1})/h_{i-1})
+    // which is solved using the Thomas algorithm with the matrices
+    // as right-hand sides.
+    _gaf_interp_d2.resize(n_pts, ComplexMatrixX::Zero(n, n));
+    
+    if (n_pts == 2)
+        return;
+    
+    std::vector<Real>
+    diag(n_pts, 0.);
+    
+    for (unsigned int i=1; i<n_pts-1; i++) {
+        
+        const Real
+        h0 = _gaf_interp_kr[i]   - _gaf_interp_kr[i-1],
+        h1 = _gaf_interp_kr[i+1] - _gaf_interp_kr[i];
+        
+        const ComplexMatrixX
+        &a0 = _gaf_matrices[_gaf_interp_kr[i-1]],
+        &a1 = _gaf_matrices[_gaf_interp_kr[i]],
+        &a2 = _gaf_matrices[_gaf_interp_kr[i+1]];
+        
+        diag[i]           = 2. * (h0 + h1);
+        _gaf_interp_d2[i] = 6. * ((a2 - a1)/h1 - (a1 - a0)/h0);
+        
+        // forward elimination of the sub-diagonal term
+        if (i > 1) {
+            
+            const Real f = h0/diag[i-1];
+            diag[i]           -= f * h0;
+            _gaf_interp_d2[i] -= f * _gaf_interp_d2[i-1];
+        }
+    }
+    
+    // back substitution
+    for (unsigned int i=n_pts-2; i>0; i--) {
+        
+        if (i < n_pts-2)
+            _gaf_interp_d2[i] -=
+            (_gaf_interp_kr[i+1] - _gaf_interp_kr[i]) * _gaf_interp_d2[i+1];
+        
+        _gaf_interp_d2[i] /= diag[i];
+    }
+}
+
+
+
+void
+MAST::FlutterSolverBase::
+_generalized_aero_force_matrix(MAST::Parameter& kr_param,
+                               const Real kr,
+                               ComplexMatrixX& a) {
+    
+    if (_gaf_interp_kr.empty() ||
+        kr < _gaf_interp_kr.front() ||
+        kr > _gaf_interp_kr.back()) {
+        
+        a = _assembled_generalized_aero_force_matrix(kr_param, kr);
+    }
+    else {
+        
+        if (_gaf_interp_d2.empty())
+            _init_gaf_interpolation(kr_param);
+        
+        // identify the interval that contains kr
+        unsigned int
+        i = (unsigned int)(std::upper_bound(_gaf_interp_kr.begin(),
+                                            _gaf_interp_kr.end(),
+                                            kr) - _gaf_interp_kr.begin());
+        if (i == _gaf_interp_kr.size()) i--;
+        if (i > 0) i--;
+        
+        const Real
+        k0 = _gaf_interp_kr[i],
+        k1 = _gaf_interp_kr[i+1],
+        h  = k1 - k0,
+        w0 = k1 - kr,
+        w1 = kr - k0;
+        
+        const ComplexMatrixX
+        &a0 = _gaf_matrices[k0],
+        &a1 = _gaf_matrices[k1],
+        &m0 = _gaf_interp_d2[i],
+        &m1 = _gaf_interp_d2[i+1];
+        
+        a =
+        (pow(w0, 3)/(6.*h)) * m0 +
+        (pow(w1, 3)/(6.*h)) * m1 +
+        (w0/h) * (a0 - (h*h/6.) * m0) +
+        (w1/h) * (a1 - (h*h/6.) * m1);
+    }
+    
+    // leave the parameter at the requested value
+    kr_param = kr;
 }
 
 
@@ -24,6 +24,8 @@
 #include <string>
 #include <fstream>
 #include <iomanip>
+#include <vector>
+#include <map>
 
 
 // MAST includes
@@ -39,11 +41,13 @@ namespace MAST {
     
     // Forward declerations
     class FunctionBase;
+    class Parameter;
     class FlutterModel;
     class FlutterRootBase;
     class FlutterSolutionBase;
     class FlutterRootCrossoverBase;
     class StructuralFluidInteractionAssembly;
+    class LAPACK_ZGGEV;
     template <typename ValType> class BasisMatrix;
     
     
@@ -89,6 +93,31 @@ namespace MAST {
         };
 
         
+        /*!
+         *   abstract class defines the interface to initialize the matrices
+         *   of the eigenproblem \f$ A x = \lambda B x \f$ at a point of the
+         *   scan in _scan_eigensolutions(). Since the points are evaluated
+         *   concurrently, the implementation must not modify any data
+         *   shared between points, and must not perform any parallel
+         *   assembly. All reduced-order matrices should be computed before
+         *   the scan.
+         */
+        class ScanMatrices {
+        public:
+            
+            ScanMatrices() {}
+            
+            virtual ~ScanMatrices() {}
+            
+            /*!
+             *   initializes \p A and \p B for the \p i th point
+             */
+            virtual void init(const unsigned int i,
+                              ComplexMatrixX& A,
+                              ComplexMatrixX& B) const = 0;
+        };
+        
+        
         /*!
          *    attaches the assembly object to this solver.
          */
@@ -130,6 +159,27 @@ namespace MAST {
         }
         
         
+        /*!
+         *   specifies the reduced frequencies at which the generalized
+         *   aerodynamic force matrix is sampled for interpolation. If
+         *   provided, A(kr) for kr within the range of these samples is
+         *   obtained from a cubic spline through the sampled matrices, so
+         *   that the iterative root search does not require new fluid
+         *   solutions. Values of kr outside the range are assembled directly.
+         *   An empty vector disables the interpolation.
+         */
+        void set_gaf_interpolation_points(const std::vector<Real>& kr_vals);
+        
+        
+        /*!
+         *   clears the reduced-order structural and generalized aerodynamic
+         *   force matrices stored by this solver. This must be called if the
+         *   structural or fluid model changes between analyses that use the
+         *   same assembly and basis.
+         */
+        void clear_reduced_order_matrices();
+        
+        
         /*!
          *   Prints the sorted roots to the \p output
          */
@@ -146,6 +196,61 @@ namespace MAST {
     protected:
         
         
+        /*!
+         *   computes the eigensolutions at \p n_pts points of a scan, where
+         *   the \p n x \p n matrices of each point are provided by \p mats.
+         *   The points are distributed in contiguous blocks across the
+         *   processors, and across threads on each processor. The
+         *   solutions are then gathered so that, on return, \p ges contains
+         *   the solutions of all points on all processors. This must be
+         *   called on all processors.
+         */
+        void _scan_eigensolutions(const unsigned int n_pts,
+                                  const unsigned int n,
+                                  const MAST::FlutterSolverBase::ScanMatrices& mats,
+                                  std::vector<MAST::LAPACK_ZGGEV>& ges);
+        
+        
+        /*!
+         *   @returns the reduced-order structural mass and stiffness matrices
+         *   in \p m and \p k. These do not depend on the reduced frequency
+         *   or the flight velocity, and are assembled only once after
+         *   initialization.
+         */
+        void _reduced_order_structural_matrices(const RealMatrixX*& m,
+                                                const RealMatrixX*& k);
+        
+        
+        /*!
+         *   computes the generalized aerodynamic force matrix at reduced
+         *   frequency \p kr in \p a. \p kr_param is the parameter that
+         *   defines the reduced frequency for the fluid assembly. Matrices
+         *   assembled at a given \p kr are stored and reused. If
+         *   interpolation points have been specified, the matrix is
+         *   interpolated when \p kr lies within their range.
+         */
+        void _generalized_aero_force_matrix(MAST::Parameter& kr_param,
+                                            const Real kr,
+                                            ComplexMatrixX& a);
+        
+        
+        /*!
+         *   @returns the generalized aerodynamic force matrix assembled at
+         *   \p kr, or the stored matrix if it was assembled earlier.
+         */
+        const ComplexMatrixX&
+        _assembled_generalized_aero_force_matrix(MAST::Parameter& kr_param,
+                                                 const Real kr);
+        
+        
+        /*!
+         *   computes the second derivatives of the natural cubic spline
+         *   through the generalized aerodynamic force matrices at the
+         *   interpolation points.
+         */
+        void _init_gaf_interpolation(MAST::Parameter& kr_param);
+        
+        
         /*!
          *   structural assembly that provides the assembly of the system
          *   matrices.
@@ -170,6 +275,45 @@ namespace MAST {
          */
         MAST::FlutterSolverBase::SteadySolver* _steady_solver;
         
+        
+        /*!
+         *    flag is true if the reduced-order mass and stiffness matrices
+         *    have been assembled
+         */
+        bool                                            _if_structural_matrices;
+        
+        
+        /*!
+         *    reduced-order structural mass matrix
+         */
+        RealMatrixX                                     _reduced_mass;
+        
+        
+        /*!
+         *    reduced-order structural stiffness matrix
+         */
+        RealMatrixX                                     _reduced_stiff;
+        
+        
+        /*!
+         *    generalized aerodynamic force matrices assembled so far, with
+         *    reduced frequency as the key
+         */
+        std::map<Real, ComplexMatrixX>                  _gaf_matrices;
+        
+        
+        /*!
+         *    sorted reduced frequencies used for interpolation of the
+         *    generalized aerodynamic force matrix
+         */
+        std::vector<Real>                               _gaf_interp_kr;
+        
+        
+        /*!
+         *    second derivatives of the cubic spline at the interpolation
+         *    points. This is empty until the spline is initialized.
+         */
+        std::vector<ComplexMatrixX>                     _gaf_interp_d2;
     };
 }
 
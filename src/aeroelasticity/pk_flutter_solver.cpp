@@ -28,6 +28,53 @@
 #include "base/parameter.h"
 
 
+class MAST::PKFlutterSolver::PKScanMatrices:
+public MAST::FlutterSolverBase::ScanMatrices {
+    
+public:
+    
+    PKScanMatrices(const MAST::PKFlutterSolver&        solver,
+                   const std::vector<Real>&            v_ref_vals,
+                   const RealMatrixX&                  m,
+                   const RealMatrixX&                  k,
+                   const std::vector<ComplexMatrixX>&  a_vals):
+    MAST::FlutterSolverBase::ScanMatrices(),
+    _solver      (solver),
+    _v_ref_vals  (v_ref_vals),
+    _m           (m),
+    _k           (k),
+    _a_vals      (a_vals) { }
+    
+    virtual ~PKScanMatrices() { }
+    
+    /*!
+     *   the points are ordered with velocity varying fastest
+     */
+    virtual void init(const unsigned int i,
+                      ComplexMatrixX& A,
+                      ComplexMatrixX& B) const {
+        
+        const unsigned int
+        n_v = (unsigned int)_v_ref_vals.size();
+        
+        _solver._initialize_matrices(_v_ref_vals[i%n_v],
+                                     _m,
+                                     _k,
+                                     _a_vals[i/n_v],
+                                     A,
+                                     B);
+    }
+    
+protected:
+    
+    const MAST::PKFlutterSolver&        _solver;
+    const std::vector<Real>&            _v_ref_vals;
+    const RealMatrixX&                  _m;
+    const RealMatrixX&                  _k;
+    const std::vector<ComplexMatrixX>&  _a_vals;
+};
+
+
 MAST::PKFlutterSolver::PKFlutterSolver():
 MAST::FlutterSolverBase(),
 _velocity_param(nullptr),
@@ -156,6 +203,51 @@ MAST::PKFlutterSolver::scan_for_roots() {
         }
         k_red_vals[_n_k_red_divs] = _kr_range.first; // to get around finite-precision arithmetic
         
+        // march from the upper limit to the lower to find the roots
+        Real current_v_ref = _V_range.first,
+        delta_v_ref = (_V_range.second-_V_range.first)/_n_V_divs;
+        
+        std::vector<Real> v_ref_vals(_n_V_divs+1);
+        for (unsigned int i=0; i<_n_V_divs+1; i++) {
+            v_ref_vals[i] = current_v_ref;
+            current_v_ref += delta_v_ref;
+        }
+        v_ref_vals[_n_V_divs] = _V_range.second; // to get around finite-precision arithmetic
+        
+        // the reduced-order matrices are assembled on all processors
+        // before the eigensolutions, which are then distributed across
+        // processors and threads.
+        const RealMatrixX
+        *m     = nullptr,
+        *k     = nullptr;
+        
+        std::vector<ComplexMatrixX> a_vals(_n_k_red_divs+1);
+        
+        _reduced_order_structural_matrices(m, k);
+        for (unsigned int j=0; j<_n_k_red_divs+1; j++)
+            _generalized_aero_force_matrix(*_kred_param, k_red_vals[j], a_vals[j]);
+        
+        libMesh::out
+        << " ====================================================" << std::endl
+        << "PK Solution scan" << std::endl
+        << "   n_k_red = " << std::setw(10) << _n_k_red_divs+1 << std::endl
+        << "   n_V_ref = " << std::setw(10) << _n_V_divs+1 << std::endl;
+        
+        std::vector<MAST::LAPACK_ZGGEV> ges;
+        MAST::PKFlutterSolver::PKScanMatrices mats(*this, v_ref_vals, *m, *k, a_vals);
+        _scan_eigensolutions((_n_k_red_divs+1)*(_n_V_divs+1),
+                             2*(unsigned int)m->rows(),
+                             mats,
+                             ges);
+        
+        libMesh::out
+        << "Finished PK Solution scan" << std::endl
+        << " ====================================================" << std::endl;
+        
+        // the roots are sorted in the order of the scan after all
+        // eigensolutions are available
+        RealMatrixX stiff;
+        
         //
         //  outer loop is on reduced frequency
         //
@@ -163,29 +255,23 @@ MAST::PKFlutterSolver::scan_for_roots() {
             
             current_k_red = k_red_vals[j];
             
-            // march from the upper limit to the lower to find the roots
-            Real current_v_ref = _V_range.first,
-            delta_v_ref = (_V_range.second-_V_range.first)/_n_V_divs;
-            
-            std::vector<Real> v_ref_vals(_n_V_divs+1);
-            for (unsigned int i=0; i<_n_V_divs+1; i++) {
-                v_ref_vals[i] = current_v_ref;
-                current_v_ref += delta_v_ref;
-            }
-            v_ref_vals[_n_V_divs] = _V_range.second; // to get around finite-precision arithmetic
-            
             MAST::FlutterSolutionBase* prev_sol = nullptr;
             
             //
-            // inner loop is on reduced frequencies
+            // inner loop is on velocity
             //
             for (unsigned int i=0; i<_n_V_divs+1; i++) {
                 current_v_ref = v_ref_vals[i];
-                std::unique_ptr<MAST::FlutterSolutionBase> sol =
-                _analyze(current_k_red,
-                         current_v_ref,
-                         prev_sol);
                 
+                MAST::PKFlutterSolution* root = new MAST::PKFlutterSolution;
+                root->init(*this,
+                           current_k_red, current_v_ref,
+                           (*_bref_param)(),
+                           stiff, ges[j*(_n_V_divs+1)+i]);
+                if (prev_sol)
+                    root->sort(*prev_sol);
+                
+                std::unique_ptr<MAST::FlutterSolutionBase> sol(root);
                 
                 if (_output)
                     sol->print(*_output);
@@ -981,45 +1067,50 @@ MAST::PKFlutterSolver::_initialize_matrices(const Real k_red,
     //
 
     
-    const unsigned int n = (unsigned int)_basis_vectors->size();
-
-    RealMatrixX
-    m      =  RealMatrixX::Zero(n, n),
-    k      =  RealMatrixX::Zero(n, n);
+    const RealMatrixX
+    *m     = nullptr,
+    *k     = nullptr;
     
     ComplexMatrixX
-    a      =  ComplexMatrixX::Zero(n, n);
-
-    
-    // now prepare a map of the quantities and ask the assembly object to
-    // calculate the quantities of interest.
-    std::map<MAST::StructuralQuantityType, RealMatrixX*> qty_map;
-    qty_map[MAST::MASS]       = &m;
-    qty_map[MAST::STIFFNESS]  = &k;
+    a;
 
     
     // set the velocity value in the parameter that was provided
-    (*_kred_param)      = k_red;
     (*_velocity_param)  = v_ref;
     
-    _assembly->assemble_reduced_order_quantity(*_basis_vectors, qty_map);
+    // M and K are independent of k_red and V, and A depends only on
+    // k_red. These are assembled once and reused by the solver.
+    _reduced_order_structural_matrices(m, k);
+    _generalized_aero_force_matrix(*_kred_param, k_red, a);
 
-    dynamic_cast<MAST::FSIGeneralizedAeroForceAssembly*>(_assembly)->
-    assemble_generalized_aerodynamic_force_matrix(*_basis_vectors, a);
+    _initialize_matrices(v_ref, *m, *k, a, A, B);
+}
 
-    // scale the force vector by -1 since MAST calculates all quantities
+
+
+void
+MAST::PKFlutterSolver::_initialize_matrices(const Real v_ref,
+                                            const RealMatrixX& m,
+                                            const RealMatrixX& k,
+                                            const ComplexMatrixX& a,
+                                            ComplexMatrixX& A,
+                                            ComplexMatrixX& B) const {
+    
+    const unsigned int n = (unsigned int)m.rows();
+    
+    A = ComplexMatrixX::Zero(2*n, 2*n);
+    B = ComplexMatrixX::Zero(2*n, 2*n);
+    
+    // the force matrix is scaled by -1 since MAST calculates all quantities
     // for a R(X)=0 equation so that matrix/vector quantity is assumed
     // to be on the left of the equality. This is not consistent with
     // the expectation of a flutter solver, which expects the force
-    // vector to be defined on the RHS. Hence, we multiply the quantity
+    // vector to be defined on the RHS. Hence, the quantity is subtracted
     // here to maintain consistency.
-    a  *= -1.;
-
     A.topRightCorner    (n, n)    =  ComplexMatrixX::Identity(n, n);
-    A.bottomLeftCorner  (n, n)    = -k.cast<Complex>() + _rho/2.*v_ref*v_ref*a;
+    A.bottomLeftCorner  (n, n)    = -k.cast<Complex>() - _rho/2.*v_ref*v_ref*a;
     B.topLeftCorner     (n, n)    = ComplexMatrixX::Identity(n, n);
     B.bottomRightCorner (n, n)    = m.cast<Complex>();
-    
 }
 
 
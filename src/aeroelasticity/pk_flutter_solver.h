@@ -184,6 +184,27 @@ namespace MAST {
                                   RealMatrixX& stiff); // stiffness
         
         
+        /*!
+         *    initializes the matrices for velocity \p v_ref from the
+         *    reduced-order mass and stiffness matrices, \p m and \p k, and
+         *    the generalized aerodynamic force matrix \p a. This does not
+         *    perform any assembly.
+         */
+        void _initialize_matrices(const Real v_ref,
+                                  const RealMatrixX& m,
+                                  const RealMatrixX& k,
+                                  const ComplexMatrixX& a,
+                                  ComplexMatrixX& L,
+                                  ComplexMatrixX& R) const;
+        
+        
+        /*!
+         *    provides the matrices at the (k_red, V) points of the
+         *    initial scan
+         */
+        class PKScanMatrices;
+        
+        
         /*!
          *    Assembles the reduced order system structural and aerodynmaic
          *    matrices for specified flight velocity \p U_inf.
@@ -17,6 +17,10 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+// C++ includes
+#include <algorithm>
+
+
 // MAST includes
 #include "aeroelasticity/time_domain_flutter_solver.h"
 #include "aeroelasticity/time_domain_flutter_solution.h"
@@ -165,15 +169,13 @@ MAST::TimeDomainFlutterSolver::find_next_root(const Real g_tol,
         if (!cross->root) {
             const unsigned int root_num = cross->root_num;
             std::pair<bool, MAST::FlutterSolutionBase*> sol;
-            // first try the Newton search. If that fails, then
+            // first try the continuation search. If that fails, then
             // try the bisection search
-            /*sol = newton_search(*cross->crossover_solutions.second,
-                                root_num,
-                                g_tol,
-                                n_bisection_iters);
-            if (!sol.first)*/
-            sol =   _bisection_search(cross->crossover_solutions,
-                                      root_num, g_tol, n_bisection_iters);
+            sol =   _continuation_search(cross->crossover_solutions,
+                                         root_num, g_tol, n_bisection_iters);
+            if (!sol.first)
+                sol =   _bisection_search(cross->crossover_solutions,
+                                          root_num, g_tol, n_bisection_iters);
             
             cross->root = &(sol.second->get_root(root_num));
             
@@ -219,15 +221,13 @@ MAST::TimeDomainFlutterSolver::find_critical_root(const Real g_tol,
             
             const unsigned int root_num = cross->root_num;
             std::pair<bool, MAST::FlutterSolutionBase*> sol;
-            // first try the Newton search. If that fails, then
+            // first try the continuation search. If that fails, then
             // try the bisection search
-            /*sol = newton_search(*cross->crossover_solutions.second,
-                                root_num,
-                                g_tol,
-                                n_bisection_iters);
-            if (!sol.first)*/
-            sol =   _bisection_search(cross->crossover_solutions,
-                                     root_num, g_tol, n_bisection_iters);
+            sol =   _continuation_search(cross->crossover_solutions,
+                                         root_num, g_tol, n_bisection_iters);
+            if (!sol.first)
+                sol =   _bisection_search(cross->crossover_solutions,
+                                          root_num, g_tol, n_bisection_iters);
             
             cross->root = &(sol.second->get_root(root_num));
             
@@ -636,6 +636,292 @@ _bisection_search(const std::pair<MAST::FlutterSolutionBase*,
 
 
 
+std::pair<bool, MAST::FlutterSolutionBase*>
+MAST::TimeDomainFlutterSolver::
+_continuation_search(const std::pair<MAST::FlutterSolutionBase*,
+                     MAST::FlutterSolutionBase*>& ref_sol_range,
+                     const unsigned int root_num,
+                     const Real g_tol,
+                     const unsigned int max_iters) {
+    
+    // minimum correlation between the eigenvectors of two consecutive
+    // points for the corrected root to be considered the same mode
+    const Real
+    min_correlation = 0.9;
+    
+    const unsigned int
+    max_newton_its  = 10;
+    
+    // assumes that the upper V has +ve g val and lower V has -ve g val
+    Real
+    lower_V  = ref_sol_range.first->ref_val(),
+    lower_g  = ref_sol_range.first->get_root(root_num).root.real(),
+    upper_V  = ref_sol_range.second->ref_val(),
+    upper_g  = ref_sol_range.second->get_root(root_num).root.real(),
+    max_dV   = fabs(upper_V - lower_V),
+    dV       = 0.,
+    new_V    = 0.;
+    
+    std::pair<bool, MAST::FlutterSolutionBase*> rval(false, nullptr);
+    
+    // the root is tracked starting from the negative damping solution
+    MAST::FlutterRootBase
+    root(ref_sol_range.first->get_root(root_num));
+    root.V   = lower_V;
+    
+    RealMatrixX
+    A,
+    B,
+    new_A,
+    new_B;
+    
+    Complex
+    deig_dV  = 0.,
+    new_eig  = 0.;
+    
+    ComplexVectorX
+    new_x,
+    new_y;
+    
+    // the sensitivity of the steady solution wrt velocity is not known,
+    // so it is assumed to be zero
+    std::unique_ptr<libMesh::NumericVector<Real> >
+    zero_sol_sens(_assembly->system().solution->zero_clone().release());
+    
+    // the matrices and the steady solution at the starting point are
+    // needed for the predictor
+    _initialize_matrices(root.V, A, B);
+    deig_dV = _eigenvalue_sensitivity(root, B, *_velocity_param, *zero_sol_sens);
+    
+    unsigned int n_iters = 0;
+    bool if_converged = false;
+    
+    while (n_iters < max_iters) {
+        
+        // predictor: Newton step on Re(lambda(V)) = 0. If this is not
+        // directed inside the bracket, then the linear interpolation
+        // between the bracketing points is used
+        if (fabs(deig_dV.real()) > 0.)
+            dV   = -root.root.real()/deig_dV.real();
+        else
+            dV   = 0.;
+        
+        new_V    = root.V + dV;
+        
+        if (dV == 0. ||
+            (new_V - lower_V) * (new_V - upper_V) >= 0.) {
+            new_V = lower_V +
+            (upper_V-lower_V)/(upper_g-lower_g)*(0.-lower_g);
+            dV    = new_V - root.V;
+        }
+        
+        // limit the step size
+        if (fabs(dV) > max_dV) {
+            dV    = (dV > 0.)? max_dV: -max_dV;
+            new_V = root.V + dV;
+        }
+        
+        libMesh::out
+        << "Continuation step: " << std::setw(5) << n_iters
+        << "  V = " << std::setw(15) << root.V
+        << "  g = " << std::setw(15) << root.root.real()
+        << "  dV = " << std::setw(15) << dV << std::endl;
+        
+        new_eig  = root.root + deig_dV * dV;
+        new_x    = root.eig_vec_right;
+        new_y    = root.eig_vec_left;
+        
+        // corrector
+        _initialize_matrices(new_V, new_A, new_B);
+        
+        n_iters++;
+        
+        if (!_correct_eigenpair(new_A, new_B, new_eig, new_x, new_y, max_newton_its) ||
+            std::abs(root.eig_vec_right.dot(new_x)) <
+            min_correlation * root.eig_vec_right.norm() * new_x.norm()) {
+            
+            // reduce the step if the corrector failed or switched to
+            // another mode
+            max_dV = 0.5 * fabs(dV);
+            continue;
+        }
+        
+        // accept the step
+        root.V             = new_V;
+        root.root          = new_eig;
+        root.eig_vec_right = new_x;
+        root.eig_vec_left  = new_y;
+        A                  = new_A;
+        B                  = new_B;
+        max_dV             = std::min(2. * fabs(dV), fabs(upper_V - lower_V));
+        
+        if (fabs(root.root.real()) <= g_tol) {
+            if_converged = true;
+            break;
+        }
+        
+        // update the bracket
+        if (root.root.real() < 0.) {
+            
+            lower_V = root.V;
+            lower_g = root.root.real();
+        }
+        else {
+            
+            upper_V = root.V;
+            upper_g = root.root.real();
+        }
+        
+        // the steady solution corresponds to the accepted point, so the
+        // sensitivity for the next predictor is computed here
+        deig_dV = _eigenvalue_sensitivity(root, B, *_velocity_param, *zero_sol_sens);
+    }
+    
+    if (!if_converged)
+        return rval;
+    
+    // a full eigensolution is performed only at the converged point
+    MAST::LAPACK_DGGEV ges;
+    ges.compute(A, B);
+    ges.scale_eigenvectors_to_identity_innerproduct();
+    
+    MAST::TimeDomainFlutterSolution* new_sol = new MAST::TimeDomainFlutterSolution;
+    new_sol->init(*this, root.V, ges);
+    new_sol->sort(*ref_sol_range.first);
+    
+    // make sure that the tracked root is stored as root_num, since the
+    // sorting may be ambiguous near mode crossings
+    unsigned int tracked_num = root_num;
+    Real min_dist = std::abs(new_sol->get_root(root_num).root - root.root);
+    for (unsigned int i=0; i<new_sol->n_roots(); i++)
+        if (std::abs(new_sol->get_root(i).root - root.root) < min_dist) {
+            min_dist    = std::abs(new_sol->get_root(i).root - root.root);
+            tracked_num = i;
+        }
+    
+    if (tracked_num != root_num) {
+        
+        MAST::FlutterRootBase tmp(new_sol->get_root(root_num));
+        new_sol->get_root(root_num).copy_root(new_sol->get_root(tracked_num));
+        new_sol->get_root(tracked_num).copy_root(tmp);
+    }
+    
+    if (_output)
+        new_sol->print(*_output);
+    
+    // add the solution to this solver
+    bool if_success =
+    _flutter_solutions.insert(std::pair<Real, MAST::FlutterSolutionBase*>
+                              (root.V, new_sol)).second;
+    
+    libmesh_assert(if_success);
+    
+    rval.first  = true;
+    rval.second = new_sol;
+    
+    return rval;
+}
+
+
+
+
+bool
+MAST::TimeDomainFlutterSolver::_correct_eigenpair(const RealMatrixX& A,
+                                                  const RealMatrixX& B,
+                                                  Complex& eig,
+                                                  ComplexVectorX& x,
+                                                  ComplexVectorX& y,
+                                                  const unsigned int max_its) const {
+    
+    const Real
+    tol   = 1.e-10;
+    
+    const unsigned int
+    n     = (unsigned int)A.rows();
+    
+    const ComplexMatrixX
+    Ac    = A.cast<Complex>(),
+    Bc    = B.cast<Complex>();
+    
+    // the right eigenvector is normalized so that c^H x = 1 with
+    // c = x0/|x0|^2, so that the Newton system for (x, lambda)
+    //   [ A - lambda B    -B x ] { dx      }   = - { (A - lambda B) x }
+    //   [ c^H               0  ] { dlambda }       { c^H x - 1        }
+    // is nonsingular for a simple eigenvalue.
+    const ComplexVectorX
+    c     = x/x.squaredNorm();
+    
+    const Real
+    scale = Ac.norm() + Bc.norm();
+    
+    ComplexMatrixX
+    jac   = ComplexMatrixX::Zero(n+1, n+1);
+    
+    ComplexVectorX
+    res   = ComplexVectorX::Zero(n+1),
+    dsol  = ComplexVectorX::Zero(n+1),
+    Bx;
+    
+    bool if_converged = false;
+    
+    for (unsigned int i=0; i<=max_its; i++) {
+        
+        Bx                = Bc * x;
+        res.topRows(n)    = Ac * x - eig * Bx;
+        res(n)            = c.dot(x) - 1.;
+        
+        if (res.norm() <= tol * scale * x.norm()) {
+            if_converged = true;
+            break;
+        }
+        
+        if (i == max_its)
+            break;
+        
+        jac.topLeftCorner(n, n)     = Ac - eig * Bc;
+        jac.topRightCorner(n, 1)    = -Bx;
+        jac.bottomLeftCorner(1, n)  = c.adjoint();
+        jac(n, n)                   = 0.;
+        
+        dsol  = jac.partialPivLu().solve(res);
+        
+        x    -= dsol.topRows(n);
+        eig  -= dsol(n);
+    }
+    
+    if (!if_converged)
+        return false;
+    
+    // the left eigenvector satisfies (A - lambda B)^H y = 0, which is
+    // obtained from the bordered system
+    //   [ (A - lambda B)^H   x ] { y  }   = { 0 }
+    //   [ y0^H               0 ] { mu }     { 1 }
+    jac.topLeftCorner(n, n)     = (Ac - eig * Bc).adjoint();
+    jac.topRightCorner(n, 1)    = x;
+    jac.bottomLeftCorner(1, n)  = y.adjoint();
+    jac(n, n)                   = 0.;
+    
+    res.setZero();
+    res(n) = 1.;
+    
+    dsol  = jac.partialPivLu().solve(res);
+    y     = dsol.topRows(n);
+    
+    // scale the eigenvectors the same way as
+    // LAPACK_DGGEV::scale_eigenvectors_to_identity_innerproduct()
+    y    /= y.norm();
+    
+    const Complex
+    val   = y.dot(Bc * x);
+    if (std::abs(val) > 0.)
+        x *= (1./val);
+    
+    return true;
+}
+
+
+
+
 std::unique_ptr<MAST::TimeDomainFlutterSolution>
 MAST::TimeDomainFlutterSolver::_analyze(const Real v_ref,
                                        const MAST::FlutterSolutionBase* prev_sol) {
@@ -1002,19 +1288,12 @@ calculate_sensitivity(MAST::FlutterRootBase& root,
     << "   V_ref = " << std::setw(10) << root.V << std::endl;
     
     Complex
-    eig              = root.root,
     deig_dp          = 0.,
-    deig_dV          = 0.,
-    den              = 0.;
+    deig_dV          = 0.;
     
-    // get the sensitivity of the matrices
     RealMatrixX
     mat_A,
-    mat_B,
-    mat_A_sens,
-    mat_B_sens;
-    
-    ComplexVectorX v;
+    mat_B;
     
     // initialize the baseline matrices
     _initialize_matrices(root.V, mat_A, mat_B);
@@ -1031,26 +1310,7 @@ calculate_sensitivity(MAST::FlutterRootBase& root,
         sol_sens = dXdp;
     
     // calculate the eigenproblem sensitivity
-    _initialize_matrix_sensitivity_for_param(f,
-                                             *sol_sens,
-                                             root.V,
-                                             mat_A_sens,
-                                             mat_B_sens);
-    
-    
-    // the eigenproblem is     y^T A x - lambda y^T B x = 0
-    // therefore, the denominator is obtained from the inner product of
-    // y^T B x
-    // sensitivity is
-    //   -dlambda/dp y^T B x = - y^T (dA/dp - lambda dB/dp)
-    // or
-    //   dlambda/dp = [y^T (dA/dp - lambda dB/dp)]/(y^T B x)
-    
-    // now calculate the numerator for sensitivity
-    // numerator =  ( dA/dp - lambda dB/dp)
-    den     = root.eig_vec_left.dot(mat_B*root.eig_vec_right);
-    deig_dp = root.eig_vec_left.dot((mat_A_sens.cast<Complex>() -
-                                    eig*mat_B_sens.cast<Complex>())*root.eig_vec_right)/den;
+    deig_dp = _eigenvalue_sensitivity(root, mat_B, f, *sol_sens);
     
     // next we need the sensitivity of eigenvalue wrt V
     // identify the sensitivity of solution to be used based on the
@@ -1061,17 +1321,7 @@ calculate_sensitivity(MAST::FlutterRootBase& root,
     else
         sol_sens = dXdV;
     
-    _initialize_matrix_sensitivity_for_param(*_velocity_param,
-                                             *sol_sens,
-                                             root.V,
-                                             mat_A_sens,
-                                             mat_B_sens);
-
-    
-    // now calculate the quotient for sensitivity wrt V
-    // calculate numerator
-    deig_dV = root.eig_vec_left.dot((mat_A_sens.cast<Complex>() -
-                                     eig*mat_B_sens.cast<Complex>())*root.eig_vec_right)/den;
+    deig_dV = _eigenvalue_sensitivity(root, mat_B, *_velocity_param, *sol_sens);
     
     // since the constraint that defines flutter speed is that damping = 0,
     // Re(lambda) = 0, then the sensitivity of flutter speed is obtained
@@ -1091,3 +1341,40 @@ calculate_sensitivity(MAST::FlutterRootBase& root,
     << " ====================================================" << std::endl;
     
 }
+
+
+
+
+Complex
+MAST::TimeDomainFlutterSolver::
+_eigenvalue_sensitivity(const MAST::FlutterRootBase& root,
+                        const RealMatrixX& B,
+                        const MAST::FunctionBase& f,
+                        const libMesh::NumericVector<Real>& dXdp) {
+    
+    RealMatrixX
+    mat_A_sens,
+    mat_B_sens;
+    
+    _initialize_matrix_sensitivity_for_param(f,
+                                             dXdp,
+                                             root.V,
+                                             mat_A_sens,
+                                             mat_B_sens);
+    
+    // the eigenproblem is     y^T A x - lambda y^T B x = 0
+    // therefore, the denominator is obtained from the inner product of
+    // y^T B x
+    // sensitivity is
+    //   -dlambda/dp y^T B x = - y^T (dA/dp - lambda dB/dp)
+    // or
+    //   dlambda/dp = [y^T (dA/dp - lambda dB/dp)]/(y^T B x)
+    
+    // now calculate the numerator for sensitivity
+    // numerator =  ( dA/dp - lambda dB/dp)
+    const Complex
+    den     = root.eig_vec_left.dot(B*root.eig_vec_right);
+    
+    return root.eig_vec_left.dot((mat_A_sens.cast<Complex>() -
+                                  root.root*mat_B_sens.cast<Complex>())*root.eig_vec_right)/den;
+}
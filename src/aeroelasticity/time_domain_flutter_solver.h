@@ -189,6 +189,54 @@ namespace MAST {
                           const unsigned int root_num,
                           const Real g_tol,
                           const unsigned int max_iters);
+        
+        
+        /*!
+         *    predictor-corrector continuation search. The root \p root_num
+         *    is tracked from the first solution in \p ref_sol_range, which
+         *    has negative damping, to the zero-damping point. The step in
+         *    velocity is predicted from the sensitivity of the eigenvalue,
+         *    and the eigenpair is corrected at the new velocity with Newton
+         *    iterations on the single eigenpair, so that a full
+         *    eigensolution is needed only at the converged point. The step
+         *    is halved if the corrector does not converge or switches to a
+         *    different mode. The sensitivity of the steady solution with
+         *    respect to velocity is assumed to be zero. @returns false if
+         *    the root was not found in \p max_iters steps.
+         */
+        virtual std::pair<bool, MAST::FlutterSolutionBase*>
+        _continuation_search(const std::pair<MAST::FlutterSolutionBase*,
+                             MAST::FlutterSolutionBase*>& ref_sol_range,
+                             const unsigned int root_num,
+                             const Real g_tol,
+                             const unsigned int max_iters);
+        
+        
+        /*!
+         *    Newton iterations for the eigenpair of \f$ A x = \lambda B x \f$
+         *    starting from \p eig and the right and left eigenvectors \p x
+         *    and \p y. On return, the eigenvectors are scaled in the same
+         *    manner as the eigensolution of LAPACK_DGGEV. @returns false if
+         *    the iterations did not converge in \p max_its.
+         */
+        bool _correct_eigenpair(const RealMatrixX& A,
+                                const RealMatrixX& B,
+                                Complex& eig,
+                                ComplexVectorX& x,
+                                ComplexVectorX& y,
+                                const unsigned int max_its) const;
+        
+        
+        /*!
+         *   @returns the sensitivity of the eigenvalue of \p root with
+         *   respect to \p f, where \p B is the matrix at the velocity of the
+         *   root and \p dXdp is the sensitivity of the steady solution.
+         */
+        Complex
+        _eigenvalue_sensitivity(const MAST::FlutterRootBase& root,
+                                const RealMatrixX& B,
+                                const MAST::FunctionBase& f,
+                                const libMesh::NumericVector<Real>& dXdp);
 
         
         /*!
@@ -32,6 +32,42 @@
 #include "base/nonlinear_system.h"
 
 
+class MAST::UGFlutterSolver::UGScanMatrices:
+public MAST::FlutterSolverBase::ScanMatrices {
+    
+public:
+    
+    UGScanMatrices(const MAST::UGFlutterSolver&        solver,
+                   const std::vector<Real>&            kr_vals,
+                   const RealMatrixX&                  m,
+                   const RealMatrixX&                  k,
+                   const std::vector<ComplexMatrixX>&  a_vals):
+    MAST::FlutterSolverBase::ScanMatrices(),
+    _solver   (solver),
+    _kr_vals  (kr_vals),
+    _m        (m),
+    _k        (k),
+    _a_vals   (a_vals) { }
+    
+    virtual ~UGScanMatrices() { }
+    
+    virtual void init(const unsigned int i,
+                      ComplexMatrixX& A,
+                      ComplexMatrixX& B) const {
+        
+        _solver._initialize_matrices(_kr_vals[i], _m, _k, _a_vals[i], A, B);
+    }
+    
+protected:
+    
+    const MAST::UGFlutterSolver&        _solver;
+    const std::vector<Real>&            _kr_vals;
+    const RealMatrixX&                  _m;
+    const RealMatrixX&                  _k;
+    const std::vector<ComplexMatrixX>&  _a_vals;
+};
+
+
 MAST::UGFlutterSolver::UGFlutterSolver():
 MAST::FlutterSolverBase(),
 _kr_param(nullptr),
@@ -275,12 +311,44 @@ MAST::UGFlutterSolver::scan_for_roots() {
         }
         k_vals[_n_kr_divs] = _kr_range.first; // to get around finite-precision arithmetic
         
+        // the reduced-order matrices are assembled on all processors
+        // before the eigensolutions, which are then distributed across
+        // processors and threads.
+        const RealMatrixX
+        *m     = nullptr,
+        *k     = nullptr;
+        
+        std::vector<ComplexMatrixX> a_vals(_n_kr_divs+1);
+        
+        _reduced_order_structural_matrices(m, k);
+        for (unsigned int i=0; i<_n_kr_divs+1; i++)
+            _generalized_aero_force_matrix(*_kr_param, k_vals[i], a_vals[i]);
+        
+        libMesh::out
+        << " ====================================================" << std::endl
+        << "Eigensolution scan" << std::endl
+        << "   n_kr = " << std::setw(10) << _n_kr_divs+1 << std::endl;
+        
+        std::vector<MAST::LAPACK_ZGGEV> ges;
+        MAST::UGFlutterSolver::UGScanMatrices mats(*this, k_vals, *m, *k, a_vals);
+        _scan_eigensolutions(_n_kr_divs+1, (unsigned int)m->rows(), mats, ges);
+        
+        libMesh::out
+        << "Finished Eigensolution scan" << std::endl
+        << " ====================================================" << std::endl;
+        
+        // the roots are sorted in the order of the scan after all
+        // eigensolutions are available
         MAST::FlutterSolutionBase* prev_sol = nullptr;
         for (unsigned int i=0; i< _n_kr_divs+1; i++) {
             
             current_kr = k_vals[i];
-            std::unique_ptr<MAST::FlutterSolutionBase> sol =
-            _analyze(current_kr, prev_sol);
+            MAST::UGFlutterSolution* root = new MAST::UGFlutterSolution;
+            root->init(*this, current_kr, (*_bref_param)(), ges[i]);
+            if (prev_sol)
+                root->sort(*prev_sol);
+            
+            std::unique_ptr<MAST::FlutterSolutionBase> sol(root);
             
             prev_sol = sol.get();
             
@@ -530,41 +598,38 @@ MAST::UGFlutterSolver::_initialize_matrices(Real kr,
     // matrices, and A(kr) is the generalized aerodynamic force matrix.
     //
     
-    const unsigned int n = (unsigned int)_basis_vectors->size();
-    
-    RealMatrixX
-    m      =  RealMatrixX::Zero(n, n),
-    k      =  RealMatrixX::Zero(n, n);
+    const RealMatrixX
+    *m     = nullptr,
+    *k     = nullptr;
     
     ComplexMatrixX
-    a      =  ComplexMatrixX::Zero(n, n);
-    
-    // now prepare a map of the quantities and ask the assembly object to
-    // calculate the quantities of interest.
-    std::map<MAST::StructuralQuantityType, RealMatrixX*> qty_map;
-    qty_map[MAST::MASS]       = &m;
-    qty_map[MAST::STIFFNESS]  = &k;
+    a;
     
+    // M and K are independent of kr, and A(kr) is stored for each kr.
+    // These are assembled once and reused by the solver.
+    _reduced_order_structural_matrices(m, k);
+    _generalized_aero_force_matrix(*_kr_param, kr, a);
     
-    // set the velocity value in the parameter that was provided
-    (*_kr_param) = kr;
-    
-    _assembly->assemble_reduced_order_quantity(*_basis_vectors, qty_map);
-    
-    dynamic_cast<MAST::FSIGeneralizedAeroForceAssembly*>(_assembly)->
-    assemble_generalized_aerodynamic_force_matrix(*_basis_vectors, a);
+    _initialize_matrices(kr, *m, *k, a, A, B);
+}
+
+
+
+void
+MAST::UGFlutterSolver::_initialize_matrices(Real kr,
+                                            const RealMatrixX& m,
+                                            const RealMatrixX& k,
+                                            const ComplexMatrixX& a,
+                                            ComplexMatrixX& A,
+                                            ComplexMatrixX& B) const {
     
- 
-    // scale the force vector by -1 since MAST calculates all quantities
+    // the force matrix is scaled by -1 since MAST calculates all quantities
     // for a R(X)=0 equation so that matrix/vector quantity is assumed
     // to be on the left of the equality. This is not consistent with
     // the expectation of a flutter solver, which expects the force
-    // vector to be defined on the RHS. Hence, we multiply the quantity
+    // vector to be defined on the RHS. Hence, the quantity is subtracted
     // here to maintain consistency.
-    a  *= -1.;
-
-    
-    A    = pow(kr/(*_bref_param)(),2) * m.cast<Complex>() + (_rho/2.) * a;
+    A    = pow(kr/(*_bref_param)(),2) * m.cast<Complex>() - (_rho/2.) * a;
     B    = k.cast<Complex>();
 }
 
@@ -650,24 +715,18 @@ _initialize_matrix_sensitivity_for_kr(Real kr,
     
     const unsigned int n = (unsigned int)_basis_vectors->size();
     
-    RealMatrixX
-    m      =  RealMatrixX::Zero(n, n);
+    const RealMatrixX
+    *m     = nullptr,
+    *k     = nullptr;
     
     ComplexMatrixX
     a      =  ComplexMatrixX::Zero(n, n);
     
-    // now prepare a map of the quantities and ask the assembly object to
-    // calculate the quantities of interest.
-    std::map<MAST::StructuralQuantityType, RealMatrixX*> qty_map;
-    qty_map[MAST::MASS]       = &m;
-    
+    _reduced_order_structural_matrices(m, k);
     
     // set the velocity value in the parameter that was provided
     (*_kr_param) = kr;
     
-    _assembly->assemble_reduced_order_quantity(*_basis_vectors,
-                                               qty_map);
-    
     dynamic_cast<MAST::FSIGeneralizedAeroForceAssembly*>(_assembly)->
     assemble_generalized_aerodynamic_force_matrix(*_basis_vectors, a, _kr_param);
     
@@ -680,7 +739,7 @@ _initialize_matrix_sensitivity_for_kr(Real kr,
     a  *= -1.;
 
     
-    A    = 2.*kr*pow((*_bref_param)(),-2) * m.cast<Complex>() +  (_rho/2.) * a;
+    A    = 2.*kr*pow((*_bref_param)(),-2) * m->cast<Complex>() +  (_rho/2.) * a;
     B    = ComplexMatrixX::Zero(n, n);
 }
 
@@ -187,6 +187,27 @@ namespace MAST {
                                   ComplexMatrixX& B);
         
         
+        /*!
+         *    initializes the matrices for reduced freq \p kr from the
+         *    reduced-order mass and stiffness matrices, \p m and \p k, and
+         *    the generalized aerodynamic force matrix \p a. This does not
+         *    perform any assembly.
+         */
+        void _initialize_matrices(Real kr,
+                                  const RealMatrixX& m,
+                                  const RealMatrixX& k,
+                                  const ComplexMatrixX& a,
+                                  ComplexMatrixX& A,
+                                  ComplexMatrixX& B) const;
+        
+        
+        /*!
+         *    provides the matrices at the reduced frequencies of the
+         *    initial scan
+         */
+        class UGScanMatrices;
+        
+        
         /*!
          *    Assembles the reduced order system structural and aerodynmaic
          *    matrices for specified flight velocity \p U_inf.
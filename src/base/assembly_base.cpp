@@ -17,6 +17,9 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+// C++ includes
+#include <algorithm>
+
 // MAST includes
 #include "base/assembly_base.h"
 #include "base/system_initialization.h"
@@ -26,6 +29,9 @@
 #include "base/nonlinear_system.h"
 #include "base/assembly_elem_operation.h"
 #include "base/output_assembly_elem_operations.h"
+#include "base/parameter_dependency_index.h"
+#include "base/boundary_condition_base.h"
+#include "property_cards/element_property_card_base.h"
 #include "mesh/fe_base.h"
 #include "mesh/geom_elem.h"
 #include "numerics/utility.h"
@@ -34,6 +40,93 @@
 // libMesh includes
 #include "libmesh/numeric_vector.h"
 #include "libmesh/dof_map.h"
+#include "libmesh/libmesh.h"
+#include "libmesh/threads.h"
+#include "libmesh/elem_range.h"
+
+// C++ includes
+#include <typeinfo>
+
+
+namespace MAST {
+    
+    /*!
+     *   body of the thread-parallel element loop in
+     *   MAST::AssemblyBase::_elem_loop(). The original body works with
+     *   the element operation object provided by the user, and each body
+     *   created by splitting works with a clone of this object. The clone
+     *   created by \p _elem_loop() to check the element operation object
+     *   is used by the first split body.
+     */
+    class ElemLoopThreadBody {
+    public:
+        
+        ElemLoopThreadBody(MAST::AssemblyElemOperations& ops,
+                           MAST::AssemblyBase::ElemKernel& kernel,
+                           std::unique_ptr<MAST::AssemblyElemOperations> first_clone):
+        _master      (ops),
+        _first_clone (std::move(first_clone)),
+        _spare       (&_first_clone),
+        _ops         (&ops),
+        _kernel      (kernel) { }
+        
+        ElemLoopThreadBody(ElemLoopThreadBody& other,
+                           libMesh::Threads::split):
+        _master   (other._master),
+        _spare    (other._spare),
+        _clone    (_build_clone()),
+        _ops      (_clone.get()),
+        _kernel   (other._kernel) { }
+        
+        void operator() (const libMesh::ConstElemRange& range) {
+            
+            libMesh::ConstElemRange::const_iterator
+            it  = range.begin(),
+            end = range.end();
+            
+            for ( ; it != end; it++)
+                _kernel(*_ops, **it);
+        }
+        
+        void join(const ElemLoopThreadBody& other) {
+            
+            _ops->join(*other._ops);
+        }
+        
+    protected:
+        
+        /*!
+         *   @returns the clone created by \p _elem_loop() if it has not
+         *   been used by another body, otherwise a new clone of the
+         *   master element operation object.
+         */
+        std::unique_ptr<MAST::AssemblyElemOperations> _build_clone() {
+            
+            std::unique_ptr<MAST::AssemblyElemOperations> c;
+            
+            {
+                libMesh::Threads::spin_mutex::scoped_lock
+                lock(libMesh::Threads::spin_mtx);
+                c.swap(*_spare);
+            }
+            
+            if (!c)
+                c = _master.clone();
+            
+            libmesh_assert(c.get() && typeid(*c) == typeid(_master));
+            
+            return c;
+        }
+        
+        MAST::AssemblyElemOperations&                  _master;
+        std::unique_ptr<MAST::AssemblyElemOperations>  _first_clone;
+        std::unique_ptr<MAST::AssemblyElemOperations>* _spare;
+        std::unique_ptr<MAST::AssemblyElemOperations>  _clone;
+        MAST::AssemblyElemOperations*                  _ops;
+        MAST::AssemblyBase::ElemKernel&                _kernel;
+    };
+}
+
 
 
 MAST::AssemblyBase::AssemblyBase():
@@ -43,7 +136,8 @@ _discipline       (nullptr),
 _system           (nullptr),
 _sol_function     (nullptr),
 _solver_monitor   (nullptr),
-_param_dependence (nullptr) {
+_param_dependence (nullptr),
+_sensitivity_batch_size (100) {
     
 }
 
@@ -179,6 +273,11 @@ clear_discipline_and_system() {
     _discipline       = nullptr;
     _system           = nullptr;
     _param_dependence = nullptr;
+    
+    // the work vectors are built for the communicator and send list of
+    // the system, and are invalid for any other system
+    _work_vectors.clear();
+    _work_send_lists.clear();
 }
 
 
@@ -229,6 +328,101 @@ build_localized_vector(const libMesh::System& sys,
 
 
 
+const libMesh::NumericVector<Real>&
+MAST::AssemblyBase::
+localized_work_vector(const libMesh::NumericVector<Real>& global,
+                      const unsigned int i) {
+    
+    libmesh_assert(_system);
+    
+    const libMesh::System& sys = _system->system();
+    
+    const std::vector<libMesh::dof_id_type>& send_list =
+    sys.get_dof_map().get_send_list();
+    
+    if (_work_vectors.size() <= i) {
+        _work_vectors.resize(i+1);
+        _work_send_lists.resize(i+1);
+    }
+    
+    std::unique_ptr<libMesh::NumericVector<Real> >&
+    local = _work_vectors[i];
+    
+    // the vector is recreated only if the dof distribution or the ghost
+    // dofs have changed
+    if (!local ||
+        local->size()        != sys.n_dofs() ||
+        local->local_size()  != sys.n_local_dofs() ||
+        _work_send_lists[i]  != send_list) {
+        
+        _work_send_lists[i] = send_list;
+        local = libMesh::NumericVector<Real>::build(sys.comm());
+        local->init(sys.n_dofs(),
+                    sys.n_local_dofs(),
+                    send_list,
+                    false,
+                    libMesh::GHOSTED);
+    }
+    
+    global.localize(*local, send_list);
+    
+    return *local;
+}
+
+
+
+
+void
+MAST::AssemblyBase::_elem_loop(MAST::AssemblyElemOperations& ops,
+                               MAST::AssemblyBase::ElemKernel& kernel) {
+    
+    libmesh_assert(_system);
+    
+    const libMesh::MeshBase&
+    mesh = _system->system().get_mesh();
+    
+    // the elements are processed in parallel only if multiple threads
+    // are available and if the element operation object has been marked
+    // as thread-parallel. The solution function uses a libMesh point
+    // locator that is not thread-safe, so the loop is serial if one is
+    // attached.
+    std::unique_ptr<MAST::AssemblyElemOperations> first_clone;
+    
+    if (libMesh::n_threads() > 1 &&
+        ops.if_thread_parallel() &&
+        !_sol_function) {
+        
+        first_clone = ops.clone();
+        
+        // a class that inherits clone() from its parent would be copied
+        // as the parent type
+        if (!first_clone || typeid(*first_clone) != typeid(ops))
+            libmesh_error_msg
+            ("Error: thread-parallel element operation must override clone().");
+    }
+    
+    if (first_clone) {
+        
+        libMesh::ConstElemRange
+        range(mesh.active_local_elements_begin(),
+              mesh.active_local_elements_end());
+        
+        MAST::ElemLoopThreadBody body(ops, kernel, std::move(first_clone));
+        libMesh::Threads::parallel_reduce(range, body);
+    }
+    else {
+        
+        libMesh::MeshBase::const_element_iterator
+        el     = mesh.active_local_elements_begin(),
+        end_el = mesh.active_local_elements_end();
+        
+        for ( ; el != end_el; ++el)
+            kernel(ops, **el);
+    }
+}
+
+
+
 
 void
 MAST::AssemblyBase::attach_solution_function(MAST::MeshFieldFunction& f){
@@ -262,13 +456,6 @@ MAST::AssemblyBase::calculate_output(const libMesh::NumericVector<Real>& X,
     
     output.zero_for_analysis();
     
-    // iterate over each element, initialize it and get the relevant
-    // analysis quantities
-    RealVectorX sol;
-    
-    std::vector<libMesh::dof_id_type> dof_indices;
-    const libMesh::DofMap& dof_map = _system->system().get_dof_map();
-    
     std::unique_ptr<libMesh::NumericVector<Real> > localized_solution;
     localized_solution.reset(build_localized_vector(nonlin_sys,
                                                     X).release());
@@ -278,40 +465,49 @@ MAST::AssemblyBase::calculate_output(const libMesh::NumericVector<Real>& X,
     //if (_sol_function)
     //    _sol_function->init( X);
     
-    libMesh::MeshBase::const_element_iterator       el     =
-    nonlin_sys.get_mesh().active_local_elements_begin();
-    const libMesh::MeshBase::const_element_iterator end_el =
-    nonlin_sys.get_mesh().active_local_elements_end();
-    
-
-    for ( ; el != end_el; ++el) {
-        
-        const libMesh::Elem* elem = *el;
-        
-        dof_map.dof_indices (elem, dof_indices);
-        
-        // get the solution
-        unsigned int ndofs = (unsigned int)dof_indices.size();
-        sol.setZero(ndofs);
-        
-        for (unsigned int i=0; i<dof_indices.size(); i++)
-            sol(i) = (*localized_solution)(dof_indices[i]);
-        
-        
-        //if (_sol_function)
-        //    physics_elem->attach_active_solution_function(*_sol_function);
+    // iterate over each element, initialize it and get the relevant
+    // analysis quantities
+    class OutputKernel:
+    public MAST::AssemblyBase::ElemKernel {
+    public:
+        OutputKernel(const MAST::SystemInitialization& sys,
+                     const libMesh::NumericVector<Real>& sol):
+        _sys  (sys),
+        _sol  (sol) { }
         
-        MAST::GeomElem geom_elem;
-        output.set_elem_data(elem->dim(), *elem, geom_elem);
-        geom_elem.init(*elem, *_system);
+        virtual void operator() (MAST::AssemblyElemOperations& ops,
+                                 const libMesh::Elem& elem) {
+            
+            MAST::OutputAssemblyElemOperations&
+            output = dynamic_cast<MAST::OutputAssemblyElemOperations&>(ops);
+            
+            std::vector<libMesh::dof_id_type> dof_indices;
+            _sys.system().get_dof_map().dof_indices (&elem, dof_indices);
+            
+            // get the solution
+            unsigned int ndofs = (unsigned int)dof_indices.size();
+            RealVectorX sol = RealVectorX::Zero(ndofs);
+            
+            for (unsigned int i=0; i<dof_indices.size(); i++)
+                sol(i) = _sol(dof_indices[i]);
+            
+            MAST::GeomElem geom_elem;
+            output.set_elem_data(elem.dim(), elem, geom_elem);
+            geom_elem.init(elem, _sys);
+            
+            output.init(geom_elem);
+            output.set_elem_solution(sol);
+            output.evaluate();
+            output.clear_elem();
+        }
         
-        output.init(geom_elem);
-        output.set_elem_solution(sol);
-        output.evaluate();
-        output.clear_elem();
-
-        //physics_elem->detach_active_solution_function();
-    }
+    protected:
+        const MAST::SystemInitialization&   _sys;
+        const libMesh::NumericVector<Real>& _sol;
+    };
+    
+    OutputKernel kernel(*_system, *localized_solution);
+    _elem_loop(output, kernel);
     
     // if a solution function is attached, clear it
     if (_sol_function)
@@ -506,6 +702,248 @@ calculate_output_direct_sensitivity(const libMesh::NumericVector<Real>& X,
 
 
 
+void
+MAST::AssemblyBase::
+calculate_output_direct_sensitivities(const libMesh::NumericVector<Real>& X,
+                                      const std::vector<const libMesh::NumericVector<Real>*>& dXdp,
+                                      const std::vector<const MAST::FunctionBase*>& params,
+                                      MAST::OutputAssemblyElemOperations& output,
+                                      std::vector<Real>& dq_dp) {
+    
+    libmesh_assert(_discipline);
+    libmesh_assert(_system);
+    libmesh_assert(dXdp.empty() || dXdp.size() == params.size());
+    
+    // limit the number of localized solution sensitivity vectors
+    if (_calculate_output_direct_sensitivities_in_batches(X, dXdp, params, output, dq_dp))
+        return;
+    
+    const unsigned int
+    n_params = (unsigned int)params.size();
+    
+    dq_dp.assign(n_params, 0.);
+    
+    output.zero_for_sensitivity();
+    
+    MAST::NonlinearSystem& nonlin_sys = _system->system();
+    output.set_assembly(*this);
+    
+    // iterate over each element, initialize it and get the relevant
+    // analysis quantities
+    RealVectorX
+    sol,
+    dsol;
+    
+    std::vector<libMesh::dof_id_type> dof_indices;
+    std::vector<unsigned int>         p_ids;
+    const libMesh::DofMap& dof_map = _system->system().get_dof_map();
+    
+    
+    std::unique_ptr<libMesh::NumericVector<Real> >
+    localized_solution;
+    std::vector<std::unique_ptr<libMesh::NumericVector<Real> > >
+    localized_solution_sens(dXdp.size());
+    
+    localized_solution.reset(build_localized_vector(nonlin_sys,
+                                                    X).release());
+    for (unsigned int i=0; i<dXdp.size(); i++)
+        localized_solution_sens[i].reset(build_localized_vector(nonlin_sys,
+                                                                *dXdp[i]).release());
+    
+    
+    // the dependency of the property cards and loads on all parameters
+    // is computed once, instead of once for each element and parameter.
+    // The index removes the precomputed data when it goes out of scope.
+    MAST::ParameterDependencyIndex dependency;
+    _init_parameter_dependency(params, dependency);
+    
+    
+    // if a solution function is attached, initialize it
+    if (_sol_function)
+        _sol_function->init( X);
+    
+    
+    libMesh::MeshBase::const_element_iterator       el     =
+    nonlin_sys.get_mesh().active_local_elements_begin();
+    const libMesh::MeshBase::const_element_iterator end_el =
+    nonlin_sys.get_mesh().active_local_elements_end();
+    
+    
+    for ( ; el != end_el; ++el) {
+        
+        const libMesh::Elem* elem = *el;
+        
+        _elem_parameters(*elem, params, !dXdp.empty(), p_ids);
+        
+        // no sensitivity computation assembly is neeed in this case
+        if (p_ids.empty())
+            continue;
+        
+        dof_map.dof_indices (elem, dof_indices);
+        
+        // get the solution
+        unsigned int ndofs = (unsigned int)dof_indices.size();
+        sol.setZero(ndofs);
+        dsol.setZero(ndofs);
+        
+        for (unsigned int i=0; i<dof_indices.size(); i++)
+            sol(i)  = (*localized_solution)(dof_indices[i]);
+        
+        MAST::GeomElem geom_elem;
+        output.set_elem_data(elem->dim(), *elem, geom_elem);
+        geom_elem.init(*elem, *_system);
+        
+        output.init(geom_elem);
+        output.set_elem_solution(sol);
+        
+        // the element is initialized once and then used for all
+        // parameters that influence it
+        for (unsigned int j=0; j<p_ids.size(); j++) {
+            
+            const unsigned int p = p_ids[j];
+            
+            if (!dXdp.empty())
+                for (unsigned int i=0; i<dof_indices.size(); i++)
+                    dsol(i) = (*localized_solution_sens[p])(dof_indices[i]);
+            
+            output.set_elem_solution_sensitivity(dsol);
+            dq_dp[p] += output.output_sensitivity_for_elem(*params[p]);
+        }
+        
+        output.clear_elem();
+    }
+    
+    // if a solution function is attached, clear it
+    if (_sol_function)
+        _sol_function->clear();
+    
+    output.clear_assembly();
+    
+    // sum over all processors since part of the mesh can live on different
+    // processors
+    nonlin_sys.comm().sum(dq_dp);
+}
+
+
+
+
+void
+MAST::AssemblyBase::
+_elem_parameters(const libMesh::Elem& elem,
+                 const std::vector<const MAST::FunctionBase*>& params,
+                 const bool if_sol_sens,
+                 std::vector<unsigned int>& p_ids) const {
+    
+    p_ids.clear();
+    
+    for (unsigned int i=0; i<params.size(); i++) {
+        
+        // same criterion as the single parameter sensitivity calculation
+        if (_param_dependence &&
+            !_param_dependence->if_elem_depends_on_parameter(elem, *params[i]) &&
+            (!if_sol_sens || _param_dependence->override_flag))
+            continue;
+        
+        p_ids.push_back(i);
+    }
+}
+
+
+
+
+bool
+MAST::AssemblyBase::
+_calculate_output_direct_sensitivities_in_batches
+(const libMesh::NumericVector<Real>& X,
+ const std::vector<const libMesh::NumericVector<Real>*>& dXdp,
+ const std::vector<const MAST::FunctionBase*>& params,
+ MAST::OutputAssemblyElemOperations& output,
+ std::vector<Real>& dq_dp) {
+    
+    libmesh_assert_greater(_sensitivity_batch_size, 0);
+    
+    if (dXdp.size() <= _sensitivity_batch_size)
+        return false;
+    
+    const unsigned int
+    n_params = (unsigned int)params.size();
+    
+    dq_dp.assign(n_params, 0.);
+    
+    // the dependency index is created once for all parameters. The
+    // batches find the parameters registered and do not create their own.
+    MAST::ParameterDependencyIndex dependency;
+    _init_parameter_dependency(params, dependency);
+    
+    std::vector<const libMesh::NumericVector<Real>*> dXdp_batch;
+    std::vector<const MAST::FunctionBase*>           params_batch;
+    std::vector<Real>                                dq_dp_batch;
+    
+    for (unsigned int i0=0; i0<n_params; i0+=_sensitivity_batch_size) {
+        
+        const unsigned int
+        n = std::min(_sensitivity_batch_size, n_params-i0);
+        
+        dXdp_batch.assign(dXdp.begin()+i0, dXdp.begin()+i0+n);
+        params_batch.assign(params.begin()+i0, params.begin()+i0+n);
+        
+        this->calculate_output_direct_sensitivities(X,
+                                                    dXdp_batch,
+                                                    params_batch,
+                                                    output,
+                                                    dq_dp_batch);
+        
+        for (unsigned int j=0; j<n; j++)
+            dq_dp[i0+j] = dq_dp_batch[j];
+    }
+    
+    return true;
+}
+
+
+
+void
+MAST::AssemblyBase::
+_init_parameter_dependency(const std::vector<const MAST::FunctionBase*>& params,
+                           MAST::ParameterDependencyIndex& index) const {
+    
+    libmesh_assert(_discipline);
+    libmesh_assert(_system);
+    
+    for (unsigned int i=0; i<params.size(); i++)
+        if (params[i]->parameter_index())
+            return;
+    
+    for (unsigned int i=0; i<params.size(); i++)
+        index.add_parameter(*params[i]);
+    
+    libMesh::MeshBase::const_element_iterator       el     =
+    _system->system().get_mesh().active_local_elements_begin();
+    const libMesh::MeshBase::const_element_iterator end_el =
+    _system->system().get_mesh().active_local_elements_end();
+    
+    // the index stores each card only once
+    for ( ; el != end_el; ++el)
+        index.add_function_set(_discipline->get_property_card(**el));
+    
+    MAST::VolumeBCMapType::const_iterator
+    v_it    = _discipline->volume_loads().begin(),
+    v_end   = _discipline->volume_loads().end();
+    for ( ; v_it != v_end; v_it++)
+        index.add_function_set(*v_it->second);
+    
+    MAST::SideBCMapType::const_iterator
+    s_it    = _discipline->side_loads().begin(),
+    s_end   = _discipline->side_loads().end();
+    for ( ; s_it != s_end; s_it++)
+        index.add_function_set(*s_it->second);
+    
+    index.init();
+}
+
+
+
+
 Real
 MAST::AssemblyBase::
 calculate_output_adjoint_sensitivity(const libMesh::NumericVector<Real>& X,
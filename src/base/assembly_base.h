@@ -47,6 +47,7 @@ namespace MAST {
     class AssemblyElemOperations;
     class OutputAssemblyElemOperations;
     class FunctionBase;
+    class ParameterDependencyIndex;
     
     class AssemblyBase:
     public libMesh::NonlinearImplicitSystem::ComputeResidualandJacobian {
@@ -97,6 +98,22 @@ namespace MAST {
             bool override_flag;
         };
         
+        /*!
+         *   Element level operation that is executed on each active local
+         *   element by \p _elem_loop(). The same kernel object is shared
+         *   by all threads and receives the element operation object
+         *   owned by the calling thread. Hence, any data that is written
+         *   outside of the element operation object (e.g. global vectors
+         *   and matrices) must be protected by \p libMesh::Threads::spin_mtx.
+         */
+        class ElemKernel {
+        public:
+            ElemKernel() {}
+            virtual ~ElemKernel() {}
+            virtual void operator() (MAST::AssemblyElemOperations& ops,
+                                     const libMesh::Elem& elem) = 0;
+        };
+        
         /*!
          *   flag to control the closing fo the Jacobian after assembly
          */
@@ -274,6 +291,46 @@ namespace MAST {
                                             MAST::OutputAssemblyElemOperations& output);
 
         
+        /*!
+         *   evaluates the sensitivity of \p output with respect to each
+         *   parameter in \p params in a single pass over the elements, and
+         *   returns the values in \p dq_dp. If total sensitivity is desired,
+         *   then \p dXdp should contain the solution sensitivity for each
+         *   parameter in \p params, otherwise it can be empty. The
+         *   contribution of each element is obtained from
+         *   \p output_sensitivity_for_elem(), so this should only be used
+         *   for outputs that are sums of element contributions. If an
+         *   ElemParameterDependence object is attached, each element
+         *   evaluates only the parameters that it depends on.
+         */
+        virtual void
+        calculate_output_direct_sensitivities(const libMesh::NumericVector<Real>& X,
+                                              const std::vector<const libMesh::NumericVector<Real>*>& dXdp,
+                                              const std::vector<const MAST::FunctionBase*>& params,
+                                              MAST::OutputAssemblyElemOperations& output,
+                                              std::vector<Real>& dq_dp);
+        
+        
+        /*!
+         *   sets the largest number of solution sensitivity vectors that
+         *   \p calculate_output_direct_sensitivities() localizes at a time.
+         *   Larger sets of parameters are processed in batches of this
+         *   size, with one pass over the elements per batch. The default
+         *   is 100.
+         */
+        void set_sensitivity_batch_size(unsigned int n) {
+            
+            libmesh_assert_greater(n, 0);
+            _sensitivity_batch_size = n;
+        }
+        
+        
+        /*!
+         *   @returns the batch size set by \p set_sensitivity_batch_size()
+         */
+        unsigned int sensitivity_batch_size() const { return _sensitivity_batch_size; }
+        
+        
         /*!
          *   Evaluates the total sensitivity of \p output wrt \p p using
          *   the adjoint solution provided in \p dq_dX for a linearization
@@ -298,8 +355,76 @@ namespace MAST {
                                const libMesh::NumericVector<Real>& global) const;
         
         
+        /*!
+         *   localizes the parallel vector \p global into the work vector
+         *   \p i owned by this assembly and returns a reference to it. The
+         *   work vector is created on first use and is reused in
+         *   subsequent calls, so that only the scatter of the ghosted values
+         *   is performed. The returned vector is valid until the next call
+         *   with the same index \p i, or until
+         *   \p clear_discipline_and_system() is called.
+         */
+        const libMesh::NumericVector<Real>&
+        localized_work_vector(const libMesh::NumericVector<Real>& global,
+                              const unsigned int i = 0);
+        
+        
     protected:
         
+        /*!
+         *   iterates over the active local elements of the system and calls
+         *   \p kernel for each element. If \p libMesh::n_threads() is
+         *   greater than one, \p ops has been marked as thread-parallel with
+         *   \p set_thread_parallel() and no solution function is attached,
+         *   the elements are partitioned among the threads and each thread
+         *   uses its own clone of \p ops, which is joined with \p ops at
+         *   the end of the loop.
+         *   This works with any number of MPI ranks, since each rank only
+         *   processes its own local elements. Otherwise, all elements are
+         *   processed serially with \p ops.
+         */
+        void _elem_loop(MAST::AssemblyElemOperations& ops,
+                        MAST::AssemblyBase::ElemKernel& kernel);
+        
+        
+        /*!
+         *   identifies the parameters in \p params that influence \p elem
+         *   and returns their indices in \p p_ids. All parameters are
+         *   returned if no ElemParameterDependence object is attached, or
+         *   if solution sensitivity is provided and the dependence object
+         *   does not override it.
+         */
+        void _elem_parameters(const libMesh::Elem& elem,
+                              const std::vector<const MAST::FunctionBase*>& params,
+                              const bool if_sol_sens,
+                              std::vector<unsigned int>& p_ids) const;
+        
+        
+        /*!
+         *   registers \p params, the property cards of the local elements
+         *   and the loads of the discipline with \p index and initializes
+         *   it, so that the dependency of these objects on \p params is
+         *   a lookup during the sensitivity assembly. Nothing is done if
+         *   any parameter in \p params is already registered with another
+         *   index.
+         */
+        void _init_parameter_dependency(const std::vector<const MAST::FunctionBase*>& params,
+                                        MAST::ParameterDependencyIndex& index) const;
+        
+        /*!
+         *   calls \p calculate_output_direct_sensitivities() for batches
+         *   of \p _sensitivity_batch_size parameters and collects the
+         *   sensitivities in \p dq_dp. @returns \p false without doing
+         *   anything if the solution sensitivities fit in a single batch.
+         */
+        bool
+        _calculate_output_direct_sensitivities_in_batches
+        (const libMesh::NumericVector<Real>& X,
+         const std::vector<const libMesh::NumericVector<Real>*>& dXdp,
+         const std::vector<const MAST::FunctionBase*>& params,
+         MAST::OutputAssemblyElemOperations& output,
+         std::vector<Real>& dq_dp);
+        
         /*!
          *   provides assembly elem operations for use by this class
          */
@@ -334,6 +459,22 @@ namespace MAST {
          *   an element. This can be used to enhance computational efficiency.
          */
         MAST::AssemblyBase::ElemParameterDependence *_param_dependence;
+        
+        /*!
+         *   largest number of solution sensitivity vectors localized at a
+         *   time by \p calculate_output_direct_sensitivities()
+         */
+        unsigned int _sensitivity_batch_size;
+        
+        /*!
+         *   ghosted work vectors used by \p localized_work_vector()
+         */
+        std::vector<std::unique_ptr<libMesh::NumericVector<Real> > > _work_vectors;
+        
+        /*!
+         *   send lists used to build each vector in \p _work_vectors
+         */
+        std::vector<std::vector<libMesh::dof_id_type> > _work_send_lists;
     };
         
 }
@@ -32,7 +32,8 @@ MAST::AssemblyElemOperations::AssemblyElemOperations():
 _system           (nullptr),
 _discipline       (nullptr),
 _assembly         (nullptr),
-_physics_elem     (nullptr) {
+_physics_elem     (nullptr),
+_if_thread_parallel (false) {
     
 }
 
@@ -195,3 +196,30 @@ MAST::AssemblyElemOperations::clear_elem() {
         
     _physics_elem = nullptr;
 }
+
+
+
+std::unique_ptr<MAST::AssemblyElemOperations>
+MAST::AssemblyElemOperations::clone() const {
+    
+    return std::unique_ptr<MAST::AssemblyElemOperations>();
+}
+
+
+void
+MAST::AssemblyElemOperations::join(const MAST::AssemblyElemOperations& other) {
+    
+    // nothing to be done here
+}
+
+
+void
+MAST::AssemblyElemOperations::_init_clone(MAST::AssemblyElemOperations& c) const {
+    
+    libmesh_assert(!c._physics_elem);
+    
+    c._system     = _system;
+    c._discipline = _discipline;
+    c._assembly   = _assembly;
+    c._if_thread_parallel = _if_thread_parallel;
+}
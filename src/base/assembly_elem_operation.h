@@ -20,6 +20,9 @@
 #ifndef __mast_assembly_elem_operation_h__
 #define __mast_assembly_elem_operation_h__
 
+// C++ includes
+#include <memory>
+
 // MAST includes
 #include "base/mast_data_types.h"
 
@@ -107,6 +110,46 @@ namespace MAST {
          */
         virtual void clear_elem();
         
+        /*!
+         *   @returns a new object of the same type that is associated with
+         *   the same discipline, system and assembly as this object. This
+         *   is used by the thread-parallel element loops in
+         *   MAST::AssemblyBase to provide each thread with its own
+         *   element operation object. Data accumulated over elements (e.g.
+         *   output values) must not be copied to the clone, since its
+         *   contribution is added back to this object through \p join().
+         *   The default implementation returns a null pointer. Each class
+         *   that allows thread-parallel processing must override this
+         *   method, including classes derived from a class that already
+         *   overrides it, since the assembly checks that the clone has the
+         *   same type as this object.
+         */
+        virtual std::unique_ptr<MAST::AssemblyElemOperations> clone() const;
+        
+        /*!
+         *   adds the data accumulated by \p other, which was created by
+         *   \p clone(), to this object. The default implementation does
+         *   nothing since most element operations do not accumulate data.
+         */
+        virtual void join(const MAST::AssemblyElemOperations& other);
+        
+        /*!
+         *   allows the assembly to process the elements on multiple threads
+         *   with clones of this object. This is \p false by default. It
+         *   should be set only if the class implements \p clone() and
+         *   \p join(), and if all functions evaluated by the elements
+         *   (property cards, loads, etc.) are thread-safe. For example,
+         *   MAST::MeshFieldFunction uses a libMesh point locator and is
+         *   not thread-safe.
+         */
+        void set_thread_parallel(bool f) { _if_thread_parallel = f; }
+        
+        /*!
+         *   @returns \p true if the elements may be processed on multiple
+         *   threads with clones of this object.
+         */
+        bool if_thread_parallel() const { return _if_thread_parallel; }
+        
         /*!
          *   @returns a reference to the physics element. The object must have
          *   been initialized before this method is called.
@@ -169,12 +212,24 @@ namespace MAST {
         
     protected:
 
+        /*!
+         *   copies the association with discipline, system and assembly
+         *   to \p c. This is meant for use by the \p clone() methods of
+         *   derived classes.
+         */
+        void _init_clone(MAST::AssemblyElemOperations& c) const;
+        
         MAST::SystemInitialization       *_system;
         MAST::PhysicsDisciplineBase      *_discipline;
 
         MAST::AssemblyBase               *_assembly;
         
         MAST::ElementBase                *_physics_elem;
+        
+        /*!
+         *   flag set by \p set_thread_parallel()
+         */
+        bool                              _if_thread_parallel;
     };
 }
 
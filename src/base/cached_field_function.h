@@ -0,0 +1,183 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__cached_field_function__
+#define __mast__cached_field_function__
+
+// C++ includes
+#include <map>
+#include <memory>
+
+// MAST includes
+#include "base/field_function_base.h"
+
+
+namespace MAST {
+    
+    /*!
+     *    Wraps a field function whose value is independent of the
+     *    spatial location and time, as reported by
+     *    \p FieldFunction::is_constant(), and evaluates the wrapped
+     *    function only once. The value and the derivatives with respect to
+     *    each function requested by the user are stored on the first
+     *    evaluation and returned for all subsequent points. Property cards
+     *    create the section functions for each element calculation, so the
+     *    cache lives for a single element calculation and does not need to
+     *    track changes in the parameter values.
+     */
+    template <typename ValType>
+    class CachedFieldFunction:
+    public MAST::FieldFunction<ValType> {
+        
+    public:
+        
+        /*!
+         *    takes ownership of \p f, which must be a constant function.
+         */
+        CachedFieldFunction(std::unique_ptr<MAST::FieldFunction<ValType> > f):
+        MAST::FieldFunction<ValType>(f->name()),
+        _f(std::move(f)),
+        _if_value(false) {
+            
+            libmesh_assert(_f->is_constant());
+            this->_functions.insert(_f.get());
+        }
+        
+        
+        virtual ~CachedFieldFunction() { }
+        
+        
+        virtual bool is_constant() const { return true; }
+        
+        
+        virtual void operator() (ValType& v) const {
+            
+            if (!_if_value) {
+                (*_f)(_value);
+                _if_value = true;
+            }
+            
+            v = _value;
+        }
+        
+        
+        virtual void perturbation (ValType& v) const {
+            
+            _f->perturbation(v);
+        }
+        
+        
+        virtual void derivative (const MAST::FunctionBase& f,
+                                 ValType& v) const {
+            
+            typename std::map<const MAST::FunctionBase*, ValType>::const_iterator
+            it = _derivatives.find(&f);
+            
+            if (it == _derivatives.end()) {
+                
+                _f->derivative(f, v);
+                _derivatives[&f] = v;
+            }
+            else
+                v = it->second;
+        }
+        
+        
+        virtual void operator() (const libMesh::Point& p,
+                                 const Real t,
+                                 ValType& v) const {
+            
+            if (!_if_value) {
+                (*_f)(p, t, _value);
+                _if_value = true;
+            }
+            
+            v = _value;
+        }
+        
+        
+        virtual void perturbation (const libMesh::Point& p,
+                                   const Real t,
+                                   ValType& v) const {
+            
+            _f->perturbation(p, t, v);
+        }
+        
+        
+        virtual void derivative (const MAST::FunctionBase& f,
+                                 const libMesh::Point& p,
+                                 const Real t,
+                                 ValType& v) const {
+            
+            typename std::map<const MAST::FunctionBase*, ValType>::const_iterator
+            it = _derivatives.find(&f);
+            
+            if (it == _derivatives.end()) {
+                
+                _f->derivative(f, p, t, v);
+                _derivatives[&f] = v;
+            }
+            else
+                v = it->second;
+        }
+        
+    protected:
+        
+        /*!
+         *    the wrapped function
+         */
+        std::unique_ptr<MAST::FieldFunction<ValType> > _f;
+        
+        /*!
+         *    true after the value has been computed and stored in \p _value
+         */
+        mutable bool _if_value;
+        
+        /*!
+         *    stored value of the function
+         */
+        mutable ValType _value;
+        
+        /*!
+         *    stored derivatives of the function with respect to the
+         *    functions that have been requested so far
+         */
+        mutable std::map<const MAST::FunctionBase*, ValType> _derivatives;
+    };
+    
+    
+    /*!
+     *    @returns \p f wrapped in a \p CachedFieldFunction if it is
+     *    constant, otherwise returns \p f.
+     */
+    template <typename ValType>
+    std::unique_ptr<MAST::FieldFunction<ValType> >
+    build_cached_field_function(MAST::FieldFunction<ValType>* f) {
+        
+        std::unique_ptr<MAST::FieldFunction<ValType> > rval(f);
+        
+        if (rval->is_constant())
+            rval.reset(new MAST::CachedFieldFunction<ValType>(std::move(rval)));
+        
+        return rval;
+    }
+}
+
+#endif // __mast__cached_field_function__
@@ -412,6 +412,29 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
                                libMesh::NumericVector<Real>& R,
                                libMesh::SparseMatrix<Real>&  J,
                                MAST::Parameter* p) {
+    
+    this->_residual_and_jacobian_blocked(X, R, &J, p);
+}
+
+
+
+void
+MAST::ComplexAssemblyBase::
+residual_blocked (const libMesh::NumericVector<Real>& X,
+                  libMesh::NumericVector<Real>& R,
+                  MAST::Parameter* p) {
+    
+    this->_residual_and_jacobian_blocked(X, R, nullptr, p);
+}
+
+
+
+void
+MAST::ComplexAssemblyBase::
+_residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
+                                libMesh::NumericVector<Real>& R,
+                                libMesh::SparseMatrix<Real>*  J,
+                                MAST::Parameter* p) {
 
     libmesh_assert(_system);
     libmesh_assert(_discipline);
@@ -422,7 +445,7 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
     MAST::NonlinearSystem& nonlin_sys = _system->system();
     
     R.zero();
-    J.zero();
+    if (J) J->zero();
     
     // iterate over each element, initialize it and get the relevant
     // analysis quantities
@@ -437,7 +460,9 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
 
     // get the petsc vector and matrix objects
     Mat
-    jac_bmat = dynamic_cast<libMesh::PetscMatrix<Real>&>(J).mat();
+    jac_bmat = nullptr;
+    if (J)
+        jac_bmat = dynamic_cast<libMesh::PetscMatrix<Real>&>(*J).mat();
     
     PetscInt ierr;
     
@@ -533,7 +558,7 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
         
         
         // perform the element level calculations
-        ops.elem_calculations(true, vec, mat);
+        ops.elem_calculations(J != nullptr, vec, mat);
         
         // if sensitivity was requested, then ask the element for sensitivity
         // of the residual
@@ -562,23 +587,30 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
         std::vector<Real> vals(4);
         
         // copy the real part of the residual and Jacobian
-        MAST::copy( m_R, mat.real());
-        MAST::copy(m_I1, mat.imag()); m_I1 *= -1.;   // this is the -J_I component
-        MAST::copy(m_I2, mat.imag());                // this is the J_I component
         MAST::copy( v_R, vec.real());
         MAST::copy( v_I, vec.imag());
-        dof_map.constrain_element_matrix(m_R,  dof_indices);
-        dof_map.constrain_element_matrix(m_I1, dof_indices);
-        dof_map.constrain_element_matrix(m_I2, dof_indices);
         dof_map.constrain_element_vector(v_R,  dof_indices);
         dof_map.constrain_element_vector(v_I,  dof_indices);
         
+        if (J) {
+            
+            MAST::copy( m_R, mat.real());
+            MAST::copy(m_I1, mat.imag()); m_I1 *= -1.;   // this is the -J_I component
+            MAST::copy(m_I2, mat.imag());                // this is the J_I component
+            dof_map.constrain_element_matrix(m_R,  dof_indices);
+            dof_map.constrain_element_matrix(m_I1, dof_indices);
+            dof_map.constrain_element_matrix(m_I2, dof_indices);
+        }
+        
         
         for (unsigned int i=0; i<dof_indices.size(); i++) {
             
             R.add(2*dof_indices[i],     v_R(i));
             R.add(2*dof_indices[i]+1,   v_I(i));
             
+            if (!J)
+                continue;
+            
             for (unsigned int j=0; j<dof_indices.size(); j++) {
                 vals[0] = m_R (i,j);
                 vals[1] = m_I1(i,j);
@@ -599,7 +631,7 @@ residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
     //    _sol_function->clear();
     
     R.close();
-    J.close();
+    if (J) J->close();
     
     libMesh::out << "R: " << R.l2_norm() << std::endl;
     STOP_LOG("residual_and_jacobian()", "ComplexSolve");
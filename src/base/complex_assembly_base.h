@@ -115,6 +115,21 @@ namespace MAST {
                                        libMesh::NumericVector<Real>& R,
                                        libMesh::SparseMatrix<Real>&  J,
                                        MAST::Parameter* p = nullptr);
+        
+        
+        /*!
+         *   Assembles only the residual of the N complex system of equations
+         *   split into 2N real system of equations, using the same storage
+         *   as \p residual_and_jacobian_blocked(). This is useful when the
+         *   Jacobian from a previous assembly is reused and only the
+         *   right-hand side changes, for example due to a different
+         *   boundary condition. If \p p is provided, then \p R will return
+         *   the sensitivity of the residual vector.
+         */
+        void
+        residual_blocked (const libMesh::NumericVector<Real>& X,
+                          libMesh::NumericVector<Real>& R,
+                          MAST::Parameter* p = nullptr);
 
         /**
          * Assembly function.  This function will be called
@@ -133,6 +148,16 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *   assembles the blocked residual in \p R and, if \p J is
+         *   non-null, the blocked Jacobian.
+         */
+        void
+        _residual_and_jacobian_blocked (const libMesh::NumericVector<Real>& X,
+                                        libMesh::NumericVector<Real>& R,
+                                        libMesh::SparseMatrix<Real>*  J,
+                                        MAST::Parameter* p);
+        
         /*!
          *   base solution about which this problem is defined. This
          *   vector stores the localized values necessary to perform element
@@ -19,6 +19,7 @@
 
 // MAST includes
 #include "base/complex_mesh_field_function.h"
+#include "base/mesh_field_transfer_map.h"
 #include "base/system_initialization.h"
 #include "base/nonlinear_system.h"
 
@@ -39,7 +40,8 @@ _perturbed_sol_im(nullptr),
 _function_re(nullptr),
 _function_im(nullptr),
 _perturbed_function_re(nullptr),
-_perturbed_function_im(nullptr)
+_perturbed_function_im(nullptr),
+_transfer_map(nullptr)
 { }
 
 
@@ -62,6 +64,15 @@ init(const libMesh::NumericVector<Real>& sol_re,
     // first make sure that the object is not already initialized
     libmesh_assert(!_function_re);
     
+    // with a transfer map only the dofs needed by the mapped points are
+    // localized. The vectors are reused in subsequent calls.
+    if (_transfer_map) {
+        
+        _transfer_map->localize(sol_re, _map_sol_re);
+        _transfer_map->localize(sol_im, _map_sol_im);
+        return;
+    }
+    
     MAST::NonlinearSystem& system = _system->system();
     
     // next, clone this solution and localize to the sendlist
@@ -117,6 +128,13 @@ init_perturbation(const libMesh::NumericVector<Real>& sol_re,
     // first make sure that the object is not already initialized
     libmesh_assert(!_perturbed_function_re);
     
+    if (_transfer_map) {
+        
+        _transfer_map->localize(sol_re, _map_dsol_re);
+        _transfer_map->localize(sol_im, _map_dsol_im);
+        return;
+    }
+    
     MAST::NonlinearSystem& system = _system->system();
     
     // next, clone this solution and localize to the sendlist
@@ -168,6 +186,19 @@ MAST::ComplexMeshFieldFunction::operator() (const libMesh::Point& p,
                                             const Real t,
                                             ComplexVectorX& v) const {
     
+    // use the precomputed interpolation if a transfer map is provided
+    if (_transfer_map) {
+        
+        libmesh_assert(_map_sol_re.get());
+        
+        RealVectorX v_re, v_im;
+        _transfer_map->interpolate(*_map_sol_re, p, v_re);
+        _transfer_map->interpolate(*_map_sol_im, p, v_im);
+        
+        v = v_re.cast<Complex>() + Complex(0., 1.) * v_im.cast<Complex>();
+        return;
+    }
+    
     // make sure that the object was initialized
     libmesh_assert(_function_re);
     
@@ -194,6 +225,19 @@ MAST::ComplexMeshFieldFunction::perturbation(const libMesh::Point& p,
                                              const Real t,
                                              ComplexVectorX& v) const {
     
+    // use the precomputed interpolation if a transfer map is provided
+    if (_transfer_map) {
+        
+        libmesh_assert(_map_dsol_re.get());
+        
+        RealVectorX v_re, v_im;
+        _transfer_map->interpolate(*_map_dsol_re, p, v_re);
+        _transfer_map->interpolate(*_map_dsol_im, p, v_im);
+        
+        v = v_re.cast<Complex>() + Complex(0., 1.) * v_im.cast<Complex>();
+        return;
+    }
+    
     // make sure that the object was initialized
     libmesh_assert(_perturbed_function_re);
     
@@ -218,6 +262,106 @@ MAST::ComplexMeshFieldFunction::perturbation(const libMesh::Point& p,
 
 
 
+void
+MAST::ComplexMeshFieldFunction::gradient(const libMesh::Point& p,
+                                         const Real t,
+                                         ComplexMatrixX& g) const {
+    
+    RealMatrixX g_re, g_im;
+    
+    if (_transfer_map) {
+        
+        libmesh_assert(_map_sol_re.get());
+        _transfer_map->interpolate_gradient(*_map_sol_re, p, g_re);
+        _transfer_map->interpolate_gradient(*_map_sol_im, p, g_im);
+    }
+    else {
+        
+        libmesh_assert(_function_re);
+        _gradient(*_function_re, p, t, g_re);
+        _gradient(*_function_im, p, t, g_im);
+    }
+    
+    g = g_re.cast<Complex>() + Complex(0., 1.) * g_im.cast<Complex>();
+}
+
+
+
+void
+MAST::ComplexMeshFieldFunction::perturbation_gradient(const libMesh::Point& p,
+                                                      const Real t,
+                                                      ComplexMatrixX& g) const {
+    
+    RealMatrixX g_re, g_im;
+    
+    if (_transfer_map) {
+        
+        libmesh_assert(_map_dsol_re.get());
+        _transfer_map->interpolate_gradient(*_map_dsol_re, p, g_re);
+        _transfer_map->interpolate_gradient(*_map_dsol_im, p, g_im);
+    }
+    else {
+        
+        libmesh_assert(_perturbed_function_re);
+        _gradient(*_perturbed_function_re, p, t, g_re);
+        _gradient(*_perturbed_function_im, p, t, g_im);
+    }
+    
+    g = g_re.cast<Complex>() + Complex(0., 1.) * g_im.cast<Complex>();
+}
+
+
+
+void
+MAST::ComplexMeshFieldFunction::_gradient(libMesh::MeshFunction& f,
+                                          const libMesh::Point& p,
+                                          const Real t,
+                                          RealMatrixX& g) const {
+    
+    std::vector<libMesh::Gradient> v;
+    f.gradient(p, t, v);
+    
+    // make sure that the mesh function was able to find the element
+    // and a solution
+    libmesh_assert(v.size());
+    
+    g = RealMatrixX::Zero(v.size(), 3); // assume 3-dimensional by default
+    for (unsigned int i=0; i<v.size(); i++)
+        for (unsigned int j=0; j<3; j++)
+            g(i, j) = v[i](j);
+}
+
+
+
+void
+MAST::ComplexMeshFieldFunction::set_transfer_map(const MAST::MeshFieldTransferMap& m) {
+    
+    // the map should be set before the function is initialized
+    libmesh_assert(!_function_re);
+    libmesh_assert(m.initialized());
+    libmesh_assert(&m.source_system() == &_system->system());
+    
+    _transfer_map = &m;
+    _map_sol_re.reset();
+    _map_sol_im.reset();
+    _map_dsol_re.reset();
+    _map_dsol_im.reset();
+}
+
+
+
+void
+MAST::ComplexMeshFieldFunction::clear_transfer_map() {
+    
+    _transfer_map = nullptr;
+    _map_sol_re.reset();
+    _map_sol_im.reset();
+    _map_dsol_re.reset();
+    _map_dsol_im.reset();
+}
+
+
+
 void
 MAST::ComplexMeshFieldFunction::clear() {
     
@@ -247,6 +391,12 @@ MAST::ComplexMeshFieldFunction::clear() {
         _perturbed_sol_re = nullptr;
         _perturbed_sol_im = nullptr;
     }
+    
+    // the vectors localized with the transfer map are retained for reuse
+    // in the next call to init(), but the perturbation is cleared since
+    // it is optional
+    _map_dsol_re.reset();
+    _map_dsol_im.reset();
 }
 
 
@@ -24,6 +24,9 @@
 #include "base/field_function_base.h"
 
 
+// C++ includes
+#include <memory>
+
 // libMesh includes
 #include "libmesh/numeric_vector.h"
 #include "libmesh/mesh_function.h"
@@ -34,6 +37,7 @@ namespace MAST {
     
     // Forward declerations
     class SystemInitialization;
+    class MeshFieldTransferMap;
     
     
     /*!
@@ -67,6 +71,24 @@ namespace MAST {
                                    ComplexVectorX& v) const;
         
         
+        /*!
+         *    calculates the gradient of the function at \p p, with
+         *    \f$ g(i,j) = dv(i)/dx(j) \f$.
+         */
+        void gradient (const libMesh::Point& p,
+                       const Real t,
+                       ComplexMatrixX& g) const;
+        
+        
+        /*!
+         *    calculates the gradient of the perturbation of the function
+         *    at \p p, with \f$ g(i,j) = dv(i)/dx(j) \f$.
+         */
+        void perturbation_gradient (const libMesh::Point& p,
+                                    const Real t,
+                                    ComplexMatrixX& g) const;
+        
+        
         void init(const libMesh::NumericVector<Real>& sol_re,
                   const libMesh::NumericVector<Real>& sol_im);
         
@@ -75,6 +97,24 @@ namespace MAST {
                                const libMesh::NumericVector<Real>& dsol_im);
         
         
+        /*!
+         *   sets the transfer map used for interpolation of the solution.
+         *   The real and imaginary solutions are then localized to only
+         *   the dofs needed by the points in \p m, and the interpolation
+         *   uses the precomputed source elements and shape functions
+         *   instead of the libMesh MeshFunction. This should be called
+         *   before \p init(), and \p m should be initialized.
+         */
+        void set_transfer_map(const MAST::MeshFieldTransferMap& m);
+        
+        
+        /*!
+         *   clears the transfer map, so that the libMesh MeshFunction is
+         *   used for interpolation.
+         */
+        void clear_transfer_map();
+        
+        
         /*!
          *    @returns a reference to the libMesh mesh function
          */
@@ -108,6 +148,14 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *   gradient of \p f at \p p, with \f$ g(i,j) = dv(i)/dx(j) \f$
+         */
+        void _gradient(libMesh::MeshFunction& f,
+                       const libMesh::Point& p,
+                       const Real t,
+                       RealMatrixX& g) const;
+        
         /*!
          *  current system for which solution is to be interpolated
          */
@@ -131,6 +179,19 @@ namespace MAST {
         *_perturbed_function_re,
         *_perturbed_function_im;
         
+        /*!
+         *   transfer map used for interpolation, if provided
+         */
+        const MAST::MeshFieldTransferMap* _transfer_map;
+        
+        /*!
+         *   solution vectors localized using the transfer map
+         */
+        std::unique_ptr<libMesh::NumericVector<Real> >
+        _map_sol_re,
+        _map_sol_im,
+        _map_dsol_re,
+        _map_dsol_im;
     };
 }
 
@@ -76,6 +76,12 @@ namespace MAST {
                                  Real& v) const;
 
         
+        /*!
+         *    @returns true, since the value is independent of the point
+         *    and time.
+         */
+        virtual bool is_constant() const { return true; }
+        
         
     protected:
 
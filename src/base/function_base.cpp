@@ -26,7 +26,10 @@ MAST::FunctionBase::FunctionBase(const std::string& nm,
 _name                      (nm),
 _is_field_func             (is_field_func),
 _is_shape_parameter        (false),
-_is_topology_parameter     (false) {
+_is_topology_parameter     (false),
+_dependency_index          (nullptr),
+_parameter_index           (nullptr),
+_parameter_id              (0) {
     
 }
 
@@ -36,7 +39,10 @@ MAST::FunctionBase::FunctionBase(const MAST::FunctionBase& f):
 _name                      (f._name),
 _is_field_func             (f._is_field_func),
 _is_shape_parameter        (f._is_shape_parameter),
-_is_topology_parameter     (f._is_topology_parameter) {
+_is_topology_parameter     (f._is_topology_parameter),
+_dependency_index          (nullptr),
+_parameter_index           (nullptr),
+_parameter_id              (0) {
     
 }
 
@@ -22,6 +22,7 @@
 
 // C++ includes
 #include <set>
+#include <vector>
 
 
 //  MAST includes
@@ -31,6 +32,10 @@
 namespace MAST
 {
     
+    // Forward declerations
+    class ParameterDependencyIndex;
+    class FunctionSetBase;
+    
     
     class FunctionBase {
     public:
@@ -63,22 +68,19 @@ namespace MAST
         
         
         /*!
-         *  returns true if the function depends on the provided value
+         *  returns true if the function depends on the provided value. If
+         *  the dependency has been precomputed by a
+         *  \p MAST::ParameterDependencyIndex that \p f is registered with,
+         *  this is a single lookup. Otherwise, \p _depends_on() is called.
+         *  Derived classes should override \p _depends_on() instead of
+         *  this method, so that the precomputed dependency is used.
          */
         virtual bool depends_on(const MAST::FunctionBase& f) const {
-            if (_functions.count(&f))   // this function is the same
-                return true;
-            
-            // check with all functions if they are dependent
-            std::set<const MAST::FunctionBase*>::const_iterator
-            it = _functions.begin(), end = _functions.end();
-            
-            for ( ; it != end; it++)
-                if ((*it)->depends_on(f))
-                    return true;
-            
-            // if it gets here, then there is no dependency
-            return false;
+            if (_dependency_index &&
+                f._parameter_index == _dependency_index)
+                return _dependency[f._parameter_id];
+            else
+                return _depends_on(f);
         }
         
         
@@ -96,9 +98,72 @@ namespace MAST
          */
         virtual bool is_topology_parameter() const {return _is_topology_parameter;}
         virtual void set_as_topology_parameter(bool f) {_is_topology_parameter = f;}
+
+
+        /*!
+         *  @returns true if the value of this function is independent of
+         *  the spatial location and time, so that it needs to be evaluated
+         *  only once for a given set of parameter values. False by default.
+         */
+        virtual bool is_constant() const { return false; }
+        
+        
+        /*!
+         *  @returns the index that \p this has been registered with as a
+         *  parameter, or \p nullptr if it is not a registered parameter.
+         */
+        const MAST::ParameterDependencyIndex* parameter_index() const {
+            return _parameter_index;
+        }
         
     protected:
         
+        friend class MAST::ParameterDependencyIndex;
+        friend class MAST::FunctionSetBase;
+        
+        /*!
+         *  returns true if the function depends on the provided value by
+         *  recursively checking all functions that \p this depends on.
+         *  Derived classes that depend on other objects should override this.
+         */
+        virtual bool _depends_on(const MAST::FunctionBase& f) const {
+            if (_functions.count(&f))   // this function is the same
+                return true;
+            
+            // check with all functions if they are dependent
+            std::set<const MAST::FunctionBase*>::const_iterator
+            it = _functions.begin(), end = _functions.end();
+            
+            for ( ; it != end; it++)
+                if ((*it)->depends_on(f))
+                    return true;
+            
+            // if it gets here, then there is no dependency
+            return false;
+        }
+        
+        /*!
+         *  @returns true if \p this depends on at least one function and
+         *  all functions that \p this depends on are constant. Derived
+         *  classes that combine other functions without introducing a
+         *  spatial dependence can use this to implement \p is_constant().
+         */
+        bool _all_functions_constant() const {
+            
+            if (_functions.empty())
+                return false;
+            
+            std::set<const MAST::FunctionBase*>::const_iterator
+            it = _functions.begin(), end = _functions.end();
+            
+            for ( ; it != end; it++)
+                if (!(*it)->is_constant())
+                    return false;
+            
+            return true;
+        }
+        
+        
         /*!
          *    name of this parameter
          */
@@ -116,6 +181,30 @@ namespace MAST
          *   set of functions that \p this function depends on
          */
         std::set<const MAST::FunctionBase*> _functions;
+        
+        /*!
+         *   index that has precomputed \p _dependency for this function,
+         *   or \p nullptr if the dependency has not been precomputed
+         */
+        mutable const MAST::ParameterDependencyIndex* _dependency_index;
+        
+        /*!
+         *   flags for the dependency of this function on each parameter
+         *   registered with \p _dependency_index, ordered by the
+         *   parameter id
+         */
+        mutable std::vector<bool> _dependency;
+        
+        /*!
+         *   index that \p this has been registered with as a parameter,
+         *   or \p nullptr if it is not a registered parameter
+         */
+        mutable const MAST::ParameterDependencyIndex* _parameter_index;
+        
+        /*!
+         *   dense id of this parameter in \p _parameter_index
+         */
+        mutable unsigned int _parameter_id;
     };
     
 }
@@ -22,7 +22,8 @@
 
 
 
-MAST::FunctionSetBase::FunctionSetBase()
+MAST::FunctionSetBase::FunctionSetBase():
+_dependency_index    (nullptr)
 { }
         
 
@@ -53,12 +54,15 @@ MAST::FunctionSetBase::add(MAST::FunctionBase& f) {
     bool success = _properties.insert(std::pair<std::string, MAST::FunctionBase*>
                                       (f.name(), &f)).second;
     libmesh_assert(success);
+    
+    // the precomputed dependency does not include the new function
+    _dependency_index = nullptr;
 }
 
         
 
 bool
-MAST::FunctionSetBase::depends_on(const MAST::FunctionBase& f) const {
+MAST::FunctionSetBase::_depends_on(const MAST::FunctionBase& f) const {
     
     // check with all the properties to see if any one of them is
     // dependent on the provided parameter, or is the parameter itself
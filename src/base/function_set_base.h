@@ -93,17 +93,50 @@ namespace MAST {
         
         
         /*!
-         *  returns true if the property card depends on the function \p f
+         *  returns true if the property card depends on the function \p f.
+         *  If the dependency has been precomputed by a
+         *  \p MAST::ParameterDependencyIndex that \p f is registered with,
+         *  this is a single lookup. Otherwise, \p _depends_on() is called.
+         *  Derived classes should override \p _depends_on() instead of
+         *  this method, so that the precomputed dependency is used.
          */
-        virtual bool depends_on(const MAST::FunctionBase& f) const;
+        virtual bool depends_on(const MAST::FunctionBase& f) const {
+            if (_dependency_index &&
+                f._parameter_index == _dependency_index)
+                return _dependency[f._parameter_id];
+            else
+                return _depends_on(f);
+        }
 
         
     protected:
         
+        friend class MAST::ParameterDependencyIndex;
+        
+        /*!
+         *  returns true if any function in this card depends on the
+         *  function \p f. Derived classes that depend on other objects
+         *  should override this.
+         */
+        virtual bool _depends_on(const MAST::FunctionBase& f) const;
+        
         /*!
          *    map of the functions in this card
          */
         std::map<std::string, MAST::FunctionBase*> _properties;
+        
+        /*!
+         *   index that has precomputed \p _dependency for this card,
+         *   or \p nullptr if the dependency has not been precomputed
+         */
+        mutable const MAST::ParameterDependencyIndex* _dependency_index;
+        
+        /*!
+         *   flags for the dependency of this card on each parameter
+         *   registered with \p _dependency_index, ordered by the
+         *   parameter id
+         */
+        mutable std::vector<bool> _dependency;
     };
     
 }
@@ -19,6 +19,7 @@
 
 // MAST includes
 #include "base/mesh_field_function.h"
+#include "base/mesh_field_transfer_map.h"
 #include "base/system_initialization.h"
 #include "base/nonlinear_system.h"
 
@@ -36,7 +37,8 @@ _sys(&sys.system()),
 _sol(nullptr),
 _dsol(nullptr),
 _function(nullptr),
-_perturbed_function(nullptr)
+_perturbed_function(nullptr),
+_transfer_map(nullptr)
 { }
 
 
@@ -51,7 +53,8 @@ _sys(&sys),
 _sol(nullptr),
 _dsol(nullptr),
 _function(nullptr),
-_perturbed_function(nullptr)
+_perturbed_function(nullptr),
+_transfer_map(nullptr)
 { }
 
 
@@ -80,6 +83,13 @@ MAST::MeshFieldFunction::operator() (const libMesh::Point& p,
         return;
     }
     
+    // use the precomputed interpolation if a transfer map is provided
+    if (_transfer_map) {
+        libmesh_assert(_map_sol.get());
+        _transfer_map->interpolate(*_map_sol, p, v);
+        return;
+    }
+    
     // make sure that the object was initialized
     libmesh_assert(_function);
     
@@ -113,6 +123,13 @@ MAST::MeshFieldFunction::gradient (const libMesh::Point& p,
         return;
     }
     
+    // use the precomputed interpolation if a transfer map is provided
+    if (_transfer_map) {
+        libmesh_assert(_map_sol.get());
+        _transfer_map->interpolate_gradient(*_map_sol, p, v);
+        return;
+    }
+    
     // make sure that the object was initialized
     libmesh_assert(_function);
     
@@ -147,6 +164,13 @@ MAST::MeshFieldFunction::perturbation(const libMesh::Point& p,
         return;
     }
     
+    // use the precomputed interpolation if a transfer map is provided
+    if (_transfer_map) {
+        libmesh_assert(_map_dsol.get());
+        _transfer_map->interpolate(*_map_dsol, p, v);
+        return;
+    }
+    
     // make sure that the object was initialized
     libmesh_assert(_perturbed_function);
     
@@ -192,6 +216,19 @@ init(const libMesh::NumericVector<Real>& sol,
     // first make sure that the object is not already initialized
     libmesh_assert(!_function);
     
+    // with a transfer map only the dofs needed by the mapped points are
+    // localized. The vectors are reused in subsequent calls.
+    if (_transfer_map) {
+        
+        _transfer_map->localize(sol, _map_sol);
+        if (dsol)
+            _transfer_map->localize(*dsol, _map_dsol);
+        else
+            _map_dsol.reset();
+        
+        return;
+    }
+    
     // next, clone this solution and localize to the sendlist
     _sol = libMesh::NumericVector<Real>::build(_sys->comm()).release();
 
@@ -265,12 +302,43 @@ MAST::MeshFieldFunction::clear() {
     }
 
     
+    // the vectors localized with the transfer map are retained for reuse
+    // in the next call to init(), but the perturbation is cleared since
+    // it is optional
+    _map_dsol.reset();
+    
     // clear flags for quadrature point solution
     _use_qp_sol = false;
 }
 
 
 
+void
+MAST::MeshFieldFunction::
+set_transfer_map(const MAST::MeshFieldTransferMap& m) {
+    
+    // the map should be set before the function is initialized
+    libmesh_assert(!_function);
+    libmesh_assert(m.initialized());
+    libmesh_assert(&m.source_system() == _sys);
+    
+    _transfer_map = &m;
+    _map_sol.reset();
+    _map_dsol.reset();
+}
+
+
+
+void
+MAST::MeshFieldFunction::clear_transfer_map() {
+    
+    _transfer_map = nullptr;
+    _map_sol.reset();
+    _map_dsol.reset();
+}
+
+
+
 
 void
 MAST::MeshFieldFunction::
@@ -35,6 +35,7 @@ namespace MAST {
 
     // Forward declerations
     class SystemInitialization;
+    class MeshFieldTransferMap;
     
     
     /*!
@@ -110,6 +111,24 @@ namespace MAST {
                   const libMesh::NumericVector<Real>* dsol = nullptr);
 
         
+        /*!
+         *   sets the transfer map used for interpolation of the solution.
+         *   The solution is then localized to only the dofs needed by the
+         *   points in \p m, and the interpolation uses the precomputed
+         *   source elements and shape functions instead of the libMesh
+         *   MeshFunction. This should be called before \p init(), and
+         *   \p m should be initialized.
+         */
+        void set_transfer_map(const MAST::MeshFieldTransferMap& m);
+        
+        
+        /*!
+         *   clears the transfer map, so that the libMesh MeshFunction is
+         *   used for interpolation.
+         */
+        void clear_transfer_map();
+
+        
         /*!
          *    @returns a reference to the libMesh mesh function
          */
@@ -180,6 +199,16 @@ namespace MAST {
          *   the MeshFunction object that performs the interpolation
          */
         libMesh::MeshFunction *_function, *_perturbed_function;
+        
+        /*!
+         *   transfer map used for interpolation, if provided
+         */
+        const MAST::MeshFieldTransferMap* _transfer_map;
+        
+        /*!
+         *   solution vectors localized using the transfer map
+         */
+        std::unique_ptr<libMesh::NumericVector<Real> > _map_sol, _map_dsol;
     };
 }
 
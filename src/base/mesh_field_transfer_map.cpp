@@ -0,0 +1,466 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+
+// C++ includes
+#include <set>
+#include <algorithm>
+
+// MAST includes
+#include "base/mesh_field_transfer_map.h"
+
+// libMesh includes
+#include "libmesh/fe_base.h"
+#include "libmesh/fe_interface.h"
+#include "libmesh/quadrature.h"
+#include "libmesh/dof_map.h"
+#include "libmesh/elem.h"
+#include "libmesh/mesh_base.h"
+#include "libmesh/boundary_info.h"
+
+
+MAST::MeshFieldTransferMap::
+MeshFieldTransferMap(const libMesh::System& source,
+                     const Real tol):
+_source         (source),
+_initialized    (false),
+_points         (MAST::MeshFieldTransferMap::PointLess(tol)) {
+    
+}
+
+
+
+MAST::MeshFieldTransferMap::~MeshFieldTransferMap() {
+    
+}
+
+
+
+void
+MAST::MeshFieldTransferMap::add_points(const std::vector<libMesh::Point>& pts) {
+    
+    // points cannot be added after the map has been initialized
+    libmesh_assert(!_initialized);
+    
+    for (unsigned int i=0; i<pts.size(); i++)
+        _points[pts[i]];
+}
+
+
+
+void
+MAST::MeshFieldTransferMap::
+add_quadrature_points(const libMesh::System& target,
+                      const int q_order,
+                      const bool if_sides) {
+    
+    libmesh_assert(!_initialized);
+    
+    // all variables are assumed to be of same type
+    const libMesh::FEType
+    fe_type = target.variable_type(0);
+    
+    // the FE objects and quadrature rules are created once for each
+    // dimension and used for all elements of that dimension
+    std::unique_ptr<libMesh::FEBase>
+    fe[4],
+    fe_side[4];
+    std::unique_ptr<libMesh::QBase>
+    qrule[4],
+    qrule_side[4];
+    
+    libMesh::MeshBase::const_element_iterator       el     =
+    target.get_mesh().active_local_elements_begin();
+    const libMesh::MeshBase::const_element_iterator end_el =
+    target.get_mesh().active_local_elements_end();
+    
+    for ( ; el != end_el; ++el) {
+        
+        const libMesh::Elem* elem = *el;
+        const unsigned int   dim  = elem->dim();
+        
+        if (!fe[dim].get()) {
+            
+            fe[dim].reset(libMesh::FEBase::build(dim, fe_type).release());
+            qrule[dim].reset(fe_type.default_quadrature_rule(dim, q_order).release());
+            fe[dim]->attach_quadrature_rule(qrule[dim].get());
+            fe[dim]->get_xyz();
+            
+            if (if_sides && dim > 0) {
+                
+                fe_side[dim].reset(libMesh::FEBase::build(dim, fe_type).release());
+                qrule_side[dim].reset(fe_type.default_quadrature_rule(dim-1, q_order).release());
+                fe_side[dim]->attach_quadrature_rule(qrule_side[dim].get());
+                fe_side[dim]->get_xyz();
+            }
+        }
+        
+        fe[dim]->reinit(elem);
+        this->add_points(fe[dim]->get_xyz());
+        
+        if (if_sides && dim > 0)
+            for (unsigned short int s=0; s<elem->n_sides(); s++) {
+                
+                fe_side[dim]->reinit(elem, s);
+                this->add_points(fe_side[dim]->get_xyz());
+            }
+    }
+}
+
+
+
+void
+MAST::MeshFieldTransferMap::
+add_side_quadrature_points(const libMesh::System& target,
+                           const int q_order,
+                           const std::set<libMesh::boundary_id_type>& bids) {
+    
+    libmesh_assert(!_initialized);
+    
+    // all variables are assumed to be of same type
+    const libMesh::FEType
+    fe_type = target.variable_type(0);
+    
+    const libMesh::BoundaryInfo&
+    binfo = target.get_mesh().get_boundary_info();
+    
+    std::unique_ptr<libMesh::FEBase>
+    fe_side[4];
+    std::unique_ptr<libMesh::QBase>
+    qrule_side[4];
+    
+    std::vector<libMesh::boundary_id_type> side_bids;
+    
+    libMesh::MeshBase::const_element_iterator       el     =
+    target.get_mesh().active_local_elements_begin();
+    const libMesh::MeshBase::const_element_iterator end_el =
+    target.get_mesh().active_local_elements_end();
+    
+    for ( ; el != end_el; ++el) {
+        
+        const libMesh::Elem* elem = *el;
+        const unsigned int   dim  = elem->dim();
+        
+        if (dim == 0)
+            continue;
+        
+        for (unsigned short int s=0; s<elem->n_sides(); s++) {
+            
+            binfo.boundary_ids(elem, s, side_bids);
+            
+            bool
+            on_boundary = false;
+            for (unsigned int i=0; i<side_bids.size() && !on_boundary; i++)
+                on_boundary = bids.count(side_bids[i]);
+            
+            if (!on_boundary)
+                continue;
+            
+            if (!fe_side[dim].get()) {
+                
+                fe_side[dim].reset(libMesh::FEBase::build(dim, fe_type).release());
+                qrule_side[dim].reset(fe_type.default_quadrature_rule(dim-1, q_order).release());
+                fe_side[dim]->attach_quadrature_rule(qrule_side[dim].get());
+                fe_side[dim]->get_xyz();
+            }
+            
+            fe_side[dim]->reinit(elem, s);
+            this->add_points(fe_side[dim]->get_xyz());
+        }
+    }
+}
+
+
+
+void
+MAST::MeshFieldTransferMap::init() {
+    
+    libmesh_assert(!_initialized);
+    
+    const libMesh::DofMap& dof_map = _source.get_dof_map();
+    
+    const libMesh::dof_id_type
+    first_dof  = dof_map.first_dof(),
+    end_dof    = dof_map.end_dof();
+    
+    _point_locator = _source.get_mesh().sub_point_locator();
+    _point_locator->enable_out_of_mesh_mode();
+    
+    // group the points by the source element in which they are located
+    std::map<const libMesh::Elem*, std::vector<libMesh::Point> >
+    elem_pts;
+    std::map<const libMesh::Elem*, std::vector<PointData*> >
+    elem_data;
+    
+    std::map<libMesh::Point, PointData, PointLess>::iterator
+    it   = _points.begin(),
+    end  = _points.end();
+    
+    for ( ; it != end; it++) {
+        
+        const libMesh::Elem* e = (*_point_locator)(it->first);
+        
+        if (!e)
+            libmesh_error_msg("Point not found in source mesh: " << it->first);
+        
+        elem_pts[e].push_back(it->first);
+        elem_data[e].push_back(&it->second);
+    }
+    
+    // now compute the shape functions of each source element at its
+    // points, and identify the dofs that are needed from other processors
+    std::set<libMesh::dof_id_type> ghosts;
+    
+    _dofs.resize(elem_pts.size());
+    
+    std::map<const libMesh::Elem*, std::vector<libMesh::Point> >::const_iterator
+    e_it   = elem_pts.begin(),
+    e_end  = elem_pts.end();
+    
+    for (unsigned int i=0 ; e_it != e_end; e_it++, i++) {
+        
+        std::vector<PointData*>& data = elem_data[e_it->first];
+        
+        _elem_dofs(*e_it->first, _dofs[i]);
+        
+        for (unsigned int j=0; j<_dofs[i].size(); j++)
+            for (unsigned int k=0; k<_dofs[i][j].size(); k++)
+                if (_dofs[i][j][k] < first_dof || _dofs[i][j][k] >= end_dof)
+                    ghosts.insert(_dofs[i][j][k]);
+        
+        for (unsigned int j=0; j<data.size(); j++)
+            data[j]->elem = i;
+        
+        _shape_functions(*e_it->first, e_it->second, data);
+    }
+    
+    _ghost_dofs.assign(ghosts.begin(), ghosts.end());
+    
+    _initialized = true;
+}
+
+
+
+void
+MAST::MeshFieldTransferMap::clear() {
+    
+    _points.clear();
+    _dofs.clear();
+    _ghost_dofs.clear();
+    _point_locator.reset();
+    _initialized = false;
+}
+
+
+
+void
+MAST::MeshFieldTransferMap::
+localize(const libMesh::NumericVector<Real>& global,
+         std::unique_ptr<libMesh::NumericVector<Real> >& local) const {
+    
+    libmesh_assert(_initialized);
+    libmesh_assert_equal_to(global.size(), _source.n_dofs());
+    
+    // the vector is recreated only if the dof distribution has changed
+    if (!local ||
+        local->size()       != _source.n_dofs() ||
+        local->local_size() != _source.n_local_dofs()) {
+        
+        local = libMesh::NumericVector<Real>::build(_source.comm());
+        local->init(_source.n_dofs(),
+                    _source.n_local_dofs(),
+                    _ghost_dofs,
+                    false,
+                    libMesh::GHOSTED);
+    }
+    
+    global.localize(*local, _ghost_dofs);
+}
+
+
+
+void
+MAST::MeshFieldTransferMap::
+interpolate(const libMesh::NumericVector<Real>& local,
+            const libMesh::Point& p,
+            RealVectorX& v) const {
+    
+    const PointData* data = nullptr;
+    const std::vector<std::vector<libMesh::dof_id_type> >* dofs = nullptr;
+    PointData tmp_data;
+    std::vector<std::vector<libMesh::dof_id_type> > tmp_dofs;
+    
+    _point_data(p, local, data, dofs, tmp_data, tmp_dofs);
+    
+    const unsigned int
+    n_vars = _source.n_vars();
+    
+    v = RealVectorX::Zero(n_vars);
+    
+    for (unsigned int i=0; i<n_vars; i++) {
+        
+        const std::vector<libMesh::dof_id_type>& d = (*dofs)[i];
+        libmesh_assert_equal_to(d.size(), data->phi.size());
+        
+        for (unsigned int j=0; j<d.size(); j++)
+            v(i) += data->phi[j] * local(d[j]);
+    }
+}
+
+
+
+void
+MAST::MeshFieldTransferMap::
+interpolate_gradient(const libMesh::NumericVector<Real>& local,
+                     const libMesh::Point& p,
+                     RealMatrixX& g) const {
+    
+    const PointData* data = nullptr;
+    const std::vector<std::vector<libMesh::dof_id_type> >* dofs = nullptr;
+    PointData tmp_data;
+    std::vector<std::vector<libMesh::dof_id_type> > tmp_dofs;
+    
+    _point_data(p, local, data, dofs, tmp_data, tmp_dofs);
+    
+    const unsigned int
+    n_vars = _source.n_vars();
+    
+    g = RealMatrixX::Zero(n_vars, 3); // assume 3-dimensional by default
+    
+    for (unsigned int i=0; i<n_vars; i++) {
+        
+        const std::vector<libMesh::dof_id_type>& d = (*dofs)[i];
+        libmesh_assert_equal_to(d.size(), data->dphi.size());
+        
+        for (unsigned int j=0; j<d.size(); j++)
+            for (unsigned int k=0; k<3; k++)
+                g(i, k) += data->dphi[j](k) * local(d[j]);
+    }
+}
+
+
+
+void
+MAST::MeshFieldTransferMap::
+_shape_functions(const libMesh::Elem& e,
+                 const std::vector<libMesh::Point>& pts,
+                 std::vector<PointData*>& data) const {
+    
+    libmesh_assert_equal_to(pts.size(), data.size());
+    
+    // all variables are assumed to be of same type
+    const libMesh::FEType
+    fe_type = _source.variable_type(0);
+    
+    const unsigned int
+    dim = e.dim();
+    
+    std::vector<libMesh::Point> ref_pts;
+    libMesh::FEInterface::inverse_map(dim, fe_type, &e, pts, ref_pts);
+    
+    std::unique_ptr<libMesh::FEBase> fe(libMesh::FEBase::build(dim, fe_type).release());
+    
+    const std::vector<std::vector<Real> >&
+    phi  = fe->get_phi();
+    const std::vector<std::vector<libMesh::RealGradient> >&
+    dphi = fe->get_dphi();
+    
+    fe->reinit(&e, &ref_pts);
+    
+    for (unsigned int i=0; i<pts.size(); i++) {
+        
+        data[i]->phi.resize(phi.size());
+        data[i]->dphi.resize(phi.size());
+        
+        for (unsigned int j=0; j<phi.size(); j++) {
+            data[i]->phi[j]  = phi[j][i];
+            data[i]->dphi[j] = dphi[j][i];
+        }
+    }
+}
+
+
+
+void
+MAST::MeshFieldTransferMap::
+_elem_dofs(const libMesh::Elem& e,
+           std::vector<std::vector<libMesh::dof_id_type> >& dofs) const {
+    
+    const libMesh::DofMap& dof_map = _source.get_dof_map();
+    
+    dofs.resize(_source.n_vars());
+    for (unsigned int i=0; i<dofs.size(); i++)
+        dof_map.dof_indices(&e, dofs[i], i);
+}
+
+
+
+void
+MAST::MeshFieldTransferMap::
+_point_data(const libMesh::Point& p,
+            const libMesh::NumericVector<Real>& local,
+            const PointData*& data,
+            const std::vector<std::vector<libMesh::dof_id_type> >*& dofs,
+            PointData& tmp_data,
+            std::vector<std::vector<libMesh::dof_id_type> >& tmp_dofs) const {
+    
+    libmesh_assert(_initialized);
+    
+    std::map<libMesh::Point, PointData, PointLess>::const_iterator
+    it = _points.find(p);
+    
+    if (it != _points.end()) {
+        
+        data = &it->second;
+        dofs = &_dofs[it->second.elem];
+        return;
+    }
+    
+    // the point is not in the map. So, it is located in the source mesh,
+    // which is possible only if its dofs are available in the vector
+    const libMesh::Elem* e = (*_point_locator)(p);
+    
+    if (!e)
+        libmesh_error_msg("Point not found in source mesh: " << p);
+    
+    _elem_dofs(*e, tmp_dofs);
+    
+    if (local.type() != libMesh::SERIAL) {
+        
+        const libMesh::DofMap& dof_map = _source.get_dof_map();
+        
+        for (unsigned int i=0; i<tmp_dofs.size(); i++)
+            for (unsigned int j=0; j<tmp_dofs[i].size(); j++)
+                if ((tmp_dofs[i][j] < dof_map.first_dof() ||
+                     tmp_dofs[i][j] >= dof_map.end_dof()) &&
+                    !std::binary_search(_ghost_dofs.begin(),
+                                        _ghost_dofs.end(),
+                                        tmp_dofs[i][j]))
+                    libmesh_error_msg("Point not in transfer map and its source dofs are not available: "
+                                      << p);
+    }
+    
+    std::vector<libMesh::Point> pts(1, p);
+    std::vector<PointData*>     d(1, &tmp_data);
+    _shape_functions(*e, pts, d);
+    
+    data = &tmp_data;
+    dofs = &tmp_dofs;
+}
@@ -0,0 +1,253 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__mesh_field_transfer_map_h__
+#define __mast__mesh_field_transfer_map_h__
+
+// C++ includes
+#include <cmath>
+#include <map>
+#include <set>
+#include <vector>
+#include <memory>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+// libMesh includes
+#include "libmesh/system.h"
+#include "libmesh/numeric_vector.h"
+#include "libmesh/point_locator_base.h"
+
+
+namespace MAST {
+    
+    /*!
+     *    Precomputed map from a set of points, typically the quadrature
+     *    points of the elements of a target mesh, to the elements of the
+     *    mesh of a source system and the shape functions of these elements
+     *    at the points. The map is built once using \p init() and is then
+     *    used to interpolate any solution vector of the source system at
+     *    these points without a point-locator search. The solution vector
+     *    only needs the values of the source dofs that are used by the
+     *    mapped points, which are localized to a ghosted vector by
+     *    \p localize(). The map can be reused for as long as the two meshes
+     *    do not change, for example across Newton iterations, time steps
+     *    and frequencies.
+     */
+    class MeshFieldTransferMap {
+        
+    public:
+        
+        /*!
+         *   constructor for interpolation of the solutions of \p source.
+         *   Points within \p tol of each other are considered identical.
+         */
+        MeshFieldTransferMap(const libMesh::System& source,
+                             const Real tol = libMesh::TOLERANCE);
+        
+        virtual ~MeshFieldTransferMap();
+        
+        /*!
+         *   @returns the system whose solutions are interpolated
+         */
+        const libMesh::System& source_system() const { return _source; }
+        
+        /*!
+         *   adds the points in \p pts to the map. This should be called
+         *   before \p init().
+         */
+        void add_points(const std::vector<libMesh::Point>& pts);
+        
+        /*!
+         *   adds the quadrature points of the active local elements of
+         *   \p target to the map, and the quadrature points of the element
+         *   sides if \p if_sides is true. The quadrature rules are the
+         *   same as those created by MAST::FEBase, where \p q_order is the
+         *   sum of the extra quadrature order of the target system and of
+         *   the element. This should be called before \p init().
+         */
+        void add_quadrature_points(const libMesh::System& target,
+                                   const int q_order,
+                                   const bool if_sides);
+        
+        /*!
+         *   adds the quadrature points of the sides of the active local
+         *   elements of \p target that lie on the boundaries in \p bids.
+         *   This is used when the source solution is needed only on a
+         *   boundary of the target mesh, for example on the fluid-structure
+         *   interface. \p q_order is defined as in
+         *   \p add_quadrature_points(). This should be called before
+         *   \p init().
+         */
+        void add_side_quadrature_points(const libMesh::System& target,
+                                        const int q_order,
+                                        const std::set<libMesh::boundary_id_type>& bids);
+        
+        /*!
+         *   locates the points added to the map in the source mesh and
+         *   computes the source element shape functions at these points.
+         */
+        void init();
+        
+        /*!
+         *   @returns true if \p init() has been called.
+         */
+        bool initialized() const { return _initialized; }
+        
+        /*!
+         *   clears the map and the points added to it
+         */
+        void clear();
+        
+        /*!
+         *   @returns the number of points in the map
+         */
+        unsigned int n_points() const { return (unsigned int)_points.size(); }
+        
+        /*!
+         *   @returns the non-local source dofs needed to interpolate at
+         *   the mapped points.
+         */
+        const std::vector<libMesh::dof_id_type>& ghost_dofs() const {
+            return _ghost_dofs;
+        }
+        
+        /*!
+         *   localizes \p global to \p local, which has values for the
+         *   local dofs and the dofs in \p ghost_dofs(). \p local is
+         *   created if it is null, and is reused otherwise.
+         */
+        void localize(const libMesh::NumericVector<Real>& global,
+                      std::unique_ptr<libMesh::NumericVector<Real> >& local) const;
+        
+        /*!
+         *   interpolates the solution \p local, localized using
+         *   \p localize(), at \p p and returns the value of each variable
+         *   in \p v. Points that are not in the map are located in the
+         *   source mesh, which requires that their source dofs be
+         *   available in \p local.
+         */
+        void interpolate(const libMesh::NumericVector<Real>& local,
+                         const libMesh::Point& p,
+                         RealVectorX& v) const;
+        
+        /*!
+         *   interpolates the gradient of solution \p local at \p p, with
+         *   \f$ g(i,j) = dv(i)/dx(j) \f$.
+         */
+        void interpolate_gradient(const libMesh::NumericVector<Real>& local,
+                                  const libMesh::Point& p,
+                                  RealMatrixX& g) const;
+        
+    protected:
+        
+        /*!
+         *   lexicographic ordering of points with a tolerance on each
+         *   coordinate
+         */
+        class PointLess {
+        public:
+            PointLess(const Real tol): _tol(tol) {}
+            bool operator() (const libMesh::Point& a,
+                             const libMesh::Point& b) const {
+                for (unsigned int i=0; i<3; i++)
+                    if (std::abs(a(i)-b(i)) > _tol)
+                        return a(i) < b(i);
+                return false;
+            }
+        protected:
+            Real _tol;
+        };
+        
+        /*!
+         *   source element and shape functions for a point
+         */
+        struct PointData {
+            
+            PointData(): elem(0) {}
+            
+            unsigned int                       elem;
+            std::vector<Real>                  phi;
+            std::vector<libMesh::RealGradient> dphi;
+        };
+        
+        /*!
+         *   computes the shape functions of source element \p e at the
+         *   physical points \p pts in \p data
+         */
+        void _shape_functions(const libMesh::Elem& e,
+                              const std::vector<libMesh::Point>& pts,
+                              std::vector<PointData*>& data) const;
+        
+        /*!
+         *   provides in \p dofs the dofs of source element \p e for each
+         *   variable
+         */
+        void _elem_dofs(const libMesh::Elem& e,
+                        std::vector<std::vector<libMesh::dof_id_type> >& dofs) const;
+        
+        /*!
+         *   provides in \p data and \p dofs the data for point \p p. If
+         *   \p p is not in the map, it is located in the source mesh and
+         *   its data is computed in \p tmp_data and \p tmp_dofs.
+         */
+        void _point_data(const libMesh::Point& p,
+                         const libMesh::NumericVector<Real>& local,
+                         const PointData*& data,
+                         const std::vector<std::vector<libMesh::dof_id_type> >*& dofs,
+                         PointData& tmp_data,
+                         std::vector<std::vector<libMesh::dof_id_type> >& tmp_dofs) const;
+        
+        /*!
+         *   source system
+         */
+        const libMesh::System& _source;
+        
+        /*!
+         *   flag is set to true after \p init()
+         */
+        bool _initialized;
+        
+        /*!
+         *   map of points to their data
+         */
+        std::map<libMesh::Point, PointData, PointLess> _points;
+        
+        /*!
+         *   dofs of each variable of the source elements used by the
+         *   mapped points. \p PointData::elem is the index in this vector.
+         */
+        std::vector<std::vector<std::vector<libMesh::dof_id_type> > > _dofs;
+        
+        /*!
+         *   sorted non-local dofs used by the mapped points
+         */
+        std::vector<libMesh::dof_id_type> _ghost_dofs;
+        
+        /*!
+         *   point locator for points that are not in the map
+         */
+        std::unique_ptr<libMesh::PointLocatorBase> _point_locator;
+    };
+}
+
+
+#endif // __mast__mesh_field_transfer_map_h__
@@ -24,6 +24,10 @@
 #include "base/mesh_field_function.h"
 #include "base/nonlinear_system.h"
 #include "base/nonlinear_implicit_assembly_elem_operations.h"
+#include "base/output_assembly_elem_operations.h"
+#include "base/parameter.h"
+#include "base/boundary_condition_base.h"
+#include "property_cards/element_property_card_base.h"
 #include "boundary_condition/point_load_condition.h"
 #include "numerics/utility.h"
 #include "mesh/geom_elem.h"
@@ -33,6 +37,8 @@
 #include "libmesh/numeric_vector.h"
 #include "libmesh/sparse_matrix.h"
 #include "libmesh/dof_map.h"
+#include "libmesh/threads.h"
+#include "libmesh/elem.h"
 
 
 
@@ -40,7 +46,11 @@ MAST::NonlinearImplicitAssembly::
 NonlinearImplicitAssembly():MAST::AssemblyBase(),
 _post_assembly           (nullptr),
 _res_l2_norm             (0.),
-_first_iter_res_l2_norm  (-1.) {
+_first_iter_res_l2_norm  (-1.),
+_if_elem_matrix_cache    (false),
+_elem_matrix_cache_ops   (nullptr),
+_elem_matrix_cache_max_elem_id (0),
+_elem_matrix_cache_n_dofs      (0) {
     
 }
 
@@ -61,6 +71,138 @@ set_post_assembly_operation(MAST::NonlinearImplicitAssembly::PostAssemblyOperati
 
 
 
+void
+MAST::NonlinearImplicitAssembly::clear_discipline_and_system() {
+    
+    // the cached quantities belong to the mesh and discipline of the
+    // system being cleared
+    this->clear_element_matrix_cache();
+    _elem_matrix_cache_params.clear();
+    
+    MAST::AssemblyBase::clear_discipline_and_system();
+}
+
+
+
+void
+MAST::NonlinearImplicitAssembly::set_element_matrix_cache(bool f) {
+    
+    _if_elem_matrix_cache = f;
+    this->clear_element_matrix_cache();
+}
+
+
+
+void
+MAST::NonlinearImplicitAssembly::
+add_element_matrix_cache_parameter(const MAST::Parameter& p) {
+    
+    _elem_matrix_cache_params[&p] = p();
+}
+
+
+
+void
+MAST::NonlinearImplicitAssembly::clear_element_matrix_cache() {
+    
+    _elem_matrix_cache.clear();
+    _elem_matrix_cache_ops         = nullptr;
+    _elem_matrix_cache_max_elem_id = 0;
+    _elem_matrix_cache_n_dofs      = 0;
+}
+
+
+
+void
+MAST::NonlinearImplicitAssembly::_update_element_matrix_cache() {
+    
+    libmesh_assert(_system);
+    libmesh_assert(_discipline);
+    
+    const libMesh::MeshBase& mesh = _system->system().get_mesh();
+    
+    const libMesh::dof_id_type
+    max_elem_id = mesh.max_elem_id(),
+    n_dofs      = _system->system().n_dofs();
+    
+    // quantities computed with a different element operation object, or
+    // before the mesh or the dofs changed, are not valid
+    if (_elem_matrix_cache_ops != _elem_ops             ||
+        _elem_matrix_cache_max_elem_id != max_elem_id   ||
+        _elem_matrix_cache_n_dofs      != n_dofs) {
+        
+        _elem_matrix_cache.clear();
+        _elem_matrix_cache_ops         = _elem_ops;
+        _elem_matrix_cache_max_elem_id = max_elem_id;
+        _elem_matrix_cache_n_dofs      = n_dofs;
+    }
+    
+    // the cache is only valid for a residual that is linear in the
+    // solution, which is checked each time the cache is rebuilt
+    if (_elem_matrix_cache.empty()) {
+        
+        libMesh::MeshBase::const_element_iterator
+        el      = mesh.active_local_elements_begin();
+        const libMesh::MeshBase::const_element_iterator
+        end_el  = mesh.active_local_elements_end();
+        
+        for ( ; el != end_el; ++el)
+            if (_discipline->get_property_card(**el).strain_type() != MAST::LINEAR_STRAIN)
+                libmesh_error_msg("Element matrix cache requires MAST::LINEAR_STRAIN for all elements.");
+    }
+    
+    _elem_matrix_cache.resize(max_elem_id);
+    
+    std::map<const MAST::Parameter*, Real>::iterator
+    p_it    = _elem_matrix_cache_params.begin(),
+    p_end   = _elem_matrix_cache_params.end();
+    
+    for ( ; p_it != p_end; p_it++) {
+        
+        const MAST::Parameter& p = *p_it->first;
+        
+        if (p() == p_it->second)
+            continue;
+        
+        p_it->second = p();
+        
+        // if any load depends on the parameter, then the residual of all
+        // elements may have changed
+        bool
+        load_dependence = false;
+        
+        MAST::VolumeBCMapType::const_iterator
+        v_it    = _discipline->volume_loads().begin(),
+        v_end   = _discipline->volume_loads().end();
+        for ( ; v_it != v_end && !load_dependence; v_it++)
+            load_dependence = v_it->second->depends_on(p);
+        
+        MAST::SideBCMapType::const_iterator
+        s_it    = _discipline->side_loads().begin(),
+        s_end   = _discipline->side_loads().end();
+        for ( ; s_it != s_end && !load_dependence; s_it++)
+            load_dependence = s_it->second->depends_on(p);
+        
+        if (load_dependence) {
+            
+            for (unsigned int i=0; i<_elem_matrix_cache.size(); i++)
+                _elem_matrix_cache[i].valid = false;
+            continue;
+        }
+        
+        libMesh::MeshBase::const_element_iterator
+        el      = mesh.active_local_elements_begin();
+        const libMesh::MeshBase::const_element_iterator
+        end_el  = mesh.active_local_elements_end();
+        
+        for ( ; el != end_el; ++el)
+            if (_discipline->get_property_card(**el).depends_on(p))
+                _elem_matrix_cache[(*el)->id()].valid = false;
+    }
+}
+
+
+
 void
 MAST::NonlinearImplicitAssembly::
 residual_and_jacobian (const libMesh::NumericVector<Real>& X,
@@ -81,92 +223,134 @@ residual_and_jacobian (const libMesh::NumericVector<Real>& X,
     if (R) R->zero();
     if (J) J->zero();
     
-    // iterate over each element, initialize it and get the relevant
-    // analysis quantities
-    RealVectorX vec, sol;
-    RealMatrixX mat;
+    RealVectorX vec;
     
     std::vector<libMesh::dof_id_type> dof_indices;
     const libMesh::DofMap& dof_map = _system->system().get_dof_map();
     
     
-    std::unique_ptr<libMesh::NumericVector<Real> > localized_solution;
-    localized_solution.reset(build_localized_vector(nonlin_sys,
-                                                     X).release());
+    const libMesh::NumericVector<Real>&
+    localized_solution = localized_work_vector(X);
     
     
     // if a solution function is attached, initialize it
     if (_sol_function)
         _sol_function->init( X);
     
+    if (_if_elem_matrix_cache)
+        _update_element_matrix_cache();
     
-    libMesh::MeshBase::const_element_iterator       el     =
-    nonlin_sys.get_mesh().active_local_elements_begin();
-    const libMesh::MeshBase::const_element_iterator end_el =
-    nonlin_sys.get_mesh().active_local_elements_end();
     
-    MAST::NonlinearImplicitAssemblyElemOperations&
-    ops = dynamic_cast<MAST::NonlinearImplicitAssemblyElemOperations&>(*_elem_ops);
-
-    for ( ; el != end_el; ++el) {
-        
-        const libMesh::Elem* elem = *el;
-        
-        dof_map.dof_indices (elem, dof_indices);
-        
-        MAST::GeomElem geom_elem;
-        ops.set_elem_data(elem->dim(), *elem, geom_elem);
-        geom_elem.init(*elem, *_system);
-        
-        ops.init(geom_elem);
-
-        // get the solution
-        unsigned int ndofs = (unsigned int)dof_indices.size();
-        sol.setZero(ndofs);
-        vec.setZero(ndofs);
-        mat.setZero(ndofs, ndofs);
-        
-        for (unsigned int i=0; i<dof_indices.size(); i++)
-            sol(i) = (*localized_solution)(dof_indices[i]);
-        
-        ops.set_elem_solution(sol);
-        
-        
-//        if (_sol_function)
-//            physics_elem->attach_active_solution_function(*_sol_function);
-        
-        //_check_element_numerical_jacobian(*physics_elem, sol);
-        
-        // perform the element level calculations
-        ops.elem_calculations(J!=nullptr?true:false,
-                                              vec, mat);
-        
-//        physics_elem->detach_active_solution_function();
-
-        ops.clear_elem();
+    // iterate over each element, initialize it and get the relevant
+    // analysis quantities
+    class ResidualAndJacobianKernel:
+    public MAST::AssemblyBase::ElemKernel {
+    public:
+        ResidualAndJacobianKernel(const MAST::SystemInitialization& sys,
+                                  const libMesh::NumericVector<Real>& sol,
+                                  libMesh::NumericVector<Real>* R,
+                                  libMesh::SparseMatrix<Real>*  J,
+                                  std::vector<MAST::NonlinearImplicitAssembly::ElemMatrixCacheEntry>* cache):
+        _sys  (sys),
+        _sol  (sol),
+        _R    (R),
+        _J    (J),
+        _cache(cache) { }
         
-        // copy to the libMesh matrix for further processing
-        DenseRealVector v;
-        DenseRealMatrix m;
-        if (R)
-            MAST::copy(v, vec);
-        if (J)
-            MAST::copy(m, mat);
-
-        // constrain the quantities to account for hanging dofs,
-        // Dirichlet constraints, etc.
-        if (R && J)
-            dof_map.constrain_element_matrix_and_vector(m, v, dof_indices);
-        else if (R)
-            dof_map.constrain_element_vector(v, dof_indices);
-        else
-            dof_map.constrain_element_matrix(m, dof_indices);
+        virtual void operator() (MAST::AssemblyElemOperations& o,
+                                 const libMesh::Elem& elem) {
+            
+            MAST::NonlinearImplicitAssemblyElemOperations&
+            ops = dynamic_cast<MAST::NonlinearImplicitAssemblyElemOperations&>(o);
+            
+            const libMesh::DofMap& dof_map = _sys.system().get_dof_map();
+            std::vector<libMesh::dof_id_type> dof_indices;
+            dof_map.dof_indices (&elem, dof_indices);
+            
+            // get the solution
+            unsigned int ndofs = (unsigned int)dof_indices.size();
+            RealVectorX
+            sol = RealVectorX::Zero(ndofs),
+            vec = RealVectorX::Zero(ndofs);
+            RealMatrixX
+            mat = RealMatrixX::Zero(ndofs, ndofs);
+            
+            for (unsigned int i=0; i<dof_indices.size(); i++)
+                sol(i) = _sol(dof_indices[i]);
+            
+            // each element writes only to its own entry of the cache, so
+            // no lock is needed
+            MAST::NonlinearImplicitAssembly::ElemMatrixCacheEntry*
+            entry = _cache?&(*_cache)[elem.id()]:nullptr;
+            
+            if (entry && entry->valid && (unsigned int)entry->jac.rows() == ndofs) {
+                
+                mat = entry->jac;
+                vec = entry->res0;
+                vec.noalias() += mat * sol;
+            }
+            else {
+                
+                MAST::GeomElem geom_elem;
+                ops.set_elem_data(elem.dim(), elem, geom_elem);
+                geom_elem.init(elem, _sys);
+                
+                ops.init(geom_elem);
+                ops.set_elem_solution(sol);
+                
+                // perform the element level calculations. The Jacobian is
+                // always needed for the cache.
+                ops.elem_calculations((_J!=nullptr || entry)?true:false,
+                                      vec, mat);
+                
+                ops.clear_elem();
+                
+                if (entry) {
+                    
+                    entry->jac   = mat;
+                    entry->res0  = vec;
+                    entry->res0.noalias() -= mat * sol;
+                    entry->valid = true;
+                }
+            }
+            
+            // copy to the libMesh matrix for further processing
+            DenseRealVector v;
+            DenseRealMatrix m;
+            if (_R)
+                MAST::copy(v, vec);
+            if (_J)
+                MAST::copy(m, mat);
+            
+            // constrain the quantities to account for hanging dofs,
+            // Dirichlet constraints, etc.
+            if (_R && _J)
+                dof_map.constrain_element_matrix_and_vector(m, v, dof_indices);
+            else if (_R)
+                dof_map.constrain_element_vector(v, dof_indices);
+            else
+                dof_map.constrain_element_matrix(m, dof_indices);
+            
+            // add to the global matrices. The global objects are shared
+            // among threads
+            libMesh::Threads::spin_mutex::scoped_lock
+            lock(libMesh::Threads::spin_mtx);
+            
+            if (_R) _R->add_vector(v, dof_indices);
+            if (_J) _J->add_matrix(m, dof_indices);
+        }
         
-        // add to the global matrices
-        if (R) R->add_vector(v, dof_indices);
-        if (J) J->add_matrix(m, dof_indices);
-        dof_indices.clear();
-    }
+    protected:
+        const MAST::SystemInitialization&   _sys;
+        const libMesh::NumericVector<Real>& _sol;
+        libMesh::NumericVector<Real>*       _R;
+        libMesh::SparseMatrix<Real>*        _J;
+        std::vector<MAST::NonlinearImplicitAssembly::ElemMatrixCacheEntry>* _cache;
+    };
+    
+    ResidualAndJacobianKernel kernel(*_system, localized_solution, R, J,
+                                     _if_elem_matrix_cache?&_elem_matrix_cache:nullptr);
+    _elem_loop(*_elem_ops, kernel);
 
     
     // add the point loads if any in the discipline
@@ -271,95 +455,201 @@ linearized_jacobian_solution_product (const libMesh::NumericVector<Real>& X,
     // and the system passed through the function call are the same
     libmesh_assert_equal_to(&S, &(nonlin_sys));
     
+    const libMesh::NumericVector<Real>
+    &localized_solution           = localized_work_vector(X,  0),
+    &localized_perturbed_solution = localized_work_vector(dX, 1);
+    
+    
+    // if a solution function is attached, initialize it
+    if (_sol_function)
+        _sol_function->init( X);
+    
+    
     // iterate over each element, initialize it and get the relevant
     // analysis quantities
-    RealVectorX vec, sol, dsol;
-    RealMatrixX mat;
+    class JacobianSolutionProductKernel:
+    public MAST::AssemblyBase::ElemKernel {
+    public:
+        JacobianSolutionProductKernel(const MAST::SystemInitialization& sys,
+                                      const libMesh::NumericVector<Real>& sol,
+                                      const libMesh::NumericVector<Real>& dsol,
+                                      libMesh::NumericVector<Real>& JdX):
+        _sys  (sys),
+        _sol  (sol),
+        _dsol (dsol),
+        _JdX  (JdX) { }
+        
+        virtual void operator() (MAST::AssemblyElemOperations& o,
+                                 const libMesh::Elem& elem) {
+            
+            MAST::NonlinearImplicitAssemblyElemOperations&
+            ops = dynamic_cast<MAST::NonlinearImplicitAssemblyElemOperations&>(o);
+            
+            const libMesh::DofMap& dof_map = _sys.system().get_dof_map();
+            std::vector<libMesh::dof_id_type> dof_indices;
+            dof_map.dof_indices (&elem, dof_indices);
+            
+            MAST::GeomElem geom_elem;
+            ops.set_elem_data(elem.dim(), elem, geom_elem);
+            geom_elem.init(elem, _sys);
+            
+            ops.init(geom_elem);
+            
+            // get the solution
+            unsigned int ndofs = (unsigned int)dof_indices.size();
+            RealVectorX
+            sol  = RealVectorX::Zero(ndofs),
+            dsol = RealVectorX::Zero(ndofs),
+            vec  = RealVectorX::Zero(ndofs);
+            
+            for (unsigned int i=0; i<dof_indices.size(); i++) {
+                sol (i) = _sol (dof_indices[i]);
+                dsol(i) = _dsol(dof_indices[i]);
+            }
+            
+            ops.set_elem_solution(sol);
+            ops.set_elem_perturbed_solution(dsol);
+            
+            // perform the element level calculations
+            ops.elem_linearized_jacobian_solution_product(vec);
+            
+            ops.clear_elem();
+            
+            // copy to the libMesh matrix for further processing
+            DenseRealVector v;
+            MAST::copy(v, vec);
+            
+            // constrain the quantities to account for hanging dofs,
+            // Dirichlet constraints, etc.
+            dof_map.constrain_element_vector(v, dof_indices);
+            
+            // add to the global vector, which is shared among threads
+            libMesh::Threads::spin_mutex::scoped_lock
+            lock(libMesh::Threads::spin_mtx);
+            
+            _JdX.add_vector(v, dof_indices);
+        }
+        
+    protected:
+        const MAST::SystemInitialization&   _sys;
+        const libMesh::NumericVector<Real>& _sol;
+        const libMesh::NumericVector<Real>& _dsol;
+        libMesh::NumericVector<Real>&       _JdX;
+    };
     
-    std::vector<libMesh::dof_id_type> dof_indices;
-    const libMesh::DofMap& dof_map = _system->system().get_dof_map();
+    JacobianSolutionProductKernel
+    kernel(*_system, localized_solution, localized_perturbed_solution, JdX);
+    _elem_loop(*_elem_ops, kernel);
+    
+    
+    // if a solution function is attached, clear it
+    if (_sol_function)
+        _sol_function->clear();
+    
+    JdX.close();
+}
+
+
+
+void
+MAST::NonlinearImplicitAssembly::
+jacobian_diagonal (const libMesh::NumericVector<Real>& X,
+                   libMesh::NumericVector<Real>& diag,
+                   libMesh::NonlinearImplicitSystem& S) {
     
+    libmesh_assert(_system);
+    libmesh_assert(_discipline);
+    libmesh_assert(_elem_ops);
     
-    std::unique_ptr<libMesh::NumericVector<Real> >
-    localized_solution,
-    localized_perturbed_solution;
+    diag.zero();
     
-    localized_solution.reset(build_localized_vector(nonlin_sys,
-                                                     X).release());
-    localized_perturbed_solution.reset(build_localized_vector(nonlin_sys,
-                                                               dX).release());
+    MAST::NonlinearSystem& nonlin_sys = _system->system();
     
+    // make sure that the system for which this object was created,
+    // and the system passed through the function call are the same
+    libmesh_assert_equal_to(&S, &(nonlin_sys));
+    
+    const libMesh::NumericVector<Real>&
+    localized_solution = localized_work_vector(X);
     
     // if a solution function is attached, initialize it
     if (_sol_function)
         _sol_function->init( X);
     
     
-    libMesh::MeshBase::const_element_iterator       el     =
-    nonlin_sys.get_mesh().active_local_elements_begin();
-    const libMesh::MeshBase::const_element_iterator end_el =
-    nonlin_sys.get_mesh().active_local_elements_end();
-    
-    MAST::NonlinearImplicitAssemblyElemOperations&
-    ops = dynamic_cast<MAST::NonlinearImplicitAssemblyElemOperations&>(*_elem_ops);
-
-    for ( ; el != end_el; ++el) {
-        
-        const libMesh::Elem* elem = *el;
-        
-        dof_map.dof_indices (elem, dof_indices);
-        
-        MAST::GeomElem geom_elem;
-        ops.set_elem_data(elem->dim(), *elem, geom_elem);
-        geom_elem.init(*elem, *_system);
-        
-        ops.init(geom_elem);
-
-        // get the solution
-        unsigned int ndofs = (unsigned int)dof_indices.size();
-        sol.setZero(ndofs);
-        dsol.setZero(ndofs);
-        vec.setZero(ndofs);
-        mat.setZero(ndofs, ndofs);
+    // iterate over each element and add the diagonal of the element
+    // Jacobian
+    class JacobianDiagonalKernel:
+    public MAST::AssemblyBase::ElemKernel {
+    public:
+        JacobianDiagonalKernel(const MAST::SystemInitialization& sys,
+                               const libMesh::NumericVector<Real>& sol,
+                               libMesh::NumericVector<Real>& diag):
+        _sys  (sys),
+        _sol  (sol),
+        _diag (diag) { }
         
-        for (unsigned int i=0; i<dof_indices.size(); i++) {
-            sol (i) = (*localized_solution)          (dof_indices[i]);
-            dsol(i) = (*localized_perturbed_solution)(dof_indices[i]);
+        virtual void operator() (MAST::AssemblyElemOperations& o,
+                                 const libMesh::Elem& elem) {
+            
+            MAST::NonlinearImplicitAssemblyElemOperations&
+            ops = dynamic_cast<MAST::NonlinearImplicitAssemblyElemOperations&>(o);
+            
+            const libMesh::DofMap& dof_map = _sys.system().get_dof_map();
+            std::vector<libMesh::dof_id_type> dof_indices;
+            dof_map.dof_indices (&elem, dof_indices);
+            
+            MAST::GeomElem geom_elem;
+            ops.set_elem_data(elem.dim(), elem, geom_elem);
+            geom_elem.init(elem, _sys);
+            
+            ops.init(geom_elem);
+            
+            // get the solution
+            unsigned int ndofs = (unsigned int)dof_indices.size();
+            RealVectorX
+            sol = RealVectorX::Zero(ndofs),
+            vec = RealVectorX::Zero(ndofs);
+            RealMatrixX
+            mat = RealMatrixX::Zero(ndofs, ndofs);
+            
+            for (unsigned int i=0; i<dof_indices.size(); i++)
+                sol(i) = _sol(dof_indices[i]);
+            
+            ops.set_elem_solution(sol);
+            ops.elem_calculations(true, vec, mat);
+            ops.clear_elem();
+            
+            DenseRealMatrix m;
+            MAST::copy(m, mat);
+            dof_map.constrain_element_matrix(m, dof_indices);
+            
+            // the constraint may add dofs to the element
+            DenseRealVector v(dof_indices.size());
+            for (unsigned int i=0; i<dof_indices.size(); i++)
+                v(i) = m(i, i);
+            
+            // add to the global vector, which is shared among threads
+            libMesh::Threads::spin_mutex::scoped_lock
+            lock(libMesh::Threads::spin_mtx);
+            
+            _diag.add_vector(v, dof_indices);
         }
         
-        ops.set_elem_solution(sol);
-        ops.set_elem_perturbed_solution(dsol);
-        
-//        if (_sol_function)
-//            physics_elem->attach_active_solution_function(*_sol_function);
-        
-        //_check_element_numerical_jacobian(*physics_elem, sol);
-        
-        // perform the element level calculations
-        ops.elem_linearized_jacobian_solution_product(vec);
-        
-        //physics_elem->detach_active_solution_function();
-        ops.clear_elem();
-
-        // copy to the libMesh matrix for further processing
-        DenseRealVector v;
-        MAST::copy(v, vec);
-        
-        // constrain the quantities to account for hanging dofs,
-        // Dirichlet constraints, etc.
-        dof_map.constrain_element_vector(v, dof_indices);
-        
-        // add to the global matrices
-        JdX.add_vector(v, dof_indices);
-        dof_indices.clear();
-    }
+    protected:
+        const MAST::SystemInitialization&   _sys;
+        const libMesh::NumericVector<Real>& _sol;
+        libMesh::NumericVector<Real>&       _diag;
+    };
     
+    JacobianDiagonalKernel kernel(*_system, localized_solution, diag);
+    _elem_loop(*_elem_ops, kernel);
     
     // if a solution function is attached, clear it
     if (_sol_function)
         _sol_function->clear();
     
-    JdX.close();
+    diag.close();
 }
 
 
@@ -393,14 +683,9 @@ second_derivative_dot_solution_assembly (const libMesh::NumericVector<Real>& X,
     const libMesh::DofMap& dof_map = _system->system().get_dof_map();
     
     
-    std::unique_ptr<libMesh::NumericVector<Real> >
-    localized_solution,
-    localized_perturbed_solution;
-    
-    localized_solution.reset(build_localized_vector(nonlin_sys,
-                                                     X).release());
-    localized_perturbed_solution.reset(build_localized_vector(nonlin_sys,
-                                                               dX).release());
+    const libMesh::NumericVector<Real>
+    &localized_solution           = localized_work_vector(X,  0),
+    &localized_perturbed_solution = localized_work_vector(dX, 1);
     
     
     // if a solution function is attached, initialize it
@@ -435,8 +720,8 @@ second_derivative_dot_solution_assembly (const libMesh::NumericVector<Real>& X,
         mat.setZero(ndofs, ndofs);
         
         for (unsigned int i=0; i<dof_indices.size(); i++) {
-            sol (i) = (*localized_solution)          (dof_indices[i]);
-            dsol(i) = (*localized_perturbed_solution)(dof_indices[i]);
+            sol (i) = localized_solution          (dof_indices[i]);
+            dsol(i) = localized_perturbed_solution(dof_indices[i]);
         }
         
         ops.set_elem_solution(sol);
@@ -496,9 +781,8 @@ sensitivity_assemble (const MAST::FunctionBase& f,
     const libMesh::DofMap& dof_map = nonlin_sys.get_dof_map();
     
     
-    std::unique_ptr<libMesh::NumericVector<Real> > localized_solution;
-    localized_solution.reset(build_localized_vector(nonlin_sys,
-                                                     *nonlin_sys.solution).release());
+    const libMesh::NumericVector<Real>&
+    localized_solution = localized_work_vector(*nonlin_sys.solution);
     
     // if a solution function is attached, initialize it
     if (_sol_function)
@@ -536,7 +820,7 @@ sensitivity_assemble (const MAST::FunctionBase& f,
         vec.setZero(ndofs);
         
         for (unsigned int i=0; i<dof_indices.size(); i++)
-            sol(i) = (*localized_solution)(dof_indices[i]);
+            sol(i) = localized_solution(dof_indices[i]);
         
         ops.set_elem_solution(sol);
         
@@ -629,3 +913,174 @@ sensitivity_assemble (const MAST::FunctionBase& f,
 }
 
 
+
+
+
+void
+MAST::NonlinearImplicitAssembly::
+calculate_output_adjoint_sensitivities(const libMesh::NumericVector<Real>& X,
+                                       const libMesh::NumericVector<Real>& dq_dX,
+                                       MAST::NonlinearImplicitAssembly::ElemParameters& params,
+                                       MAST::AssemblyElemOperations&       elem_ops,
+                                       MAST::OutputAssemblyElemOperations& output,
+                                       std::vector<Real>& dq_dp,
+                                       const bool include_partial_sens) {
+    
+    this->set_elem_operation_object(elem_ops);
+    this->_elem_parameter_sensitivities(X,
+                                        &dq_dX,
+                                        params,
+                                        include_partial_sens?&output:nullptr,
+                                        dq_dp);
+    this->clear_elem_operation_object();
+}
+
+
+
+void
+MAST::NonlinearImplicitAssembly::
+calculate_output_partial_sensitivities(const libMesh::NumericVector<Real>& X,
+                                       MAST::NonlinearImplicitAssembly::ElemParameters& params,
+                                       MAST::OutputAssemblyElemOperations& output,
+                                       std::vector<Real>& dq_dp) {
+    
+    this->_elem_parameter_sensitivities(X, nullptr, params, &output, dq_dp);
+}
+
+
+
+void
+MAST::NonlinearImplicitAssembly::
+_elem_parameter_sensitivities(const libMesh::NumericVector<Real>& X,
+                              const libMesh::NumericVector<Real>* dq_dX,
+                              MAST::NonlinearImplicitAssembly::ElemParameters& params,
+                              MAST::OutputAssemblyElemOperations* output,
+                              std::vector<Real>& dq_dp) {
+    
+    libmesh_assert(_system);
+    libmesh_assert(_discipline);
+    libmesh_assert(!dq_dX || _elem_ops);
+    
+    MAST::NonlinearSystem& nonlin_sys = _system->system();
+    
+    dq_dp.assign(params.n_parameters(), 0.);
+    
+    if (output) {
+        
+        output->zero_for_sensitivity();
+        output->set_assembly(*this);
+    }
+    
+    RealVectorX
+    vec,
+    sol,
+    dsol;
+    
+    std::vector<libMesh::dof_id_type>
+    dof_indices,
+    constrained_dof_indices;
+    std::vector<unsigned int> p_ids;
+    const libMesh::DofMap& dof_map = nonlin_sys.get_dof_map();
+    
+    const libMesh::NumericVector<Real>
+    &localized_solution = localized_work_vector(X, 0),
+    *localized_adjoint  = dq_dX?&localized_work_vector(*dq_dX, 1):nullptr;
+    
+    // if a solution function is attached, initialize it
+    if (_sol_function)
+        _sol_function->init(X);
+    
+    MAST::NonlinearImplicitAssemblyElemOperations*
+    ops = dq_dX?dynamic_cast<MAST::NonlinearImplicitAssemblyElemOperations*>(_elem_ops):nullptr;
+    
+    libMesh::MeshBase::const_element_iterator       el     =
+    nonlin_sys.get_mesh().active_local_elements_begin();
+    const libMesh::MeshBase::const_element_iterator end_el =
+    nonlin_sys.get_mesh().active_local_elements_end();
+    
+    for ( ; el != end_el; ++el) {
+        
+        const libMesh::Elem* elem = *el;
+        
+        params.elem_parameters(*elem, p_ids);
+        
+        // no sensitivity computation is needed in this case
+        if (p_ids.empty())
+            continue;
+        
+        dof_map.dof_indices (elem, dof_indices);
+        
+        // get the solution
+        unsigned int ndofs = (unsigned int)dof_indices.size();
+        sol.setZero(ndofs);
+        dsol.setZero(ndofs);
+        
+        for (unsigned int i=0; i<dof_indices.size(); i++)
+            sol(i) = localized_solution(dof_indices[i]);
+        
+        // the element is initialized once and then used for all
+        // parameters that influence it
+        MAST::GeomElem geom_elem;
+        if (ops)
+            ops->set_elem_data(elem->dim(), *elem, geom_elem);
+        else
+            output->set_elem_data(elem->dim(), *elem, geom_elem);
+        geom_elem.init(*elem, *_system);
+        
+        if (ops) {
+            
+            ops->init(geom_elem);
+            ops->set_elem_solution(sol);
+        }
+        
+        if (output) {
+            
+            output->init(geom_elem);
+            output->set_elem_solution(sol);
+            output->set_elem_solution_sensitivity(dsol);
+        }
+        
+        for (unsigned int j=0; j<p_ids.size(); j++) {
+            
+            const unsigned int p = p_ids[j];
+            
+            const MAST::FunctionBase& f = params.activate(*elem, p);
+            
+            if (ops) {
+                
+                vec.setZero(ndofs);
+                ops->elem_sensitivity_calculations(f, vec);
+                
+                // constrain the quantities to account for hanging dofs,
+                // Dirichlet constraints, etc.
+                DenseRealVector v;
+                MAST::copy(v, vec);
+                constrained_dof_indices = dof_indices;
+                dof_map.constrain_element_vector(v, constrained_dof_indices);
+                
+                for (unsigned int i=0; i<constrained_dof_indices.size(); i++)
+                    dq_dp[p] += (*localized_adjoint)(constrained_dof_indices[i]) * v(i);
+            }
+            
+            if (output) {
+                
+                output->evaluate_sensitivity(f);
+                dq_dp[p] += output->output_sensitivity_for_elem(f);
+            }
+        }
+        
+        if (ops)    ops->clear_elem();
+        if (output) output->clear_elem();
+    }
+    
+    // if a solution function is attached, clear it
+    if (_sol_function)
+        _sol_function->clear();
+    
+    if (output)
+        output->clear_assembly();
+    
+    // sum over all processors since part of the mesh can live on different
+    // processors
+    nonlin_sys.comm().sum(dq_dp);
+}
@@ -20,6 +20,10 @@
 #ifndef __mast__nonlinear_implicit_assembly__
 #define __mast__nonlinear_implicit_assembly__
 
+// C++ includes
+#include <map>
+#include <vector>
+
 // MAST includes
 #include "base/assembly_base.h"
 
@@ -31,6 +35,7 @@ namespace MAST {
     
     // Forward declerations
     class NonlinearImplicitAssemblyElemOperations;
+    class Parameter;
     
     
     class NonlinearImplicitAssembly:
@@ -53,6 +58,44 @@ namespace MAST {
                                        libMesh::SparseMatrix<Real>*  J,
                                        libMesh::NonlinearImplicitSystem& S) = 0;
         };
+        
+        
+        /*!
+         *    user-provided object that defines a set of element-local
+         *    parameters, for example element-wise or nodal densities in
+         *    topology optimization, for use with
+         *    \p calculate_output_adjoint_sensitivities(). Each parameter is
+         *    identified by an index in \f$ [0, n_{parameters}) \f$ and only
+         *    influences the elements that list it in \p elem_parameters().
+         */
+        class ElemParameters {
+            
+        public:
+            ElemParameters() {}
+            virtual ~ElemParameters() {}
+            
+            /*!
+             *   @returns the total number of parameters
+             */
+            virtual unsigned int n_parameters() const = 0;
+            
+            /*!
+             *   provides in \p ids the indices of the parameters that
+             *   influence element \p e.
+             */
+            virtual void elem_parameters(const libMesh::Elem& e,
+                                         std::vector<unsigned int>& ids) const = 0;
+            
+            /*!
+             *   prepares the element quantities for sensitivity with respect
+             *   to parameter \p id on element \p e and returns the function
+             *   object that should be used for the sensitivity calculations.
+             *   The same object may be returned for all parameters.
+             */
+            virtual const MAST::FunctionBase&
+            activate(const libMesh::Elem& e, const unsigned int id) = 0;
+        };
+
 
         /*!
          *   constructor associates this assembly object with the system
@@ -92,6 +135,48 @@ namespace MAST {
         void
         set_post_assembly_operation(MAST::NonlinearImplicitAssembly::PostAssemblyOperation& post);
         
+        /*!
+         *   clears association with the system and discipline, and the
+         *   element matrix cache
+         */
+        virtual void
+        clear_discipline_and_system();
+        
+        /*!
+         *    enables a cache of the element Jacobian matrices for problems
+         *    where the element residual is linear in the solution and
+         *    independent of time, for example, linear elasticity with
+         *    MAST::LINEAR_STRAIN. The Jacobian \f$ K_e \f$ and the residual
+         *    at zero solution \f$ r_e \f$ are stored for each element during
+         *    the first call to residual_and_jacobian(), and subsequent calls
+         *    compute the element residual as \f$ K_e u_e + r_e \f$ without
+         *    element calculations. The cache is cleared if the element
+         *    operation object, the number of elements or the number of dofs
+         *    is changed, and by \p clear_discipline_and_system(). An error
+         *    is raised if any element uses a strain other than
+         *    MAST::LINEAR_STRAIN.
+         */
+        void set_element_matrix_cache(bool f);
+        
+        /*!
+         *   @returns true if the element matrix cache is enabled
+         */
+        bool element_matrix_cache() const { return _if_elem_matrix_cache; }
+        
+        /*!
+         *   adds \p p to the parameters that invalidate the element matrix
+         *   cache. If the value of \p p has changed since the last assembly,
+         *   the cached quantities of elements with a property card that
+         *   depends on \p p are recomputed. All cached quantities are
+         *   recomputed if a load in the discipline depends on \p p.
+         */
+        void add_element_matrix_cache_parameter(const MAST::Parameter& p);
+        
+        /*!
+         *   clears the cached element quantities
+         */
+        void clear_element_matrix_cache();
+        
         /*!
          *    function that assembles the matrices and vectors quantities for
          *    nonlinear solution
@@ -118,6 +203,23 @@ namespace MAST {
                                              libMesh::NonlinearImplicitSystem& S);
 
 
+        /*!
+         *    assembles the diagonal of the Jacobian at \p X in \p diag without
+         *    assembling the matrix. This provides a Jacobi preconditioner for
+         *    matrix-free solutions that use
+         *    \p linearized_jacobian_solution_product().
+         *    Note that the element operations only provide the full element
+         *    Jacobian, which is also needed to apply the constraints. Hence,
+         *    the computational cost of this method is that of a Jacobian
+         *    assembly. Only the storage and communication of the global
+         *    sparse matrix are avoided.
+         */
+        virtual void
+        jacobian_diagonal(const libMesh::NumericVector<Real>& X,
+                          libMesh::NumericVector<Real>& diag,
+                          libMesh::NonlinearImplicitSystem& S);
+        
+        
         /*!
          *    calculates \f$ d ([J] \{\Delta X\})/ dX  \f$.
          */
@@ -143,9 +245,74 @@ namespace MAST {
         sensitivity_assemble (const MAST::FunctionBase& f,
                               libMesh::NumericVector<Real>& sensitivity_rhs);
         
+        
+        /*!
+         *   calculates the adjoint sensitivity of \p output with respect to
+         *   all parameters in \p params in a single loop over the elements,
+         *   \f[ \frac{dq}{dp_i} = \frac{\partial q}{\partial p_i} +
+         *   \lambda^T \frac{\partial R}{\partial p_i}, \f]
+         *   where \p dq_dX is the adjoint solution \f$ \lambda \f$. Each
+         *   element is initialized once for all parameters that influence
+         *   it, and \p dq_dp is returned with one reduction across
+         *   processors. The partial sensitivity of \p output is included
+         *   if \p include_partial_sens is true. Point loads are assumed
+         *   to be independent of these parameters.
+         */
+        void
+        calculate_output_adjoint_sensitivities(const libMesh::NumericVector<Real>& X,
+                                               const libMesh::NumericVector<Real>& dq_dX,
+                                               MAST::NonlinearImplicitAssembly::ElemParameters& params,
+                                               MAST::AssemblyElemOperations&       elem_ops,
+                                               MAST::OutputAssemblyElemOperations& output,
+                                               std::vector<Real>& dq_dp,
+                                               const bool include_partial_sens = true);
+        
+        
+        /*!
+         *   calculates the partial sensitivity
+         *   \f$ \partial q/\partial p_i \f$ of \p output at solution
+         *   \p X with respect to all parameters in \p params in a single
+         *   loop over the elements.
+         */
+        void
+        calculate_output_partial_sensitivities(const libMesh::NumericVector<Real>& X,
+                                               MAST::NonlinearImplicitAssembly::ElemParameters& params,
+                                               MAST::OutputAssemblyElemOperations& output,
+                                               std::vector<Real>& dq_dp);
+        
     protected:
         
-
+        /*!
+         *   element loop for \p calculate_output_adjoint_sensitivities()
+         *   and \p calculate_output_partial_sensitivities(). The adjoint
+         *   term is computed with the element operation object if
+         *   \p dq_dX is provided, and the partial sensitivity if \p output
+         *   is provided.
+         */
+        void
+        _elem_parameter_sensitivities(const libMesh::NumericVector<Real>& X,
+                                      const libMesh::NumericVector<Real>* dq_dX,
+                                      MAST::NonlinearImplicitAssembly::ElemParameters& params,
+                                      MAST::OutputAssemblyElemOperations* output,
+                                      std::vector<Real>& dq_dp);
+        
+        /*!
+         *   cached Jacobian and residual at zero solution for an element
+         */
+        struct ElemMatrixCacheEntry {
+            
+            ElemMatrixCacheEntry(): valid(false) { }
+            
+            bool        valid;
+            RealMatrixX jac;
+            RealVectorX res0;
+        };
+        
+        /*!
+         *   invalidates the cached quantities affected by parameters that
+         *   have changed since the last assembly
+         */
+        void _update_element_matrix_cache();
         
         /*!
          *    this object, if non-NULL is user-provided to perform actions
@@ -158,6 +325,32 @@ namespace MAST {
          */
         Real _res_l2_norm, _first_iter_res_l2_norm;
         
+        /*!
+         *   flag to check if the element matrix cache is enabled
+         */
+        bool _if_elem_matrix_cache;
+        
+        /*!
+         *   cached element quantities indexed by element id
+         */
+        std::vector<MAST::NonlinearImplicitAssembly::ElemMatrixCacheEntry> _elem_matrix_cache;
+        
+        /*!
+         *   element operation object used to compute the cached quantities
+         */
+        const MAST::AssemblyElemOperations* _elem_matrix_cache_ops;
+        
+        /*!
+         *   maximum element id and number of dofs when the cached
+         *   quantities were computed
+         */
+        libMesh::dof_id_type _elem_matrix_cache_max_elem_id, _elem_matrix_cache_n_dofs;
+        
+        /*!
+         *   parameters that invalidate the cache, with their values at the
+         *   time of the last assembly
+         */
+        std::map<const MAST::Parameter*, Real> _elem_matrix_cache_params;
     };
 }
 
@@ -22,6 +22,8 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <map>
+#include <cstring>
 #include <sys/stat.h>
 
 // MAST includes
@@ -42,11 +44,135 @@
 #include "libmesh/petsc_linear_solver.h"
 #include "libmesh/xdr_cxx.h"
 #include "libmesh/mesh_tools.h"
+#include "libmesh/mesh_base.h"
+#include "libmesh/elem.h"
 #include "libmesh/utility.h"
 #include "libmesh/libmesh_version.h"
 #include "libmesh/generic_projector.h"
 #include "libmesh/wrapped_functor.h"
 #include "libmesh/fem_context.h"
+#include "libmesh/parallel_sync.h"
+
+
+namespace {
+    
+    /*!
+     *   version of the binary vector files written by
+     *   NonlinearSystem::write_out_vector
+     */
+    const uint64_t nonlinear_system_vector_file_version = 1;
+    
+    /*!
+     *   @returns the name of the vector file written by processor
+     *   \p rank, or the name of the index file if \p rank is
+     *   libMesh::invalid_uint.
+     */
+    std::string
+    nonlinear_system_vector_file_name(const std::string& directory_name,
+                                      const std::string& data_name,
+                                      const unsigned int rank = libMesh::invalid_uint) {
+        
+        std::ostringstream oss;
+        oss << directory_name << "/" << data_name << "_data";
+        if (rank == libMesh::invalid_uint)
+            oss << ".idx";
+        else
+            oss << "." << rank << ".bin";
+        
+        return oss.str();
+    }
+    
+    
+    /*!
+     *   reads the header, keys and values from a vector file written by
+     *   one processor.
+     */
+    void
+    nonlinear_system_read_vector_file(const std::string& nm,
+                                      uint64_t* header,
+                                      std::vector<uint64_t>& keys,
+                                      std::vector<double>& vals) {
+        
+        std::ifstream in(nm, std::ios::binary);
+        if (!in)
+            libmesh_error_msg("File missing: " + nm);
+        
+        in.read(reinterpret_cast<char*>(header), 5*sizeof(uint64_t));
+        if (!in || header[0] != nonlinear_system_vector_file_version)
+            libmesh_error_msg("Invalid vector file: " + nm);
+        
+        keys.resize(2*header[3]);
+        vals.resize(header[3]);
+        in.read(reinterpret_cast<char*>(keys.data()), keys.size()*sizeof(uint64_t));
+        in.read(reinterpret_cast<char*>(vals.data()), vals.size()*sizeof(double));
+        
+        if (!in)
+            libmesh_error_msg("Error reading file: " + nm);
+    }
+    
+    
+    /*!
+     *   sets the key of \p dof if it is in the local range [first, end).
+     *   The first value of the key stores the id of the owning object and
+     *   its type: 0 for nodes, 1 for elements and 2 for SCALAR variables.
+     *   The second value stores the variable and component number.
+     */
+    void
+    nonlinear_system_set_dof_key(const uint64_t first,
+                                 const uint64_t end,
+                                 const uint64_t dof,
+                                 const uint64_t id,
+                                 const uint64_t type,
+                                 const uint64_t var,
+                                 const uint64_t comp,
+                                 std::vector<uint64_t>& keys,
+                                 std::vector<bool>& assigned) {
+        
+        if (dof < first || dof >= end)
+            return;
+        
+        keys[2*(dof-first)]   = 4*id + type;
+        keys[2*(dof-first)+1] = (var << 32) + comp;
+        assigned[dof-first]   = true;
+    }
+    
+    
+    /*!
+     *   @returns the processor that collects the value of the dof with
+     *   key (\p k0, \p k1) when a vector is redistributed on read.
+     */
+    libMesh::processor_id_type
+    nonlinear_system_rendezvous_rank(const uint64_t k0,
+                                     const uint64_t k1,
+                                     const libMesh::processor_id_type n_procs) {
+        
+        return (libMesh::processor_id_type)
+        ((k0 ^ (k1 * 0x9e3779b97f4a7c15ULL)) % n_procs);
+    }
+    
+    
+    /*!
+     *   stores the bits of \p v in an integer so that values can be
+     *   communicated along with the keys.
+     */
+    uint64_t
+    nonlinear_system_value_bits(const double v) {
+        
+        uint64_t b;
+        std::memcpy(&b, &v, sizeof(double));
+        return b;
+    }
+    
+    
+    double
+    nonlinear_system_bits_value(const uint64_t b) {
+        
+        double v;
+        std::memcpy(&v, &b, sizeof(double));
+        return v;
+    }
+}
+
 
 
 MAST::NonlinearSystem::NonlinearSystem(libMesh::EquationSystems& es,
@@ -847,6 +973,15 @@ MAST::NonlinearSystem::write_out_vector(libMesh::NumericVector<Real>& vec,
                                         const std::string & data_name,
                                         const bool write_binary_vectors)
 {
+    if (!write_binary_vectors) {
+        
+        this->_write_out_serialized_vector(vec,
+                                           directory_name,
+                                           data_name,
+                                           write_binary_vectors);
+        return;
+    }
+    
     LOG_SCOPE("write_out_vector()", "NonlinearSystem");
     
     if (this->processor_id() == 0)
@@ -858,6 +993,328 @@ MAST::NonlinearSystem::write_out_vector(libMesh::NumericVector<Real>& vec,
     // Make sure processors are synced up before we begin
     this->comm().barrier();
     
+    const libMesh::DofMap& dof_map = this->get_dof_map();
+    
+    const uint64_t
+    first    = dof_map.first_dof(),
+    n_local  = dof_map.n_local_dofs(),
+    header[5] = {
+        nonlinear_system_vector_file_version,
+        this->n_processors(),
+        first,
+        n_local,
+        dof_map.n_dofs()};
+    
+    libmesh_assert_equal_to(vec.size(), dof_map.n_dofs());
+    
+    std::vector<uint64_t> keys;
+    this->_local_dof_keys(keys);
+    
+    std::vector<double> vals(n_local);
+    for (uint64_t i=0; i<n_local; i++)
+        vals[i] = vec(first+i);
+    
+    // processor 0 writes the index with the number of files
+    if (this->processor_id() == 0) {
+        
+        const std::string
+        nm = nonlinear_system_vector_file_name(directory_name, data_name);
+        std::ofstream out(nm, std::ios::binary);
+        if (!out)
+            libmesh_error_msg("Error opening file: " + nm);
+        out.write(reinterpret_cast<const char*>(header), 2*sizeof(uint64_t));
+        out.write(reinterpret_cast<const char*>(&header[4]), sizeof(uint64_t));
+    }
+    
+    // each processor writes its local dofs
+    const std::string
+    nm = nonlinear_system_vector_file_name(directory_name,
+                                           data_name,
+                                           this->processor_id());
+    std::ofstream out(nm, std::ios::binary);
+    if (!out)
+        libmesh_error_msg("Error opening file: " + nm);
+    
+    out.write(reinterpret_cast<const char*>(header), 5*sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(keys.data()), keys.size()*sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(vals.data()), vals.size()*sizeof(double));
+    out.close();
+    
+    if (!out)
+        libmesh_error_msg("Error writing file: " + nm);
+    
+    // make sure all files are complete before returning
+    this->comm().barrier();
+}
+
+
+
+void
+MAST::NonlinearSystem::read_in_vector(libMesh::NumericVector<Real>& vec,
+                                      const std::string & directory_name,
+                                      const std::string & data_name,
+                                      const bool read_binary_vector) {
+    
+    if (!read_binary_vector) {
+        
+        this->_read_in_serialized_vector(vec,
+                                         directory_name,
+                                         data_name,
+                                         read_binary_vector);
+        return;
+    }
+    
+    // vectors written before the per-processor format was introduced are
+    // stored in a single serialized .xdr file without an index file. These
+    // are read through the serialized path. Processor 0 checks the files
+    // and the result is shared so that all processors take the same path:
+    // 0 for the per-processor format, 1 for the legacy format and 2 if
+    // neither file exists.
+    const std::string
+    idx_nm    = nonlinear_system_vector_file_name(directory_name, data_name),
+    legacy_nm = directory_name + "/" + data_name + "_data.xdr";
+    
+    unsigned int
+    file_format = 0;
+    
+    if (this->processor_id() == 0) {
+        
+        struct stat stat_info;
+        
+        if (stat(idx_nm.c_str(), &stat_info) != 0)
+            file_format = (stat(legacy_nm.c_str(), &stat_info) == 0)? 1: 2;
+    }
+    
+    this->comm().broadcast(file_format);
+    
+    if (file_format == 2)
+        libmesh_error_msg("Neither vector index file: " + idx_nm
+                          + " nor legacy vector file: " + legacy_nm
+                          + " exists");
+    
+    if (file_format == 1) {
+        
+        this->_read_in_serialized_vector(vec,
+                                         directory_name,
+                                         data_name,
+                                         read_binary_vector);
+        return;
+    }
+    
+    LOG_SCOPE("read_in_vector()", "NonlinearSystem");
+    
+    // Make sure processors are synced up before we begin
+    this->comm().barrier();
+    
+    const libMesh::DofMap& dof_map = this->get_dof_map();
+    
+    const uint64_t
+    first    = dof_map.first_dof(),
+    n_local  = dof_map.n_local_dofs(),
+    n_global = dof_map.n_dofs();
+    
+    libmesh_assert_equal_to(vec.size(), n_global);
+    
+    // read the number of processors that wrote the vector
+    uint64_t
+    index[3] = {0, 0, 0};
+    {
+        const std::string
+        nm = nonlinear_system_vector_file_name(directory_name, data_name);
+        std::ifstream in(nm, std::ios::binary);
+        if (!in)
+            libmesh_error_msg("File missing: " + nm);
+        in.read(reinterpret_cast<char*>(index), 3*sizeof(uint64_t));
+        if (!in || index[0] != nonlinear_system_vector_file_version)
+            libmesh_error_msg("Invalid vector index file: " + nm);
+    }
+    
+    if (index[2] != n_global)
+        libmesh_error_msg("Number of dofs in file: " << index[2]
+                          << " does not match system dofs: " << n_global);
+    
+    std::vector<uint64_t>
+    keys,
+    file_keys;
+    std::vector<double>
+    file_vals;
+    
+    this->_local_dof_keys(keys);
+    
+    // a serial vector is filled through a parallel vector, since
+    // each processor reads only its local values
+    std::unique_ptr<libMesh::NumericVector<Real>> tmp;
+    libMesh::NumericVector<Real>* v = &vec;
+    if (vec.type() == libMesh::SERIAL) {
+        
+        tmp.reset(libMesh::NumericVector<Real>::build(this->comm()).release());
+        tmp->init(n_global, n_local, false, libMesh::PARALLEL);
+        v = tmp.get();
+    }
+    
+    // if the partitioning is unchanged, the file written by this
+    // processor has the local dofs in the same order.
+    bool
+    found = false;
+    
+    if (index[1] == this->n_processors()) {
+        
+        uint64_t
+        header[5];
+        nonlinear_system_read_vector_file
+        (nonlinear_system_vector_file_name(directory_name,
+                                           data_name,
+                                           this->processor_id()),
+         header, file_keys, file_vals);
+        
+        if (header[2] == first && header[3] == n_local && file_keys == keys) {
+            
+            for (uint64_t i=0; i<n_local; i++)
+                v->set(first+i, file_vals[i]);
+            found = true;
+        }
+    }
+    
+    // the redistribution below is collective, so it is used on all
+    // processors if the partitioning differs on any of them
+    this->comm().min(found);
+    
+    // otherwise, each file is read by a single processor and the values
+    // are redistributed by their dof keys. The value of each key is sent
+    // to a rendezvous processor that is computed from the key, which
+    // also receives the requests for that key from the processors that
+    // own the dof in the current partitioning.
+    if (!found) {
+        
+        const libMesh::processor_id_type
+        n_procs = this->n_processors();
+        
+        std::map<libMesh::processor_id_type, std::vector<uint64_t>>
+        file_data,
+        requests,
+        replies;
+        
+        for (uint64_t p=this->processor_id(); p<index[1]; p+=n_procs) {
+            
+            // the file written by this processor has already been read
+            // if the number of processors is unchanged
+            if (index[1] != n_procs) {
+                
+                uint64_t
+                header[5];
+                nonlinear_system_read_vector_file
+                (nonlinear_system_vector_file_name(directory_name,
+                                                   data_name,
+                                                   p),
+                 header, file_keys, file_vals);
+            }
+            
+            for (uint64_t i=0; i<file_vals.size(); i++) {
+                
+                std::vector<uint64_t>&
+                d = file_data[nonlinear_system_rendezvous_rank(file_keys[2*i],
+                                                               file_keys[2*i+1],
+                                                               n_procs)];
+                d.push_back(file_keys[2*i]);
+                d.push_back(file_keys[2*i+1]);
+                d.push_back(nonlinear_system_value_bits(file_vals[i]));
+            }
+        }
+        
+        for (uint64_t i=0; i<n_local; i++) {
+            
+            std::vector<uint64_t>&
+            d = requests[nonlinear_system_rendezvous_rank(keys[2*i],
+                                                          keys[2*i+1],
+                                                          n_procs)];
+            d.push_back(keys[2*i]);
+            d.push_back(keys[2*i+1]);
+            d.push_back(first+i);
+        }
+        
+        // values collected on this processor, by key
+        std::map<std::pair<uint64_t, uint64_t>, uint64_t> rendezvous_vals;
+        
+        auto
+        recv_file_data = [&rendezvous_vals] (libMesh::processor_id_type,
+                                             const std::vector<uint64_t>& d) {
+            
+            for (uint64_t i=0; i<d.size()/3; i++)
+                rendezvous_vals[std::make_pair(d[3*i], d[3*i+1])] = d[3*i+2];
+        };
+        
+        libMesh::Parallel::push_parallel_vector_data(this->comm(),
+                                                     file_data,
+                                                     recv_file_data);
+        
+        auto
+        recv_requests = [&rendezvous_vals, &replies] (libMesh::processor_id_type pid,
+                                                      const std::vector<uint64_t>& d) {
+            
+            std::vector<uint64_t>& r = replies[pid];
+            
+            for (uint64_t i=0; i<d.size()/3; i++) {
+                
+                std::map<std::pair<uint64_t, uint64_t>, uint64_t>::const_iterator
+                it = rendezvous_vals.find(std::make_pair(d[3*i], d[3*i+1]));
+                
+                if (it != rendezvous_vals.end()) {
+                    
+                    r.push_back(d[3*i+2]);
+                    r.push_back(it->second);
+                }
+            }
+        };
+        
+        libMesh::Parallel::push_parallel_vector_data(this->comm(),
+                                                     requests,
+                                                     recv_requests);
+        
+        uint64_t
+        n_found = 0;
+        
+        auto
+        recv_replies = [v, &n_found] (libMesh::processor_id_type,
+                                      const std::vector<uint64_t>& d) {
+            
+            for (uint64_t i=0; i<d.size()/2; i++)
+                v->set(d[2*i], nonlinear_system_bits_value(d[2*i+1]));
+            n_found += d.size()/2;
+        };
+        
+        libMesh::Parallel::push_parallel_vector_data(this->comm(),
+                                                     replies,
+                                                     recv_replies);
+        
+        if (n_found != n_local)
+            libmesh_error_msg("Missing values for local dofs in vector: " + data_name);
+    }
+    
+    v->close();
+    
+    if (tmp)
+        tmp->localize(vec);
+}
+
+
+
+void
+MAST::NonlinearSystem::_write_out_serialized_vector(libMesh::NumericVector<Real>& vec,
+                                                    const std::string & directory_name,
+                                                    const std::string & data_name,
+                                                    const bool write_binary_vectors)
+{
+    LOG_SCOPE("_write_out_serialized_vector()", "NonlinearSystem");
+    
+    if (this->processor_id() == 0)
+    {
+        // Make a directory to store all the data files
+        libMesh::Utility::mkdir(directory_name.c_str());
+    }
+    
+    // Make sure processors are synced up before we begin
+    this->comm().barrier();
+    
     std::ostringstream file_name;
     const std::string suffix = (write_binary_vectors ? ".xdr" : ".dat");
     
@@ -899,12 +1356,12 @@ MAST::NonlinearSystem::write_out_vector(libMesh::NumericVector<Real>& vec,
 
 
 void
-MAST::NonlinearSystem::read_in_vector(libMesh::NumericVector<Real>& vec,
-                                      const std::string & directory_name,
-                                      const std::string & data_name,
-                                      const bool read_binary_vector) {
+MAST::NonlinearSystem::_read_in_serialized_vector(libMesh::NumericVector<Real>& vec,
+                                                  const std::string & directory_name,
+                                                  const std::string & data_name,
+                                                  const bool read_binary_vector) {
     
-    LOG_SCOPE("read_in_vector()", "NonlinearSystem");
+    LOG_SCOPE("_read_in_serialized_vector()", "NonlinearSystem");
     
     // Make sure processors are synced up before we begin
     this->comm().barrier();
@@ -972,6 +1429,72 @@ MAST::NonlinearSystem::read_in_vector(libMesh::NumericVector<Real>& vec,
 
 
 
+void
+MAST::NonlinearSystem::_local_dof_keys(std::vector<uint64_t>& keys) const {
+    
+    const libMesh::DofMap& dof_map = this->get_dof_map();
+    const libMesh::MeshBase& mesh  = this->get_mesh();
+    
+    const uint64_t
+    first    = dof_map.first_dof(),
+    end      = dof_map.end_dof();
+    
+    const unsigned int
+    sys_num  = this->number(),
+    n_vars   = this->n_vars();
+    
+    keys.assign(2*(end-first), 0);
+    std::vector<bool> assigned(end-first, false);
+    
+    libMesh::MeshBase::const_node_iterator
+    n_it    = mesh.local_nodes_begin();
+    const libMesh::MeshBase::const_node_iterator
+    n_end   = mesh.local_nodes_end();
+    
+    for ( ; n_it != n_end; ++n_it) {
+        
+        const libMesh::Node& node = **n_it;
+        for (unsigned int v=0; v<n_vars; v++)
+            for (unsigned int c=0; c<node.n_comp(sys_num, v); c++)
+                nonlinear_system_set_dof_key
+                (first, end, node.dof_number(sys_num, v, c), node.id(), 0, v, c,
+                 keys, assigned);
+    }
+    
+    libMesh::MeshBase::const_element_iterator
+    e_it    = mesh.active_local_elements_begin();
+    const libMesh::MeshBase::const_element_iterator
+    e_end   = mesh.active_local_elements_end();
+    
+    for ( ; e_it != e_end; ++e_it) {
+        
+        const libMesh::Elem& elem = **e_it;
+        for (unsigned int v=0; v<n_vars; v++)
+            for (unsigned int c=0; c<elem.n_comp(sys_num, v); c++)
+                nonlinear_system_set_dof_key
+                (first, end, elem.dof_number(sys_num, v, c), elem.id(), 1, v, c,
+                 keys, assigned);
+    }
+    
+    std::vector<libMesh::dof_id_type> SCALAR_indices;
+    for (unsigned int v=0; v<n_vars; v++)
+        if (this->variable(v).type().family == libMesh::SCALAR) {
+            
+            dof_map.SCALAR_dof_indices(SCALAR_indices, v);
+            for (unsigned int i=0; i<SCALAR_indices.size(); i++)
+                nonlinear_system_set_dof_key
+                (first, end, SCALAR_indices[i], 0, 2, v, i,
+                 keys, assigned);
+        }
+    
+    // every local dof should have been identified
+    for (uint64_t i=0; i<assigned.size(); i++)
+        if (!assigned[i])
+            libmesh_error_msg("Unable to identify local dof: " << first+i);
+}
+
+
+
 void
 MAST::NonlinearSystem::
 project_vector_without_dirichlet (libMesh::NumericVector<Real> & new_vector,
@@ -22,6 +22,7 @@
 
 // C++ includes
 #include <memory>
+#include <cstdint>
 
 // MAST includes
 #include "base/mast_data_types.h"
@@ -294,6 +295,12 @@ namespace MAST {
         
         /*!
          *   writes the specified vector with the specified name in a directory.
+         *   Binary vectors are written in parallel: each processor writes
+         *   its local dofs in the native ordering to a separate file along
+         *   with a key that identifies each dof independent of the
+         *   partitioning. Processor 0 also writes an index file with the
+         *   number of processors. Non-binary vectors are written to a
+         *   single serialized ASCII file through processor 0.
          */
         void write_out_vector(libMesh::NumericVector<Real>& vec,
                               const std::string & directory_name,
@@ -303,6 +310,14 @@ namespace MAST {
         
         /*!
          *   reads the specified vector with the specified name in a directory.
+         *   For binary vectors each processor reads its own file if the
+         *   partitioning is unchanged since the vector was written.
+         *   Otherwise, for instance on restart with a different number of
+         *   processors, each file is read by one processor and the values
+         *   are redistributed to the owners of the dofs by their keys.
+         *   Binary vectors written in the legacy serialized
+         *   .xdr format, without an index file, are read through
+         *   processor 0 as before.
          */
         void read_in_vector(libMesh::NumericVector<Real>& vec,
                             const std::string & directory_name,
@@ -315,6 +330,33 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *   writes \p vec to a single serialized file through processor 0.
+         *   This requires a temporary global renumbering of the mesh.
+         */
+        void _write_out_serialized_vector(libMesh::NumericVector<Real>& vec,
+                                          const std::string & directory_name,
+                                          const std::string & data_name,
+                                          const bool write_binary_vectors);
+        
+        /*!
+         *   reads \p vec from a single serialized file written by
+         *   _write_out_serialized_vector().
+         */
+        void _read_in_serialized_vector(libMesh::NumericVector<Real>& vec,
+                                        const std::string & directory_name,
+                                        const std::string & data_name,
+                                        const bool read_binary_vectors);
+        
+        /*!
+         *   computes a key for each local dof that is independent of the
+         *   partitioning of the mesh. Two values are stored per dof in
+         *   the order of the local dofs: the id of the node, element or
+         *   SCALAR variable that owns the dof along with its type, and
+         *   the variable and component number.
+         */
+        void _local_dof_keys(std::vector<uint64_t>& keys) const;
+        
         
         /**
          * Initializes the member data fields associated with
@@ -172,3 +172,15 @@ if_evaluate_for_boundary(const MAST::GeomElem& elem,
 }
 
 
+
+void
+MAST::OutputAssemblyElemOperations::
+_init_output_clone(MAST::OutputAssemblyElemOperations& c) const {
+    
+    this->_init_clone(c);
+    
+    c._if_evaluate_on_all_elems = _if_evaluate_on_all_elems;
+    c._elem_subset              = _elem_subset;
+    c._sub_domain_ids           = _sub_domain_ids;
+    c._bids                     = _bids;
+}
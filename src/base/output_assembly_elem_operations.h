@@ -235,6 +235,14 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *   copies the association with discipline, system and assembly,
+         *   and the participating elements, subdomains and boundaries
+         *   to \p c. This is meant for use by the \p clone() methods of
+         *   derived classes.
+         */
+        void _init_output_clone(MAST::OutputAssemblyElemOperations& c) const;
+        
         /*!
          *   if true, evaluates on all elements.
          */
@@ -81,14 +81,10 @@ namespace MAST {
         
         
         /*!
-         *  @returns  \p true only if the given function is this.
+         *  @returns \p true, since the parameter value does not vary in
+         *  space or time.
          */
-        virtual bool depends_on(const MAST::FunctionBase& f) const {
-            if (&f == this)
-                return true;
-            else
-                return false;
-        }
+        virtual bool is_constant() const { return true; }
         
         
         
@@ -101,6 +97,16 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *  @returns  \p true only if the given function is this.
+         */
+        virtual bool _depends_on(const MAST::FunctionBase& f) const {
+            if (&f == this)
+                return true;
+            else
+                return false;
+        }
+        
         /*!
          *    Pointer to the value of the parameter
          */
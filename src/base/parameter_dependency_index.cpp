@@ -0,0 +1,217 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <algorithm>
+
+// MAST includes
+#include "base/parameter_dependency_index.h"
+#include "base/function_base.h"
+#include "base/function_set_base.h"
+
+
+MAST::ParameterDependencyIndex::ParameterDependencyIndex():
+_initialized    (false) {
+    
+}
+
+
+
+MAST::ParameterDependencyIndex::~ParameterDependencyIndex() {
+    
+    this->clear();
+}
+
+
+
+void
+MAST::ParameterDependencyIndex::add_parameter(const MAST::FunctionBase& p) {
+    
+    // a parameter can provide an id for only one index
+    libmesh_assert(!p._parameter_index || p._parameter_index == this);
+    
+    if (std::find(_parameters.begin(), _parameters.end(), &p) ==
+        _parameters.end())
+        _parameters.push_back(&p);
+}
+
+
+
+void
+MAST::ParameterDependencyIndex::add_function(const MAST::FunctionBase& f) {
+    
+    // nothing to be done if the function has already been added
+    if (!_functions.insert(&f).second)
+        return;
+    
+    std::set<const MAST::FunctionBase*>::const_iterator
+    it  = f._functions.begin(),
+    end = f._functions.end();
+    
+    for ( ; it != end; it++)
+        this->add_function(**it);
+}
+
+
+
+void
+MAST::ParameterDependencyIndex::add_function_set(const MAST::FunctionSetBase& f) {
+    
+    // nothing to be done if the function set has already been added
+    if (!_function_sets.insert(&f).second)
+        return;
+    
+    std::map<std::string, MAST::FunctionBase*>::const_iterator
+    it  = f._properties.begin(),
+    end = f._properties.end();
+    
+    for ( ; it != end; it++)
+        this->add_function(*it->second);
+}
+
+
+
+unsigned int
+MAST::ParameterDependencyIndex::parameter_id(const MAST::FunctionBase& p) const {
+    
+    libmesh_assert(_initialized);
+    libmesh_assert_msg(p._parameter_index == this,
+                       "Parameter not registered with index: " + p.name());
+    
+    return p._parameter_id;
+}
+
+
+
+void
+MAST::ParameterDependencyIndex::init() {
+    
+    // remove any previously computed data, so that the dependency below
+    // is computed from the function graph
+    this->_clear_dependency();
+    
+    const unsigned int n = this->n_parameters();
+    
+    for (unsigned int i=0; i<n; i++) {
+        
+        libmesh_assert(!_parameters[i]->_parameter_index);
+        _parameters[i]->_parameter_index = this;
+        _parameters[i]->_parameter_id    = i;
+    }
+    
+    // the dependency of a function is marked as available as soon as it
+    // has been computed, so that the functions computed later can use it
+    // in their recursive search.
+    {
+        std::set<const MAST::FunctionBase*>::const_iterator
+        it  = _functions.begin(),
+        end = _functions.end();
+        
+        for ( ; it != end; it++) {
+            
+            // objects precomputed by another index are left unchanged
+            if ((*it)->_dependency_index)
+                continue;
+            
+            // the virtual depends_on() is used so that derived classes
+            // that override it are honored
+            std::vector<bool> dep(n, false);
+            for (unsigned int i=0; i<n; i++)
+                dep[i] = (*it)->depends_on(*_parameters[i]);
+            
+            (*it)->_dependency.swap(dep);
+            (*it)->_dependency_index = this;
+        }
+    }
+    
+    {
+        std::set<const MAST::FunctionSetBase*>::const_iterator
+        it  = _function_sets.begin(),
+        end = _function_sets.end();
+        
+        for ( ; it != end; it++) {
+            
+            // objects precomputed by another index are left unchanged
+            if ((*it)->_dependency_index)
+                continue;
+            
+            std::vector<bool> dep(n, false);
+            for (unsigned int i=0; i<n; i++)
+                dep[i] = (*it)->depends_on(*_parameters[i]);
+            
+            (*it)->_dependency.swap(dep);
+            (*it)->_dependency_index = this;
+        }
+    }
+    
+    _initialized = true;
+}
+
+
+
+void
+MAST::ParameterDependencyIndex::clear() {
+    
+    this->_clear_dependency();
+    
+    _parameters.clear();
+    _functions.clear();
+    _function_sets.clear();
+}
+
+
+
+void
+MAST::ParameterDependencyIndex::_clear_dependency() {
+    
+    {
+        std::set<const MAST::FunctionBase*>::const_iterator
+        it  = _functions.begin(),
+        end = _functions.end();
+        
+        for ( ; it != end; it++) {
+            
+            if ((*it)->_dependency_index == this) {
+                (*it)->_dependency_index = nullptr;
+                (*it)->_dependency.clear();
+            }
+        }
+    }
+    
+    {
+        std::set<const MAST::FunctionSetBase*>::const_iterator
+        it  = _function_sets.begin(),
+        end = _function_sets.end();
+        
+        for ( ; it != end; it++) {
+            
+            if ((*it)->_dependency_index == this) {
+                (*it)->_dependency_index = nullptr;
+                (*it)->_dependency.clear();
+            }
+        }
+    }
+    
+    for (unsigned int i=0; i<_parameters.size(); i++)
+        if (_parameters[i]->_parameter_index == this)
+            _parameters[i]->_parameter_index = nullptr;
+    
+    _initialized = false;
+}
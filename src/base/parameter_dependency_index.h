@@ -0,0 +1,151 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__parameter_dependency_index__
+#define __mast__parameter_dependency_index__
+
+// C++ includes
+#include <vector>
+#include <set>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+
+namespace MAST {
+    
+    // Forward declerations
+    class FunctionBase;
+    class FunctionSetBase;
+    
+    /*!
+     *   Precomputes the dependency of functions and property cards on a
+     *   set of parameters. Each parameter added to this object is assigned
+     *   a dense id, and \p init() stores, for each registered function and
+     *   function set, a flag per parameter id. After this,
+     *   \p FunctionBase::depends_on() and \p FunctionSetBase::depends_on()
+     *   with a registered parameter are a single lookup instead of a
+     *   recursive search of the function graph. Queries with parameters
+     *   that are not registered fall back to the recursive search.
+     *
+     *   Functions and function sets whose dependency has already been
+     *   precomputed by another index are not modified by \p init().
+     *
+     *   \p init() must be called again if the dependencies of any of the
+     *   registered functions are modified. The registered objects must
+     *   outlive this object, or \p clear() must be called before they
+     *   are destroyed.
+     */
+    class ParameterDependencyIndex {
+        
+    public:
+        
+        ParameterDependencyIndex();
+        
+        /*!
+         *   removes the precomputed dependency from all registered objects
+         */
+        virtual ~ParameterDependencyIndex();
+        
+        
+        /*!
+         *   registers \p p as a parameter. The ids are assigned in the
+         *   order in which the parameters are added. A parameter can be
+         *   registered with only one index.
+         */
+        void add_parameter(const MAST::FunctionBase& p);
+        
+        
+        /*!
+         *   registers \p f, and recursively all functions that \p f
+         *   depends on, for precomputation of the dependency.
+         */
+        void add_function(const MAST::FunctionBase& f);
+        
+        
+        /*!
+         *   registers \p f, and all functions in \p f, for precomputation
+         *   of the dependency. Objects that a derived card depends on, but
+         *   which are not stored in the card as properties (for example,
+         *   the material card), should be added separately.
+         */
+        void add_function_set(const MAST::FunctionSetBase& f);
+        
+        
+        /*!
+         *   @returns the number of registered parameters
+         */
+        unsigned int n_parameters() const {
+            return (unsigned int)_parameters.size();
+        }
+        
+        
+        /*!
+         *   @returns the dense id of parameter \p p. This requires that
+         *   \p init() has been called after \p p was added.
+         */
+        unsigned int parameter_id(const MAST::FunctionBase& p) const;
+        
+        
+        /*!
+         *   assigns the parameter ids and computes the dependency of all
+         *   registered functions and function sets on all registered
+         *   parameters.
+         */
+        void init();
+        
+        
+        /*!
+         *   removes the precomputed dependency from all registered objects
+         *   and clears the registered parameters and functions.
+         */
+        void clear();
+        
+    protected:
+        
+        /*!
+         *   removes the precomputed dependency and parameter ids from
+         *   all registered objects
+         */
+        void _clear_dependency();
+        
+        /*!
+         *   true after \p init() has been called
+         */
+        bool _initialized;
+        
+        /*!
+         *   registered parameters, ordered by their ids
+         */
+        std::vector<const MAST::FunctionBase*> _parameters;
+        
+        /*!
+         *   registered functions
+         */
+        std::set<const MAST::FunctionBase*> _functions;
+        
+        /*!
+         *   registered function sets
+         */
+        std::set<const MAST::FunctionSetBase*> _function_sets;
+    };
+}
+
+#endif // __mast__parameter_dependency_index__
@@ -128,7 +128,7 @@ initialize_bending_strain_operator_for_yz (const MAST::FEBase& fe,
     // N3 = (1.0/4.0) * (0.0 -  1.0        - 2.0*xi  +         3.0*pow(xi,2));  // needs a -1.0 factor for theta_y
     // N4 = (1.0/4.0) * (0.0 -  1.0        + 2.0*xi  +         3.0*pow(xi,2));  // needs a -1.0 factor for theta_y
     
-    RealVectorX N = RealVectorX::Zero(2);
+    Matrix<Real, 2, 1> N = Matrix<Real, 2, 1>::Zero();
     
     // second order shape function derivative
     N(0) = (0.5/_length) * (  0.0     +  12.0/_length*xi);
@@ -40,27 +40,12 @@ MAST::ComplexNormalRotationMeshFunction::operator()(const libMesh::Point& p,
     
     dn_rot.setZero();
     
-    libMesh::MeshFunction
-    &function_re = *_func.get_function().first,
-    &function_im = *_func.get_function().second;
-    
-    // translation is obtained by direct interpolation of the u,v,w vars
-    
-    DenseRealVector
-    v_re,
-    v_im;
-    
-    function_re(p, 0., v_re);
-    function_im(p, 0., v_im);
-    
-    
     // perturbation of the normal requires calculation of the curl of
-    // displacement at the given point
-    std::vector<libMesh::Gradient>
-    gradients_re,
-    gradients_im;
-    function_re.gradient(p, 0., gradients_re);
-    function_im.gradient(p, 0., gradients_im);
+    // displacement at the given point. The displacement function uses
+    // its transfer map for this, if one is provided.
+    ComplexMatrixX
+    grad;
+    _func.gradient(p, 0., grad);
     
     // TODO: these need to be mapped from local 2D to 3D space
     
@@ -68,12 +53,9 @@ MAST::ComplexNormalRotationMeshFunction::operator()(const libMesh::Point& p,
     ComplexVectorX
     rot = ComplexVectorX::Zero(3);
     
-    rot(0) = std::complex<Real>(gradients_re[2](1) - gradients_re[1](2),
-                                gradients_im[2](1) - gradients_im[1](2)); // dwz/dy - dwy/dz
-    rot(1) = std::complex<Real>(gradients_re[0](2) - gradients_re[2](0),
-                                gradients_im[0](2) - gradients_im[2](0)); // dwx/dz - dwz/dx
-    rot(2) = std::complex<Real>(gradients_re[1](0) - gradients_re[0](1),
-                                gradients_im[1](0) - gradients_im[0](1)); // dwy/dx - dwx/dy
+    rot(0) = grad(2, 1) - grad(1, 2); // dwz/dy - dwy/dz
+    rot(1) = grad(0, 2) - grad(2, 0); // dwx/dz - dwz/dx
+    rot(2) = grad(1, 0) - grad(0, 1); // dwy/dx - dwx/dy
     
     // now do the cross-products
     dn_rot(0) =   rot(1) * n(2) - rot(2) * n(1);
@@ -92,25 +74,11 @@ MAST::ComplexNormalRotationMeshFunction::perturbation(const libMesh::Point& p,
     
     dn_rot.setZero();
     
-    libMesh::MeshFunction
-    &perturbed_function_re = *_func.get_perturbed_function().first,
-    &perturbed_function_im = *_func.get_perturbed_function().second;
-    
-    // translation is obtained by direct interpolation of the u,v,w vars
-    
-    DenseRealVector
-    v_re,
-    v_im;
-    perturbed_function_re(p, 0., v_re);
-    perturbed_function_im(p, 0., v_im);
-    
     // perturbation of the normal requires calculation of the curl of
     // displacement at the given point
-    std::vector<libMesh::Gradient>
-    gradients_re,
-    gradients_im;
-    perturbed_function_re.gradient(p, 0., gradients_re);
-    perturbed_function_im.gradient(p, 0., gradients_im);
+    ComplexMatrixX
+    grad;
+    _func.perturbation_gradient(p, 0., grad);
     
     // TODO: these need to be mapped from local 2D to 3D space
     
@@ -118,12 +86,9 @@ MAST::ComplexNormalRotationMeshFunction::perturbation(const libMesh::Point& p,
     ComplexVectorX
     rot = ComplexVectorX::Zero(3);
     
-    rot(0) = std::complex<Real>(gradients_re[2](1) - gradients_re[1](2),
-                                gradients_im[2](1) - gradients_im[1](2)); // dwz/dy - dwy/dz
-    rot(1) = std::complex<Real>(gradients_re[0](2) - gradients_re[2](0),
-                                gradients_im[0](2) - gradients_im[2](0)); // dwx/dz - dwz/dx
-    rot(2) = std::complex<Real>(gradients_re[1](0) - gradients_re[0](1),
-                                gradients_im[1](0) - gradients_im[0](1)); // dwy/dx - dwx/dy
+    rot(0) = grad(2, 1) - grad(1, 2); // dwz/dy - dwy/dz
+    rot(1) = grad(0, 2) - grad(2, 0); // dwx/dz - dwz/dx
+    rot(2) = grad(1, 0) - grad(0, 1); // dwy/dx - dwx/dy
     
     // now do the cross-products
     dn_rot(0) =   rot(1) * n(2) - rot(2) * n(1);
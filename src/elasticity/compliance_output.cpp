@@ -282,3 +282,25 @@ MAST::ComplianceOutput::init(const MAST::GeomElem& elem) {
 }
 
 
+
+std::unique_ptr<MAST::AssemblyElemOperations>
+MAST::ComplianceOutput::clone() const {
+    
+    MAST::ComplianceOutput*
+    c = new MAST::ComplianceOutput;
+    this->_init_output_clone(*c);
+    
+    return std::unique_ptr<MAST::AssemblyElemOperations>(c);
+}
+
+
+
+void
+MAST::ComplianceOutput::join(const MAST::AssemblyElemOperations& other) {
+    
+    const MAST::ComplianceOutput&
+    c = dynamic_cast<const MAST::ComplianceOutput&>(other);
+    
+    _compliance     += c._compliance;
+    _dcompliance_dp += c._dcompliance_dp;
+}
@@ -169,6 +169,17 @@ namespace MAST {
          */
         virtual void output_derivative_for_elem(RealVectorX& dq_dX);
         
+        /*!
+         *   @returns a clone of this object with zero compliance for use in
+         *   thread-parallel element loops.
+         */
+        virtual std::unique_ptr<MAST::AssemblyElemOperations> clone() const;
+        
+        /*!
+         *   adds the compliance and its sensitivity accumulated by \p other
+         *   to this object.
+         */
+        virtual void join(const MAST::AssemblyElemOperations& other);
         
     protected:
     
@@ -143,9 +143,9 @@ namespace MAST
                                           Real& cosine);
         
         
-        void _calculate_dkt_shape_functions(const RealVectorX& phi,
-                                            RealVectorX& betax,
-                                            RealVectorX& betay);
+        void _calculate_dkt_shape_functions(const Matrix<Real, 6, 1>& phi,
+                                            Matrix<Real, 9, 1>& betax,
+                                            Matrix<Real, 9, 1>& betay);
         
         
         /*!
@@ -191,15 +191,22 @@ initialize_bending_strain_operator_for_z (const MAST::FEBase& fe,
     const std::vector<std::vector<libMesh::RealVectorValue> >& dphi = _fe->get_dphi();
     const unsigned int n_phi = (unsigned int)dphi.size();
     
-    RealVectorX
-    phi       = RealVectorX::Zero(n_phi),
-    dbetaxdx  = RealVectorX::Zero(9),
-    dbetaxdy  = RealVectorX::Zero(9),
-    dbetaydx  = RealVectorX::Zero(9),
-    dbetaydy  = RealVectorX::Zero(9),
-    w         = RealVectorX::Zero(3),
-    thetax    = RealVectorX::Zero(3),
-    thetay    = RealVectorX::Zero(3);
+    // the sizes are fixed by the TRI6 shape functions and the three
+    // corner nodes of the element, so that nothing is allocated on the
+    // heap at each quadrature point
+    libmesh_assert_equal_to(n_phi, 6);
+    
+    Matrix<Real, 6, 1>
+    phi       = Matrix<Real, 6, 1>::Zero();
+    Matrix<Real, 9, 1>
+    dbetaxdx  = Matrix<Real, 9, 1>::Zero(),
+    dbetaxdy  = Matrix<Real, 9, 1>::Zero(),
+    dbetaydx  = Matrix<Real, 9, 1>::Zero(),
+    dbetaydy  = Matrix<Real, 9, 1>::Zero();
+    RealVector3
+    w         = RealVector3::Zero(),
+    thetax    = RealVector3::Zero(),
+    thetay    = RealVector3::Zero();
 
     
     for ( unsigned int i_nd=0; i_nd<n_phi; i_nd++ )
@@ -318,9 +325,9 @@ MAST::DKTBendingOperator::_get_edge_normal_sine_cosine(unsigned int i,
 
 inline
 void
-MAST::DKTBendingOperator::_calculate_dkt_shape_functions(const RealVectorX& phi,
-                                                         RealVectorX& betax,
-                                                         RealVectorX& betay)
+MAST::DKTBendingOperator::_calculate_dkt_shape_functions(const Matrix<Real, 6, 1>& phi,
+                                                         Matrix<Real, 9, 1>& betax,
+                                                         Matrix<Real, 9, 1>& betay)
 {
     // -- keep in mind that the index numbers for the elems start at 0.
     // -- also, the mid side node numbers in the Batoz's paper are different from
@@ -143,20 +143,17 @@ assemble_generalized_aerodynamic_force_matrix
     std::vector<libMesh::dof_id_type> dof_indices;
     
     
-    std::unique_ptr<libMesh::NumericVector<Real> >
-    localized_solution,
-    localized_zero;
-    std::vector<libMesh::NumericVector<Real>*> localized_basis(n_basis);
-
+    const libMesh::NumericVector<Real>* localized_solution = nullptr;
+    
     if (_base_sol)
-        localized_solution.reset(build_localized_vector(_system->system(),
-                                                         *_base_sol).release());
+        localized_solution = &localized_work_vector(*_base_sol);
     
-    for (unsigned int i=0; i<n_basis; i++)
-        localized_basis[i] = build_localized_vector(_system->system(), *basis[i]).release();
+    // localize all basis vectors in a single communication
+    _localized_basis.init(_system->system(), basis);
     
     //create a zero-clone copy for the imaginary component of the solution
-    localized_zero.reset(localized_basis[0]->zero_clone().release());
+    std::unique_ptr<libMesh::NumericVector<Real> >
+    zero(basis[0]->zero_clone().release());
     
     
     // if a solution function is attached, initialize it
@@ -166,13 +163,20 @@ assemble_generalized_aerodynamic_force_matrix
     MAST::FluidStructureAssemblyElemOperations&
     ops = dynamic_cast<MAST::FluidStructureAssemblyElemOperations&>(*_elem_ops);
     
+    // the fluid operator depends only on the frequency and the base
+    // solution, not on the mode. Hence, it is assembled and
+    // preconditioned once and reused for the right-hand side of each mode.
+    _fluid_complex_solver->set_reuse_block_matrix(true);
+    
     // iterate over each structural mode to calculate the
     // fluid small-disturbance solution
     for (unsigned int i=0; i<n_basis; i++) {
         
-        // set up the fluid flexible-surface boundary condition for this mode
+        // set up the fluid flexible-surface boundary condition for this mode.
+        // The displacement function makes its own serial copy of the
+        // vectors, so the parallel basis vector is provided directly.
         _complex_displ->clear();
-        _complex_displ->init(*localized_basis[i], *localized_zero);
+        _complex_displ->init(*basis[i], *zero);
         
         
         // solve the complex smamll-disturbance fluid-equations
@@ -214,16 +218,11 @@ assemble_generalized_aerodynamic_force_matrix
             unsigned int ndofs = (unsigned int)dof_indices.size();
             sol.setZero(ndofs);
             vec.setZero(ndofs);
-            basis_mat.setZero(ndofs, n_basis);
+            _localized_basis.get_values(dof_indices, basis_mat);
             
-            for (unsigned int i=0; i<dof_indices.size(); i++) {
-                
-                if (_base_sol)
-                    sol(i) = (*localized_solution)(dof_indices[i]);
-                
-                for (unsigned int j=0; j<n_basis; j++)
-                    basis_mat(i,j) = (*localized_basis[j])(dof_indices[i]);
-            }
+            if (_base_sol)
+                for (unsigned int j=0; j<dof_indices.size(); j++)
+                    sol(j) = (*localized_solution)(dof_indices[j]);
             
             
             ops.set_elem_solution(sol);
@@ -263,15 +262,14 @@ assemble_generalized_aerodynamic_force_matrix
     
     
     
+    // release the retained fluid operator
+    _fluid_complex_solver->set_reuse_block_matrix(false);
+    
     // if a solution function is attached, clear it
     if (_sol_function)
         _sol_function->clear();
     
     
-    // delete the localized basis vectors
-    for (unsigned int i=0; i<basis.size(); i++)
-        delete localized_basis[i];
-    
     // sum the matrix and provide it to each processor
     // this assumes that the structural comm is a subset of fluid comm
     MAST::parallel_sum(_system->system().comm(), mat);
@@ -49,53 +49,28 @@ MAST::KSStressStrainOutput::~KSStressStrainOutput() {
 
 
 void
-MAST::KSStressStrainOutput::functional_for_all_elems() {
+MAST::KSStressStrainOutput::_accumulate_functional(const unsigned int begin,
+                                                   const unsigned int end) {
     
-    libmesh_assert(!_if_stress_plot_mode);
-    libmesh_assert(!_primal_data_initialized);
-    libmesh_assert_greater(_sigma0, 0.);
-    
-    Real
-    e_val            = 0.,
-    JxW              = 0.;
-    
-    _JxW_val         = 0.;
-    _sigma_vm_int    = 0.;
-    _sigma_vm_p_norm = 0.;
+    const Real
+    *vm     = _stress_data.von_Mises_stress().data(),
+    *JxW    = _stress_data.JxW().data();
     
-    // first find the data with the maximum value, to be used for scaling
-    
-    // iterate over all element data
-    std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >::const_iterator
-    map_it   =  _stress_data.begin(),
-    map_end  =  _stress_data.end();
-    
-    for ( ; map_it != map_end; map_it++) {
-        
-        std::vector<MAST::StressStrainOutputBase::Data*>::const_iterator
-        vec_it   = map_it->second.begin(),
-        vec_end  = map_it->second.end();
+    // we do not use absolute value here, since von Mises stress
+    // is >= 0.
+    for (unsigned int i=begin; i<end; i++) {
         
-        for ( ; vec_it != vec_end; vec_it++) {
-            
-            // ask this data point for the von Mises stress value
-            e_val    =   (*vec_it)->von_Mises_stress();
-            JxW      =   (*vec_it)->quadrature_point_JxW();
-            
-            // we do not use absolute value here, since von Mises stress
-            // is >= 0.
-            _sigma_vm_int  +=  exp(_p_norm_stress * (e_val-_sigma0)/_sigma0) * JxW;
-            _JxW_val       +=  JxW;
-        }
+        _sigma_vm_int  +=  exp(_p_norm_stress * (vm[i]-_sigma0)/_sigma0) * JxW[i];
+        _JxW_val       +=  JxW[i];
     }
+}
+
+
+
+void
+MAST::KSStressStrainOutput::_finalize_functional() {
     
-    // sum over all processors, since part of the mesh will exist on the
-    // other processors.
-    _system->system().comm().sum(_sigma_vm_int);
-    _system->system().comm().sum(_JxW_val);
-    
-    _sigma_vm_p_norm         = 1./_p_norm_stress * log(_sigma_vm_int/_JxW_val);
-    _primal_data_initialized = true;
+    _sigma_vm_p_norm = 1./_p_norm_stress * log(_sigma_vm_int/_JxW_val);
 }
 
 
@@ -120,22 +95,18 @@ MAST::KSStressStrainOutput::functional_sensitivity_for_elem
     dsigma_vm_val_df = 0.;
     
     // iterate over all element data
-    std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >::const_iterator
-    map_it   =  _stress_data.find(e_id),
-    map_end  =  _stress_data.end();
-    
-    libmesh_assert(map_it != map_end);
+    unsigned int
+    begin    = 0,
+    end      = 0;
     
-    std::vector<MAST::StressStrainOutputBase::Data*>::const_iterator
-    vec_it   = map_it->second.begin(),
-    vec_end  = map_it->second.end();
+    _stress_data.elem_range(e_id, begin, end);
     
-    for ( ; vec_it != vec_end; vec_it++) {
+    for (unsigned int i=begin; i<end; i++) {
         
         // ask this data point for the von Mises stress value
-        e_val    =   (*vec_it)->von_Mises_stress();
-        de_val   =   (*vec_it)->dvon_Mises_stress_dp(f);
-        JxW      =   (*vec_it)->quadrature_point_JxW();
+        e_val    =   _stress_data.von_Mises_stress()[i];
+        de_val   =   _stress_data.dvon_Mises_stress_dp(i, f);
+        JxW      =   _stress_data.JxW()[i];
         
         num_sens    +=  _p_norm_stress * de_val/_sigma0 * exp(_p_norm_stress * (e_val-_sigma0)/_sigma0) * JxW;
     }
@@ -166,21 +137,17 @@ MAST::KSStressStrainOutput::functional_boundary_sensitivity_for_elem
     dsigma_vm_val_df = 0.;
     
     // iterate over all element data
-    std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >::const_iterator
-    map_it   =  _boundary_stress_data.find(e_id),
-    map_end  =  _boundary_stress_data.end();
-    
-    libmesh_assert(map_it != map_end);
+    unsigned int
+    begin    = 0,
+    end      = 0;
     
-    std::vector<MAST::StressStrainOutputBase::Data*>::const_iterator
-    vec_it   = map_it->second.begin(),
-    vec_end  = map_it->second.end();
+    _boundary_stress_data.elem_range(e_id, begin, end);
     
-    for ( ; vec_it != vec_end; vec_it++) {
+    for (unsigned int i=begin; i<end; i++) {
         
         // ask this data point for the von Mises stress value
-        e_val    =   (*vec_it)->von_Mises_stress();
-        JxW_Vn   =   (*vec_it)->quadrature_point_JxW();
+        e_val    =   _boundary_stress_data.von_Mises_stress()[i];
+        JxW_Vn   =   _boundary_stress_data.JxW()[i];
         
         denom_sens  +=  JxW_Vn;
         num_sens    +=  exp(_p_norm_stress * (e_val-_sigma0)/_sigma0) * JxW_Vn;
@@ -212,24 +179,18 @@ MAST::KSStressStrainOutput::functional_state_derivartive_for_elem(const libMesh:
     // first find the data with the maximum value, to be used for scaling
     
     // iterate over all element data
-    std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >::const_iterator
-    map_it   =  _stress_data.find(e_id),
-    map_end  =  _stress_data.end();
-    
-    // make sure that the data exists
-    libmesh_assert(map_it != map_end);
-    
-    std::vector<MAST::StressStrainOutputBase::Data*>::const_iterator
-    vec_it   = map_it->second.begin(),
-    vec_end  = map_it->second.end();
+    unsigned int
+    begin    = 0,
+    end      = 0;
     
+    _stress_data.elem_range(e_id, begin, end);
     
-    for ( ; vec_it != vec_end; vec_it++) {
+    for (unsigned int i=begin; i<end; i++) {
         
         // ask this data point for the von Mises stress value
-        e_val    =   (*vec_it)->von_Mises_stress();
-        de_val   =   (*vec_it)->dvon_Mises_stress_dX();
-        JxW      =   (*vec_it)->quadrature_point_JxW();
+        e_val    =   _stress_data.von_Mises_stress()[i];
+        JxW      =   _stress_data.JxW()[i];
+        _stress_data.dvon_Mises_stress_dX(i, de_val);
         
         num_sens    += _p_norm_stress * de_val/_sigma0 * exp(_p_norm_stress * (e_val-_sigma0)/_sigma0) * JxW;
     }
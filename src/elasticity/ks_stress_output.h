@@ -52,16 +52,6 @@ namespace MAST {
         virtual ~KSStressStrainOutput();
         
         
-        /*!
-         *   calculates and returns the von Mises p-norm functional for
-         *   all the elements that this object currently stores data for.
-         *   This is defined as
-         *   \f[  \left( \frac{\int_\Omega (\sigma_{VM}(\Omega))^p ~
-         *    d\Omega}{\int_\Omega ~ d\Omega} \right)^{\frac{1}{p}} \f]
-         */
-        virtual void functional_for_all_elems();
-        
-                
         /*!
          *   calculates and returns the sensitivity of von Mises p-norm
          *   functional for the element \p e.
@@ -102,6 +92,20 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *   adds the contribution of the points \p [begin, end) in
+         *   \p _stress_data to the local integrals \p _sigma_vm_int and
+         *   \p _JxW_val.
+         */
+        virtual void _accumulate_functional(const unsigned int begin,
+                                            const unsigned int end);
+        
+        /*!
+         *   computes \p _sigma_vm_p_norm from the integrals
+         *   \p _sigma_vm_int and \p _JxW_val that have been summed over
+         *   all processors.
+         */
+        virtual void _finalize_functional();
     };
 }
 
@@ -80,16 +80,6 @@ MAST::LevelSetStressAssembly::clear() {
 
 
 
-extern void
-get_max_stress_strain_values(const std::vector<MAST::StressStrainOutputBase::Data*>& data,
-                             RealVectorX&           max_strain,
-                             RealVectorX&           max_stress,
-                             Real&                  max_vm,
-                             const MAST::FunctionBase* p);
-
-
-
-
 void MAST::LevelSetStressAssembly::
 update_stress_strain_data(MAST::StressStrainOutputBase&       ops,
                           const libMesh::NumericVector<Real>& X) {
@@ -98,6 +88,9 @@ update_stress_strain_data(MAST::StressStrainOutputBase&       ops,
     libmesh_assert(_system);
     libmesh_assert(_discipline);
     libmesh_assert(!_elem_ops);
+    // the element data is read after evaluate(), which is not possible
+    // if it is not retained
+    libmesh_assert(!ops.streaming_aggregation());
     
     this->set_elem_operation_object(ops);
     
@@ -186,21 +179,20 @@ update_stress_strain_data(MAST::StressStrainOutputBase&       ops,
                 ops.clear_elem();
             }
             
-            // get the stress-strain data map from the object
-            const std::map<const libMesh::dof_id_type,
-            std::vector<MAST::StressStrainOutputBase::Data*> >& output_map =
+            // get the stress-strain data from the object
+            const MAST::StressStrainOutputBase::DataStore& output_data =
             ops.get_stress_strain_data();
             
             // make sure that the number of elements in this is the same
             // as the number of elements in the subelement vector
-            libmesh_assert_equal_to(output_map.size(), elems_hi.size());
+            libmesh_assert_equal_to(output_data.n_elems(), elems_hi.size());
             
             // now iterate over all the elements and set the value in the
             // new system used for output
             std::map<const libMesh::dof_id_type,
-            std::vector<MAST::StressStrainOutputBase::Data*> >::const_iterator
-            e_it    =  output_map.begin(),
-            e_end   =  output_map.end();
+            std::pair<unsigned int, unsigned int> >::const_iterator
+            e_it    =  output_data.elem_offsets().begin(),
+            e_end   =  output_data.elem_offsets().end();
             
             RealVectorX
             max_vals = RealVectorX::Zero(13);
@@ -208,11 +200,11 @@ update_stress_strain_data(MAST::StressStrainOutputBase&       ops,
             // get the max of all quantities
             for ( ; e_it != e_end; e_it++) {
                 
-                get_max_stress_strain_values(e_it->second,
-                                             max_strain_vals,
-                                             max_stress_vals,
-                                             max_vm_stress,
-                                             nullptr);
+                output_data.max_values_for_elem(e_it->first,
+                                                max_strain_vals,
+                                                max_stress_vals,
+                                                max_vm_stress,
+                                                nullptr);
                 
                 
                 for (unsigned int i=0; i<6; i++) {
@@ -66,7 +66,12 @@ initialize_bending_strain_operator_for_z(const MAST::FEBase& fe,
     
     const unsigned int n_phi = (unsigned int)phi.size();
     
-    RealVectorX phi_vec = RealVectorX::Zero(n_phi);
+    // the work vector is resized only if this is the first call for
+    // the element, or if the number of shape functions has changed.
+    if (_phi_vec.size() != n_phi)
+        _phi_vec.setZero(n_phi);
+    RealVectorX& phi_vec = _phi_vec;
+    
     for ( unsigned int i_nd=0; i_nd<n_phi; i_nd++ )
         phi_vec(i_nd) = dphi[i_nd][qp](0);  // dphi/dx
     
@@ -95,6 +100,26 @@ calculate_transverse_shear_residual(bool request_jacobian,
                                     RealVectorX& local_f,
                                     RealMatrixX& local_jac) {
     
+    this->transverse_shear_residual<Dynamic>(request_jacobian, local_f, local_jac);
+}
+
+
+
+template <int N2>
+void
+MAST::MindlinBendingOperator::
+transverse_shear_residual(bool request_jacobian,
+                          Matrix<Real, N2, 1>&  local_f,
+                          Matrix<Real, N2, N2>& local_jac) {
+    
+    // number of shape functions known at compile time
+    const int NPhi = (N2 == Dynamic)? Dynamic : N2/6;
+    
+    typedef Matrix<Real, NPhi, 1> PhiVecType;
+    typedef Matrix<Real, N2,   1> VecN2Type;
+    typedef Matrix<Real, N2,  N2> MatN2N2Type;
+    typedef Matrix<Real,  2,  N2> Mat2N2Type;
+    
     const MAST::ElementPropertyCardBase& property = _structural_elem.elem_property();
     
     // make an fe and quadrature object for the requested order for integrating
@@ -112,14 +137,21 @@ calculate_transverse_shear_residual(bool request_jacobian,
     n_phi = (unsigned int)phi.size(),
     n2    = 6*n_phi;
     
-    RealVectorX
-    phi_vec   = RealVectorX::Zero(n_phi),
-    vec_n2    = RealVectorX::Zero(n2),
-    vec_2     = RealVectorX::Zero(2);
+    libmesh_assert(N2 == Dynamic || N2 == (int)n2);
+    libmesh_assert_equal_to(local_f.size(), n2);
+    
+    PhiVecType
+    phi_vec   = PhiVecType::Zero(n_phi);
+    VecN2Type
+    vec_n2    = VecN2Type::Zero(n2);
+    Matrix<Real, 2, 1>
+    vec_2     = Matrix<Real, 2, 1>::Zero();
     RealMatrixX
-    material_trans_shear_mat,
-    mat_n2n2    = RealMatrixX::Zero(n2,n2),
-    mat_2n2     = RealMatrixX::Zero(2,n2);
+    material_trans_shear_mat;
+    MatN2N2Type
+    mat_n2n2    = MatN2N2Type::Zero(n2,n2);
+    Mat2N2Type
+    mat_2n2     = Mat2N2Type::Zero(2,n2);
     
     
     FEMOperatorMatrix Bmat_trans;
@@ -183,8 +215,9 @@ calculate_transverse_shear_residual_sensitivity(const MAST::FunctionBase& p,
     
     RealVectorX
     phi_vec   = RealVectorX::Zero(n_phi),
-    vec_n2    = RealVectorX::Zero(n2),
-    vec_2     = RealVectorX::Zero(2);
+    vec_n2    = RealVectorX::Zero(n2);
+    Matrix<Real, 2, 1>
+    vec_2     = Matrix<Real, 2, 1>::Zero();
     RealMatrixX
     material_trans_shear_mat,
     mat_n2n2    = RealMatrixX::Zero(n2,n2),
@@ -255,8 +288,9 @@ calculate_transverse_shear_residual_boundary_velocity
     RealVectorX
     phi_vec     = RealVectorX::Zero(n_phi),
     vec_n2      = RealVectorX::Zero(n2),
-    vec_2       = RealVectorX::Zero(2),
     vel         = RealVectorX::Zero(dim);
+    Matrix<Real, 2, 1>
+    vec_2       = Matrix<Real, 2, 1>::Zero();
     RealMatrixX
     material_trans_shear_mat,
     dmaterial_trans_shear_mat_dp,
@@ -309,6 +343,10 @@ calculate_transverse_shear_residual_boundary_velocity
 
 
 
+template <typename PhiVecType,
+          typename VecN2Type,
+          typename MatN2N2Type,
+          typename Mat2N2Type>
 void
 MAST::MindlinBendingOperator::
 _transverse_shear_operations(const std::vector<std::vector<Real> >& phi,
@@ -317,14 +355,16 @@ _transverse_shear_operations(const std::vector<std::vector<Real> >& phi,
                              const unsigned int     qp,
                              const RealMatrixX&     material,
                              FEMOperatorMatrix&     Bmat,
-                             RealVectorX&           phi_vec,
-                             RealVectorX&           vec_n2,
-                             RealVectorX&           vec_2,
-                             RealMatrixX&           mat_n2n2,
-                             RealMatrixX&           mat_2n2,
+                             PhiVecType&            phi_vec,
+                             VecN2Type&             vec_n2,
+                             Matrix<Real, 2, 1>&    vec_2,
+                             MatN2N2Type&           mat_n2n2,
+                             Mat2N2Type&            mat_2n2,
                              bool                   request_jacobian,
-                             RealVectorX&           local_f,
-                             RealMatrixX&           local_jac) {
+                             VecN2Type&             local_f,
+                             MatN2N2Type&           local_jac) {
+    
+    Matrix<Real, 2, 1> strain;
     
     // initialize the strain operator
     for ( unsigned int i_nd=0; i_nd<phi.size(); i_nd++ )
@@ -346,8 +386,8 @@ _transverse_shear_operations(const std::vector<std::vector<Real> >& phi,
     
     
     // now add the transverse shear component
-    Bmat.vector_mult(vec_2, _structural_elem.local_solution());
-    vec_2 = material * vec_2;
+    Bmat.vector_mult(strain, _structural_elem.local_solution());
+    vec_2.noalias() = material * strain;
     Bmat.vector_mult_transpose(vec_n2, vec_2);
     local_f += JxW[qp] * vec_n2;
     
@@ -359,3 +399,20 @@ _transverse_shear_operations(const std::vector<std::vector<Real> >& phi,
         local_jac += JxW[qp] * mat_n2n2;
     }
 }
+
+
+
+// explicit instantiations for the element dofs of the TRI3 and QUAD4
+// elements, and for a general element
+template void
+MAST::MindlinBendingOperator::transverse_shear_residual<Dynamic>
+(bool, RealVectorX&, RealMatrixX&);
+
+template void
+MAST::MindlinBendingOperator::transverse_shear_residual<18>
+(bool, Matrix<Real, 18, 1>&, Matrix<Real, 18, 18>&);
+
+template void
+MAST::MindlinBendingOperator::transverse_shear_residual<24>
+(bool, Matrix<Real, 24, 1>&, Matrix<Real, 24, 24>&);
+
@@ -71,6 +71,19 @@ namespace MAST {
                                             RealVectorX& local_f,
                                             RealMatrixX& local_jac);
 
+        /*!
+         *   calculate the transverse shear component for the element using
+         *   vectors and matrices with \p N2 rows for the element dofs.
+         *   \p N2 is \p Eigen::Dynamic for a general element, or the number
+         *   of element dofs if it is known at compile time, so that the
+         *   element quantities are not allocated on the heap.
+         */
+        template <int N2>
+        void
+        transverse_shear_residual(bool request_jacobian,
+                                  Matrix<Real, N2, 1>&  local_f,
+                                  Matrix<Real, N2, N2>& local_jac);
+
         /*!
          *   calculate the transverse shear component for the element
          */
@@ -94,6 +107,10 @@ namespace MAST {
 
     protected:
         
+        template <typename PhiVecType,
+                  typename VecN2Type,
+                  typename MatN2N2Type,
+                  typename Mat2N2Type>
         void
         _transverse_shear_operations(const std::vector<std::vector<Real> >& phi,
                                      const std::vector<std::vector<libMesh::RealVectorValue> >& dphi,
@@ -101,14 +118,21 @@ namespace MAST {
                                      const unsigned int     qp,
                                      const RealMatrixX&     material,
                                      FEMOperatorMatrix&     Bmat_trans,
-                                     RealVectorX&           phi_vec,
-                                     RealVectorX&           vec_n2,
-                                     RealVectorX&           vec_2,
-                                     RealMatrixX&           mat_n2n2,
-                                     RealMatrixX&           mat_2n2,
+                                     PhiVecType&            phi_vec,
+                                     VecN2Type&             vec_n2,
+                                     Matrix<Real, 2, 1>&    vec_2,
+                                     MatN2N2Type&           mat_n2n2,
+                                     Mat2N2Type&            mat_2n2,
                                      bool                   request_jacobian,
-                                     RealVectorX&           local_f,
-                                     RealMatrixX&           local_jac);
+                                     VecN2Type&             local_f,
+                                     MatN2N2Type&           local_jac);
+        
+        /*!
+         *   work vector for the shape function derivatives used in the
+         *   bending strain operator. This is sized once for the element
+         *   and reused at each quadrature point.
+         */
+        RealVectorX _phi_vec;
         
         /*!
          *   reduction in quadrature for shear energy
@@ -1021,8 +1021,8 @@ MAST::StructuralElement3D::calculate_stress(bool request_derivative,
         stress = material_mat * strain;
         
         // set the stress and strain data
-        MAST::StressStrainOutputBase::Data*
-        data = nullptr;
+        MAST::StressStrainOutputBase::Data
+        data;
         
         // if neither the derivative nor sensitivity is requested, then
         // we assume that a new data entry is to be provided. Otherwise,
@@ -1030,15 +1030,15 @@ MAST::StructuralElement3D::calculate_stress(bool request_derivative,
         // exists, and we only need to append sensitivity/derivative
         // data to it
         if (!request_derivative && !p)
-            data = &(stress_output.add_stress_strain_at_qp_location(_elem,
-                                                                    qp,
-                                                                    qp_loc[qp],
-                                                                    xyz[qp],
-                                                                    stress,
-                                                                    strain,
-                                                                    JxW[qp]));
+            data = stress_output.add_stress_strain_at_qp_location(_elem,
+                                                                  qp,
+                                                                  qp_loc[qp],
+                                                                  xyz[qp],
+                                                                  stress,
+                                                                  strain,
+                                                                  JxW[qp]);
         else
-            data = &(stress_output.get_stress_strain_data_for_elem_at_qp(_elem, qp));
+            data = stress_output.get_stress_strain_data_for_elem_at_qp(_elem, qp);
 
         
         if (request_derivative) {
@@ -42,62 +42,6 @@ MAST::StressAssembly::~StressAssembly() {
 
 
 
-void
-get_max_stress_strain_values(const std::vector<MAST::StressStrainOutputBase::Data*>& data,
-                             RealVectorX&           max_strain,
-                             RealVectorX&           max_stress,
-                             Real&                  max_vm,
-                             const MAST::FunctionBase* p) {
-    
-    max_strain    = RealVectorX::Zero(6);
-    max_stress    = RealVectorX::Zero(6);
-    max_vm        = 0.;
-    
-    // if there is only one data point, then simply copy the value to the output
-    // routines
-    if (data.size() == 1) {
-        if (p == nullptr) {
-            max_strain  = data[0]->strain();
-            max_stress  = data[0]->stress();
-            max_vm      = data[0]->von_Mises_stress();
-        }
-        else {
-            max_strain  = data[0]->get_strain_sensitivity(*p);
-            max_stress  = data[0]->get_stress_sensitivity(*p);
-            max_vm      = data[0]->dvon_Mises_stress_dp  (*p);
-        }
-        
-        return;
-    }
-    
-    // if multiple values are provided for an element, then we need to compare
-    std::vector<MAST::StressStrainOutputBase::Data*>::const_iterator
-    it        = data.begin(),
-    end       = data.end();
-    
-    Real
-    vm        = 0.;
-    
-    for ( ; it != end; it++) {
-        
-        // get the strain value at this point
-        const RealVectorX& strain =  (*it)->strain();
-        const RealVectorX& stress =  (*it)->stress();
-        vm                        =  (*it)->von_Mises_stress();
-        
-        // now compare
-        if (vm > max_vm)                      max_vm        = vm;
-        
-        for ( unsigned int i=0; i<6; i++) {
-            if (fabs(strain(i)) > fabs(max_strain(i)))  max_strain(i) = strain(i);
-            if (fabs(stress(i)) > fabs(max_stress(i)))  max_stress(i) = stress(i);
-        }
-    }
-}
-
-
-
-
 void MAST::StressAssembly::
 update_stress_strain_data(MAST::StressStrainOutputBase&       ops,
                           const libMesh::NumericVector<Real>& X) {
@@ -106,6 +50,9 @@ update_stress_strain_data(MAST::StressStrainOutputBase&       ops,
     libmesh_assert(_system);
     libmesh_assert(_discipline);
     libmesh_assert(!_elem_ops);
+    // the element data is read after evaluate(), which is not possible
+    // if it is not retained
+    libmesh_assert(!ops.streaming_aggregation());
     
     this->set_elem_operation_object(ops);
 
@@ -170,30 +117,29 @@ update_stress_strain_data(MAST::StressStrainOutputBase&       ops,
         ops.evaluate();
         ops.clear_elem();
         
-        // get the stress-strain data map from the object
-        const std::map<const libMesh::dof_id_type,
-        std::vector<MAST::StressStrainOutputBase::Data*> >& output_map =
+        // get the stress-strain data from the object
+        const MAST::StressStrainOutputBase::DataStore& output_data =
         ops.get_stress_strain_data();
         
         // make sure that only one element has been added to this data,
         // and that the element id is the same as the one being computed
-        libmesh_assert_equal_to(output_map.size(), 1);
-        libmesh_assert_equal_to(output_map.begin()->first, elem->id());
+        libmesh_assert_equal_to(output_data.n_elems(), 1);
+        libmesh_assert_equal_to(output_data.elem_offsets().begin()->first, elem->id());
         
         // now iterate over all the elements and set the value in the
         // new system used for output
         std::map<const libMesh::dof_id_type,
-        std::vector<MAST::StressStrainOutputBase::Data*> >::const_iterator
-        e_it    =  output_map.begin(),
-        e_end   =  output_map.end();
+        std::pair<unsigned int, unsigned int> >::const_iterator
+        e_it    =  output_data.elem_offsets().begin(),
+        e_end   =  output_data.elem_offsets().end();
         
         for ( ; e_it != e_end; e_it++) {
             
-            get_max_stress_strain_values(e_it->second,
-                                         max_strain_vals,
-                                         max_stress_vals,
-                                         max_vm_stress,
-                                         nullptr);
+            output_data.max_values_for_elem(e_it->first,
+                                            max_strain_vals,
+                                            max_stress_vals,
+                                            max_vm_stress,
+                                            nullptr);
             
             // set the values in the system
             // stress value
@@ -231,6 +177,9 @@ update_stress_strain_sensitivity_data(MAST::StressStrainOutputBase&       ops,
     libmesh_assert(_system);
     libmesh_assert(_discipline);
     libmesh_assert(!_elem_ops);
+    // the element data is read after evaluate(), which is not possible
+    // if it is not retained
+    libmesh_assert(!ops.streaming_aggregation());
     
     this->set_elem_operation_object(ops);
     
@@ -309,30 +258,29 @@ update_stress_strain_sensitivity_data(MAST::StressStrainOutputBase&       ops,
         ops.evaluate_sensitivity(p);
         ops.clear_elem();
 
-        // get the stress-strain data map from the object
-        const std::map<const libMesh::dof_id_type,
-        std::vector<MAST::StressStrainOutputBase::Data*> >& output_map =
+        // get the stress-strain data from the object
+        const MAST::StressStrainOutputBase::DataStore& output_data =
         ops.get_stress_strain_data();
 
         // make sure that only one element has been added to this data,
         // and that the element id is the same as the one being computed
-        libmesh_assert_equal_to(output_map.size(), 1);
-        libmesh_assert_equal_to(output_map.begin()->first, elem->id());
+        libmesh_assert_equal_to(output_data.n_elems(), 1);
+        libmesh_assert_equal_to(output_data.elem_offsets().begin()->first, elem->id());
 
         // now iterate over all the elements and set the value in the
         // new system used for output
         std::map<const libMesh::dof_id_type,
-        std::vector<MAST::StressStrainOutputBase::Data*> >::const_iterator
-        e_it    =  output_map.begin(),
-        e_end   =  output_map.end();
+        std::pair<unsigned int, unsigned int> >::const_iterator
+        e_it    =  output_data.elem_offsets().begin(),
+        e_end   =  output_data.elem_offsets().end();
         
         for ( ; e_it != e_end; e_it++) {
             
-            get_max_stress_strain_values(e_it->second,
-                                         max_strain_vals,
-                                         max_stress_vals,
-                                         max_vm_stress,
-                                         &p);
+            output_data.max_values_for_elem(e_it->first,
+                                            max_strain_vals,
+                                            max_stress_vals,
+                                            max_vm_stress,
+                                            &p);
             
             // set the values in the system
             // stress value
@@ -17,6 +17,8 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
+// C++ includes
+#include <algorithm>
 
 // MAST includes
 #include "elasticity/stress_output_base.h"
@@ -32,22 +34,463 @@
 #include "mesh/geom_elem.h"
 
 
-MAST::StressStrainOutputBase::Data::Data(const RealVectorX& stress,
-                                         const RealVectorX& strain,
-                                         const libMesh::Point& qp,
-                                         const libMesh::Point& xyz,
-                                         Real JxW):
-_stress(stress),
-_strain(strain),
-_qp(qp),
-_xyz(xyz),
-_JxW(JxW) {
+MAST::StressStrainOutputBase::DataStore::DataStore() {
+    
+}
+
+
+
+void
+MAST::StressStrainOutputBase::DataStore::clear() {
+    
+    _stress.clear();
+    _strain.clear();
+    _JxW.clear();
+    _von_Mises.clear();
+    _qp.clear();
+    _xyz.clear();
+    _elem_offsets.clear();
+    _dX_offset.clear();
+    _dX_cols.clear();
+    _dstress_dX.clear();
+    _dstrain_dX.clear();
+    _sensitivity.clear();
+}
+
+
+
+void
+MAST::StressStrainOutputBase::DataStore::clear_sensitivity_data() {
+    
+    _sensitivity.clear();
+}
 
+
+
+unsigned int
+MAST::StressStrainOutputBase::DataStore::add(const libMesh::dof_id_type e_id,
+                                             const unsigned int qp,
+                                             const RealVectorX& stress,
+                                             const RealVectorX& strain,
+                                             const libMesh::Point& qp_pt,
+                                             const libMesh::Point& xyz,
+                                             Real JxW) {
+    
     // make sure that both the stress and strain are for a 3D configuration,
     // which is the default for this data structure
     libmesh_assert_equal_to(stress.size(), 6);
     libmesh_assert_equal_to(strain.size(), 6);
+
+    const unsigned int
+    i = this->n_points();
+    
+    // check if the specified element exists in the map. If not, add it
+    std::map<const libMesh::dof_id_type, std::pair<unsigned int, unsigned int>>::iterator
+    it = _elem_offsets.find(e_id);
+    
+    if (it == _elem_offsets.end())
+        it = _elem_offsets.insert
+        (std::pair<const libMesh::dof_id_type, std::pair<unsigned int, unsigned int>>
+         (e_id, std::pair<unsigned int, unsigned int>(i, 0))).first;
+    else {
+        // this assumes that the previous qp data is provided and
+        // therefore, this qp number should be == number of points of the
+        // elem. The points of the element are also expected to be
+        // the last ones added to the store.
+        libmesh_assert_equal_to(qp, it->second.second);
+        libmesh_assert_equal_to(it->second.first + it->second.second, i);
+    }
+    
+    it->second.second++;
+    
+    for (unsigned int j=0; j<6; j++) {
+        _stress.push_back(stress(j));
+        _strain.push_back(strain(j));
+    }
+    _JxW.push_back(JxW);
+    _qp.push_back(qp_pt);
+    _xyz.push_back(xyz);
+    
+    _von_Mises.push_back
+    (pow(0.5 * (pow(stress(0)-stress(1),2) +    //(((sigma_xx - sigma_yy)^2    +
+                pow(stress(1)-stress(2),2) +    //  (sigma_yy - sigma_zz)^2    +
+                pow(stress(2)-stress(0),2)) +   //  (sigma_zz - sigma_xx)^2)/2 +
+         3.0 * (pow(stress(3), 2) +              // 3* (tau_xx^2 +
+                pow(stress(4), 2) +              //     tau_yy^2 +
+                pow(stress(5), 2)), 0.5));       //     tau_zz^2))^.5
+    
+    // keep the derivative block consistent with the number of points,
+    // if it has been initialized
+    if (_dX_offset.size()) {
+        _dX_offset.push_back(libMesh::invalid_uint);
+        _dX_cols.push_back(0);
+    }
+    
+    return i;
+}
+
+
+
+unsigned int
+MAST::StressStrainOutputBase::DataStore::
+n_points_for_elem(const libMesh::dof_id_type e_id) const {
+    
+    std::map<const libMesh::dof_id_type, std::pair<unsigned int, unsigned int>>::const_iterator
+    it = _elem_offsets.find(e_id);
+    
+    if (it == _elem_offsets.end())
+        return 0;
+    else
+        return it->second.second;
+}
+
+
+
+void
+MAST::StressStrainOutputBase::DataStore::elem_range(const libMesh::dof_id_type e_id,
+                                                    unsigned int& begin,
+                                                    unsigned int& end) const {
+    
+    std::map<const libMesh::dof_id_type, std::pair<unsigned int, unsigned int>>::const_iterator
+    it = _elem_offsets.find(e_id);
+    
+    // make sure that the specified elem exists in the map
+    libmesh_assert(it != _elem_offsets.end());
+    
+    begin = it->second.first;
+    end   = it->second.first + it->second.second;
+}
+
+
+
+unsigned int
+MAST::StressStrainOutputBase::DataStore::index(const libMesh::dof_id_type e_id,
+                                               const unsigned int qp) const {
+    
+    std::map<const libMesh::dof_id_type, std::pair<unsigned int, unsigned int>>::const_iterator
+    it = _elem_offsets.find(e_id);
     
+    // make sure that the specified elem exists in the map
+    libmesh_assert(it != _elem_offsets.end());
+    libmesh_assert_less(qp, it->second.second);
+    
+    return it->second.first + qp;
+}
+
+
+
+void
+MAST::StressStrainOutputBase::DataStore::set_derivatives(const unsigned int i,
+                                                         const RealMatrixX& dstress_dX,
+                                                         const RealMatrixX& dstrain_dX) {
+    
+    // make sure that the number of rows is 6.
+    libmesh_assert_less(i, this->n_points());
+    libmesh_assert_equal_to(dstress_dX.rows(), 6);
+    libmesh_assert_equal_to(dstrain_dX.rows(), 6);
+    libmesh_assert_equal_to(dstress_dX.cols(), dstrain_dX.cols());
+    
+    // initialize the derivative block, if this is the first derivative
+    if (!_dX_offset.size()) {
+        _dX_offset.resize(this->n_points(), libMesh::invalid_uint);
+        _dX_cols.resize(this->n_points(), 0);
+    }
+    
+    const unsigned int
+    n = (unsigned int)dstress_dX.size();
+    
+    // reuse the storage if the derivative has been set before with the
+    // same size, otherwise append to the block
+    if (_dX_offset[i] == libMesh::invalid_uint ||
+        _dX_cols[i] != (unsigned int)dstress_dX.cols()) {
+        
+        _dX_offset[i] = (unsigned int)_dstress_dX.size();
+        _dX_cols[i]   = (unsigned int)dstress_dX.cols();
+        _dstress_dX.resize(_dstress_dX.size() + n);
+        _dstrain_dX.resize(_dstrain_dX.size() + n);
+    }
+    
+    Eigen::Map<RealMatrixX>(&_dstress_dX[_dX_offset[i]], 6, _dX_cols[i]) = dstress_dX;
+    Eigen::Map<RealMatrixX>(&_dstrain_dX[_dX_offset[i]], 6, _dX_cols[i]) = dstrain_dX;
+}
+
+
+
+Eigen::Map<const RealMatrixX>
+MAST::StressStrainOutputBase::DataStore::dstress_dX(const unsigned int i) const {
+
+    libmesh_assert_less(i, _dX_offset.size());
+    libmesh_assert(_dX_offset[i] != libMesh::invalid_uint);
+    
+    return Eigen::Map<const RealMatrixX>(&_dstress_dX[_dX_offset[i]], 6, _dX_cols[i]);
+}
+
+
+
+Eigen::Map<const RealMatrixX>
+MAST::StressStrainOutputBase::DataStore::dstrain_dX(const unsigned int i) const {
+    
+    libmesh_assert_less(i, _dX_offset.size());
+    libmesh_assert(_dX_offset[i] != libMesh::invalid_uint);
+    
+    return Eigen::Map<const RealMatrixX>(&_dstrain_dX[_dX_offset[i]], 6, _dX_cols[i]);
+}
+
+
+
+void
+MAST::StressStrainOutputBase::DataStore::set_sensitivity(const unsigned int i,
+                                                         const MAST::FunctionBase& f,
+                                                         const RealVectorX& dstress_df,
+                                                         const RealVectorX& dstrain_df) {
+    
+    // make sure that both the stress and strain are for a 3D configuration,
+    // which is the default for this data structure
+    libmesh_assert_less(i, this->n_points());
+    libmesh_assert_equal_to(dstress_df.size(), 6);
+    libmesh_assert_equal_to(dstrain_df.size(), 6);
+    
+    MAST::StressStrainOutputBase::DataStore::SensitivityBlock&
+    sens = _sensitivity[&f];
+    
+    // reuse the storage if the sensitivity of this point has been set
+    // before, otherwise append to the block
+    std::map<unsigned int, unsigned int>::iterator
+    it = sens.offset.find(i);
+    
+    if (it == sens.offset.end()) {
+        
+        it = sens.offset.insert(std::make_pair(i, (unsigned int)sens.dstress.size())).first;
+        sens.dstress.resize(sens.dstress.size() + 6);
+        sens.dstrain.resize(sens.dstrain.size() + 6);
+    }
+    
+    for (unsigned int j=0; j<6; j++) {
+        sens.dstress[it->second+j] = dstress_df(j);
+        sens.dstrain[it->second+j] = dstrain_df(j);
+    }
+}
+
+
+
+bool
+MAST::StressStrainOutputBase::DataStore::has_sensitivity(const unsigned int i,
+                                                         const MAST::FunctionBase& f) const {
+    
+    std::map<const MAST::FunctionBase*, SensitivityBlock>::const_iterator
+    it = _sensitivity.find(&f);
+    
+    return (it != _sensitivity.end() &&
+            it->second.offset.count(i));
+}
+
+
+
+Eigen::Map<const RealVectorX>
+MAST::StressStrainOutputBase::DataStore::stress_sensitivity(const unsigned int i,
+                                                            const MAST::FunctionBase& f) const {
+    
+    // make sure that the data exists
+    libmesh_assert(this->has_sensitivity(i, f));
+    
+    const MAST::StressStrainOutputBase::DataStore::SensitivityBlock&
+    sens = _sensitivity.find(&f)->second;
+    
+    return Eigen::Map<const RealVectorX>(&sens.dstress[sens.offset.find(i)->second], 6);
+}
+
+
+
+Eigen::Map<const RealVectorX>
+MAST::StressStrainOutputBase::DataStore::strain_sensitivity(const unsigned int i,
+                                                            const MAST::FunctionBase& f) const {
+    
+    // make sure that the data exists
+    libmesh_assert(this->has_sensitivity(i, f));
+    
+    const MAST::StressStrainOutputBase::DataStore::SensitivityBlock&
+    sens = _sensitivity.find(&f)->second;
+    
+    return Eigen::Map<const RealVectorX>(&sens.dstrain[sens.offset.find(i)->second], 6);
+}
+
+
+
+void
+MAST::StressStrainOutputBase::DataStore::clear_sensitivity_data(const unsigned int i) {
+    
+    std::map<const MAST::FunctionBase*, SensitivityBlock>::iterator
+    it  = _sensitivity.begin(),
+    end = _sensitivity.end();
+    
+    // the storage of the point is released when all sensitivity data
+    // is cleared
+    for ( ; it != end; it++)
+        it->second.offset.erase(i);
+}
+
+
+
+void
+MAST::StressStrainOutputBase::DataStore::dvon_Mises_stress_dX(const unsigned int i,
+                                                              RealVectorX& dvm_dX) const {
+    
+    const Real
+    *s = &_stress[6*i];
+    
+    Eigen::Map<const RealMatrixX>
+    ds = this->dstress_dX(i);
+    
+    Real
+    p =
+    0.5 * (pow(s[0]-s[1],2) +    //((sigma_xx - sigma_yy)^2    +
+           pow(s[1]-s[2],2) +    // (sigma_yy - sigma_zz)^2    +
+           pow(s[2]-s[0],2)) +   // (sigma_zz - sigma_xx)^2)/2 +
+    3.0 * (pow(s[3], 2) +        // 3* (tau_xx^2 +
+           pow(s[4], 2) +        //     tau_yy^2 +
+           pow(s[5], 2));        //     tau_zz^2)
+    
+    dvm_dX.setZero(ds.cols());
+    
+    // if p == 0, then the sensitivity returns nan
+    // Hence, we are avoiding this by setting it to zero whenever p = 0.
+    if (fabs(p) > 0.)
+        dvm_dX =
+        (((ds.row(0) - ds.row(1)) * (s[0] - s[1]) +
+          (ds.row(1) - ds.row(2)) * (s[1] - s[2]) +
+          (ds.row(2) - ds.row(0)) * (s[2] - s[0])) +
+         6.0 * (ds.row(3) * s[3]+
+                ds.row(4) * s[4]+
+                ds.row(5) * s[5])).transpose() * 0.5 * pow(p, -0.5);
+}
+
+
+
+Real
+MAST::StressStrainOutputBase::DataStore::dvon_Mises_stress_dp(const unsigned int i,
+                                                              const MAST::FunctionBase& f) const {
+    
+    if (!this->has_sensitivity(i, f))
+        return 0.;
+    
+    const MAST::StressStrainOutputBase::DataStore::SensitivityBlock&
+    sens = _sensitivity.find(&f)->second;
+    
+    const Real
+    *s  = &_stress[6*i],
+    *ds = &sens.dstress[sens.offset.find(i)->second];
+    
+    Real
+    p =
+    0.5 * (pow(s[0]-s[1],2) +    //((sigma_xx - sigma_yy)^2    +
+           pow(s[1]-s[2],2) +    // (sigma_yy - sigma_zz)^2    +
+           pow(s[2]-s[0],2)) +   // (sigma_zz - sigma_xx)^2)/2 +
+    3.0 * (pow(s[3], 2) +        // 3* (tau_xx^2 +
+           pow(s[4], 2) +        //     tau_yy^2 +
+           pow(s[5], 2)),        //     tau_zz^2)
+    dp = 0.;
+    
+    // if p == 0, then the sensitivity returns nan
+    // Hence, we are avoiding this by setting it to zero whenever p = 0.
+    if (fabs(p) > 0.)
+        dp =
+        (((ds[0] - ds[1]) * (s[0] - s[1]) +
+          (ds[1] - ds[2]) * (s[1] - s[2]) +
+          (ds[2] - ds[0]) * (s[2] - s[0])) +
+         6.0 * (ds[3] * s[3]+
+                ds[4] * s[4]+
+                ds[5] * s[5])) * 0.5 * pow(p, -0.5);
+    
+    return dp;
+}
+
+
+
+void
+MAST::StressStrainOutputBase::DataStore::
+max_values_for_elem(const libMesh::dof_id_type e_id,
+                    RealVectorX& max_strain,
+                    RealVectorX& max_stress,
+                    Real& max_vm,
+                    const MAST::FunctionBase* p) const {
+    
+    max_strain    = RealVectorX::Zero(6);
+    max_stress    = RealVectorX::Zero(6);
+    max_vm        = 0.;
+    
+    unsigned int
+    begin = 0,
+    end   = 0;
+    
+    this->elem_range(e_id, begin, end);
+    
+    // if there is only one data point, then simply copy the value to the output
+    // routines
+    if (end - begin == 1) {
+        if (p == nullptr) {
+            max_strain  = this->strain(begin);
+            max_stress  = this->stress(begin);
+            max_vm      = _von_Mises[begin];
+        }
+        else {
+            max_strain  = this->strain_sensitivity(begin, *p);
+            max_stress  = this->stress_sensitivity(begin, *p);
+            max_vm      = this->dvon_Mises_stress_dp(begin, *p);
+        }
+        
+        return;
+    }
+    
+    // if multiple values are provided for an element, then we need to compare
+    for (unsigned int i=begin; i<end; i++) {
+        
+        // now compare
+        if (_von_Mises[i] > max_vm)                      max_vm        = _von_Mises[i];
+        
+        for ( unsigned int j=0; j<6; j++) {
+            if (fabs(_strain[6*i+j]) > fabs(max_strain(j)))  max_strain(j) = _strain[6*i+j];
+            if (fabs(_stress[6*i+j]) > fabs(max_stress(j)))  max_stress(j) = _stress[6*i+j];
+        }
+    }
+}
+
+
+
+Real
+MAST::StressStrainOutputBase::DataStore::max_von_Mises_stress() const {
+    
+    const unsigned int
+    n      = this->n_points();
+    
+    const Real
+    *vm    = _von_Mises.data();
+
+    Real
+    max_vm = 0.;
+    
+    for (unsigned int i=0; i<n; i++)
+        max_vm = vm[i]>max_vm?vm[i]:max_vm;
+    
+    return max_vm;
+}
+
+
+
+
+MAST::StressStrainOutputBase::Data::Data():
+_store (nullptr),
+_i     (0) {
+    
+}
+
+
+
+MAST::StressStrainOutputBase::Data::Data(MAST::StressStrainOutputBase::DataStore& store,
+                                         const unsigned int i):
+_store (&store),
+_i     (i) {
+
+    libmesh_assert_less(i, store.n_points());
 }
 
 
@@ -55,8 +498,8 @@ _JxW(JxW) {
 void
 MAST::StressStrainOutputBase::Data::clear_sensitivity_data() {
     
-    _stress_sensitivity.clear();
-    _strain_sensitivity.clear();
+    libmesh_assert(_store);
+    _store->clear_sensitivity_data(_i);
 }
 
 
@@ -64,21 +507,25 @@ const libMesh::Point&
 MAST::StressStrainOutputBase::Data::
 point_location_in_element_coordinate() const {
 
-    return _qp;
+    libmesh_assert(_store);
+    return _store->qp_location(_i);
 }
 
 
-const RealVectorX&
+Eigen::Map<const RealVectorX>
 MAST::StressStrainOutputBase::Data::stress() const {
     
-    return _stress;
+    libmesh_assert(_store);
+    return _store->stress(_i);
 }
 
 
 
-const RealVectorX&
+Eigen::Map<const RealVectorX>
 MAST::StressStrainOutputBase::Data::strain() const {
-    return _strain;
+
+    libmesh_assert(_store);
+    return _store->strain(_i);
 }
 
 
@@ -87,34 +534,33 @@ void
 MAST::StressStrainOutputBase::Data::set_derivatives(const RealMatrixX& dstress_dX,
                                                     const RealMatrixX& dstrain_dX) {
     
-    // make sure that the number of rows is 6.
-    libmesh_assert_equal_to(dstress_dX.rows(), 6);
-    libmesh_assert_equal_to(dstrain_dX.rows(), 6);
-    
-    _dstress_dX = dstress_dX;
-    _dstrain_dX = dstrain_dX;
+    libmesh_assert(_store);
+    _store->set_derivatives(_i, dstress_dX, dstrain_dX);
 }
 
 
 
-const RealMatrixX&
+Eigen::Map<const RealMatrixX>
 MAST::StressStrainOutputBase::Data::get_dstress_dX() const {
     
-    return _dstress_dX;
+    libmesh_assert(_store);
+    return _store->dstress_dX(_i);
 }
 
 
-const RealMatrixX&
+Eigen::Map<const RealMatrixX>
 MAST::StressStrainOutputBase::Data::get_dstrain_dX() const {
     
-    return _dstrain_dX;
+    libmesh_assert(_store);
+    return _store->dstrain_dX(_i);
 }
 
 
 Real
 MAST::StressStrainOutputBase::Data::quadrature_point_JxW() const {
     
-    return _JxW;
+    libmesh_assert(_store);
+    return _store->JxW()[_i];
 }
 
 
@@ -123,13 +569,8 @@ MAST::StressStrainOutputBase::Data::set_sensitivity(const MAST::FunctionBase& f,
                                                     const RealVectorX& dstress_df,
                                                     const RealVectorX& dstrain_df) {
 
-    // make sure that both the stress and strain are for a 3D configuration,
-    // which is the default for this data structure
-    libmesh_assert_equal_to(dstress_df.size(), 6);
-    libmesh_assert_equal_to(dstrain_df.size(), 6);
-    
-    _stress_sensitivity[&f] = dstress_df;
-    _strain_sensitivity[&f] = dstrain_df;
+    libmesh_assert(_store);
+    _store->set_sensitivity(_i, f, dstress_df, dstrain_df);
 }
 
 
@@ -137,42 +578,27 @@ bool
 MAST::StressStrainOutputBase::Data::
 has_stress_sensitivity(const MAST::FunctionBase& f) const {
     
-    // make sure that the data exists
-    std::map<const MAST::FunctionBase*, RealVectorX>::const_iterator
-    it = _stress_sensitivity.find(&f);
-    
-    return it != _stress_sensitivity.end();
+    libmesh_assert(_store);
+    return _store->has_sensitivity(_i, f);
 }
 
 
-const RealVectorX&
+Eigen::Map<const RealVectorX>
 MAST::StressStrainOutputBase::Data::
 get_stress_sensitivity(const MAST::FunctionBase& f) const {
     
-    // make sure that the data exists
-    std::map<const MAST::FunctionBase*, RealVectorX>::const_iterator
-    it = _stress_sensitivity.find(&f);
-    
-    libmesh_assert(it != _stress_sensitivity.end());
-    
-    
-    return it->second;
+    libmesh_assert(_store);
+    return _store->stress_sensitivity(_i, f);
 }
 
 
 
-const RealVectorX&
+Eigen::Map<const RealVectorX>
 MAST::StressStrainOutputBase::Data::
 get_strain_sensitivity(const MAST::FunctionBase& f) const {
     
-    // make sure that the data exists
-    std::map<const MAST::FunctionBase*, RealVectorX>::const_iterator
-    it = _strain_sensitivity.find(&f);
-    
-    libmesh_assert(it != _strain_sensitivity.end());
-    
-    
-    return it->second;
+    libmesh_assert(_store);
+    return _store->strain_sensitivity(_i, f);
 }
 
 
@@ -180,16 +606,8 @@ get_strain_sensitivity(const MAST::FunctionBase& f) const {
 Real
 MAST::StressStrainOutputBase::Data::von_Mises_stress() const {
     
-    // make sure that the data is available
-    libmesh_assert_equal_to(_stress.size(), 6);
-    
-    return
-    pow(0.5 * (pow(_stress(0)-_stress(1),2) +    //(((sigma_xx - sigma_yy)^2    +
-               pow(_stress(1)-_stress(2),2) +    //  (sigma_yy - sigma_zz)^2    +
-               pow(_stress(2)-_stress(0),2)) +   //  (sigma_zz - sigma_xx)^2)/2 +
-        3.0 * (pow(_stress(3), 2) +              // 3* (tau_xx^2 +
-               pow(_stress(4), 2) +              //     tau_yy^2 +
-               pow(_stress(5), 2)), 0.5);        //     tau_zz^2))^.5
+    libmesh_assert(_store);
+    return _store->von_Mises_stress()[_i];
 }
 
 
@@ -197,32 +615,12 @@ MAST::StressStrainOutputBase::Data::von_Mises_stress() const {
 RealVectorX
 MAST::StressStrainOutputBase::Data::dvon_Mises_stress_dX() const {
     
-    // make sure that the data is available
-    libmesh_assert_equal_to(_stress.size(), 6);
-    libmesh_assert_equal_to(_dstress_dX.rows(), 6);
-    
-    Real
-    p =
-    0.5 * (pow(_stress(0)-_stress(1),2) +    //((sigma_xx - sigma_yy)^2    +
-           pow(_stress(1)-_stress(2),2) +    // (sigma_yy - sigma_zz)^2    +
-           pow(_stress(2)-_stress(0),2)) +   // (sigma_zz - sigma_xx)^2)/2 +
-    3.0 * (pow(_stress(3), 2) +              // 3* (tau_xx^2 +
-           pow(_stress(4), 2) +              //     tau_yy^2 +
-           pow(_stress(5), 2));              //     tau_zz^2)
+    libmesh_assert(_store);
 
     RealVectorX
-    dp = RealVectorX::Zero(_dstress_dX.cols());
+    dp;
     
-    // if p == 0, then the sensitivity returns nan
-    // Hence, we are avoiding this by setting it to zero whenever p = 0.
-    if (fabs(p) > 0.)
-        dp =
-        (((_dstress_dX.row(0) - _dstress_dX.row(1)) * (_stress(0) - _stress(1)) +
-          (_dstress_dX.row(1) - _dstress_dX.row(2)) * (_stress(1) - _stress(2)) +
-          (_dstress_dX.row(2) - _dstress_dX.row(0)) * (_stress(2) - _stress(0))) +
-         6.0 * (_dstress_dX.row(3) * _stress(3)+
-                _dstress_dX.row(4) * _stress(4)+
-                _dstress_dX.row(5) * _stress(5))) * 0.5 * pow(p, -0.5);
+    _store->dvon_Mises_stress_dX(_i, dp);
     
     return dp;
 }
@@ -234,38 +632,8 @@ Real
 MAST::StressStrainOutputBase::Data::
 dvon_Mises_stress_dp(const MAST::FunctionBase& f) const {
     
-    // make sure that the data is available
-    libmesh_assert_equal_to(_stress.size(), 6);
-    
-    if (!this->has_stress_sensitivity(f))
-        return 0.;
-    
-    // get the stress sensitivity data
-    const RealVectorX dstress_dp = this->get_stress_sensitivity(f);
-    
-    
-    Real
-    p =
-    0.5 * (pow(_stress(0)-_stress(1),2) +    //((sigma_xx - sigma_yy)^2    +
-           pow(_stress(1)-_stress(2),2) +    // (sigma_yy - sigma_zz)^2    +
-           pow(_stress(2)-_stress(0),2)) +   // (sigma_zz - sigma_xx)^2)/2 +
-    3.0 * (pow(_stress(3), 2) +              // 3* (tau_xx^2 +
-           pow(_stress(4), 2) +              //     tau_yy^2 +
-           pow(_stress(5), 2)),              //     tau_zz^2)
-    dp = 0.;
-    
-    // if p == 0, then the sensitivity returns nan
-    // Hence, we are avoiding this by setting it to zero whenever p = 0.
-    if (fabs(p) > 0.)
-        dp =
-        (((dstress_dp(0) - dstress_dp(1)) * (_stress(0) - _stress(1)) +
-          (dstress_dp(1) - dstress_dp(2)) * (_stress(1) - _stress(2)) +
-          (dstress_dp(2) - dstress_dp(0)) * (_stress(2) - _stress(0))) +
-         6.0 * (dstress_dp(3) * _stress(3)+
-                dstress_dp(4) * _stress(4)+
-                dstress_dp(5) * _stress(5))) * 0.5 * pow(p, -0.5);
-    
-    return dp;
+    libmesh_assert(_store);
+    return _store->dvon_Mises_stress_dp(_i, f);
 }
 
 
@@ -281,7 +649,10 @@ _primal_data_initialized  (false),
 _JxW_val                  (0.),
 _sigma_vm_int             (0.),
 _sigma_vm_p_norm          (0.),
-_if_stress_plot_mode      (false) {
+_if_stress_plot_mode      (false),
+_if_streaming             (false),
+_sigma_vm_p_norm_sens     (0.),
+_streaming_max_vm         (0.) {
     
 }
 
@@ -302,6 +673,7 @@ MAST::StressStrainOutputBase::zero_for_analysis() {
     _JxW_val         = 0.;
     _sigma_vm_int    = 0.;
     _sigma_vm_p_norm = 0.;
+    _streaming_max_vm = 0.;
 }
 
 
@@ -309,7 +681,7 @@ MAST::StressStrainOutputBase::zero_for_analysis() {
 void
 MAST::StressStrainOutputBase::zero_for_sensitivity() {
 
-    // nothign to be done here.
+    _sigma_vm_p_norm_sens = 0.;
 }
 
 
@@ -320,12 +692,25 @@ MAST::StressStrainOutputBase::evaluate() {
     libmesh_assert(_physics_elem);
     libmesh_assert(!_primal_data_initialized);
 
-    if (this->if_evaluate_for_element(_physics_elem->elem()))
+    if (this->if_evaluate_for_element(_physics_elem->elem())) {
+        
         // ask for the values
         dynamic_cast<MAST::StructuralElementBase*>
         (_physics_elem)->calculate_stress(false,
                                           nullptr,
                                           *this);
+        
+        // in the streaming mode the values of this element are reduced
+        // into the functional and are not retained.
+        if (_if_streaming && !_if_stress_plot_mode) {
+            
+            libmesh_assert_greater(_sigma0, 0.);
+            this->_accumulate_functional(0, _stress_data.n_points());
+            _streaming_max_vm = std::max(_streaming_max_vm,
+                                         _stress_data.max_von_Mises_stress());
+            _stress_data.clear();
+        }
+    }
 }
 
 
@@ -340,11 +725,18 @@ MAST::StressStrainOutputBase::evaluate_sensitivity(const MAST::FunctionBase &f)
 
     if (this->if_evaluate_for_element(_physics_elem->elem())) {
         
-        // ask for the values
-        dynamic_cast<MAST::StructuralElementBase*>
-        (_physics_elem)->calculate_stress(false,
-                                          &f,
-                                          *this);
+        if (_if_streaming && !_if_stress_plot_mode) {
+            
+            // the contribution of this element is accumulated, since the
+            // data is not retained in the streaming mode
+            _sigma_vm_p_norm_sens += this->output_sensitivity_for_elem(f);
+        }
+        else
+            // ask for the values
+            dynamic_cast<MAST::StructuralElementBase*>
+            (_physics_elem)->calculate_stress(false,
+                                              &f,
+                                              *this);
     }
 }
 
@@ -361,6 +753,10 @@ evaluate_topology_sensitivity(const MAST::FunctionBase &f,
     if (!_if_stress_plot_mode)
         libmesh_assert(_primal_data_initialized);
     
+    // the boundary sensitivity needs the stress data of all elements
+    if (_if_streaming)
+        libmesh_error_msg("Topology sensitivity is not available in the streaming aggregation mode.");
+    
     const MAST::LevelSetIntersectedElem
     &elem = dynamic_cast<const MAST::LevelSetIntersectedElem&>(_physics_elem->elem());
 
@@ -387,8 +783,22 @@ MAST::StressStrainOutputBase::output_total() {
     libmesh_assert(!_if_stress_plot_mode);
     
     // if this has not been initialized, then we should do so now
-    if (!_primal_data_initialized)
-        this->functional_for_all_elems();
+    if (!_primal_data_initialized) {
+        
+        if (_if_streaming) {
+            
+            // the local integrals have been accumulated by evaluate().
+            // sum over all processors, since part of the mesh will exist
+            // on the other processors.
+            _system->system().comm().sum(_sigma_vm_int);
+            _system->system().comm().sum(_JxW_val);
+            
+            this->_finalize_functional();
+            _primal_data_initialized = true;
+        }
+        else
+            this->functional_for_all_elems();
+    }
     
     return _sigma_vm_p_norm;
 }
@@ -402,8 +812,27 @@ MAST::StressStrainOutputBase::output_sensitivity_for_elem(const MAST::FunctionBa
     
     Real val = 0.;
     
-    this->functional_sensitivity_for_elem
-    (p, _physics_elem->elem().get_quadrature_elem().id(), val);
+    if (_if_streaming) {
+        
+        // the element data is not retained in the streaming mode.
+        // Hence, it is recomputed here with the sensitivity for this element.
+        if (!this->if_evaluate_for_element(_physics_elem->elem()))
+            return val;
+        
+        MAST::StructuralElementBase&
+        e = dynamic_cast<MAST::StructuralElementBase&>(*_physics_elem);
+        
+        e.calculate_stress(false, nullptr, *this);
+        e.calculate_stress(false,      &p, *this);
+        
+        this->functional_sensitivity_for_elem
+        (p, _physics_elem->elem().get_quadrature_elem().id(), val);
+        
+        _stress_data.clear();
+    }
+    else
+        this->functional_sensitivity_for_elem
+        (p, _physics_elem->elem().get_quadrature_elem().id(), val);
     
     return val;
 }
@@ -439,13 +868,21 @@ MAST::StressStrainOutputBase::output_derivative_for_elem(RealVectorX& dq_dX) {
         
         dq_dX.setZero();
         
-        dynamic_cast<MAST::StructuralElementBase*>
-        (_physics_elem)->calculate_stress(true,
-                                          nullptr,
-                                          *this);
+        MAST::StructuralElementBase&
+        e = dynamic_cast<MAST::StructuralElementBase&>(*_physics_elem);
+        
+        // the primal data is not retained in the streaming mode, and is
+        // recomputed for this element before its derivative.
+        if (_if_streaming)
+            e.calculate_stress(false, nullptr, *this);
+        
+        e.calculate_stress(true, nullptr, *this);
         
         this->functional_state_derivartive_for_elem
         (_physics_elem->elem().get_quadrature_elem().id(), dq_dX);
+        
+        if (_if_streaming)
+            _stress_data.clear();
     }
 }
 
@@ -488,42 +925,7 @@ MAST::StressStrainOutputBase::init(const MAST::GeomElem& elem) {
 void
 MAST::StressStrainOutputBase::clear() {
     
-    std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >::iterator
-    map_it  =  _stress_data.begin(),
-    map_end =  _stress_data.end();
-    
-    for ( ; map_it != map_end; map_it++) {
-        
-        // iterate over all the data and delete them
-        std::vector<MAST::StressStrainOutputBase::Data*>::iterator
-        it   =  map_it->second.begin(),
-        end  =  map_it->second.end();
-        
-        for ( ; it != end; it++)
-            delete *it;
-        
-        map_it->second.clear();
-    }
-    
     _stress_data.clear();
-
-    
-    map_it  =  _boundary_stress_data.begin();
-    map_end =  _boundary_stress_data.end();
-    
-    for ( ; map_it != map_end; map_it++) {
-        
-        // iterate over all the data and delete them
-        std::vector<MAST::StressStrainOutputBase::Data*>::iterator
-        it   =  map_it->second.begin(),
-        end  =  map_it->second.end();
-        
-        for ( ; it != end; it++)
-            delete *it;
-        
-        map_it->second.clear();
-    }
-    
     _boundary_stress_data.clear();
 
     this->clear_elem();
@@ -532,6 +934,8 @@ MAST::StressStrainOutputBase::clear() {
     _JxW_val                 = 0.;
     _sigma_vm_int            = 0.;
     _sigma_vm_p_norm         = 0.;
+    _sigma_vm_p_norm_sens    = 0.;
+    _streaming_max_vm        = 0.;
     _if_stress_plot_mode     = false;
 }
 
@@ -541,35 +945,7 @@ MAST::StressStrainOutputBase::clear() {
 void
 MAST::StressStrainOutputBase::clear_sensitivity_data() {
     
-    std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >::iterator
-    map_it  =  _stress_data.begin(),
-    map_end =  _stress_data.end();
-    
-    for ( ; map_it != map_end; map_it++) {
-        
-        // iterate over all the data and delete them
-        std::vector<MAST::StressStrainOutputBase::Data*>::iterator
-        it   =  map_it->second.begin(),
-        end  =  map_it->second.end();
-        
-        for ( ; it != end; it++)
-            (*it)->clear_sensitivity_data();
-    }
-
-    
-    map_it  =  _boundary_stress_data.begin();
-    map_end =  _boundary_stress_data.end();
-    
-    for ( ; map_it != map_end; map_it++) {
-        
-        // iterate over all the data and delete them
-        std::vector<MAST::StressStrainOutputBase::Data*>::iterator
-        it   =  map_it->second.begin(),
-        end  =  map_it->second.end();
-        
-        for ( ; it != end; it++)
-            delete *it;
-    }
+    _stress_data.clear_sensitivity_data();
     _boundary_stress_data.clear();
 }
 
@@ -578,7 +954,7 @@ MAST::StressStrainOutputBase::clear_sensitivity_data() {
 
 
 
-MAST::StressStrainOutputBase::Data&
+MAST::StressStrainOutputBase::Data
 MAST::StressStrainOutputBase::
 add_stress_strain_at_qp_location(const MAST::GeomElem& e,
                                  const unsigned int qp,
@@ -593,39 +969,22 @@ add_stress_strain_at_qp_location(const MAST::GeomElem& e,
     if (_elem_subset.size())
         libmesh_assert(_elem_subset.count(&e.get_reference_elem()));
     
+    const unsigned int
+    i = _stress_data.add(e.get_quadrature_elem().id(),
+                         qp,
+                         stress,
+                         strain,
+                         quadrature_pt,
+                         physical_pt,
+                         JxW);
     
-    MAST::StressStrainOutputBase::Data* d =
-    new MAST::StressStrainOutputBase::Data (stress,
-                                            strain,
-                                            quadrature_pt,
-                                            physical_pt,
-                                            JxW);
-
-    
-    // check if the specified element exists in the map. If not, add it
-    std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >::iterator
-    it = _stress_data.find(e.get_quadrature_elem().id());
-    
-    // if the element does not exist in the map, add it to the map.
-    if (it == _stress_data.end())
-        it =
-        _stress_data.insert(std::pair<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >
-                            (e.get_quadrature_elem().id(),
-                             std::vector<MAST::StressStrainOutputBase::Data*>())).first;
-    else
-        // this assumes that the previous qp data is provided and
-        // therefore, this qp number should be == size of the vector.
-    libmesh_assert_equal_to(qp, it->second.size());
-    
-    it->second.push_back(d);
-    
-    return *d;
+    return MAST::StressStrainOutputBase::Data(_stress_data, i);
 }
 
 
 
 
-MAST::StressStrainOutputBase::Data&
+MAST::StressStrainOutputBase::Data
 MAST::StressStrainOutputBase::
 add_stress_strain_at_boundary_qp_location(const MAST::GeomElem& e,
                                           const unsigned int s,
@@ -641,40 +1000,22 @@ add_stress_strain_at_boundary_qp_location(const MAST::GeomElem& e,
     if (_elem_subset.size())
         libmesh_assert(_elem_subset.count(&e.get_reference_elem()));
     
+    const unsigned int
+    i = _boundary_stress_data.add(e.get_quadrature_elem().id(),
+                                  qp,
+                                  stress,
+                                  strain,
+                                  quadrature_pt,
+                                  physical_pt,
+                                  JxW_Vn);
     
-    MAST::StressStrainOutputBase::Data* d =
-    new MAST::StressStrainOutputBase::Data (stress,
-                                            strain,
-                                            quadrature_pt,
-                                            physical_pt,
-                                            JxW_Vn);
-    
-    
-    // check if the specified element exists in the map. If not, add it
-    std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >::iterator
-    it = _boundary_stress_data.find(e.get_quadrature_elem().id());
-    
-    // if the element does not exist in the map, add it to the map.
-    if (it == _boundary_stress_data.end())
-        it =
-        _boundary_stress_data.insert
-        (std::pair<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >
-         (e.get_quadrature_elem().id(),
-          std::vector<MAST::StressStrainOutputBase::Data*>())).first;
-    else
-        // this assumes that the previous qp data is provided and
-        // therefore, this qp number should be == size of the vector.
-        libmesh_assert_equal_to(qp, it->second.size());
-    
-    it->second.push_back(d);
-    
-    return *d;
+    return MAST::StressStrainOutputBase::Data(_boundary_stress_data, i);
 }
 
 
 
 
-const std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >&
+const MAST::StressStrainOutputBase::DataStore&
 MAST::StressStrainOutputBase::get_stress_strain_data() const {
     
     return _stress_data;
@@ -685,25 +1026,10 @@ MAST::StressStrainOutputBase::get_stress_strain_data() const {
 Real
 MAST::StressStrainOutputBase::get_maximum_von_mises_stress() const {
     
-    std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*>>::const_iterator
-    it  = _stress_data.begin(),
-    end = _stress_data.end();
-    
+    // the data is not retained in the streaming mode, and the maximum
+    // is tracked during evaluate()
     Real
-    vm     = 0.,
-    max_vm = 0.;
-    
-    for ( ; it != end; it++) {
-        
-        std::vector<MAST::StressStrainOutputBase::Data*>::const_iterator
-        s_it  = it->second.begin(),
-        s_end = it->second.end();
-        
-        for ( ; s_it != s_end; s_it++) {
-            vm = (*s_it)->von_Mises_stress();
-            max_vm =  vm>max_vm?vm:max_vm;
-        }
-    }
+    max_vm = _if_streaming? _streaming_max_vm: _stress_data.max_von_Mises_stress();
 
     // now, identify the max stress on all ranks.
     _system->system().comm().max(max_vm);
@@ -717,15 +1043,7 @@ unsigned int
 MAST::StressStrainOutputBase::
 n_stress_strain_data_for_elem(const MAST::GeomElem& e) const {
     
-    unsigned int n = 0;
-    
-    std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >::const_iterator
-    it = _stress_data.find(e.get_quadrature_elem().id());
-    
-    if ( it != _stress_data.end())
-        n = (unsigned int)it->second.size();
-    
-    return n;
+    return _stress_data.n_points_for_elem(e.get_quadrature_elem().id());
 }
 
 
@@ -734,51 +1052,39 @@ unsigned int
 MAST::StressStrainOutputBase::
 n_boundary_stress_strain_data_for_elem(const MAST::GeomElem& e) const {
     
-    unsigned int n = 0;
-    
-    std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >::const_iterator
-    it = _boundary_stress_data.find(e.get_quadrature_elem().id());
-    
-    if ( it != _boundary_stress_data.end())
-        n = (unsigned int)it->second.size();
-    
-    return n;
+    return _boundary_stress_data.n_points_for_elem(e.get_quadrature_elem().id());
 }
 
 
 
-const std::vector<MAST::StressStrainOutputBase::Data*>&
+std::vector<MAST::StressStrainOutputBase::Data>
 MAST::StressStrainOutputBase::
-get_stress_strain_data_for_elem(const MAST::GeomElem& e) const {
+get_stress_strain_data_for_elem(const MAST::GeomElem& e) {
     
-    // check if the specified element exists in the map. If not, add it
-    std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >::const_iterator
-    it = _stress_data.find(e.get_quadrature_elem().id());
-
-    // make sure that the specified elem exists in the map
-    libmesh_assert(it != _stress_data.end());
+    unsigned int
+    begin = 0,
+    end   = 0;
+    
+    _stress_data.elem_range(e.get_quadrature_elem().id(), begin, end);
     
-    return it->second;
+    std::vector<MAST::StressStrainOutputBase::Data> data;
+    data.reserve(end-begin);
+    
+    for (unsigned int i=begin; i<end; i++)
+        data.push_back(MAST::StressStrainOutputBase::Data(_stress_data, i));
+    
+    return data;
 }
 
 
 
-MAST::StressStrainOutputBase::Data&
+MAST::StressStrainOutputBase::Data
 MAST::StressStrainOutputBase::
 get_stress_strain_data_for_elem_at_qp(const MAST::GeomElem& e,
                                       const unsigned int qp) {
 
-    
-    // check if the specified element exists in the map. If not, add it
-    std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >::const_iterator
-    it = _stress_data.find(e.get_quadrature_elem().id());
-    
-    // make sure that the specified elem exists in the map
-    libmesh_assert(it != _stress_data.end());
-    
-    libmesh_assert_less(qp, it->second.size());
-    
-    return *(it->second[qp]);
+    return MAST::StressStrainOutputBase::Data
+    (_stress_data, _stress_data.index(e.get_quadrature_elem().id(), qp));
 }
 
 
@@ -823,60 +1129,66 @@ MAST::StressStrainOutputBase::functional_for_all_elems() {
     
     libmesh_assert(!_if_stress_plot_mode);
     libmesh_assert(!_primal_data_initialized);
+    libmesh_assert(!_if_streaming);
     libmesh_assert_greater(_sigma0, 0.);
     
-    Real
-    sp               = 0.,
-    exp_sp           = 0.,
-    e_val            = 0.,
-    JxW              = 0.;
-    
     _JxW_val         = 0.;
     _sigma_vm_int    = 0.;
     _sigma_vm_p_norm = 0.;
     
-    // first find the data with the maximum value, to be used for scaling
-    
-    // iterate over all element data
-    std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >::const_iterator
-    map_it   =  _stress_data.begin(),
-    map_end  =  _stress_data.end();
-    
-    for ( ; map_it != map_end; map_it++) {
-        
-        std::vector<MAST::StressStrainOutputBase::Data*>::const_iterator
-        vec_it   = map_it->second.begin(),
-        vec_end  = map_it->second.end();
-        
-        for ( ; vec_it != vec_end; vec_it++) {
-            
-            // ask this data point for the von Mises stress value
-            e_val    =   (*vec_it)->von_Mises_stress();
-            JxW      =   (*vec_it)->quadrature_point_JxW();
-            
-            // we do not use absolute value here, since von Mises stress
-            // is >= 0.
-            sp              =  pow((e_val-_sigma0)/_sigma0, _p_norm_weight);
-            if (_rho * sp > _exp_arg_lim)
-                exp_sp          =  exp(_exp_arg_lim);
-            else
-                exp_sp          =  exp(_rho * sp);
-            _sigma_vm_int  +=  pow(e_val/_sigma0, _p_norm_stress) * exp_sp * JxW;
-            _JxW_val       +=  exp_sp * JxW;
-        }
-    }
+    this->_accumulate_functional(0, _stress_data.n_points());
     
     // sum over all processors, since part of the mesh will exist on the
     // other processors.
     _system->system().comm().sum(_sigma_vm_int);
     _system->system().comm().sum(_JxW_val);
 
-    _sigma_vm_p_norm         = _sigma0 * pow(_sigma_vm_int/_JxW_val, 1./_p_norm_stress);
+    this->_finalize_functional();
     _primal_data_initialized = true;
 }
 
 
 
+void
+MAST::StressStrainOutputBase::_accumulate_functional(const unsigned int begin,
+                                                     const unsigned int end) {
+    
+    Real
+    sp               = 0.,
+    exp_sp           = 0.,
+    e_val            = 0.;
+    
+    // iterate over the contiguous data of the points
+    const Real
+    *vm     = _stress_data.von_Mises_stress().data(),
+    *JxW    = _stress_data.JxW().data();
+    
+    for (unsigned int i=begin; i<end; i++) {
+        
+        e_val    =   vm[i];
+        
+        // we do not use absolute value here, since von Mises stress
+        // is >= 0.
+        sp              =  pow((e_val-_sigma0)/_sigma0, _p_norm_weight);
+        if (_rho * sp > _exp_arg_lim)
+            exp_sp          =  exp(_exp_arg_lim);
+        else
+            exp_sp          =  exp(_rho * sp);
+        _sigma_vm_int  +=  pow(e_val/_sigma0, _p_norm_stress) * exp_sp * JxW[i];
+        _JxW_val       +=  exp_sp * JxW[i];
+    }
+}
+
+
+
+void
+MAST::StressStrainOutputBase::_finalize_functional() {
+    
+    _sigma_vm_p_norm = _sigma0 * pow(_sigma_vm_int/_JxW_val, 1./_p_norm_stress);
+}
+
+
+
 void
 MAST::StressStrainOutputBase::functional_sensitivity_for_all_elems
 (const MAST::FunctionBase& f,
@@ -890,10 +1202,19 @@ MAST::StressStrainOutputBase::functional_sensitivity_for_all_elems
     
     dsigma_vm_val_df = 0.;
     
+    // in the streaming mode the contributions of the elements have been
+    // accumulated by evaluate_sensitivity()
+    if (_if_streaming) {
+        
+        dsigma_vm_val_df = _sigma_vm_p_norm_sens;
+        _system->system().comm().sum(dsigma_vm_val_df);
+        return;
+    }
+    
     // iterate over all element data
-    std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >::const_iterator
-    map_it   =  _stress_data.begin(),
-    map_end  =  _stress_data.end();
+    std::map<const libMesh::dof_id_type, std::pair<unsigned int, unsigned int>>::const_iterator
+    map_it   =  _stress_data.elem_offsets().begin(),
+    map_end  =  _stress_data.elem_offsets().end();
     
     for ( ; map_it != map_end; map_it++) {
         
@@ -923,9 +1244,9 @@ MAST::StressStrainOutputBase::functional_boundary_sensitivity_for_all_elems
     dsigma_vm_val_df = 0.;
     
     // iterate over all element data
-    std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >::const_iterator
-    map_it   =  _boundary_stress_data.begin(),
-    map_end  =  _boundary_stress_data.end();
+    std::map<const libMesh::dof_id_type, std::pair<unsigned int, unsigned int>>::const_iterator
+    map_it   =  _boundary_stress_data.elem_offsets().begin(),
+    map_end  =  _boundary_stress_data.elem_offsets().end();
     
     for ( ; map_it != map_end; map_it++) {
         
@@ -964,23 +1285,19 @@ MAST::StressStrainOutputBase::functional_sensitivity_for_elem
     
     dsigma_vm_val_df = 0.;
     
-    // iterate over all element data
-    std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >::const_iterator
-    map_it   =  _stress_data.find(e_id),
-    map_end  =  _stress_data.end();
-    
-    libmesh_assert(map_it != map_end);
+    // iterate over the points of this element
+    unsigned int
+    begin    = 0,
+    end      = 0;
     
-    std::vector<MAST::StressStrainOutputBase::Data*>::const_iterator
-    vec_it   = map_it->second.begin(),
-    vec_end  = map_it->second.end();
+    _stress_data.elem_range(e_id, begin, end);
     
-    for ( ; vec_it != vec_end; vec_it++) {
+    for (unsigned int i=begin; i<end; i++) {
         
         // ask this data point for the von Mises stress value
-        e_val    =   (*vec_it)->von_Mises_stress();
-        de_val   =   (*vec_it)->dvon_Mises_stress_dp(f);
-        JxW      =   (*vec_it)->quadrature_point_JxW();
+        e_val    =   _stress_data.von_Mises_stress()[i];
+        de_val   =   _stress_data.dvon_Mises_stress_dp(i, f);
+        JxW      =   _stress_data.JxW()[i];
         
         // we do not use absolute value here, since von Mises stress
         // is >= 0.
@@ -1031,22 +1348,21 @@ MAST::StressStrainOutputBase::functional_boundary_sensitivity_for_elem
 
     dsigma_vm_val_df = 0.;
     
-    // iterate over all element data
-    std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >::const_iterator
-    map_it   =  _boundary_stress_data.find(e_id),
-    map_end  =  _boundary_stress_data.end();
+    // iterate over the boundary points of this element
+    unsigned int
+    begin    = 0,
+    end      = 0;
     
-    libmesh_assert(map_it != map_end);
+    _boundary_stress_data.elem_range(e_id, begin, end);
     
-    std::vector<MAST::StressStrainOutputBase::Data*>::const_iterator
-    vec_it   = map_it->second.begin(),
-    vec_end  = map_it->second.end();
+    const Real
+    *vm     = _boundary_stress_data.von_Mises_stress().data(),
+    *JxW    = _boundary_stress_data.JxW().data();
     
-    for ( ; vec_it != vec_end; vec_it++) {
+    for (unsigned int i=begin; i<end; i++) {
         
-        // ask this data point for the von Mises stress value
-        e_val    =   (*vec_it)->von_Mises_stress();
-        JxW_Vn   =   (*vec_it)->quadrature_point_JxW();
+        e_val    =   vm[i];
+        JxW_Vn   =   JxW[i];
         
         // we do not use absolute value here, since von Mises stress
         // is >= 0.
@@ -1088,27 +1404,19 @@ MAST::StressStrainOutputBase::functional_state_derivartive_for_elem(const libMes
     de_val         = RealVectorX::Zero(dq_dX.size());
     dq_dX.setZero();
     
-    // first find the data with the maximum value, to be used for scaling
-    
-    // iterate over all element data
-    std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*> >::const_iterator
-    map_it   =  _stress_data.find(e_id),
-    map_end  =  _stress_data.end();
-
-    // make sure that the data exists
-    libmesh_assert(map_it != map_end);
-    
-    std::vector<MAST::StressStrainOutputBase::Data*>::const_iterator
-    vec_it   = map_it->second.begin(),
-    vec_end  = map_it->second.end();
+    // iterate over the points of this element
+    unsigned int
+    begin    = 0,
+    end      = 0;
     
+    _stress_data.elem_range(e_id, begin, end);
     
-    for ( ; vec_it != vec_end; vec_it++) {
+    for (unsigned int i=begin; i<end; i++) {
         
         // ask this data point for the von Mises stress value
-        e_val    =   (*vec_it)->von_Mises_stress();
-        de_val   =   (*vec_it)->dvon_Mises_stress_dX();
-        JxW      =   (*vec_it)->quadrature_point_JxW();
+        e_val    =   _stress_data.von_Mises_stress()[i];
+        JxW      =   _stress_data.JxW()[i];
+        _stress_data.dvon_Mises_stress_dX(i, de_val);
         
         // we do not use absolute value here, since von Mises stress
         // is >= 0.
@@ -1119,7 +1427,6 @@ MAST::StressStrainOutputBase::functional_state_derivartive_for_elem(const libMes
         if (_rho*sp_weight > _exp_arg_lim) {
             
             exp_sp       =  exp(_exp_arg_lim);
-            denom_sens  +=  0. * de_val;
             num_sens    +=  1. * _p_norm_stress * sp1_stress * exp_sp/_sigma0 * JxW * de_val;
         }
         else {
@@ -1135,7 +1442,3 @@ MAST::StressStrainOutputBase::functional_state_derivartive_for_elem(const libMes
     dq_dX = _sigma0/_p_norm_stress * pow(_sigma_vm_int/_JxW_val, 1./_p_norm_stress - 1.) *
     (num_sens / _JxW_val - _sigma_vm_int / pow(_JxW_val, 2.) * denom_sens);
 }
-
-
-
-
@@ -65,19 +65,297 @@ namespace MAST {
     
         
         /*!
-         *    This class provides a mechanism to store stress/strain values,
-         *    their derivatives and sensitivity values corresponding to a 
-         *    specific quadrature point on the element.
+         *    Contiguous storage of the stress/strain data at all points
+         *    for which data has been added to the output object. The
+         *    point values are stored as flat arrays (structure-of-arrays):
+         *    six stress and six strain components per point, followed by
+         *    the JxW and the von Mises stress of each point. The points of
+         *    an element occupy a contiguous range of indices, which is
+         *    identified by the offset and number of points stored for the
+         *    element id. Derivatives with respect to the state vector and
+         *    sensitivities with respect to parameters are stored in separate
+         *    blocks that are only allocated when set, so that the
+         *    functional reductions can stream over the primal values alone.
+         */
+        class DataStore {
+            
+        public:
+            
+            DataStore();
+            
+            /*!
+             *   removes all data from the store
+             */
+            void clear();
+            
+            /*!
+             *   removes the sensitivity data of all points
+             */
+            void clear_sensitivity_data();
+            
+            /*!
+             *   adds the data for quadrature point \p qp of element \p e_id
+             *   and @returns the index of the point in the store. All points
+             *   of an element must be added before data is added for the
+             *   next element.
+             */
+            unsigned int add(const libMesh::dof_id_type e_id,
+                             const unsigned int qp,
+                             const RealVectorX& stress,
+                             const RealVectorX& strain,
+                             const libMesh::Point& qp_pt,
+                             const libMesh::Point& xyz,
+                             Real JxW);
+            
+            /*!
+             *   @returns the number of points stored
+             */
+            unsigned int n_points() const {
+                return (unsigned int)_JxW.size();
+            }
+            
+            /*!
+             *   @returns the number of elements stored
+             */
+            unsigned int n_elems() const {
+                return (unsigned int)_elem_offsets.size();
+            }
+            
+            /*!
+             *   @returns the number of points stored for element \p e_id
+             */
+            unsigned int n_points_for_elem(const libMesh::dof_id_type e_id) const;
+            
+            /*!
+             *   @returns the map of element id to the pair of offset and
+             *   number of points of the element in the store
+             */
+            const std::map<const libMesh::dof_id_type, std::pair<unsigned int, unsigned int>>&
+            elem_offsets() const {
+                return _elem_offsets;
+            }
+            
+            /*!
+             *   @returns the range of point indices, \p [begin, end), that
+             *   are stored for element \p e_id
+             */
+            void elem_range(const libMesh::dof_id_type e_id,
+                            unsigned int& begin,
+                            unsigned int& end) const;
+            
+            /*!
+             *   @returns the index of point \p qp of element \p e_id
+             */
+            unsigned int index(const libMesh::dof_id_type e_id,
+                               const unsigned int qp) const;
+            
+            /*!
+             *   @returns the contiguous vector of von Mises stress values
+             *   of all points
+             */
+            const std::vector<Real>& von_Mises_stress() const {
+                return _von_Mises;
+            }
+            
+            /*!
+             *   @returns the contiguous vector of JxW values of all points
+             */
+            const std::vector<Real>& JxW() const {
+                return _JxW;
+            }
+            
+            /*!
+             *   @returns the six stress components of point \p i
+             */
+            Eigen::Map<const RealVectorX> stress(const unsigned int i) const {
+                return Eigen::Map<const RealVectorX>(&_stress[6*i], 6);
+            }
+            
+            /*!
+             *   @returns the six strain components of point \p i
+             */
+            Eigen::Map<const RealVectorX> strain(const unsigned int i) const {
+                return Eigen::Map<const RealVectorX>(&_strain[6*i], 6);
+            }
+            
+            /*!
+             *   @returns the location of point \p i in the element
+             *   coordinate system
+             */
+            const libMesh::Point& qp_location(const unsigned int i) const {
+                return _qp[i];
+            }
+            
+            /*!
+             *   @returns the location of point \p i in the physical
+             *   coordinate system
+             */
+            const libMesh::Point& physical_location(const unsigned int i) const {
+                return _xyz[i];
+            }
+            
+            /*!
+             *   sets the derivative of stress and strain of point \p i
+             *   with respect to the element state vector
+             */
+            void set_derivatives(const unsigned int i,
+                                 const RealMatrixX& dstress_dX,
+                                 const RealMatrixX& dstrain_dX);
+            
+            /*!
+             *   @returns the derivative of stress of point \p i
+             *   with respect to the element state vector
+             */
+            Eigen::Map<const RealMatrixX> dstress_dX(const unsigned int i) const;
+            
+            /*!
+             *   @returns the derivative of strain of point \p i
+             *   with respect to the element state vector
+             */
+            Eigen::Map<const RealMatrixX> dstrain_dX(const unsigned int i) const;
+            
+            /*!
+             *   sets the sensitivity of stress and strain of point \p i
+             *   with respect to the function \p f
+             */
+            void set_sensitivity(const unsigned int i,
+                                 const MAST::FunctionBase& f,
+                                 const RealVectorX& dstress_df,
+                                 const RealVectorX& dstrain_df);
+            
+            /*!
+             *   @returns true if sensitivity of point \p i is available
+             *   for function \p f
+             */
+            bool has_sensitivity(const unsigned int i,
+                                 const MAST::FunctionBase& f) const;
+            
+            /*!
+             *   @returns the sensitivity of stress of point \p i with
+             *   respect to function \p f
+             */
+            Eigen::Map<const RealVectorX>
+            stress_sensitivity(const unsigned int i,
+                               const MAST::FunctionBase& f) const;
+            
+            /*!
+             *   @returns the sensitivity of strain of point \p i with
+             *   respect to function \p f
+             */
+            Eigen::Map<const RealVectorX>
+            strain_sensitivity(const unsigned int i,
+                               const MAST::FunctionBase& f) const;
+            
+            /*!
+             *   removes the sensitivity data of point \p i
+             */
+            void clear_sensitivity_data(const unsigned int i);
+            
+            /*!
+             *   calculates the derivative of von Mises stress of point \p i
+             *   wrt the state vector in \p dvm_dX.
+             */
+            void dvon_Mises_stress_dX(const unsigned int i,
+                                      RealVectorX& dvm_dX) const;
+            
+            /*!
+             *   @returns the derivative of von Mises stress of point \p i
+             *   wrt function \p f. Zero is returned if the sensitivity of
+             *   the point is not available.
+             */
+            Real dvon_Mises_stress_dp(const unsigned int i,
+                                      const MAST::FunctionBase& f) const;
+            
+            /*!
+             *   @returns the maximum value of the stress and strain
+             *   components, and of the von Mises stress over all points
+             *   of element \p e_id. If \p p is provided and the element
+             *   has a single point, then the sensitivity values are returned.
+             */
+            void max_values_for_elem(const libMesh::dof_id_type e_id,
+                                     RealVectorX& max_strain,
+                                     RealVectorX& max_stress,
+                                     Real& max_vm,
+                                     const MAST::FunctionBase* p) const;
+            
+            /*!
+             *   @returns the maximum von Mises stress of all points
+             */
+            Real max_von_Mises_stress() const;
+            
+        protected:
+            
+            /*!
+             *   sensitivity of stress and strain with respect to a parameter.
+             *   Only the points for which the sensitivity is set are stored:
+             *   \p offset maps the point index to the offset of its six
+             *   components in \p dstress and \p dstrain, so that a parameter
+             *   with a local influence, for instance a topology design
+             *   variable, does not allocate storage for all points.
+             */
+            struct SensitivityBlock {
+                std::map<unsigned int, unsigned int>  offset;
+                std::vector<Real>                     dstress;
+                std::vector<Real>                     dstrain;
+            };
+            
+            /*!
+             *   stress and strain data, six components per point
+             */
+            std::vector<Real>              _stress;
+            std::vector<Real>              _strain;
+            
+            /*!
+             *   JxW and von Mises stress of each point
+             */
+            std::vector<Real>              _JxW;
+            std::vector<Real>              _von_Mises;
+            
+            /*!
+             *   quadrature point location in element and physical coordinates
+             */
+            std::vector<libMesh::Point>    _qp;
+            std::vector<libMesh::Point>    _xyz;
+            
+            /*!
+             *   offset and number of points for each element
+             */
+            std::map<const libMesh::dof_id_type, std::pair<unsigned int, unsigned int>>
+            _elem_offsets;
+            
+            /*!
+             *   derivative block. For point \p i, \p _dX_offset[i] is the
+             *   offset of the column-major 6 x \p _dX_cols[i] matrices in
+             *   \p _dstress_dX and \p _dstrain_dX. The vectors remain empty
+             *   until a derivative is set.
+             */
+            std::vector<unsigned int>      _dX_offset;
+            std::vector<unsigned int>      _dX_cols;
+            std::vector<Real>              _dstress_dX;
+            std::vector<Real>              _dstrain_dX;
+            
+            /*!
+             *   sensitivity data for each parameter
+             */
+            std::map<const MAST::FunctionBase*, SensitivityBlock> _sensitivity;
+        };
+        
+        
+        /*!
+         *    This class provides access to the stress/strain values,
+         *    their derivatives and sensitivity values corresponding to a
+         *    specific quadrature point on the element. The data is stored
+         *    in \p DataStore, and this object only refers to it.
          */
         class Data {
             
         public:
-            Data(const RealVectorX& stress,
-                 const RealVectorX& strain,
-                 const libMesh::Point& qp,
-                 const libMesh::Point& xyz,
-                 Real JxW);
- 
+            
+            Data();
+            
+            Data(MAST::StressStrainOutputBase::DataStore& store,
+                 const unsigned int i);
+            
             
             void clear_sensitivity_data();
             
@@ -92,13 +370,13 @@ namespace MAST {
             /*!
              *   @returns stress
              */
-            const RealVectorX& stress() const;
+            Eigen::Map<const RealVectorX> stress() const;
 
             
             /*!
              *   @returns strain
              */
-            const RealVectorX& strain() const;
+            Eigen::Map<const RealVectorX> strain() const;
             
             
             /*!
@@ -134,13 +412,13 @@ namespace MAST {
             /*!
              *   @return the derivative data
              */
-            const RealMatrixX& get_dstress_dX() const;
+            Eigen::Map<const RealMatrixX> get_dstress_dX() const;
 
             
             /*!
              *   @return the derivative data
              */
-            const RealMatrixX& get_dstrain_dX() const;
+            Eigen::Map<const RealMatrixX> get_dstrain_dX() const;
 
             
             /*!
@@ -162,7 +440,7 @@ namespace MAST {
              *   @ returns the sensitivity of the data with respect to a 
              *   function
              */
-            const RealVectorX&
+            Eigen::Map<const RealVectorX>
             get_stress_sensitivity(const MAST::FunctionBase& f) const;
 
             
@@ -170,64 +448,21 @@ namespace MAST {
              *   @ returns the sensitivity of the data with respect to a
              *   function
              */
-            const RealVectorX&
+            Eigen::Map<const RealVectorX>
             get_strain_sensitivity(const MAST::FunctionBase& f) const;
 
             
         protected:
 
             /*!
-             *   stress data
-             */
-            RealVectorX                   _stress;
-            
-            
-            /*!
-             *  strain data
-             */
-            RealVectorX                   _strain;
-            
-            
-            /*!
-             *  map of sensitivity of the stress with respect to a parameter
-             */
-            std::map<const MAST::FunctionBase*, RealVectorX> _stress_sensitivity;
-
-            
-            /*!
-             *  map of sensitivity of the strain with respect to a parameter
-             */
-            std::map<const MAST::FunctionBase*, RealVectorX> _strain_sensitivity;
-
-            
-            /*!
-             *   derivative of stress wrt state vector
-             */
-            RealMatrixX   _dstress_dX;
-
-            /*!
-             *   derivative of strain data wrt state vector
-             */
-            RealMatrixX   _dstrain_dX;
-
-            
-            /*!
-             *   quadrature point location in element coordinates
-             */
-            libMesh::Point            _qp;
-            
-            
-            /*!
-             *   quadrature point location in physical coordinates
+             *   store in which the data of this point is stored
              */
-            libMesh::Point            _xyz;
-            
+            MAST::StressStrainOutputBase::DataStore*  _store;
             
             /*!
-             *   quadrature point JxW (product of transformation Jacobian and
-             *   quadrature weight) for use in definition of functionals
+             *   index of the point in the store
              */
-            Real _JxW;
+            unsigned int                              _i;
         };
         
 
@@ -270,6 +505,31 @@ namespace MAST {
         }
          
         
+        /*!
+         *   tells the object to use the streaming aggregation mode. In this
+         *   mode, the stress values at the quadrature points of an element
+         *   are reduced into the functional during the element loop and are
+         *   not retained once the element has been processed. The derivative
+         *   and sensitivity of the functional are computed by recomputing
+         *   the element stress in a second pass, using the globally reduced
+         *   functional. This mode is not applicable for plotting of
+         *   stress, for topology sensitivity, or when the stress data of all
+         *   elements needs to be accessed after \p evaluate().
+         */
+        void set_streaming_aggregation(bool f) {
+            
+            _if_streaming = f;
+        }
+        
+        /*!
+         *   @returns true if the streaming aggregation mode is used.
+         */
+        bool streaming_aggregation() const {
+            
+            return _if_streaming;
+        }
+        
+        
         /*!
          *   sets the structural element y-vector if 1D element is used.
          */
@@ -430,10 +690,10 @@ namespace MAST {
         
         
         /*!
-         *   add the stress tensor associated with the qp. @returns a reference
-         *   to \p Data.
+         *   add the stress tensor associated with the qp. @returns the
+         *   \p Data object that refers to the stored point.
          */
-        virtual MAST::StressStrainOutputBase::Data&
+        virtual MAST::StressStrainOutputBase::Data
         add_stress_strain_at_qp_location(const MAST::GeomElem& e,
                                          const unsigned int qp,
                                          const libMesh::Point& quadrature_pt,
@@ -445,9 +705,10 @@ namespace MAST {
         
         /*!
          *   add the stress tensor associated with the \p qp on side \p s of
-         *   element \p e. @returns a reference to \p Data.
+         *   element \p e. @returns the \p Data object that refers to the
+         *   stored point.
          */
-        virtual MAST::StressStrainOutputBase::Data&
+        virtual MAST::StressStrainOutputBase::Data
         add_stress_strain_at_boundary_qp_location(const MAST::GeomElem& e,
                                                   const unsigned int s,
                                                   const unsigned int qp,
@@ -460,30 +721,30 @@ namespace MAST {
         
         
         /*!
-         *    @returns the map of stress/strain data for all elems
+         *    @returns the store of stress/strain data for all elems
          */
-        virtual const std::map<const libMesh::dof_id_type,
-        std::vector<MAST::StressStrainOutputBase::Data*> >&
+        virtual const MAST::StressStrainOutputBase::DataStore&
         get_stress_strain_data() const;
 
         
         /*!
-         *   @returns the maximum von Mises stress of all stored components
+         *   @returns the maximum von Mises stress of all stored components,
+         *   or of all evaluated elements in the streaming aggregation mode
          */
         Real get_maximum_von_mises_stress() const;
         
         /*!
          *    @returns the vector of stress/strain data for specified elem.
          */
-        virtual const std::vector<MAST::StressStrainOutputBase::Data*>&
-        get_stress_strain_data_for_elem(const MAST::GeomElem& e) const;
+        virtual std::vector<MAST::StressStrainOutputBase::Data>
+        get_stress_strain_data_for_elem(const MAST::GeomElem& e);
 
         
         /*!
          *    @returns the vector of stress/strain data for specified elem at
          *    the specified quadrature point.
          */
-        virtual MAST::StressStrainOutputBase::Data&
+        virtual MAST::StressStrainOutputBase::Data
         get_stress_strain_data_for_elem_at_qp(const MAST::GeomElem& e,
                                               const unsigned int qp);
 
@@ -571,6 +832,21 @@ namespace MAST {
         
     protected:
 
+        /*!
+         *   adds the contribution of the points \p [begin, end) in
+         *   \p _stress_data to the local integrals \p _sigma_vm_int and
+         *   \p _JxW_val.
+         */
+        virtual void _accumulate_functional(const unsigned int begin,
+                                            const unsigned int end);
+        
+        /*!
+         *   computes \p _sigma_vm_p_norm from the integrals
+         *   \p _sigma_vm_int and \p _JxW_val that have been summed over
+         *   all processors.
+         */
+        virtual void _finalize_functional();
+        
         /*!
          *   \f$ p-\f$norm to be used for calculation of output stress function.
          *    Default value is 2.0.
@@ -604,17 +880,33 @@ namespace MAST {
         bool _if_stress_plot_mode;
         
         /*!
-         *    vector of stress with the associated location details
+         *   if true, the element data is reduced into the functional
+         *   during the element loop and is not retained.
+         */
+        bool _if_streaming;
+        
+        /*!
+         *   sensitivity of the functional accumulated over the elements
+         *   processed in the streaming aggregation mode.
+         */
+        Real _sigma_vm_p_norm_sens;
+        
+        /*!
+         *   maximum von Mises stress of the elements processed in the
+         *   streaming aggregation mode.
+         */
+        Real _streaming_max_vm;
+        
+        /*!
+         *    stress with the associated location details
          */
-        std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*>>
-        _stress_data;
+        MAST::StressStrainOutputBase::DataStore   _stress_data;
 
 
         /*!
-         *    vector of stress with the associated location details
+         *    boundary stress with the associated location details
          */
-        std::map<const libMesh::dof_id_type, std::vector<MAST::StressStrainOutputBase::Data*>>
-        _boundary_stress_data;
+        MAST::StressStrainOutputBase::DataStore   _boundary_stress_data;
     };
 }
 
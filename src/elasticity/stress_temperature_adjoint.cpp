@@ -105,7 +105,8 @@ MAST::StressTemperatureAdjoint::output_derivative_for_elem(RealVectorX& dq_dX) {
     libmesh_assert(_physics_elem);
     libmesh_assert(!_stress.stress_plot_mode());
     libmesh_assert(_stress.primal_data_initialized());
-
+    // the stress data of all elements is needed from the structural output
+    libmesh_assert(!_stress.streaming_aggregation());
 
     
     dq_dX.setZero();
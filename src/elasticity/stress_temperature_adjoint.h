@@ -75,7 +75,7 @@ namespace MAST {
         virtual void output_derivative_for_elem(RealVectorX& dq_dX);
         
 
-        virtual MAST::StressStrainOutputBase::Data&
+        virtual MAST::StressStrainOutputBase::Data
         add_stress_strain_at_qp_location(const MAST::GeomElem& e,
                                          const unsigned int qp,
                                          const libMesh::Point& quadrature_pt,
@@ -89,9 +89,10 @@ namespace MAST {
 
         /*!
          *   add the stress tensor associated with the \p qp on side \p s of
-         *   element \p e. @returns a reference to \p Data.
+         *   element \p e. @returns the \p Data object that refers to the
+         *   stored point.
          */
-        virtual MAST::StressStrainOutputBase::Data&
+        virtual MAST::StressStrainOutputBase::Data
         add_stress_strain_at_boundary_qp_location(const MAST::GeomElem& e,
                                                   const unsigned int s,
                                                   const unsigned int qp,
@@ -107,17 +108,16 @@ namespace MAST {
          *    @returns the vector of stress/strain data for specified elem at
          *    the specified quadrature point.
          */
-        virtual MAST::StressStrainOutputBase::Data&
+        virtual MAST::StressStrainOutputBase::Data
         get_stress_strain_data_for_elem_at_qp(const MAST::GeomElem& e,
                                               const unsigned int qp) {
             libmesh_error(); // should not get called
         }
         
         /*!
-         *    @returns the map of stress/strain data for all elems
+         *    @returns the store of stress/strain data for all elems
          */
-        virtual const std::map<const libMesh::dof_id_type,
-        std::vector<MAST::StressStrainOutputBase::Data*> >&
+        virtual const MAST::StressStrainOutputBase::DataStore&
         get_stress_strain_data() const {
             libmesh_error(); // should not get called
         }
@@ -126,8 +126,8 @@ namespace MAST {
         /*!
          *    @returns the vector of stress/strain data for specified elem.
          */
-        virtual const std::vector<MAST::StressStrainOutputBase::Data*>&
-        get_stress_strain_data_for_elem(const MAST::GeomElem& e) const {
+        virtual std::vector<MAST::StressStrainOutputBase::Data>
+        get_stress_strain_data_for_elem(const MAST::GeomElem& e) {
             libmesh_error(); // should not get called
         }
 
@@ -22,6 +22,7 @@
 #include "elasticity/piston_theory_boundary_condition.h"
 #include "elasticity/stress_output_base.h"
 #include "elasticity/bending_operator.h"
+#include "elasticity/timoshenko_bending_operator.h"
 #include "numerics/fem_operator_matrix.h"
 #include "property_cards/element_property_card_1D.h"
 #include "property_cards/material_property_card_base.h"
@@ -57,11 +58,26 @@ initialize_direct_strain_operator(const unsigned int qp,
                                   const MAST::FEBase& fe,
                                   MAST::FEMOperatorMatrix& Bmat) {
     
+    RealVectorX phi   = RealVectorX::Zero(fe.get_dphi().size());
+    
+    _direct_strain_operator(qp, fe, phi, Bmat);
+}
+
+
+
+template <typename PhiVecType>
+void
+MAST::StructuralElement1D::
+_direct_strain_operator(const unsigned int qp,
+                        const MAST::FEBase& fe,
+                        PhiVecType& phi,
+                        MAST::FEMOperatorMatrix& Bmat) {
+    
     const std::vector<std::vector<libMesh::RealVectorValue> >& dphi = fe.get_dphi();
     
     unsigned int n_phi = (unsigned int)dphi.size();
-    RealVectorX phi   = RealVectorX::Zero(n_phi);
     
+    libmesh_assert_equal_to(phi.size(), n_phi);
     libmesh_assert_equal_to(Bmat.m(), 2);
     libmesh_assert_equal_to(Bmat.n(), 6*n_phi);
     libmesh_assert_less    (qp, dphi[0].size());
@@ -86,16 +102,48 @@ initialize_von_karman_strain_operator(const unsigned int qp,
                                       MAST::FEMOperatorMatrix& Bmat_v_vk,
                                       MAST::FEMOperatorMatrix& Bmat_w_vk) {
     
-    const std::vector<std::vector<libMesh::RealVectorValue> >& dphi = fe.get_dphi();
-    const unsigned int n_phi = (unsigned int)dphi.size();
-    
     libmesh_assert_equal_to(vk_strain.size(), 2);
     libmesh_assert_equal_to(vk_dvdxi_mat.rows(), 2);
     libmesh_assert_equal_to(vk_dvdxi_mat.cols(), 2);
-    libmesh_assert_equal_to(Bmat_v_vk.m(), 2);
-    libmesh_assert_equal_to(Bmat_v_vk.n(), 6*n_phi);
     libmesh_assert_equal_to(vk_dwdxi_mat.rows(), 2);
     libmesh_assert_equal_to(vk_dwdxi_mat.cols(), 2);
+    
+    RealVectorX
+    phi_vec   = RealVectorX::Zero(fe.get_dphi().size());
+    Matrix<Real, 2, 1>
+    strain;
+    Matrix<Real, 2, 2>
+    dvdxi,
+    dwdxi;
+    
+    _von_karman_strain_operator(qp, fe, phi_vec, strain, dvdxi, dwdxi,
+                                Bmat_v_vk, Bmat_w_vk);
+    
+    vk_strain    = strain;
+    vk_dvdxi_mat = dvdxi;
+    vk_dwdxi_mat = dwdxi;
+}
+
+
+
+template <typename PhiVecType>
+void
+MAST::StructuralElement1D::
+_von_karman_strain_operator(const unsigned int qp,
+                            const MAST::FEBase& fe,
+                            PhiVecType& phi_vec,
+                            Matrix<Real, 2, 1>& vk_strain,
+                            Matrix<Real, 2, 2>& vk_dvdxi_mat,
+                            Matrix<Real, 2, 2>& vk_dwdxi_mat,
+                            MAST::FEMOperatorMatrix& Bmat_v_vk,
+                            MAST::FEMOperatorMatrix& Bmat_w_vk) {
+    
+    const std::vector<std::vector<libMesh::RealVectorValue> >& dphi = fe.get_dphi();
+    const unsigned int n_phi = (unsigned int)dphi.size();
+    
+    libmesh_assert_equal_to(phi_vec.size(), n_phi);
+    libmesh_assert_equal_to(Bmat_v_vk.m(), 2);
+    libmesh_assert_equal_to(Bmat_v_vk.n(), 6*n_phi);
     libmesh_assert_equal_to(Bmat_w_vk.m(), 2);
     libmesh_assert_equal_to(Bmat_w_vk.n(), 6*n_phi);
     libmesh_assert_less    (qp, dphi[0].size());
@@ -105,8 +153,6 @@ initialize_von_karman_strain_operator(const unsigned int qp,
     vk_dvdxi_mat.setZero();
     vk_dwdxi_mat.setZero();
     
-    RealVectorX phi_vec   = RealVectorX::Zero(n_phi);
-    
     for ( unsigned int i_nd=0; i_nd<n_phi; i_nd++ ) {
         phi_vec(i_nd) = dphi[i_nd][qp](0);            // dphi/dx
         dv += phi_vec(i_nd)*_local_sol(n_phi+i_nd);   // dv/dx
@@ -228,26 +274,38 @@ MAST::StructuralElement1D::calculate_stress(bool request_derivative,
     dref_t=  0.,
     dalpha=  0.;
     
+    libmesh_assert_equal_to(n1, 2);
+    libmesh_assert_equal_to(n3, 2);
+    
+    // the quantities with the element dofs are allocated once for the
+    // element, since the stress output data structure stores them as
+    // dynamically sized matrices. The strain and stress quantities
+    // at each point have fixed sizes.
     RealMatrixX
     material_mat,
-    vk_dvdxi_mat = RealMatrixX::Zero(n1,n3),
-    vk_dwdxi_mat = RealMatrixX::Zero(n1,n3),
     dstrain_dX   = RealMatrixX::Zero(n1,n2),
     dstress_dX   = RealMatrixX::Zero(n1,n2),
     mat_n1n2     = RealMatrixX::Zero(n1,n2),
-    eye          = RealMatrixX::Identity(n1, n1),
     dstrain_dX_3D= RealMatrixX::Zero(6,n2),
     dstress_dX_3D= RealMatrixX::Zero(6,n2);
 
+    Matrix<Real, 2, 2>
+    vk_dvdxi_mat = Matrix<Real, 2, 2>::Zero(),
+    vk_dwdxi_mat = Matrix<Real, 2, 2>::Zero(),
+    eye          = Matrix<Real, 2, 2>::Identity();
+    
+    Matrix<Real, 2, 1>
+    strain      = Matrix<Real, 2, 1>::Zero(),
+    stress      = Matrix<Real, 2, 1>::Zero(),
+    strain_bend = Matrix<Real, 2, 1>::Zero(),
+    strain_vk   = Matrix<Real, 2, 1>::Zero(),
+    dstrain_dp  = Matrix<Real, 2, 1>::Zero(),
+    dstress_dp  = Matrix<Real, 2, 1>::Zero();
+    
     RealVectorX
-    strain      = RealVectorX::Zero(n1),
-    stress      = RealVectorX::Zero(n1),
-    strain_bend = RealVectorX::Zero(n1),
-    strain_vk   = RealVectorX::Zero(n3),
+    phi_vec     = RealVectorX::Zero(n_phi),
     strain_3D   = RealVectorX::Zero(6),
-    stress_3D   = RealVectorX::Zero(6),
-    dstrain_dp  = RealVectorX::Zero(n1),
-    dstress_dp  = RealVectorX::Zero(n1);
+    stress_3D   = RealVectorX::Zero(6);
 
     MAST::FEMOperatorMatrix
     Bmat_mem,
@@ -319,7 +377,7 @@ MAST::StructuralElement1D::calculate_stress(bool request_derivative,
             // get the material matrix
             mat_stiff(xyz[qp_loc_index], _time, material_mat);
             
-            this->initialize_direct_strain_operator(qp_loc_index, *fe, Bmat_mem);
+            this->_direct_strain_operator(qp_loc_index, *fe, phi_vec, Bmat_mem);
             
             // first handle constant throught the thickness stresses: membrane and vonKarman
             Bmat_mem.vector_mult(strain, _local_sol);
@@ -338,13 +396,14 @@ MAST::StructuralElement1D::calculate_stress(bool request_derivative,
                 // von Karman strain
                 if (if_vk) {  // get the vonKarman strain operator if needed
                     
-                    this->initialize_von_karman_strain_operator(qp_loc_index,
-                                                                *fe,
-                                                                strain_vk,
-                                                                vk_dvdxi_mat,
-                                                                vk_dwdxi_mat,
-                                                                Bmat_v_vk,
-                                                                Bmat_w_vk);
+                    this->_von_karman_strain_operator(qp_loc_index,
+                                                      *fe,
+                                                      phi_vec,
+                                                      strain_vk,
+                                                      vk_dvdxi_mat,
+                                                      vk_dwdxi_mat,
+                                                      Bmat_v_vk,
+                                                      Bmat_w_vk);
                     strain += strain_vk;
                 }
                 
@@ -374,7 +433,7 @@ MAST::StructuralElement1D::calculate_stress(bool request_derivative,
             
             
             // note that this assumes linear material laws
-            stress = material_mat * strain;
+            stress.noalias() = material_mat * strain;
             
             // now set the data for the 3D stress-strain vector
             // this is using only the direct strain/stress.
@@ -384,8 +443,8 @@ MAST::StructuralElement1D::calculate_stress(bool request_derivative,
             stress_3D(0)  =   stress(0);
             
             // set the stress and strain data
-            MAST::StressStrainOutputBase::Data*
-            data = nullptr;
+            MAST::StressStrainOutputBase::Data
+            data;
             
             // if neither the derivative nor sensitivity is requested, then
             // we assume that a new data entry is to be provided. Otherwise,
@@ -393,16 +452,16 @@ MAST::StructuralElement1D::calculate_stress(bool request_derivative,
             // exists, and we only need to append sensitivity/derivative
             // data to it
             if (!request_derivative && !p)
-                data = &(stress_output.add_stress_strain_at_qp_location(_elem,
-                                                                        qp,
-                                                                        qp_loc[qp],
-                                                                        xyz[qp_loc_index],
-                                                                        stress_3D,
-                                                                        strain_3D,
-                                                                        JxW[qp_loc_index]));
+                data = stress_output.add_stress_strain_at_qp_location(_elem,
+                                                                      qp,
+                                                                      qp_loc[qp],
+                                                                      xyz[qp_loc_index],
+                                                                      stress_3D,
+                                                                      strain_3D,
+                                                                      JxW[qp_loc_index]);
             else
-                data = &(stress_output.get_stress_strain_data_for_elem_at_qp(_elem,
-                                                                             qp));
+                data = stress_output.get_stress_strain_data_for_elem_at_qp(_elem,
+                                                                           qp);
             
             // calculate the derivative if requested
             if (request_derivative || p) {
@@ -437,7 +496,7 @@ MAST::StructuralElement1D::calculate_stress(bool request_derivative,
                 dstrain_dX_3D.row(0)  = dstrain_dX.row(0);
                 
                 if (request_derivative)
-                    data->set_derivatives(dstress_dX_3D, dstrain_dX_3D);
+                    data.set_derivatives(dstress_dX_3D, dstrain_dX_3D);
                 
                 
                 if (p) {
@@ -453,7 +512,7 @@ MAST::StructuralElement1D::calculate_stress(bool request_derivative,
                     // TODO: include shape sensitivity.
                     // presently, only material parameter is included
                     
-                    dstrain_dp  =  RealVectorX::Zero(n1);
+                    dstrain_dp.setZero();
                     
                     // if thermal load was specified, then set the thermal strain
                     // component of the total strain
@@ -488,7 +547,7 @@ MAST::StructuralElement1D::calculate_stress(bool request_derivative,
                     
                     
                     // now use this to calculate the stress sensitivity.
-                    dstress_dp  =  material_mat * dstrain_dp;
+                    dstress_dp.noalias()  =  material_mat * dstrain_dp;
                     
                     // get the material matrix sensitivity
                     mat_stiff.derivative(*p, xyz[qp_loc_index], _time, material_mat);
@@ -498,7 +557,7 @@ MAST::StructuralElement1D::calculate_stress(bool request_derivative,
                     // TODO: shape sensitivity of strain operator
                     
                     // now use this to calculate the stress sensitivity.
-                    dstress_dp +=  material_mat * strain;
+                    dstress_dp.noalias() +=  material_mat * strain;
                     
                     
                     //
@@ -506,17 +565,17 @@ MAST::StructuralElement1D::calculate_stress(bool request_derivative,
                     // sensitivity
                     //
                     
-                    dstress_dp  += dstress_dX * _local_sol_sens;
-                    dstrain_dp  += dstrain_dX * _local_sol_sens;
+                    dstress_dp.noalias()  += dstress_dX * _local_sol_sens;
+                    dstrain_dp.noalias()  += dstrain_dX * _local_sol_sens;
                     
                     // copy the 3D object
                     stress_3D(0) = dstress_dp(0);
                     strain_3D(0) = dstrain_dp(0);
                     
                     // tell the data object about the sensitivity values
-                    data->set_sensitivity(*p,
-                                          stress_3D,
-                                          strain_3D);
+                    data.set_sensitivity(*p,
+                                         stress_3D,
+                                         strain_3D);
                 }
             }
         }
@@ -540,6 +599,36 @@ MAST::StructuralElement1D::internal_residual (bool request_jacobian,
                                               RealVectorX& f,
                                               RealMatrixX& jac)
 {
+    // the number of dofs of the linear EDGE2 element is known at compile
+    // time, which allows the use of fixed size matrices that are not
+    // allocated on the heap for each element.
+    switch (f.size()) {
+            
+        case 12:
+            return _internal_residual<12>(request_jacobian, f, jac);
+            
+        default:
+            return _internal_residual<Dynamic>(request_jacobian, f, jac);
+    }
+}
+
+
+
+template <int N2>
+bool
+MAST::StructuralElement1D::_internal_residual (bool request_jacobian,
+                                               RealVectorX& f,
+                                               RealMatrixX& jac)
+{
+    // number of shape functions known at compile time
+    const int NPhi = (N2 == Dynamic)? Dynamic : N2/6;
+    
+    typedef Matrix<Real, NPhi, 1> PhiVecType;
+    typedef Matrix<Real, N2,   1> VecN2Type;
+    typedef Matrix<Real,  2,  N2> MatN1N2Type;
+    typedef Matrix<Real, N2,  N2> MatN2N2Type;
+    
+
     std::unique_ptr<MAST::FEBase>   fe(_elem.init_fe(true,
                                                      false,
                                                      _property.extra_quadrature_order(_elem)));
@@ -552,30 +641,45 @@ MAST::StructuralElement1D::internal_residual (bool request_jacobian,
     n2       = 6*n_phi,
     n3       = this->n_von_karman_strain_components();
     
-    RealMatrixX
+    libmesh_assert(N2 == Dynamic || N2 == (int)n2);
+    libmesh_assert_equal_to(n1, 2);
+    
+    Matrix<Real, 2, 2>
     material_A_mat,
     material_B_mat,
     material_D_mat,
-    mat1_n1n2    = RealMatrixX::Zero(n1,n2),
-    mat2_n2n2    = RealMatrixX::Zero(n2,n2),
     mat3,
-    mat4_n3n2    = RealMatrixX::Zero(n3,2),
-    vk_dvdxi_mat = RealMatrixX::Zero(n1,n3),
-    vk_dwdxi_mat = RealMatrixX::Zero(n1,n3),
-    stress       = RealMatrixX::Zero(2,2),
-    stress_l     = RealMatrixX::Zero(2,2),
-    local_jac    = RealMatrixX::Zero(n2,n2);
+    vk_dvdxi_mat = Matrix<Real, 2, 2>::Zero(),
+    vk_dwdxi_mat = Matrix<Real, 2, 2>::Zero(),
+    stress       = Matrix<Real, 2, 2>::Zero(),
+    stress_l     = Matrix<Real, 2, 2>::Zero();
+    
+    // the section property functions return dynamically sized matrices.
+    // The matrix is allocated at the first quadrature point and then
+    // reused, since all subsequent evaluations have the same size.
+    RealMatrixX
+    material_mat;
     
-    RealVectorX
-    vec1_n1    = RealVectorX::Zero(n1),
-    vec2_n1    = RealVectorX::Zero(n1),
-    vec3_n2    = RealVectorX::Zero(n2),
-    vec4_n3    = RealVectorX::Zero(n3),
-    vec5_n3    = RealVectorX::Zero(n3),
-    local_f    = RealVectorX::Zero(n2);
+    MatN1N2Type
+    mat1_n1n2    = MatN1N2Type::Zero(n1,n2),
+    mat4_n3n2    = MatN1N2Type::Zero(n3,n2);
     
-    local_f.setZero();
-    local_jac.setZero();
+    MatN2N2Type
+    mat2_n2n2    = MatN2N2Type::Zero(n2,n2),
+    local_jac    = MatN2N2Type::Zero(n2,n2);
+    
+    Matrix<Real, 2, 1>
+    vec1_n1    = Matrix<Real, 2, 1>::Zero(),
+    vec2_n1    = Matrix<Real, 2, 1>::Zero(),
+    vec4_n3    = Matrix<Real, 2, 1>::Zero(),
+    vec5_n3    = Matrix<Real, 2, 1>::Zero();
+    
+    PhiVecType
+    phi_vec    = PhiVecType::Zero(n_phi);
+    
+    VecN2Type
+    vec3_n2    = VecN2Type::Zero(n2),
+    local_f    = VecN2Type::Zero(n2);
     
     MAST::FEMOperatorMatrix
     Bmat_mem,
@@ -611,17 +715,21 @@ MAST::StructuralElement1D::internal_residual (bool request_jacobian,
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
         
         // get the material matrix
-        (*mat_stiff_A)(xyz[qp], _time, material_A_mat);
+        (*mat_stiff_A)(xyz[qp], _time, material_mat);
+        material_A_mat = material_mat;
         
         if (bend.get()) {
-            (*mat_stiff_B)(xyz[qp], _time, material_B_mat);
-            (*mat_stiff_D)(xyz[qp], _time, material_D_mat);
+            (*mat_stiff_B)(xyz[qp], _time, material_mat);
+            material_B_mat = material_mat;
+            (*mat_stiff_D)(xyz[qp], _time, material_mat);
+            material_D_mat = material_mat;
         }
         
         // now calculte the quantity for these matrices
         _internal_residual_operation(if_vk, n2, qp, *fe, JxW,
                                      request_jacobian, 
                                      local_f, local_jac,
+                                     phi_vec,
                                      bend.get(),
                                      Bmat_mem, Bmat_bend_v, Bmat_bend_w,
                                      Bmat_v_vk, Bmat_w_vk,
@@ -636,11 +744,15 @@ MAST::StructuralElement1D::internal_residual (bool request_jacobian,
     
     
     // now calculate the transverse shear contribution if appropriate for the
-    // element
-    if (bend.get() && bend->include_transverse_shear_energy())
-        bend->calculate_transverse_shear_residual(request_jacobian,
-                                                  local_f,
-                                                  local_jac);
+    // element. The Timoshenko operator is the only one with transverse shear
+    // energy, and it adds its contribution directly to the element
+    // quantities of the same size.
+    if (bend.get() && bend->include_transverse_shear_energy()) {
+        
+        libmesh_assert(dynamic_cast<MAST::TimoshenkoBendingOperator*>(bend.get()));
+        static_cast<MAST::TimoshenkoBendingOperator&>(*bend).
+        transverse_shear_residual<N2>(request_jacobian, local_f, local_jac);
+    }
     
     
     // now transform to the global coorodinate system
@@ -698,19 +810,22 @@ MAST::StructuralElement1D::internal_residual_sensitivity (const MAST::FunctionBa
     material_trans_shear_mat,
     mat1_n1n2     = RealMatrixX::Zero(n1,n2),
     mat2_n2n2     = RealMatrixX::Zero(n2,n2),
-    mat3,
     mat4_n3n2     = RealMatrixX::Zero(n3,n2),
-    vk_dvdxi_mat  = RealMatrixX::Zero(n1,n3),
-    vk_dwdxi_mat  = RealMatrixX::Zero(n1,n3),
-    stress        = RealMatrixX::Zero(2,2),
-    stress_l      = RealMatrixX::Zero(2,2),
     local_jac     = RealMatrixX::Zero(n2,n2);
+    Matrix<Real, 2, 2>
+    mat3,
+    vk_dvdxi_mat  = Matrix<Real, 2, 2>::Zero(),
+    vk_dwdxi_mat  = Matrix<Real, 2, 2>::Zero(),
+    stress        = Matrix<Real, 2, 2>::Zero(),
+    stress_l      = Matrix<Real, 2, 2>::Zero();
+    Matrix<Real, 2, 1>
+    vec1_n1    = Matrix<Real, 2, 1>::Zero(),
+    vec2_n1    = Matrix<Real, 2, 1>::Zero(),
+    vec4_n3    = Matrix<Real, 2, 1>::Zero(),
+    vec5_n3    = Matrix<Real, 2, 1>::Zero();
     RealVectorX
-    vec1_n1    = RealVectorX::Zero(n1),
-    vec2_n1    = RealVectorX::Zero(n1),
+    phi_vec    = RealVectorX::Zero(n_phi),
     vec3_n2    = RealVectorX::Zero(n2),
-    vec4_n3    = RealVectorX::Zero(n3),
-    vec5_n3    = RealVectorX::Zero(n3),
     local_f    = RealVectorX::Zero(n2);
     
     local_f.setZero();
@@ -761,6 +876,7 @@ MAST::StructuralElement1D::internal_residual_sensitivity (const MAST::FunctionBa
         _internal_residual_operation(if_vk, n2, qp, *fe, JxW,
                                      request_jacobian,
                                      local_f, local_jac,
+                                     phi_vec,
                                      bend.get(),
                                      Bmat_mem, Bmat_bend_v, Bmat_bend_w,
                                      Bmat_v_vk, Bmat_w_vk,
@@ -1069,6 +1185,11 @@ internal_residual_jac_dot_state_sensitivity (RealMatrixX& jac) {
 
 
 
+template <typename PhiVecType,
+          typename VecN2Type,
+          typename MatN1N1Type,
+          typename MatN1N2Type,
+          typename MatN2N2Type>
 void
 MAST::StructuralElement1D::
 _internal_residual_operation(bool if_vk,
@@ -1077,36 +1198,37 @@ _internal_residual_operation(bool if_vk,
                              const MAST::FEBase& fe,
                              const std::vector<Real>& JxW,
                              bool request_jacobian,
-                             RealVectorX& local_f,
-                             RealMatrixX& local_jac,
+                             VecN2Type& local_f,
+                             MatN2N2Type& local_jac,
+                             PhiVecType& phi_vec,
                              MAST::BendingOperator1D* bend,
                              MAST::FEMOperatorMatrix& Bmat_mem,
                              MAST::FEMOperatorMatrix& Bmat_bend_v,
                              MAST::FEMOperatorMatrix& Bmat_bend_w,
                              MAST::FEMOperatorMatrix& Bmat_v_vk,
                              MAST::FEMOperatorMatrix& Bmat_w_vk,
-                             RealMatrixX& stress,
-                             RealMatrixX& stress_l,
-                             RealMatrixX& vk_dvdxi_mat,
-                             RealMatrixX& vk_dwdxi_mat,
-                             RealMatrixX& material_A_mat,
-                             RealMatrixX& material_B_mat,
-                             RealMatrixX& material_D_mat,
-                             RealVectorX& vec1_n1,
-                             RealVectorX& vec2_n1,
-                             RealVectorX& vec3_n2,
-                             RealVectorX& vec4_2,
-                             RealVectorX& vec5_2,
-                             RealMatrixX& mat1_n1n2,
-                             RealMatrixX& mat2_n2n2,
-                             RealMatrixX& mat3,
-                             RealMatrixX& mat4_2n2)
+                             Matrix<Real, 2, 2>& stress,
+                             Matrix<Real, 2, 2>& stress_l,
+                             Matrix<Real, 2, 2>& vk_dvdxi_mat,
+                             Matrix<Real, 2, 2>& vk_dwdxi_mat,
+                             MatN1N1Type& material_A_mat,
+                             MatN1N1Type& material_B_mat,
+                             MatN1N1Type& material_D_mat,
+                             Matrix<Real, 2, 1>& vec1_n1,
+                             Matrix<Real, 2, 1>& vec2_n1,
+                             VecN2Type& vec3_n2,
+                             Matrix<Real, 2, 1>& vec4_2,
+                             Matrix<Real, 2, 1>& vec5_2,
+                             MatN1N2Type& mat1_n1n2,
+                             MatN2N2Type& mat2_n2n2,
+                             Matrix<Real, 2, 2>& mat3,
+                             MatN1N2Type& mat4_2n2)
 {
-    this->initialize_direct_strain_operator(qp, fe, Bmat_mem);
+    this->_direct_strain_operator(qp, fe, phi_vec, Bmat_mem);
     
     // first handle constant throught the thickness stresses: membrane and vonKarman
     Bmat_mem.vector_mult(vec1_n1, _local_sol);
-    vec2_n1 = material_A_mat * vec1_n1; // linear direct stress
+    vec2_n1.noalias() = material_A_mat * vec1_n1; // linear direct stress
     
     // copy the stress values to a matrix
     stress_l(0,0) = vec2_n1(0); // sigma_xx
@@ -1124,25 +1246,26 @@ _internal_residual_operation(bool if_vk,
         //  evaluate the bending stress and add that to the stress vector
         // for evaluation in the nonlinear stress term
         Bmat_bend_v.vector_mult(vec2_n1, _local_sol);
-        vec1_n1 = material_B_mat * vec2_n1;
+        vec1_n1.noalias() = material_B_mat * vec2_n1;
         stress_l(0,0) += vec1_n1(0);
         stress(0,0)   += vec1_n1(0);
 
         Bmat_bend_w.vector_mult(vec2_n1, _local_sol);
-        vec1_n1 = material_B_mat * vec2_n1;
+        vec1_n1.noalias() = material_B_mat * vec2_n1;
         stress_l(0,0) += vec1_n1(0);
         stress(0,0)   += vec1_n1(0);
 
         if (if_vk) {  // get the vonKarman strain operator if needed
             
-            this->initialize_von_karman_strain_operator(qp,
-                                                        fe,
-                                                        vec2_n1, // epsilon_vk
-                                                        vk_dvdxi_mat,
-                                                        vk_dwdxi_mat,
-                                                        Bmat_v_vk,
-                                                        Bmat_w_vk);
-            vec1_n1 = material_A_mat * vec2_n1;
+            this->_von_karman_strain_operator(qp,
+                                              fe,
+                                              phi_vec,
+                                              vec2_n1, // epsilon_vk
+                                              vk_dvdxi_mat,
+                                              vk_dwdxi_mat,
+                                              Bmat_v_vk,
+                                              Bmat_w_vk);
+            vec1_n1.noalias() = material_A_mat * vec2_n1;
             stress(0,0) += vec1_n1(0); // total strain that multiplies with the membrane strain
             stress(1,1) += vec2_n1(0); // add the two strains to get the direct strain
         }
@@ -1162,12 +1285,12 @@ _internal_residual_operation(bool if_vk,
     if (bend) {
         if (if_vk) {
             // von Karman strain: direct stress
-            vec4_2 = vk_dvdxi_mat.transpose() * vec1_n1;
+            vec4_2.noalias() = vk_dvdxi_mat.transpose() * vec1_n1;
             Bmat_v_vk.vector_mult_transpose(vec3_n2, vec4_2);
             local_f += JxW[qp] * vec3_n2;
             
             // von Karman strain: direct stress
-            vec4_2 = vk_dwdxi_mat.transpose() * vec1_n1;
+            vec4_2.noalias() = vk_dwdxi_mat.transpose() * vec1_n1;
             Bmat_w_vk.vector_mult_transpose(vec3_n2, vec4_2);
             local_f += JxW[qp] * vec3_n2;
         }
@@ -1177,7 +1300,7 @@ _internal_residual_operation(bool if_vk,
         stress(1,1) = 0.;
         // now coupling with the bending strain
         // B_bend^T [B] B_mem
-        vec1_n1 = material_B_mat.transpose() * vec2_n1;
+        vec1_n1.noalias() = material_B_mat.transpose() * vec2_n1;
         Bmat_bend_v.vector_mult_transpose(vec3_n2, vec1_n1);
         local_f += JxW[qp] * vec3_n2;
         Bmat_bend_w.vector_mult_transpose(vec3_n2, vec1_n1);
@@ -1185,12 +1308,12 @@ _internal_residual_operation(bool if_vk,
 
         // now bending stress
         Bmat_bend_v.vector_mult(vec2_n1, _local_sol);
-        vec1_n1 = material_D_mat * vec2_n1;
+        vec1_n1.noalias() = material_D_mat * vec2_n1;
         Bmat_bend_v.vector_mult_transpose(vec3_n2, vec1_n1);
         local_f += JxW[qp] * vec3_n2;
 
         Bmat_bend_w.vector_mult(vec2_n1, _local_sol);
-        vec1_n1 = material_D_mat * vec2_n1;
+        vec1_n1.noalias() = material_D_mat * vec2_n1;
         Bmat_bend_w.vector_mult_transpose(vec3_n2, vec1_n1);
         local_f += JxW[qp] * vec3_n2;
     }
@@ -1204,29 +1327,27 @@ _internal_residual_operation(bool if_vk,
         if (bend) {
             if (if_vk) {
                 // membrane - vk: v-displacement
-                mat3 = RealMatrixX::Zero(vk_dvdxi_mat.rows(), n2);
-                Bmat_v_vk.left_multiply(mat3, vk_dvdxi_mat);
-                mat3 = material_A_mat * mat3;
-                Bmat_mem.right_multiply_transpose(mat2_n2n2, mat3);
+                Bmat_v_vk.left_multiply(mat1_n1n2, vk_dvdxi_mat);
+                mat1_n1n2 = material_A_mat * mat1_n1n2;
+                Bmat_mem.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // membrane - vk: w-displacement
-                mat3 = RealMatrixX::Zero(vk_dwdxi_mat.rows(), n2);
-                Bmat_w_vk.left_multiply(mat3, vk_dwdxi_mat);
-                mat3 = material_A_mat * mat3;
-                Bmat_mem.right_multiply_transpose(mat2_n2n2, mat3);
+                Bmat_w_vk.left_multiply(mat1_n1n2, vk_dwdxi_mat);
+                mat1_n1n2 = material_A_mat * mat1_n1n2;
+                Bmat_mem.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // vk - membrane: v-displacement
                 Bmat_mem.left_multiply(mat1_n1n2, material_A_mat);
-                mat3 = vk_dvdxi_mat.transpose() * mat1_n1n2;
-                Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                mat1_n1n2 = vk_dvdxi_mat.transpose() * mat1_n1n2;
+                Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // vk - membrane: w-displacement
                 Bmat_mem.left_multiply(mat1_n1n2, material_A_mat);
-                mat3 = vk_dwdxi_mat.transpose() * mat1_n1n2;
-                Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                mat1_n1n2 = vk_dwdxi_mat.transpose() * mat1_n1n2;
+                Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // if only the first order term of the Jacobian is needed, for
@@ -1235,95 +1356,85 @@ _internal_residual_operation(bool if_vk,
                 // is included. Otherwise, all terms are included
                 /*if (if_ignore_ho_jac) {
                     // vk - vk: v-displacement: first order term
-                    mat3 = RealMatrixX::Zero(2, n2);
-                    Bmat_v_vk.left_multiply(mat3, stress_l);
-                    Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                    Bmat_v_vk.left_multiply(mat1_n1n2, stress_l);
+                    Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                     local_jac += JxW[qp] * mat2_n2n2;
                     
                     // vk - vk: v-displacement: first order term
-                    mat3 = RealMatrixX::Zero(2, n2);
-                    Bmat_w_vk.left_multiply(mat3, stress_l);
-                    Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                    Bmat_w_vk.left_multiply(mat1_n1n2, stress_l);
+                    Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                     local_jac += JxW[qp] * mat2_n2n2;
                 }
                 else*/ {
                     // vk - vk: v-displacement
-                    mat3 = RealMatrixX::Zero(2, n2);
-                    Bmat_v_vk.left_multiply(mat3, stress);
-                    Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                    Bmat_v_vk.left_multiply(mat1_n1n2, stress);
+                    Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                     local_jac += JxW[qp] * mat2_n2n2;
                     
-                    mat3 = RealMatrixX::Zero(vk_dvdxi_mat.rows(), n2);
-                    Bmat_v_vk.left_multiply(mat3, vk_dvdxi_mat);
-                    mat3 = vk_dvdxi_mat.transpose() * material_A_mat * mat3;
-                    Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                    Bmat_v_vk.left_multiply(mat1_n1n2, vk_dvdxi_mat);
+                    mat1_n1n2 = vk_dvdxi_mat.transpose() * material_A_mat * mat1_n1n2;
+                    Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                     local_jac += JxW[qp] * mat2_n2n2;
                     
                     // vk - vk: w-displacement
-                    mat3 = RealMatrixX::Zero(2, n2);
-                    Bmat_w_vk.left_multiply(mat3, stress);
-                    Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                    Bmat_w_vk.left_multiply(mat1_n1n2, stress);
+                    Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                     local_jac += JxW[qp] * mat2_n2n2;
                     
-                    mat3 = RealMatrixX::Zero(vk_dwdxi_mat.rows(), n2);
-                    Bmat_w_vk.left_multiply(mat3, vk_dwdxi_mat);
-                    mat3 = vk_dwdxi_mat.transpose() * material_A_mat * mat3;
-                    Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                    Bmat_w_vk.left_multiply(mat1_n1n2, vk_dwdxi_mat);
+                    mat1_n1n2 = vk_dwdxi_mat.transpose() * material_A_mat * mat1_n1n2;
+                    Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                     local_jac += JxW[qp] * mat2_n2n2;
                     
                     // coupling of v, w-displacements
-                    mat3 = RealMatrixX::Zero(vk_dwdxi_mat.rows(), n2);
-                    Bmat_w_vk.left_multiply(mat3, vk_dwdxi_mat);
-                    mat3 = vk_dvdxi_mat.transpose() * material_A_mat * mat3;
-                    Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                    Bmat_w_vk.left_multiply(mat1_n1n2, vk_dwdxi_mat);
+                    mat1_n1n2 = vk_dvdxi_mat.transpose() * material_A_mat * mat1_n1n2;
+                    Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                     local_jac += JxW[qp] * mat2_n2n2;
                     
-                    mat3 = RealMatrixX::Zero(vk_dvdxi_mat.rows(), n2);
-                    Bmat_v_vk.left_multiply(mat3, vk_dvdxi_mat);
-                    mat3 = vk_dwdxi_mat.transpose() * material_A_mat * mat3;
-                    Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                    Bmat_v_vk.left_multiply(mat1_n1n2, vk_dvdxi_mat);
+                    mat1_n1n2 = vk_dwdxi_mat.transpose() * material_A_mat * mat1_n1n2;
+                    Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                     local_jac += JxW[qp] * mat2_n2n2;
                     
                 }
                 
                 // bending - vk: v-displacement
-                mat3 = RealMatrixX::Zero(vk_dvdxi_mat.rows(), n2);
-                Bmat_v_vk.left_multiply(mat3, vk_dvdxi_mat);
-                mat3 = material_B_mat.transpose() * mat3;
-                Bmat_bend_v.right_multiply_transpose(mat2_n2n2, mat3);
+                Bmat_v_vk.left_multiply(mat1_n1n2, vk_dvdxi_mat);
+                mat1_n1n2 = material_B_mat.transpose() * mat1_n1n2;
+                Bmat_bend_v.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
-                Bmat_bend_w.right_multiply_transpose(mat2_n2n2, mat3);
+                Bmat_bend_w.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
 
                 // bending - vk: w-displacement
-                mat3 = RealMatrixX::Zero(vk_dwdxi_mat.rows(), n2);
-                Bmat_w_vk.left_multiply(mat3, vk_dwdxi_mat);
-                mat3 = material_B_mat.transpose() * mat3;
-                Bmat_bend_v.right_multiply_transpose(mat2_n2n2, mat3);
+                Bmat_w_vk.left_multiply(mat1_n1n2, vk_dwdxi_mat);
+                mat1_n1n2 = material_B_mat.transpose() * mat1_n1n2;
+                Bmat_bend_v.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
-                Bmat_bend_w.right_multiply_transpose(mat2_n2n2, mat3);
+                Bmat_bend_w.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // vk - bending: v-displacement
                 Bmat_bend_v.left_multiply(mat1_n1n2, material_B_mat);
-                mat3 = vk_dvdxi_mat.transpose() * mat1_n1n2;
-                Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                mat1_n1n2 = vk_dvdxi_mat.transpose() * mat1_n1n2;
+                Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
 
                 Bmat_bend_v.left_multiply(mat1_n1n2, material_B_mat);
-                mat3 = vk_dwdxi_mat.transpose() * mat1_n1n2;
-                Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                mat1_n1n2 = vk_dwdxi_mat.transpose() * mat1_n1n2;
+                Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
 
                 // vk - bending: w-displacement
                 Bmat_bend_w.left_multiply(mat1_n1n2, material_B_mat);
-                mat3 = vk_dvdxi_mat.transpose() * mat1_n1n2;
-                Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                mat1_n1n2 = vk_dvdxi_mat.transpose() * mat1_n1n2;
+                Bmat_v_vk.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
 
                 Bmat_bend_w.left_multiply(mat1_n1n2, material_B_mat);
-                mat3 = vk_dwdxi_mat.transpose() * mat1_n1n2;
-                Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                mat1_n1n2 = vk_dwdxi_mat.transpose() * mat1_n1n2;
+                Bmat_w_vk.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
             }
             
@@ -352,41 +352,90 @@ namespace MAST {
          RealMatrixX& vk_dwdxi_mat_sens);
         
         
+        /*!
+         *   implementation of initialize_direct_strain_operator() that uses
+         *   the work vector \p phi, with one entry per shape function,
+         *   provided by the caller so that it can be reused across
+         *   quadrature points.
+         */
+        template <typename PhiVecType>
+        void _direct_strain_operator(const unsigned int qp,
+                                     const MAST::FEBase& fe,
+                                     PhiVecType& phi,
+                                     MAST::FEMOperatorMatrix& Bmat);
+        
+        /*!
+         *   implementation of initialize_von_karman_strain_operator() with
+         *   fixed size strain quantities. \p phi_vec is a work vector with
+         *   one entry per shape function, which is provided by the caller
+         *   so that it can be reused across quadrature points.
+         */
+        template <typename PhiVecType>
+        void
+        _von_karman_strain_operator(const unsigned int qp,
+                                    const MAST::FEBase& fe,
+                                    PhiVecType& phi_vec,
+                                    Matrix<Real, 2, 1>& vk_strain,
+                                    Matrix<Real, 2, 2>& vk_dvdxi_mat,
+                                    Matrix<Real, 2, 2>& vk_dwdxi_mat,
+                                    MAST::FEMOperatorMatrix& Bmat_v_vk,
+                                    MAST::FEMOperatorMatrix& Bmat_w_vk);
+        
+        /*!
+         *   calculates the internal residual and Jacobian using matrices
+         *   with \p N2 rows and columns for the element dofs. \p N2 is
+         *   \p Eigen::Dynamic for a general element, or the number of
+         *   element dofs if it is known at compile time, in which case the
+         *   element matrices are allocated on the stack.
+         */
+        template <int N2>
+        bool _internal_residual(bool request_jacobian,
+                                RealVectorX& f,
+                                RealMatrixX& jac);
+        
         /*!
          *   performs integration at the quadrature point for the provided
          *   matrices. The temperature vector and matrix entities are provided for
-         *   integration
+         *   integration. The matrix and vector types for the element dofs are
+         *   template parameters so that fixed size matrices can be used
+         *   for elements with a known number of dofs.
          */
-        virtual void _internal_residual_operation(bool if_vk,
-                                                  const unsigned int n2,
-                                                  const unsigned int qp,
-                                                  const MAST::FEBase& fe,
-                                                  const std::vector<Real>& JxW,
-                                                  bool request_jacobian,
-                                                  RealVectorX& local_f,
-                                                  RealMatrixX& local_jac,
-                                                  MAST::BendingOperator1D* bend_op,
-                                                  MAST::FEMOperatorMatrix& Bmat_mem,
-                                                  MAST::FEMOperatorMatrix& Bmat_bend_v,
-                                                  MAST::FEMOperatorMatrix& Bmat_bend_w,
-                                                  MAST::FEMOperatorMatrix& Bmat_v_vk,
-                                                  MAST::FEMOperatorMatrix& Bmat_w_vk,
-                                                  RealMatrixX& stress,
-                                                  RealMatrixX& stress_l,
-                                                  RealMatrixX& vk_dvdxi_mat,
-                                                  RealMatrixX& vk_dwdxi_mat,
-                                                  RealMatrixX& material_A_mat,
-                                                  RealMatrixX& material_B_mat,
-                                                  RealMatrixX& material_D_mat,
-                                                  RealVectorX& vec1_n1,
-                                                  RealVectorX& vec2_n1,
-                                                  RealVectorX& vec3_n2,
-                                                  RealVectorX& vec4_2,
-                                                  RealVectorX& vec5_2,
-                                                  RealMatrixX& mat1_n1n2,
-                                                  RealMatrixX& mat2_n2n2,
-                                                  RealMatrixX& mat3,
-                                                  RealMatrixX& mat4_2n2);
+        template <typename PhiVecType,
+                  typename VecN2Type,
+                  typename MatN1N1Type,
+                  typename MatN1N2Type,
+                  typename MatN2N2Type>
+        void _internal_residual_operation(bool if_vk,
+                                          const unsigned int n2,
+                                          const unsigned int qp,
+                                          const MAST::FEBase& fe,
+                                          const std::vector<Real>& JxW,
+                                          bool request_jacobian,
+                                          VecN2Type& local_f,
+                                          MatN2N2Type& local_jac,
+                                          PhiVecType& phi_vec,
+                                          MAST::BendingOperator1D* bend_op,
+                                          MAST::FEMOperatorMatrix& Bmat_mem,
+                                          MAST::FEMOperatorMatrix& Bmat_bend_v,
+                                          MAST::FEMOperatorMatrix& Bmat_bend_w,
+                                          MAST::FEMOperatorMatrix& Bmat_v_vk,
+                                          MAST::FEMOperatorMatrix& Bmat_w_vk,
+                                          Matrix<Real, 2, 2>& stress,
+                                          Matrix<Real, 2, 2>& stress_l,
+                                          Matrix<Real, 2, 2>& vk_dvdxi_mat,
+                                          Matrix<Real, 2, 2>& vk_dwdxi_mat,
+                                          MatN1N1Type& material_A_mat,
+                                          MatN1N1Type& material_B_mat,
+                                          MatN1N1Type& material_D_mat,
+                                          Matrix<Real, 2, 1>& vec1_n1,
+                                          Matrix<Real, 2, 1>& vec2_n1,
+                                          VecN2Type& vec3_n2,
+                                          Matrix<Real, 2, 1>& vec4_2,
+                                          Matrix<Real, 2, 1>& vec5_2,
+                                          MatN1N2Type& mat1_n1n2,
+                                          MatN2N2Type& mat2_n2n2,
+                                          Matrix<Real, 2, 2>& mat3,
+                                          MatN1N2Type& mat4_2n2);
         
         
 
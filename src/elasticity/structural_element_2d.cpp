@@ -22,6 +22,7 @@
 #include "elasticity/piston_theory_boundary_condition.h"
 #include "elasticity/stress_output_base.h"
 #include "elasticity/bending_operator.h"
+#include "elasticity/mindlin_bending_operator.h"
 #include "property_cards/element_property_card_2D.h"
 #include "property_cards/material_property_card_base.h"
 #include "numerics/fem_operator_matrix.h"
@@ -60,12 +61,41 @@ initialize_von_karman_strain_operator(const unsigned int qp,
                                       RealMatrixX& vk_dwdxi_mat,
                                       MAST::FEMOperatorMatrix& Bmat_vk) {
     
-    const std::vector<std::vector<libMesh::RealVectorValue> >& dphi = fe.get_dphi();
-    const unsigned int n_phi = (unsigned int)dphi.size();
+    const unsigned int n_phi = (unsigned int)fe.get_dphi().size();
     
     libmesh_assert_equal_to(vk_strain.size(), 3);
     libmesh_assert_equal_to(vk_dwdxi_mat.rows(), 3);
     libmesh_assert_equal_to(vk_dwdxi_mat.cols(), 2);
+
+    RealVectorX
+    phi_vec  = RealVectorX::Zero(n_phi);
+    RealVector3
+    strain;
+    Matrix<Real, 3, 2>
+    dwdxi;
+    
+    _von_karman_strain_operator(qp, fe, phi_vec, strain, dwdxi, Bmat_vk);
+    
+    vk_strain    = strain;
+    vk_dwdxi_mat = dwdxi;
+}
+
+
+
+template <typename PhiVecType>
+void
+MAST::StructuralElement2D::
+_von_karman_strain_operator(const unsigned int qp,
+                            const MAST::FEBase& fe,
+                            PhiVecType& phi_vec,
+                            RealVector3& vk_strain,
+                            Matrix<Real, 3, 2>& vk_dwdxi_mat,
+                            MAST::FEMOperatorMatrix& Bmat_vk) {
+    
+    const std::vector<std::vector<libMesh::RealVectorValue> >& dphi = fe.get_dphi();
+    const unsigned int n_phi = (unsigned int)dphi.size();
+    
+    libmesh_assert_equal_to(phi_vec.size(), n_phi);
     libmesh_assert_equal_to(Bmat_vk.m(), 2);
     libmesh_assert_equal_to(Bmat_vk.n(), 6*n_phi);
     libmesh_assert_less    (qp, dphi[0].size());
@@ -74,8 +104,6 @@ initialize_von_karman_strain_operator(const unsigned int qp,
     vk_strain.setZero();
     vk_dwdxi_mat.setZero();
     
-    RealVectorX phi_vec  = RealVectorX::Zero(n_phi);
-    
     dw = 0.;
     for ( unsigned int i_nd=0; i_nd<n_phi; i_nd++ ) {
         phi_vec(i_nd) = dphi[i_nd][qp](0);  // dphi/dx
@@ -152,6 +180,53 @@ initialize_green_lagrange_strain_operator(const unsigned int qp,
                                           MAST::FEMOperatorMatrix& Bmat_nl_u,
                                           MAST::FEMOperatorMatrix& Bmat_nl_v) {
     
+    const unsigned int n_phi = (unsigned int)fe.get_dphi().size();
+    
+    // make sure all matrices are the right size
+    libmesh_assert_equal_to(epsilon.size(), 3);
+    libmesh_assert_equal_to(mat_x.rows(), 3);
+    libmesh_assert_equal_to(mat_x.cols(), 2);
+    libmesh_assert_equal_to(mat_y.rows(), 3);
+    libmesh_assert_equal_to(mat_y.cols(), 2);
+
+    RealVectorX
+    phi  = RealVectorX::Zero(n_phi);
+    RealVector3
+    strain;
+    Matrix<Real, 3, 2>
+    mx,
+    my;
+    
+    _green_lagrange_strain_operator(qp, fe, local_disp, phi, strain, mx, my,
+                                    Bmat_lin,
+                                    Bmat_nl_x,
+                                    Bmat_nl_y,
+                                    Bmat_nl_u,
+                                    Bmat_nl_v);
+    
+    epsilon = strain;
+    mat_x   = mx;
+    mat_y   = my;
+}
+
+
+
+template <typename PhiVecType>
+void
+MAST::StructuralElement2D::
+_green_lagrange_strain_operator(const unsigned int qp,
+                                const MAST::FEBase& fe,
+                                const RealVectorX& local_disp,
+                                PhiVecType& phi,
+                                RealVector3& epsilon,
+                                Matrix<Real, 3, 2>& mat_x,
+                                Matrix<Real, 3, 2>& mat_y,
+                                MAST::FEMOperatorMatrix& Bmat_lin,
+                                MAST::FEMOperatorMatrix& Bmat_nl_x,
+                                MAST::FEMOperatorMatrix& Bmat_nl_y,
+                                MAST::FEMOperatorMatrix& Bmat_nl_u,
+                                MAST::FEMOperatorMatrix& Bmat_nl_v) {
+    
     
     epsilon.setZero();
     mat_x.setZero();
@@ -161,14 +236,9 @@ initialize_green_lagrange_strain_operator(const unsigned int qp,
     dphi = fe.get_dphi();
     
     unsigned int n_phi = (unsigned int)dphi.size();
-    RealVectorX phi  = RealVectorX::Zero(n_phi);
     
     // make sure all matrices are the right size
-    libmesh_assert_equal_to(epsilon.size(), 3);
-    libmesh_assert_equal_to(mat_x.rows(), 3);
-    libmesh_assert_equal_to(mat_x.cols(), 2);
-    libmesh_assert_equal_to(mat_y.rows(), 3);
-    libmesh_assert_equal_to(mat_y.cols(), 2);
+    libmesh_assert_equal_to(phi.size(), n_phi);
     libmesh_assert_equal_to(Bmat_lin.m(), 3);
     libmesh_assert_equal_to(Bmat_lin.n(), 6*n_phi);
     libmesh_assert_equal_to(Bmat_nl_x.m(), 2);
@@ -214,17 +284,17 @@ initialize_green_lagrange_strain_operator(const unsigned int qp,
         Bmat_nl_v.set_shape_function(1, 1, phi); // dv/dy
         
         // calculate the displacement gradient to create the
-        RealVectorX
-        ddisp_dx = RealVectorX::Zero(2),
-        ddisp_dy = RealVectorX::Zero(2);
+        Matrix<Real, 2, 1>
+        ddisp_dx = Matrix<Real, 2, 1>::Zero(),
+        ddisp_dy = Matrix<Real, 2, 1>::Zero();
         
         Bmat_nl_x.vector_mult(ddisp_dx, local_disp);  // {du/dx, dv/dx, dw/dx}
         Bmat_nl_y.vector_mult(ddisp_dy, local_disp);  // {du/dy, dv/dy, dw/dy}
         
         // prepare the deformation gradient matrix
-        RealMatrixX
-        F = RealMatrixX::Zero(2,2),
-        E = RealMatrixX::Zero(2,2);
+        Matrix<Real, 2, 2>
+        F = Matrix<Real, 2, 2>::Zero(),
+        E = Matrix<Real, 2, 2>::Zero();
         F.col(0) = ddisp_dx;
         F.col(1) = ddisp_dy;
         
@@ -238,11 +308,11 @@ initialize_green_lagrange_strain_operator(const unsigned int qp,
         
         // now initialize the matrices with strain components
         // that multiply the Bmat_nl terms
-        mat_x.row(0) =     ddisp_dx;
-        mat_x.row(2) =     ddisp_dy;
+        mat_x.row(0) =     ddisp_dx.transpose();
+        mat_x.row(2) =     ddisp_dy.transpose();
         
-        mat_y.row(1) =     ddisp_dy;
-        mat_y.row(2) =     ddisp_dx;
+        mat_y.row(1) =     ddisp_dy.transpose();
+        mat_y.row(2) =     ddisp_dx.transpose();
     }
     else
         Bmat_lin.vector_mult(epsilon, local_disp);
@@ -314,27 +384,41 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
     dref_t=  0.,
     dalpha=  0.;
     
+    libmesh_assert_equal_to(n1, 3);
+    libmesh_assert_equal_to(n3, 2);
+    
+    // the quantities with the element dofs are allocated once for the
+    // element, since the stress output data structure stores them as
+    // dynamically sized matrices. The strain and stress quantities
+    // at each point have fixed sizes.
     RealMatrixX
     material_mat,
-    vk_dwdxi_mat = RealMatrixX::Zero(n1,n3),
     dstrain_dX   = RealMatrixX::Zero(n1,n2),
     dstress_dX   = RealMatrixX::Zero(n1,n2),
     mat_n1n2     = RealMatrixX::Zero(n1,n2),
-    eye          = RealMatrixX::Identity(n1, n1),
-    mat_x        = RealMatrixX::Zero(3,2),
-    mat_y        = RealMatrixX::Zero(3,2),
     dstrain_dX_3D= RealMatrixX::Zero(6,n2),
     dstress_dX_3D= RealMatrixX::Zero(6,n2);
     
+    RealMatrix3
+    eye          = RealMatrix3::Identity();
+    
+    Matrix<Real, 3, 2>
+    vk_dwdxi_mat = Matrix<Real, 3, 2>::Zero(),
+    mat_x        = Matrix<Real, 3, 2>::Zero(),
+    mat_y        = Matrix<Real, 3, 2>::Zero();
+    
+    RealVector3
+    strain      = RealVector3::Zero(),
+    stress      = RealVector3::Zero(),
+    strain_vk   = RealVector3::Zero(),
+    strain_bend = RealVector3::Zero(),
+    dstrain_dp  = RealVector3::Zero(),
+    dstress_dp  = RealVector3::Zero();
+    
     RealVectorX
-    strain      = RealVectorX::Zero(n1),
-    stress      = RealVectorX::Zero(n1),
-    strain_vk   = RealVectorX::Zero(n1),
-    strain_bend = RealVectorX::Zero(n1),
+    phi_vec     = RealVectorX::Zero(n_phi),
     strain_3D   = RealVectorX::Zero(6),
-    stress_3D   = RealVectorX::Zero(6),
-    dstrain_dp  = RealVectorX::Zero(n1),
-    dstress_dp  = RealVectorX::Zero(n1);
+    stress_3D   = RealVectorX::Zero(6);
     
     
     FEMOperatorMatrix
@@ -407,17 +491,18 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
             // get the material matrix
             mat_stiff(xyz[qp_loc_index], _time, material_mat);
             
-            this->initialize_green_lagrange_strain_operator(qp_loc_index,
-                                                            *fe,
-                                                            _local_sol,
-                                                            strain,
-                                                            mat_x,
-                                                            mat_y,
-                                                            Bmat_lin,
-                                                            Bmat_nl_x,
-                                                            Bmat_nl_y,
-                                                            Bmat_nl_u,
-                                                            Bmat_nl_v);
+            this->_green_lagrange_strain_operator(qp_loc_index,
+                                                  *fe,
+                                                  _local_sol,
+                                                  phi_vec,
+                                                  strain,
+                                                  mat_x,
+                                                  mat_y,
+                                                  Bmat_lin,
+                                                  Bmat_nl_x,
+                                                  Bmat_nl_y,
+                                                  Bmat_nl_u,
+                                                  Bmat_nl_v);
             
             // if thermal load was specified, then set the thermal strain
             // component of the total strain
@@ -434,11 +519,12 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
                 // von Karman strain
                 if (if_vk) {  // get the vonKarman strain operator if needed
                     
-                    this->initialize_von_karman_strain_operator(qp_loc_index,
-                                                                *fe,
-                                                                strain_vk,
-                                                                vk_dwdxi_mat,
-                                                                Bmat_vk);
+                    this->_von_karman_strain_operator(qp_loc_index,
+                                                      *fe,
+                                                      phi_vec,
+                                                      strain_vk,
+                                                      vk_dwdxi_mat,
+                                                      Bmat_vk);
                     strain += strain_vk;
                 }
                 
@@ -460,7 +546,7 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
             }
             
             // note that this assumes linear material laws
-            stress = material_mat * strain;
+            stress.noalias() = material_mat * strain;
             
             
             // now set the data for the 3D stress-strain vector
@@ -475,8 +561,8 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
             strain_3D(3) = strain(2);  // gamma-xy
             
             // set the stress and strain data
-            MAST::StressStrainOutputBase::Data*
-            data = nullptr;
+            MAST::StressStrainOutputBase::Data
+            data;
             
             // if neither the derivative nor sensitivity is requested, then
             // we assume that a new data entry is to be provided. Otherwise,
@@ -484,15 +570,15 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
             // exists, and we only need to append sensitivity/derivative
             // data to it
             if (!request_derivative && !p)
-                data = &(stress_output.add_stress_strain_at_qp_location(_elem,
-                                                                        qp,
-                                                                        qp_loc[qp],
-                                                                        xyz[qp_loc_index],
-                                                                        stress_3D,
-                                                                        strain_3D,
-                                                                        JxW[qp_loc_index]));
+                data = stress_output.add_stress_strain_at_qp_location(_elem,
+                                                                      qp,
+                                                                      qp_loc[qp],
+                                                                      xyz[qp_loc_index],
+                                                                      stress_3D,
+                                                                      strain_3D,
+                                                                      JxW[qp_loc_index]);
             else
-                data = &(stress_output.get_stress_strain_data_for_elem_at_qp(_elem, qp));
+                data = stress_output.get_stress_strain_data_for_elem_at_qp(_elem, qp);
             
             
             // calculate the derivative if requested
@@ -523,7 +609,7 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
                 }
                 
                 // note: this assumes linear material laws
-                dstress_dX  = material_mat * dstrain_dX;
+                dstress_dX.noalias() = material_mat * dstrain_dX;
                 
                 // copy to the 3D structure
                 dstress_dX_3D.row(0) = dstress_dX.row(0);  // sigma-xx
@@ -534,7 +620,7 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
                 dstrain_dX_3D.row(3) = dstrain_dX.row(2);  // gamma-xy
                 
                 if (request_derivative)
-                    data->set_derivatives(dstress_dX_3D, dstrain_dX_3D);
+                    data.set_derivatives(dstress_dX_3D, dstrain_dX_3D);
                 
                 
                 if (p) {
@@ -551,7 +637,7 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
                     // presently, only material parameter is included
                     
                     
-                    dstrain_dp  =  RealVectorX::Zero(n1);
+                    dstrain_dp.setZero();
                     
                     // if thermal load was specified, then set the thermal strain
                     // component of the total strain
@@ -587,7 +673,7 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
                     
                     
                     // now use this to calculate the stress sensitivity.
-                    dstress_dp  =  material_mat * dstrain_dp;
+                    dstress_dp.noalias() = material_mat * dstrain_dp;
                     
                     // get the material matrix sensitivity
                     mat_stiff.derivative(*p,
@@ -600,14 +686,14 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
                     // TODO: shape sensitivity of strain operator
                     
                     // now use this to calculate the stress sensitivity.
-                    dstress_dp +=  material_mat * strain;
+                    dstress_dp.noalias() += material_mat * strain;
                     
                     //
                     // use the derivative data to evaluate the second term in the
                     // sensitivity
                     //
-                    dstress_dp  += dstress_dX * _local_sol_sens;
-                    dstrain_dp  += dstrain_dX * _local_sol_sens;
+                    dstress_dp.noalias() += dstress_dX * _local_sol_sens;
+                    dstrain_dp.noalias() += dstrain_dX * _local_sol_sens;
                     
                     // copy the 3D object
                     stress_3D(0) = dstress_dp(0);  // sigma-xx
@@ -618,9 +704,9 @@ MAST::StructuralElement2D::calculate_stress(bool request_derivative,
                     strain_3D(3) = dstrain_dp(2);  // gamma-xy
                     
                     // tell the data object about the sensitivity values
-                    data->set_sensitivity(*p,
-                                          stress_3D,
-                                          strain_3D);
+                    data.set_sensitivity(*p,
+                                         stress_3D,
+                                         strain_3D);
                 }
             }
         }
@@ -990,7 +1076,7 @@ calculate_stress_temperature_derivative(MAST::FEBase& fe_thermal,
 
             // set the stress and strain data
             MAST::StressStrainOutputBase::Data
-            &data = stress_output.get_stress_strain_data_for_elem_at_qp(_elem, qp);
+            data = stress_output.get_stress_strain_data_for_elem_at_qp(_elem, qp);
             data.set_derivatives(dstress_dX_3D, dstrain_dX_3D);
         }
 }
@@ -1003,6 +1089,39 @@ MAST::StructuralElement2D::internal_residual (bool request_jacobian,
                                               RealVectorX& f,
                                               RealMatrixX& jac)
 {
+    // the number of dofs of the linear TRI3 and QUAD4 elements is known
+    // at compile time, which allows the use of fixed size matrices that
+    // are not allocated on the heap for each element.
+    switch (f.size()) {
+            
+        case 18:
+            return _internal_residual<18>(request_jacobian, f, jac);
+            
+        case 24:
+            return _internal_residual<24>(request_jacobian, f, jac);
+            
+        default:
+            return _internal_residual<Dynamic>(request_jacobian, f, jac);
+    }
+}
+
+
+
+template <int N2>
+bool
+MAST::StructuralElement2D::_internal_residual (bool request_jacobian,
+                                               RealVectorX& f,
+                                               RealMatrixX& jac)
+{
+    // number of shape functions known at compile time
+    const int NPhi = (N2 == Dynamic)? Dynamic : N2/6;
+    
+    typedef Matrix<Real, NPhi, 1> PhiVecType;
+    typedef Matrix<Real, N2,   1> VecN2Type;
+    typedef Matrix<Real,  3,  N2> MatN1N2Type;
+    typedef Matrix<Real, N2,  N2> MatN2N2Type;
+    typedef Matrix<Real,  2,  N2> Mat2N2Type;
+    
     std::unique_ptr<MAST::FEBase>   fe(_elem.init_fe(true,
                                                      false,
                                                      _property.extra_quadrature_order(_elem)));
@@ -1016,30 +1135,57 @@ MAST::StructuralElement2D::internal_residual (bool request_jacobian,
     n2       =6*n_phi,
     n3       = this->n_von_karman_strain_components();
     
-    RealMatrixX
+    libmesh_assert(N2 == Dynamic || N2 == (int)n2);
+    libmesh_assert_equal_to(n1, 3);
+    libmesh_assert_equal_to(n3, 2);
+    
+    RealMatrix3
     material_A_mat,
     material_B_mat,
     material_D_mat,
-    mat1_n1n2     = RealMatrixX::Zero(n1,n2),
-    mat2_n2n2     = RealMatrixX::Zero(n2,n2),
-    mat3,
-    mat4_n3n2     = RealMatrixX::Zero(n3,n2),
-    mat5_3n2      = RealMatrixX::Zero(3,n2),
-    vk_dwdxi_mat  = RealMatrixX::Zero(n1,n3),
-    stress        = RealMatrixX::Zero(2,2),
-    mat_x         = RealMatrixX::Zero(3,2),
-    mat_y         = RealMatrixX::Zero(3,2),
-    local_jac     = RealMatrixX::Zero(n2,n2);
+    mat3;
+    
+    // the section property functions return dynamically sized matrices.
+    // The matrix is allocated at the first quadrature point and then
+    // reused, since all subsequent evaluations have the same size.
+    RealMatrixX
+    material_mat;
+    
+    Matrix<Real, 3, 2>
+    vk_dwdxi_mat  = Matrix<Real, 3, 2>::Zero(),
+    mat_x         = Matrix<Real, 3, 2>::Zero(),
+    mat_y         = Matrix<Real, 3, 2>::Zero();
+    
+    Matrix<Real, 2, 2>
+    stress        = Matrix<Real, 2, 2>::Zero();
+    
+    MatN1N2Type
+    mat1_n1n2     = MatN1N2Type::Zero(n1,n2);
+    
+    Mat2N2Type
+    mat4_n3n2     = Mat2N2Type::Zero(n3,n2),
+    mat5_3n2      = Mat2N2Type::Zero(n3,n2);
+    
+    MatN2N2Type
+    mat2_n2n2     = MatN2N2Type::Zero(n2,n2),
+    local_jac     = MatN2N2Type::Zero(n2,n2);
 
-    RealVectorX
-    vec1_n1    = RealVectorX::Zero(n1),
-    vec2_n1    = RealVectorX::Zero(n1),
-    vec3_n2    = RealVectorX::Zero(n2),
-    vec4_n3    = RealVectorX::Zero(n3),
-    vec5_n3    = RealVectorX::Zero(n3),
-    vec6_n2    = RealVectorX::Zero(n2),
-    strain     = RealVectorX::Zero(3),
-    local_f    = RealVectorX::Zero(n2);
+    RealVector3
+    vec1_n1    = RealVector3::Zero(),
+    vec2_n1    = RealVector3::Zero(),
+    strain     = RealVector3::Zero();
+    
+    Matrix<Real, 2, 1>
+    vec4_n3    = Matrix<Real, 2, 1>::Zero(),
+    vec5_n3    = Matrix<Real, 2, 1>::Zero();
+    
+    PhiVecType
+    phi_vec    = PhiVecType::Zero(n_phi);
+    
+    VecN2Type
+    vec3_n2    = VecN2Type::Zero(n2),
+    vec6_n2    = VecN2Type::Zero(n2),
+    local_f    = VecN2Type::Zero(n2);
     
     FEMOperatorMatrix
     Bmat_lin,
@@ -1078,11 +1224,14 @@ MAST::StructuralElement2D::internal_residual (bool request_jacobian,
     for (unsigned int qp=0; qp<JxW.size(); qp++) {
         
         // get the material matrix
-        (*mat_stiff_A)(xyz[qp], _time, material_A_mat);
+        (*mat_stiff_A)(xyz[qp], _time, material_mat);
+        material_A_mat = material_mat;
         
         if (bend.get()) {
-            (*mat_stiff_B)(xyz[qp], _time, material_B_mat);
-            (*mat_stiff_D)(xyz[qp], _time, material_D_mat);
+            (*mat_stiff_B)(xyz[qp], _time, material_mat);
+            material_B_mat = material_mat;
+            (*mat_stiff_D)(xyz[qp], _time, material_mat);
+            material_D_mat = material_mat;
         }
         
         // now calculte the quantity for these matrices
@@ -1095,6 +1244,7 @@ MAST::StructuralElement2D::internal_residual (bool request_jacobian,
                                      local_f,
                                      local_jac,
                                      _local_sol,
+                                     phi_vec,
                                      strain,
                                      bend.get(),
                                      Bmat_lin,
@@ -1126,12 +1276,16 @@ MAST::StructuralElement2D::internal_residual (bool request_jacobian,
     
     
     // now calculate the transverse shear contribution if appropriate for the
-    // element
+    // element. The Mindlin operator is the only one with transverse shear
+    // energy, and it adds its contribution directly to the element
+    // quantities of the same size.
     if (bend.get() &&
-        bend->include_transverse_shear_energy())
-        bend->calculate_transverse_shear_residual(request_jacobian,
-                                                  local_f,
-                                                  local_jac);
+        bend->include_transverse_shear_energy()) {
+        
+        libmesh_assert(dynamic_cast<MAST::MindlinBendingOperator*>(bend.get()));
+        static_cast<MAST::MindlinBendingOperator&>(*bend).
+        transverse_shear_residual<N2>(request_jacobian, local_f, local_jac);
+    }
     
     
     // now transform to the global coorodinate system
@@ -1196,22 +1350,28 @@ MAST::StructuralElement2D::internal_residual_sensitivity (const MAST::FunctionBa
     material_trans_shear_mat,
     mat1_n1n2     = RealMatrixX::Zero(n1,n2),
     mat2_n2n2     = RealMatrixX::Zero(n2,n2),
-    mat3,
     mat4_n3n2     = RealMatrixX::Zero(n3,n2),
     mat5_3n2      = RealMatrixX::Zero(3,n2),
-    vk_dwdxi_mat  = RealMatrixX::Zero(n1,n3),
-    stress        = RealMatrixX::Zero(2,2),
-    mat_x         = RealMatrixX::Zero(3,2),
-    mat_y         = RealMatrixX::Zero(3,2),
     local_jac     = RealMatrixX::Zero(n2,n2);
+    RealMatrix3
+    mat3;
+    Matrix<Real, 3, 2>
+    vk_dwdxi_mat  = Matrix<Real, 3, 2>::Zero(),
+    mat_x         = Matrix<Real, 3, 2>::Zero(),
+    mat_y         = Matrix<Real, 3, 2>::Zero();
+    Matrix<Real, 2, 2>
+    stress        = Matrix<Real, 2, 2>::Zero();
+    RealVector3
+    vec1_n1    = RealVector3::Zero(),
+    vec2_n1    = RealVector3::Zero(),
+    strain     = RealVector3::Zero();
+    Matrix<Real, 2, 1>
+    vec4_n3    = Matrix<Real, 2, 1>::Zero(),
+    vec5_n3    = Matrix<Real, 2, 1>::Zero();
     RealVectorX
-    vec1_n1    = RealVectorX::Zero(n1),
-    vec2_n1    = RealVectorX::Zero(n1),
+    phi_vec    = RealVectorX::Zero(n_phi),
     vec3_n2    = RealVectorX::Zero(n2),
-    vec4_n3    = RealVectorX::Zero(n3),
-    vec5_n3    = RealVectorX::Zero(n3),
     vec6_n2    = RealVectorX::Zero(n2),
-    strain     = RealVectorX::Zero(3),
     local_f    = RealVectorX::Zero(n2);
     
     FEMOperatorMatrix
@@ -1271,6 +1431,7 @@ MAST::StructuralElement2D::internal_residual_sensitivity (const MAST::FunctionBa
                                      local_f,
                                      local_jac,
                                      _local_sol,
+                                     phi_vec,
                                      strain,
                                      bend.get(),
                                      Bmat_lin,
@@ -1356,22 +1517,28 @@ internal_residual_boundary_velocity(const MAST::FunctionBase& p,
     material_trans_shear_mat,
     mat1_n1n2     = RealMatrixX::Zero(n1,n2),
     mat2_n2n2     = RealMatrixX::Zero(n2,n2),
-    mat3,
     mat4_n3n2     = RealMatrixX::Zero(n3,n2),
     mat5_3n2      = RealMatrixX::Zero(3,n2),
-    vk_dwdxi_mat  = RealMatrixX::Zero(n1,n3),
-    stress        = RealMatrixX::Zero(2,2),
-    mat_x         = RealMatrixX::Zero(3,2),
-    mat_y         = RealMatrixX::Zero(3,2),
     local_jac     = RealMatrixX::Zero(n2,n2);
+    RealMatrix3
+    mat3;
+    Matrix<Real, 3, 2>
+    vk_dwdxi_mat  = Matrix<Real, 3, 2>::Zero(),
+    mat_x         = Matrix<Real, 3, 2>::Zero(),
+    mat_y         = Matrix<Real, 3, 2>::Zero();
+    Matrix<Real, 2, 2>
+    stress        = Matrix<Real, 2, 2>::Zero();
+    RealVector3
+    vec1_n1    = RealVector3::Zero(),
+    vec2_n1    = RealVector3::Zero(),
+    strain     = RealVector3::Zero();
+    Matrix<Real, 2, 1>
+    vec4_n3    = Matrix<Real, 2, 1>::Zero(),
+    vec5_n3    = Matrix<Real, 2, 1>::Zero();
     RealVectorX
-    vec1_n1    = RealVectorX::Zero(n1),
-    vec2_n1    = RealVectorX::Zero(n1),
+    phi_vec    = RealVectorX::Zero(n_phi),
     vec3_n2    = RealVectorX::Zero(n2),
-    vec4_n3    = RealVectorX::Zero(n3),
-    vec5_n3    = RealVectorX::Zero(n3),
     vec6_n2    = RealVectorX::Zero(n2),
-    strain     = RealVectorX::Zero(3),
     local_f    = RealVectorX::Zero(n2),
     vel        = RealVectorX::Zero(dim);
     
@@ -1445,6 +1612,7 @@ internal_residual_boundary_velocity(const MAST::FunctionBase& p,
                                      local_f,
                                      local_jac,
                                      _local_sol,
+                                     phi_vec,
                                      strain,
                                      bend.get(),
                                      Bmat_lin,
@@ -1688,6 +1856,12 @@ internal_residual_jac_dot_state_sensitivity (RealMatrixX& jac) {
 
 
 
+template <typename PhiVecType,
+          typename VecN2Type,
+          typename MatN1N1Type,
+          typename MatN1N2Type,
+          typename MatN2N2Type,
+          typename Mat2N2Type>
 void
 MAST::StructuralElement2D::_internal_residual_operation
 (bool                       if_vk,
@@ -1696,10 +1870,11 @@ MAST::StructuralElement2D::_internal_residual_operation
  const MAST::FEBase&        fe,
  const std::vector<Real>&   JxW,
  bool                       request_jacobian,
- RealVectorX&               local_f,
- RealMatrixX&               local_jac,
+ VecN2Type&                 local_f,
+ MatN2N2Type&               local_jac,
  RealVectorX&               local_disp,
- RealVectorX&               strain_mem,
+ PhiVecType&                phi_vec,
+ RealVector3&               strain_mem,
  MAST::BendingOperator2D*   bend,
  FEMOperatorMatrix&         Bmat_lin,
  FEMOperatorMatrix&         Bmat_nl_x,
@@ -1708,55 +1883,57 @@ MAST::StructuralElement2D::_internal_residual_operation
  FEMOperatorMatrix&         Bmat_nl_v,
  MAST::FEMOperatorMatrix&   Bmat_bend,
  MAST::FEMOperatorMatrix&   Bmat_vk,
- RealMatrixX&               mat_x,
- RealMatrixX&               mat_y,
- RealMatrixX&               stress,
- RealMatrixX&               vk_dwdxi_mat,
- RealMatrixX&               material_A_mat,
- RealMatrixX&               material_B_mat,
- RealMatrixX&               material_D_mat,
- RealVectorX&               vec1_n1,
- RealVectorX&               vec2_n1,
- RealVectorX&               vec3_n2,
- RealVectorX&               vec4_2,
- RealVectorX&               vec5_2,
- RealVectorX&               vec6_n2,
- RealMatrixX&               mat1_n1n2,
- RealMatrixX&               mat2_n2n2,
- RealMatrixX&               mat3,
- RealMatrixX&               mat4_2n2,
- RealMatrixX&               mat5_3n2) {
-    
-    this->initialize_green_lagrange_strain_operator(qp,
-                                                    fe,
-                                                    local_disp,
-                                                    strain_mem,
-                                                    mat_x,
-                                                    mat_y,
-                                                    Bmat_lin,
-                                                    Bmat_nl_x,
-                                                    Bmat_nl_y,
-                                                    Bmat_nl_u,
-                                                    Bmat_nl_v);
-
-    vec2_n1 = material_A_mat * strain_mem; // membrane stress
+ Matrix<Real, 3, 2>&        mat_x,
+ Matrix<Real, 3, 2>&        mat_y,
+ Matrix<Real, 2, 2>&        stress,
+ Matrix<Real, 3, 2>&        vk_dwdxi_mat,
+ MatN1N1Type&               material_A_mat,
+ MatN1N1Type&               material_B_mat,
+ MatN1N1Type&               material_D_mat,
+ RealVector3&               vec1_n1,
+ RealVector3&               vec2_n1,
+ VecN2Type&                 vec3_n2,
+ Matrix<Real, 2, 1>&        vec4_2,
+ Matrix<Real, 2, 1>&        vec5_2,
+ VecN2Type&                 vec6_n2,
+ MatN1N2Type&               mat1_n1n2,
+ MatN2N2Type&               mat2_n2n2,
+ RealMatrix3&               mat3,
+ Mat2N2Type&                mat4_2n2,
+ Mat2N2Type&                mat5_3n2) {
+    
+    this->_green_lagrange_strain_operator(qp,
+                                          fe,
+                                          local_disp,
+                                          phi_vec,
+                                          strain_mem,
+                                          mat_x,
+                                          mat_y,
+                                          Bmat_lin,
+                                          Bmat_nl_x,
+                                          Bmat_nl_y,
+                                          Bmat_nl_u,
+                                          Bmat_nl_v);
+
+    vec2_n1.noalias() = material_A_mat * strain_mem; // membrane stress
     
     if (bend) {
 
         // get the bending strain operator
         bend->initialize_bending_strain_operator(fe, qp, Bmat_bend);
         Bmat_bend.vector_mult(vec1_n1, local_disp);
-        vec2_n1 += material_B_mat * vec1_n1;
+        vec2_n1.noalias() += material_B_mat * vec1_n1;
         
         if (if_vk)  { // get the vonKarman strain operator if needed
-            this->initialize_von_karman_strain_operator(qp,
-                                                        fe,
-                                                        vec1_n1, // epsilon_vk
-                                                        vk_dwdxi_mat,
-                                                        Bmat_vk);
+            this->_von_karman_strain_operator(qp,
+                                              fe,
+                                              phi_vec,
+                                              vec1_n1, // epsilon_vk
+                                              vk_dwdxi_mat,
+                                              Bmat_vk);
             
             strain_mem  += vec1_n1;              // epsilon_mem + epsilon_vk
-            vec2_n1     += material_A_mat * vec1_n1; // stress
+            vec2_n1.noalias() += material_A_mat * vec1_n1; // stress
         }
     }
     
@@ -1776,12 +1953,12 @@ MAST::StructuralElement2D::_internal_residual_operation
         
         // nonlinear strain operator
         // x
-        vec4_2   = mat_x.transpose() * vec2_n1;
+        vec4_2.noalias() = mat_x.transpose() * vec2_n1;
         Bmat_nl_x.vector_mult_transpose(vec6_n2, vec4_2);
         local_f.topRows(n2) += JxW[qp] * vec6_n2;
         
         // y
-        vec4_2   = mat_y.transpose() * vec2_n1;
+        vec4_2.noalias() = mat_y.transpose() * vec2_n1;
         Bmat_nl_y.vector_mult_transpose(vec6_n2, vec4_2);
         local_f.topRows(n2) += JxW[qp] * vec6_n2;
     }
@@ -1790,20 +1967,20 @@ MAST::StructuralElement2D::_internal_residual_operation
     if (bend) {
         if (if_vk) {
             // von Karman strain
-            vec4_2 = vk_dwdxi_mat.transpose() * vec2_n1;
+            vec4_2.noalias() = vk_dwdxi_mat.transpose() * vec2_n1;
             Bmat_vk.vector_mult_transpose(vec3_n2, vec4_2);
             local_f += JxW[qp] * vec3_n2;
         }
         
         // now coupling with the bending strain
         // B_bend^T [B] B_mem
-        vec1_n1 = material_B_mat.transpose() * strain_mem;
+        vec1_n1.noalias() = material_B_mat.transpose() * strain_mem;
         Bmat_bend.vector_mult_transpose(vec3_n2, vec1_n1);
         local_f += JxW[qp] * vec3_n2;
         
         // now bending stress
         Bmat_bend.vector_mult(vec2_n1, local_disp);
-        vec1_n1 = material_D_mat * vec2_n1;
+        vec1_n1.noalias() = material_D_mat * vec2_n1;
         Bmat_bend.vector_mult_transpose(vec3_n2, vec1_n1);
         local_f += JxW[qp] * vec3_n2;
     }
@@ -1831,41 +2008,41 @@ MAST::StructuralElement2D::_internal_residual_operation
             
             // B_x^T mat_x^T C B_lin
             Bmat_lin.left_multiply(mat1_n1n2, material_A_mat);
-            mat5_3n2 = mat_x.transpose() * mat1_n1n2;
+            mat5_3n2.noalias() = mat_x.transpose() * mat1_n1n2;
             Bmat_nl_x.right_multiply_transpose(mat2_n2n2, mat5_3n2);
             local_jac += JxW[qp] * mat2_n2n2;
             
             // B_x^T mat_x^T C mat_x B_x
             Bmat_nl_x.left_multiply(mat1_n1n2, mat_x);
             mat1_n1n2 = material_A_mat * mat1_n1n2;
-            mat5_3n2 = mat_x.transpose() * mat1_n1n2;
+            mat5_3n2.noalias() = mat_x.transpose() * mat1_n1n2;
             Bmat_nl_x.right_multiply_transpose(mat2_n2n2, mat5_3n2);
             local_jac += JxW[qp] * mat2_n2n2;
             
             // B_x^T mat_x^T C mat_y B_y
             Bmat_nl_y.left_multiply(mat1_n1n2, mat_y);
             mat1_n1n2 = material_A_mat * mat1_n1n2;
-            mat5_3n2 = mat_x.transpose() * mat1_n1n2;
+            mat5_3n2.noalias() = mat_x.transpose() * mat1_n1n2;
             Bmat_nl_x.right_multiply_transpose(mat2_n2n2, mat5_3n2);
             local_jac += JxW[qp] * mat2_n2n2;
             
             // B_y^T mat_y^T C B_lin
             Bmat_lin.left_multiply(mat1_n1n2, material_A_mat);
-            mat5_3n2 = mat_y.transpose() * mat1_n1n2;
+            mat5_3n2.noalias() = mat_y.transpose() * mat1_n1n2;
             Bmat_nl_y.right_multiply_transpose(mat2_n2n2, mat5_3n2);
             local_jac += JxW[qp] * mat2_n2n2;
             
             // B_y^T mat_y^T C mat_x B_x
             Bmat_nl_x.left_multiply(mat1_n1n2, mat_x);
             mat1_n1n2 = material_A_mat * mat1_n1n2;
-            mat5_3n2 = mat_y.transpose() * mat1_n1n2;
+            mat5_3n2.noalias() = mat_y.transpose() * mat1_n1n2;
             Bmat_nl_y.right_multiply_transpose(mat2_n2n2, mat5_3n2);
             local_jac += JxW[qp] * mat2_n2n2;
             
             // B_y^T mat_y^T C mat_y B_y
             Bmat_nl_y.left_multiply(mat1_n1n2, mat_y);
             mat1_n1n2 = material_A_mat * mat1_n1n2;
-            mat5_3n2 = mat_y.transpose() * mat1_n1n2;
+            mat5_3n2.noalias() = mat_y.transpose() * mat1_n1n2;
             Bmat_nl_y.right_multiply_transpose(mat2_n2n2, mat5_3n2);
             local_jac += JxW[qp] * mat2_n2n2;
             
@@ -1887,41 +2064,37 @@ MAST::StructuralElement2D::_internal_residual_operation
         if (bend) {
             if (if_vk) {
                 // membrane - vk
-                mat3 = RealMatrixX::Zero(vk_dwdxi_mat.rows(), n2);
-                Bmat_vk.left_multiply(mat3, vk_dwdxi_mat);
-                mat3 = material_A_mat * mat3;
-                Bmat_lin.right_multiply_transpose(mat2_n2n2, mat3);
+                Bmat_vk.left_multiply(mat1_n1n2, vk_dwdxi_mat);
+                mat1_n1n2 = material_A_mat * mat1_n1n2;
+                Bmat_lin.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // vk - membrane
                 Bmat_lin.left_multiply(mat1_n1n2, material_A_mat);
-                mat3 = vk_dwdxi_mat.transpose() * mat1_n1n2;
-                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                mat4_2n2.noalias() = vk_dwdxi_mat.transpose() * mat1_n1n2;
+                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat4_2n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // vk - vk
-                mat3 = RealMatrixX::Zero(2, n2);
-                Bmat_vk.left_multiply(mat3, stress);
-                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                Bmat_vk.left_multiply(mat4_2n2, stress);
+                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat4_2n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
-                mat3 = RealMatrixX::Zero(vk_dwdxi_mat.rows(), n2);
-                Bmat_vk.left_multiply(mat3, vk_dwdxi_mat);
-                mat3 = vk_dwdxi_mat.transpose() * material_A_mat * mat3;
-                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                Bmat_vk.left_multiply(mat1_n1n2, vk_dwdxi_mat);
+                mat4_2n2 = vk_dwdxi_mat.transpose() * material_A_mat * mat1_n1n2;
+                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat4_2n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // bending - vk
-                mat3 = RealMatrixX::Zero(vk_dwdxi_mat.rows(), n2);
-                Bmat_vk.left_multiply(mat3, vk_dwdxi_mat);
-                mat3 = material_B_mat.transpose() * mat3;
-                Bmat_bend.right_multiply_transpose(mat2_n2n2, mat3);
+                Bmat_vk.left_multiply(mat1_n1n2, vk_dwdxi_mat);
+                mat1_n1n2 = material_B_mat.transpose() * mat1_n1n2;
+                Bmat_bend.right_multiply_transpose(mat2_n2n2, mat1_n1n2);
                 local_jac += JxW[qp] * mat2_n2n2;
                 
                 // vk - bending
                 Bmat_bend.left_multiply(mat1_n1n2, material_B_mat);
-                mat3 = vk_dwdxi_mat.transpose() * mat1_n1n2;
-                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat3);
+                mat4_2n2.noalias() = vk_dwdxi_mat.transpose() * mat1_n1n2;
+                Bmat_vk.right_multiply_transpose(mat2_n2n2, mat4_2n2);
                 local_jac += JxW[qp] * mat2_n2n2;
             }
             
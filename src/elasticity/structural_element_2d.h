@@ -336,22 +336,79 @@ namespace MAST {
                                                   MAST::FEMOperatorMatrix& Bmat_nl_u,
                                                   MAST::FEMOperatorMatrix& Bmat_nl_v);
 
+        /*!
+         *   implementation of initialize_von_karman_strain_operator() with
+         *   fixed size strain quantities. \p phi_vec is a work vector with
+         *   one entry per shape function, which is provided by the caller
+         *   so that it can be reused across quadrature points.
+         */
+        template <typename PhiVecType>
+        void
+        _von_karman_strain_operator(const unsigned int qp,
+                                    const MAST::FEBase& fe,
+                                    PhiVecType& phi_vec,
+                                    RealVector3& vk_strain,
+                                    Matrix<Real, 3, 2>& vk_dwdxi_mat,
+                                    MAST::FEMOperatorMatrix& Bmat_vk);
+        
+        /*!
+         *   implementation of initialize_green_lagrange_strain_operator()
+         *   with fixed size strain quantities. \p phi is a work vector with
+         *   one entry per shape function, which is provided by the caller
+         *   so that it can be reused across quadrature points.
+         */
+        template <typename PhiVecType>
+        void
+        _green_lagrange_strain_operator(const unsigned int qp,
+                                        const MAST::FEBase& fe,
+                                        const RealVectorX& local_disp,
+                                        PhiVecType& phi,
+                                        RealVector3& epsilon,
+                                        Matrix<Real, 3, 2>& mat_x,
+                                        Matrix<Real, 3, 2>& mat_y,
+                                        MAST::FEMOperatorMatrix& Bmat_lin,
+                                        MAST::FEMOperatorMatrix& Bmat_nl_x,
+                                        MAST::FEMOperatorMatrix& Bmat_nl_y,
+                                        MAST::FEMOperatorMatrix& Bmat_nl_u,
+                                        MAST::FEMOperatorMatrix& Bmat_nl_v);
+        
+        /*!
+         *   calculates the internal residual and Jacobian using matrices
+         *   with \p N2 rows and columns for the element dofs. \p N2 is
+         *   \p Eigen::Dynamic for a general element, or the number of
+         *   element dofs if it is known at compile time, in which case the
+         *   element matrices are allocated on the stack.
+         */
+        template <int N2>
+        bool _internal_residual(bool request_jacobian,
+                                RealVectorX& f,
+                                RealMatrixX& jac);
+        
         /*!
          *   performs integration at the quadrature point for the provided
          *   matrices. The temperature vector and matrix entities are provided for
-         *   integration
+         *   integration. The matrix and vector types for the element dofs are
+         *   template parameters so that fixed size matrices can be used
+         *   for elements with a known number of dofs.
          */
-        virtual void
+        template <typename PhiVecType,
+                  typename VecN2Type,
+                  typename MatN1N1Type,
+                  typename MatN1N2Type,
+                  typename MatN2N2Type,
+                  typename Mat2N2Type>
+        void
         _internal_residual_operation(bool                       if_vk,
                                      const unsigned int         n2,
                                      const unsigned int         qp,
                                      const MAST::FEBase&        fe,
                                      const std::vector<Real>&   JxW,
                                      bool                       request_jacobian,
-                                     RealVectorX&               local_f,
-                                     RealMatrixX&               local_jac,
+                                     VecN2Type&                 local_f,
+                                     MatN2N2Type&               local_jac,
                                      RealVectorX&               local_disp,
-                                     RealVectorX&               strain_mem,
+                                     PhiVecType&                phi_vec,
+                                     RealVector3&               strain_mem,
                                      MAST::BendingOperator2D*   bend,
                                      FEMOperatorMatrix&         Bmat_lin,
                                      FEMOperatorMatrix&         Bmat_nl_x,
@@ -360,24 +417,24 @@ namespace MAST {
                                      FEMOperatorMatrix&         Bmat_nl_v,
                                      MAST::FEMOperatorMatrix&   Bmat_bend,
                                      MAST::FEMOperatorMatrix&   Bmat_vk,
-                                     RealMatrixX&               mat_x,
-                                     RealMatrixX&               mat_y,
-                                     RealMatrixX&               stress,
-                                     RealMatrixX&               vk_dwdxi_mat,
-                                     RealMatrixX&               material_A_mat,
-                                     RealMatrixX&               material_B_mat,
-                                     RealMatrixX&               material_D_mat,
-                                     RealVectorX&               vec1_n1,
-                                     RealVectorX&               vec2_n1,
-                                     RealVectorX&               vec3_n2,
-                                     RealVectorX&               vec4_2,
-                                     RealVectorX&               vec5_2,
-                                     RealVectorX&               vec6_n2,
-                                     RealMatrixX&               mat1_n1n2,
-                                     RealMatrixX&               mat2_n2n2,
-                                     RealMatrixX&               mat3,
-                                     RealMatrixX&               mat4_2n2,
-                                     RealMatrixX&               mat5_3n2);
+                                     Matrix<Real, 3, 2>&        mat_x,
+                                     Matrix<Real, 3, 2>&        mat_y,
+                                     Matrix<Real, 2, 2>&        stress,
+                                     Matrix<Real, 3, 2>&        vk_dwdxi_mat,
+                                     MatN1N1Type&               material_A_mat,
+                                     MatN1N1Type&               material_B_mat,
+                                     MatN1N1Type&               material_D_mat,
+                                     RealVector3&               vec1_n1,
+                                     RealVector3&               vec2_n1,
+                                     VecN2Type&                 vec3_n2,
+                                     Matrix<Real, 2, 1>&        vec4_2,
+                                     Matrix<Real, 2, 1>&        vec5_2,
+                                     VecN2Type&                 vec6_n2,
+                                     MatN1N2Type&               mat1_n1n2,
+                                     MatN2N2Type&               mat2_n2n2,
+                                     RealMatrix3&               mat3,
+                                     Mat2N2Type&                mat4_2n2,
+                                     Mat2N2Type&                mat5_3n2);
         
         
         /*!
@@ -1777,3 +1777,46 @@ MAST::StructuralElementBase::transform_vector_to_global_system<ComplexVectorX>
 
 
 
+
+
+// fixed size instantiations for the EDGE2, TRI3 and QUAD4 element kernels
+template
+void
+MAST::StructuralElementBase::transform_matrix_to_global_system<Matrix<Real, 12, 12> >
+(const Matrix<Real, 12, 12>& local_mat,
+ Matrix<Real, 12, 12>& global_mat) const;
+
+
+template
+void
+MAST::StructuralElementBase::transform_vector_to_global_system<Matrix<Real, 12, 1> >
+(const Matrix<Real, 12, 1>& local_vec,
+ Matrix<Real, 12, 1>& global_vec) const;
+
+
+template
+void
+MAST::StructuralElementBase::transform_matrix_to_global_system<Matrix<Real, 18, 18> >
+(const Matrix<Real, 18, 18>& local_mat,
+ Matrix<Real, 18, 18>& global_mat) const;
+
+
+template
+void
+MAST::StructuralElementBase::transform_vector_to_global_system<Matrix<Real, 18, 1> >
+(const Matrix<Real, 18, 1>& local_vec,
+ Matrix<Real, 18, 1>& global_vec) const;
+
+
+template
+void
+MAST::StructuralElementBase::transform_matrix_to_global_system<Matrix<Real, 24, 24> >
+(const Matrix<Real, 24, 24>& local_mat,
+ Matrix<Real, 24, 24>& global_mat) const;
+
+
+template
+void
+MAST::StructuralElementBase::transform_vector_to_global_system<Matrix<Real, 24, 1> >
+(const Matrix<Real, 24, 1>& local_vec,
+ Matrix<Real, 24, 1>& global_vec) const;
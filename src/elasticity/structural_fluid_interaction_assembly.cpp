@@ -63,6 +63,7 @@ clear_discipline_and_system( ) {
     
     _base_sol             = nullptr;
     _base_sol_sensitivity = nullptr;
+    _localized_basis.clear();
     
     MAST::AssemblyBase::clear_discipline_and_system();
 }
@@ -132,15 +133,12 @@ assemble_reduced_order_quantity
     const libMesh::DofMap& dof_map = nonlin_sys.get_dof_map();
     
     
-    std::unique_ptr<libMesh::NumericVector<Real> > localized_solution;
+    const libMesh::NumericVector<Real>* localized_solution = nullptr;
     if (_base_sol)
-        localized_solution.reset(build_localized_vector(nonlin_sys,
-                                                        *_base_sol).release());
+        localized_solution = &localized_work_vector(*_base_sol);
     
-    // also create localized solution vectos for the bassis vectors
-    std::vector<libMesh::NumericVector<Real>*> localized_basis(n_basis);
-    for (unsigned int i=0; i<n_basis; i++)
-        localized_basis[i] = build_localized_vector(nonlin_sys, *basis[i]).release();
+    // localize all basis vectors in a single communication
+    _localized_basis.init(nonlin_sys, basis);
     
     
     // if a solution function is attached, initialize it
@@ -167,17 +165,11 @@ assemble_reduced_order_quantity
         sol.setZero(ndofs);
         vec.setZero(ndofs);
         mat.setZero(ndofs, ndofs);
-        basis_mat.setZero(ndofs, n_basis);
+        _localized_basis.get_values(dof_indices, basis_mat);
         
-        for (unsigned int i=0; i<dof_indices.size(); i++) {
-            
-            if (_base_sol)
+        if (_base_sol)
+            for (unsigned int i=0; i<dof_indices.size(); i++)
                 sol(i) = (*localized_solution)(dof_indices[i]);
-            
-            
-            for (unsigned int j=0; j<n_basis; j++)
-                basis_mat(i,j) = (*localized_basis[j])(dof_indices[i]);
-        }
         
         
         //        if (_sol_function)
@@ -222,10 +214,6 @@ assemble_reduced_order_quantity
         _sol_function->clear();
     
     
-    // delete the localized basis vectors
-    for (unsigned int i=0; i<basis.size(); i++)
-        delete localized_basis[i];
-    
     // sum the matrix and provide it to each processor
     it  = mat_qty_map.begin();
     end = mat_qty_map.end();
@@ -270,25 +258,21 @@ assemble_reduced_order_quantity_sensitivity
     const libMesh::DofMap& dof_map = _system->system().get_dof_map();
     
     
-    std::unique_ptr<libMesh::NumericVector<Real> >
-    localized_solution,
-    localized_solution_sens;
+    const libMesh::NumericVector<Real>
+    *localized_solution      = nullptr,
+    *localized_solution_sens = nullptr;
     
     if (_base_sol) {
         
         // make sure that the solution sensitivity is provided
         libmesh_assert(_base_sol_sensitivity);
         
-        localized_solution.reset(build_localized_vector(nonlin_sys,
-                                                        *_base_sol).release());
-        localized_solution_sens.reset(build_localized_vector(nonlin_sys,
-                                                             *_base_sol_sensitivity).release());
+        localized_solution      = &localized_work_vector(*_base_sol, 0);
+        localized_solution_sens = &localized_work_vector(*_base_sol_sensitivity, 1);
     }
     
-    // also create localized solution vectos for the bassis vectors
-    std::vector<libMesh::NumericVector<Real>*> localized_basis(n_basis);
-    for (unsigned int i=0; i<n_basis; i++)
-        localized_basis[i] = build_localized_vector(nonlin_sys, *basis[i]).release();
+    // localize all basis vectors in a single communication
+    _localized_basis.init(nonlin_sys, basis);
     
     
     // if a solution function is attached, initialize it
@@ -317,7 +301,7 @@ assemble_reduced_order_quantity_sensitivity
         dsol.setZero(ndofs);
         vec.setZero(ndofs);
         mat.setZero(ndofs, ndofs);
-        basis_mat.setZero(ndofs, n_basis);
+        _localized_basis.get_values(dof_indices, basis_mat);
         
         MAST::GeomElem geom_elem;
         _elem_ops->set_elem_data(elem->dim(), *elem, geom_elem);
@@ -332,9 +316,6 @@ assemble_reduced_order_quantity_sensitivity
                 sol(i)  = (*localized_solution)(dof_indices[i]);
                 dsol(i) = (*localized_solution_sens)(dof_indices[i]);
             }
-            
-            for (unsigned int j=0; j<n_basis; j++)
-                basis_mat(i,j) = (*localized_basis[j])(dof_indices[i]);
         }
         
         _elem_ops->set_elem_solution(sol);
@@ -374,10 +355,6 @@ assemble_reduced_order_quantity_sensitivity
         _sol_function->clear();
     
     
-    // delete the localized basis vectors
-    for (unsigned int i=0; i<basis.size(); i++)
-        delete localized_basis[i];
-    
     // sum the matrix and provide it to each processor
     it  = mat_qty_map.begin();
     end = mat_qty_map.end();
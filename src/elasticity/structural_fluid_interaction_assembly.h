@@ -23,6 +23,7 @@
 
 // MAST includes
 #include "base/assembly_base.h"
+#include "numerics/localized_multi_vector.h"
 
 namespace MAST {
     
@@ -139,6 +140,12 @@ namespace MAST {
          *   perform element calculations.
          */
         const libMesh::NumericVector<Real> * _base_sol_sensitivity;
+        
+        /*!
+         *   localized values of the basis vectors used for the reduced
+         *   order quantities. The work vector is retained between calls.
+         */
+        MAST::LocalizedMultiVector _localized_basis;
     };
 }
 
@@ -109,6 +109,24 @@ init(const MAST::GeomElem& elem) {
 
 
 
+std::unique_ptr<MAST::AssemblyElemOperations>
+MAST::StructuralNonlinearAssemblyElemOperations::clone() const {
+    
+    std::unique_ptr<MAST::AssemblyElemOperations> rval;
+    
+    if (!_incompatible_sol_assembly) {
+        
+        MAST::StructuralNonlinearAssemblyElemOperations*
+        c = new MAST::StructuralNonlinearAssemblyElemOperations;
+        this->_init_clone(*c);
+        rval.reset(c);
+    }
+    
+    return rval;
+}
+
+
+
 void
 MAST::StructuralNonlinearAssemblyElemOperations::
 elem_calculations(bool if_jac,
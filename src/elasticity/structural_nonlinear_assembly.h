@@ -137,6 +137,14 @@ namespace MAST {
         virtual void
         init(const MAST::GeomElem& elem);
         
+        /*!
+         *   @returns a clone of this object for use in thread-parallel
+         *   element loops. A null pointer is returned if an incompatible
+         *   solution object is attached, since the incompatible mode
+         *   solution is stored in a map shared by all elements.
+         */
+        virtual std::unique_ptr<MAST::AssemblyElemOperations> clone() const;
+        
     protected:
         
         
@@ -69,7 +69,11 @@ initialize_bending_strain_operator_for_yz(const MAST::FEBase& fe,
     
     const unsigned int n_phi = (unsigned int)phi.size();
     
-    RealVectorX phi_vec = RealVectorX::Zero(n_phi);
+    // the work vector is resized only if this is the first call for
+    // the element, or if the number of shape functions has changed.
+    if (_phi_vec.size() != n_phi)
+        _phi_vec.setZero(n_phi);
+    RealVectorX& phi_vec = _phi_vec;
     
     for ( unsigned int i_nd=0; i_nd<n_phi; i_nd++ )
         phi_vec(i_nd) = dphi[i_nd][qp](0);  // dphi/dx
@@ -90,6 +94,26 @@ calculate_transverse_shear_residual(bool request_jacobian,
                                     RealVectorX& local_f,
                                     RealMatrixX& local_jac) {
     
+    this->transverse_shear_residual<Dynamic>(request_jacobian, local_f, local_jac);
+}
+
+
+
+template <int N2>
+void
+MAST::TimoshenkoBendingOperator::
+transverse_shear_residual(bool request_jacobian,
+                          Matrix<Real, N2, 1>&  local_f,
+                          Matrix<Real, N2, N2>& local_jac) {
+    
+    // number of shape functions known at compile time
+    const int NPhi = (N2 == Dynamic)? Dynamic : N2/6;
+    
+    typedef Matrix<Real, NPhi, 1> PhiVecType;
+    typedef Matrix<Real, N2,   1> VecN2Type;
+    typedef Matrix<Real, N2,  N2> MatN2N2Type;
+    typedef Matrix<Real,  2,  N2> Mat2N2Type;
+    
     const MAST::ElementPropertyCardBase& property = _structural_elem.elem_property();
     
     // make an fe and quadrature object for the requested order for integrating
@@ -105,15 +129,22 @@ calculate_transverse_shear_residual(bool request_jacobian,
     const std::vector<libMesh::Point>&                          xyz = fe->get_xyz();
     
     const unsigned int n_phi = (unsigned int)phi.size(), n2 = 6*n_phi;
-    RealVectorX phi_vec  = RealVectorX::Zero(n_phi);
     
-    RealVectorX
-    vec_n2    = RealVectorX::Zero(n2),
-    vec_2     = RealVectorX::Zero(2);
+    libmesh_assert(N2 == Dynamic || N2 == (int)n2);
+    libmesh_assert_equal_to(local_f.size(), n2);
+    
+    PhiVecType
+    phi_vec   = PhiVecType::Zero(n_phi);
+    VecN2Type
+    vec_n2    = VecN2Type::Zero(n2);
+    Matrix<Real, 2, 1>
+    vec_2     = Matrix<Real, 2, 1>::Zero();
     RealMatrixX
-    material_trans_shear_mat,
-    mat_n2n2  = RealMatrixX::Zero(n2,n2),
-    mat_2n2   = RealMatrixX::Zero(2,n2);
+    material_trans_shear_mat;
+    MatN2N2Type
+    mat_n2n2  = MatN2N2Type::Zero(n2,n2);
+    Mat2N2Type
+    mat_2n2   = Mat2N2Type::Zero(2,n2);
     
     
     FEMOperatorMatrix
@@ -176,8 +207,9 @@ calculate_transverse_shear_residual_sensitivity(const MAST::FunctionBase &p,
     RealVectorX phi_vec  = RealVectorX::Zero(n_phi);
     
     RealVectorX
-    vec_n2    = RealVectorX::Zero(n2),
-    vec_2     = RealVectorX::Zero(2);
+    vec_n2    = RealVectorX::Zero(n2);
+    Matrix<Real, 2, 1>
+    vec_2     = Matrix<Real, 2, 1>::Zero();
     RealMatrixX
     material_trans_shear_mat,
     mat_n2n2  = RealMatrixX::Zero(n2,n2),
@@ -221,6 +253,10 @@ calculate_transverse_shear_residual_sensitivity(const MAST::FunctionBase &p,
 
 
 
+template <typename PhiVecType,
+          typename VecN2Type,
+          typename MatN2N2Type,
+          typename Mat2N2Type>
 void
 MAST::TimoshenkoBendingOperator::
 _transverse_shear_operations(const std::vector<std::vector<Real> >& phi,
@@ -230,15 +266,17 @@ _transverse_shear_operations(const std::vector<std::vector<Real> >& phi,
                              const RealMatrixX&     material,
                              FEMOperatorMatrix&     Bmat_v,
                              FEMOperatorMatrix&     Bmat_w,
-                             RealVectorX&           phi_vec,
-                             RealVectorX&           vec_n2,
-                             RealVectorX&           vec_2,
-                             RealMatrixX&           mat_n2n2,
-                             RealMatrixX&           mat_2n2,
+                             PhiVecType&            phi_vec,
+                             VecN2Type&             vec_n2,
+                             Matrix<Real, 2, 1>&    vec_2,
+                             MatN2N2Type&           mat_n2n2,
+                             Mat2N2Type&            mat_2n2,
                              bool                   request_jacobian,
-                             RealVectorX&           local_f,
-                             RealMatrixX&           local_jac) {
+                             VecN2Type&             local_f,
+                             MatN2N2Type&           local_jac) {
 
+    Matrix<Real, 2, 1> strain;
+    
     // initialize the strain operator
     for ( unsigned int i_nd=0; i_nd<phi.size(); i_nd++ )
         phi_vec(i_nd) = dphi[i_nd][qp](0);  // dphi/dx
@@ -253,13 +291,13 @@ _transverse_shear_operations(const std::vector<std::vector<Real> >& phi,
     
     
     // now add the transverse shear component
-    Bmat_v.vector_mult(vec_2, _structural_elem.local_solution());
-    vec_2 = material * vec_2;
+    Bmat_v.vector_mult(strain, _structural_elem.local_solution());
+    vec_2.noalias() = material * strain;
     Bmat_v.vector_mult_transpose(vec_n2, vec_2);
     local_f += JxW[qp] * vec_n2;
     
-    Bmat_w.vector_mult(vec_2, _structural_elem.local_solution());
-    vec_2 = material * vec_2;
+    Bmat_w.vector_mult(strain, _structural_elem.local_solution());
+    vec_2.noalias() = material * strain;
     Bmat_w.vector_mult_transpose(vec_n2, vec_2);
     local_f += JxW[qp] * vec_n2;
     
@@ -277,3 +315,14 @@ _transverse_shear_operations(const std::vector<std::vector<Real> >& phi,
 }
 
 
+
+// explicit instantiations for the element dofs of the EDGE2 element, and
+// for a general element
+template void
+MAST::TimoshenkoBendingOperator::transverse_shear_residual<Dynamic>
+(bool, RealVectorX&, RealMatrixX&);
+
+template void
+MAST::TimoshenkoBendingOperator::transverse_shear_residual<12>
+(bool, Matrix<Real, 12, 1>&, Matrix<Real, 12, 12>&);
+
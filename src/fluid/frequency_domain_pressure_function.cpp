@@ -26,6 +26,7 @@
 #include "fluid/small_disturbance_primitive_fluid_solution.h"
 #include "fluid/flight_condition.h"
 #include "base/nonlinear_system.h"
+#include "base/mesh_field_transfer_map.h"
 
 
 // libMesh includes
@@ -40,7 +41,8 @@ FrequencyDomainPressureFunction(MAST::SystemInitialization& sys,
 MAST::FieldFunction<Complex>("frequency_domain_pressure"),
 _if_cp(false),
 _system(sys),
-_flt_cond(flt) {
+_flt_cond(flt),
+_transfer_map(nullptr) {
     
 }
 
@@ -62,6 +64,21 @@ init(const libMesh::NumericVector<Real>& steady_sol,
     
     MAST::NonlinearSystem& sys = _system.system();
     
+    // with a transfer map only the dofs needed by the mapped points are
+    // localized, and the vectors are reused across frequencies
+    if (_transfer_map) {
+        
+        _transfer_map->localize(steady_sol,          _sol);
+        _transfer_map->localize(small_dist_sol_real, _dsol_real);
+        _transfer_map->localize(small_dist_sol_imag, _dsol_imag);
+        
+        _sol_function.reset();
+        _dsol_re_function.reset();
+        _dsol_im_function.reset();
+        
+        return;
+    }
+    
     // first initialize the solution to the given vector
     // steady state solution
     _sol.reset(libMesh::NumericVector<Real>::build(sys.comm()).release());
@@ -107,6 +124,38 @@ init(const libMesh::NumericVector<Real>& steady_sol,
 
 
 
+void
+MAST::FrequencyDomainPressureFunction::
+set_transfer_map(const MAST::MeshFieldTransferMap& m) {
+    
+    libmesh_assert(m.initialized());
+    libmesh_assert(&m.source_system() == &_system.system());
+    
+    _transfer_map = &m;
+    
+    // the vectors are recreated by the next call to init()
+    _sol.reset();
+    _dsol_real.reset();
+    _dsol_imag.reset();
+    _sol_function.reset();
+    _dsol_re_function.reset();
+    _dsol_im_function.reset();
+}
+
+
+
+void
+MAST::FrequencyDomainPressureFunction::clear_transfer_map() {
+    
+    _transfer_map = nullptr;
+    
+    _sol.reset();
+    _dsol_real.reset();
+    _dsol_imag.reset();
+}
+
+
+
 
 
 void
@@ -116,7 +165,7 @@ operator () (const libMesh::Point& p,
              Complex&              dpress) const {
     
     
-    libmesh_assert(_sol_function.get()); // should be initialized before this call
+    libmesh_assert(_sol.get()); // should be initialized before this call
     
     dpress = 0.;
     
@@ -131,21 +180,35 @@ operator () (const libMesh::Point& p,
     dsol   = ComplexVectorX::Zero(_system.system().n_vars());
     
     
-    // first copy the real and imaginary solutions
-    (*_dsol_re_function)(p, 0., v);
-    MAST::copy(sol, v);
-    dsol.real() = sol;
-    
-    
-    // now the imaginary part
-    (*_dsol_im_function)(p, 0., v);
-    MAST::copy(sol, v);
-    dsol.imag() = sol;
-    
-    
-    // now the steady state function itself
-    (*_sol_function)(p, 0., v);
-    MAST::copy(sol, v);
+    if (_transfer_map) {
+        
+        // precomputed interpolation at the point
+        _transfer_map->interpolate(*_dsol_real, p, sol);
+        dsol.real() = sol;
+        
+        _transfer_map->interpolate(*_dsol_imag, p, sol);
+        dsol.imag() = sol;
+        
+        _transfer_map->interpolate(*_sol, p, sol);
+    }
+    else {
+        
+        // first copy the real and imaginary solutions
+        (*_dsol_re_function)(p, 0., v);
+        MAST::copy(sol, v);
+        dsol.real() = sol;
+        
+        
+        // now the imaginary part
+        (*_dsol_im_function)(p, 0., v);
+        MAST::copy(sol, v);
+        dsol.imag() = sol;
+        
+        
+        // now the steady state function itself
+        (*_sol_function)(p, 0., v);
+        MAST::copy(sol, v);
+    }
     
     
     MAST::PrimitiveSolution                     p_sol;
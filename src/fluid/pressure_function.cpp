@@ -26,6 +26,7 @@
 #include "fluid/small_disturbance_primitive_fluid_solution.h"
 #include "fluid/flight_condition.h"
 #include "base/nonlinear_system.h"
+#include "base/mesh_field_transfer_map.h"
 
 
 // libMesh includes
@@ -41,7 +42,8 @@ MAST::FieldFunction<Real>("pressure"),
 _if_cp            (false),
 _ref_pressure     (0.),
 _system           (sys),
-_flt_cond         (flt) {
+_flt_cond         (flt),
+_transfer_map     (nullptr) {
     
 }
 
@@ -62,6 +64,22 @@ init(const libMesh::NumericVector<Real>& steady_sol,
     
     MAST::NonlinearSystem& sys = _system.system();
     
+    // with a transfer map only the dofs needed by the mapped points are
+    // localized, and the vectors are reused in subsequent calls
+    if (_transfer_map) {
+        
+        _transfer_map->localize(steady_sol, _sol);
+        if (small_dist_sol)
+            _transfer_map->localize(*small_dist_sol, _dsol);
+        else
+            _dsol.reset();
+        
+        _sol_function.reset();
+        _dsol_function.reset();
+        
+        return;
+    }
+    
     // first initialize the solution to the given vector
     // steady state solution
     _sol.reset(libMesh::NumericVector<Real>::build(sys.comm()).release());
@@ -103,6 +121,35 @@ init(const libMesh::NumericVector<Real>& steady_sol,
 
 
 
+void
+MAST::PressureFunction::
+set_transfer_map(const MAST::MeshFieldTransferMap& m) {
+    
+    libmesh_assert(m.initialized());
+    libmesh_assert(&m.source_system() == &_system.system());
+    
+    _transfer_map = &m;
+    
+    // the vectors are recreated by the next call to init()
+    _sol.reset();
+    _dsol.reset();
+    _sol_function.reset();
+    _dsol_function.reset();
+}
+
+
+
+void
+MAST::PressureFunction::clear_transfer_map() {
+    
+    _transfer_map = nullptr;
+    
+    _sol.reset();
+    _dsol.reset();
+}
+
+
+
 
 
 void
@@ -112,7 +159,7 @@ operator() (const libMesh::Point& p,
             Real                  &press) const {
     
     
-    libmesh_assert(_sol_function.get()); // should be initialized before this call
+    libmesh_assert(_sol.get()); // should be initialized before this call
     
     press  = 0.;
     
@@ -126,8 +173,12 @@ operator() (const libMesh::Point& p,
     
     
     // now the steady state function itself
-    (*_sol_function)(p, 0., v);
-    MAST::copy(sol, v);
+    if (_transfer_map)
+        _transfer_map->interpolate(*_sol, p, sol);
+    else {
+        (*_sol_function)(p, 0., v);
+        MAST::copy(sol, v);
+    }
     
     
     MAST::PrimitiveSolution                     p_sol;
@@ -156,8 +207,8 @@ perturbation(const libMesh::Point& p,
              Real                  &dpress) const {
     
     
-    libmesh_assert(_sol_function.get()); // should be initialized before this call
-    libmesh_assert(_dsol_function.get()); // should be initialized before this call
+    libmesh_assert(_sol.get()); // should be initialized before this call
+    libmesh_assert(_dsol.get()); // should be initialized before this call
     
     dpress = 0.;
     
@@ -171,14 +222,23 @@ perturbation(const libMesh::Point& p,
     dsol   = RealVectorX::Zero(_system.system().n_vars());
     
     
-    // first copy the real and imaginary solutions
-    (*_dsol_function)(p, 0., v);
-    MAST::copy(sol, v);
-    dsol = sol;
-    
-    // now the steady state function itself
-    (*_sol_function)(p, 0., v);
-    MAST::copy(sol, v);
+    if (_transfer_map) {
+        
+        // precomputed interpolation at the point
+        _transfer_map->interpolate(*_dsol, p, dsol);
+        _transfer_map->interpolate(*_sol,  p, sol);
+    }
+    else {
+        
+        // first copy the real and imaginary solutions
+        (*_dsol_function)(p, 0., v);
+        MAST::copy(sol, v);
+        dsol = sol;
+        
+        // now the steady state function itself
+        (*_sol_function)(p, 0., v);
+        MAST::copy(sol, v);
+    }
     
     
     MAST::PrimitiveSolution                     p_sol;
@@ -37,6 +37,7 @@ namespace MAST {
     class FrequencyFunction;
     class SystemInitialization;
     class FlightCondition;
+    class MeshFieldTransferMap;
     
     
     class PressureFunction:
@@ -78,6 +79,22 @@ namespace MAST {
         void init(const libMesh::NumericVector<Real>& steady_sol,
                   const libMesh::NumericVector<Real>* small_dist_sol = nullptr);
         
+        /*!
+         *   sets the transfer map used for interpolation of the fluid
+         *   solution at the points where the pressure is evaluated. The
+         *   solutions are then localized to only the dofs needed by the
+         *   points in \p m, and the libMesh MeshFunction point search is
+         *   not used. This should be called before \p init(), and \p m
+         *   should be initialized.
+         */
+        void set_transfer_map(const MAST::MeshFieldTransferMap& m);
+        
+        
+        /*!
+         *   clears the transfer map
+         */
+        void clear_transfer_map();
+        
         
         /*!
          *   provides the value of the pressure at the specified point and time
@@ -123,6 +140,11 @@ namespace MAST {
          */
         MAST::FlightCondition&              _flt_cond;
         
+        /*!
+         *   transfer map used for interpolation, if provided
+         */
+        const MAST::MeshFieldTransferMap*   _transfer_map;
+        
         
         /*!
          *   mesh function that interpolates the solution
@@ -77,6 +77,18 @@ init(const MAST::GeomElem& elem) {
 
 
 
+std::unique_ptr<MAST::AssemblyElemOperations>
+MAST::HeatConductionNonlinearAssemblyElemOperations::clone() const {
+    
+    MAST::HeatConductionNonlinearAssemblyElemOperations*
+    c = new MAST::HeatConductionNonlinearAssemblyElemOperations;
+    this->_init_clone(*c);
+    
+    return std::unique_ptr<MAST::AssemblyElemOperations>(c);
+}
+
+
+
 
 void
 MAST::HeatConductionNonlinearAssemblyElemOperations::
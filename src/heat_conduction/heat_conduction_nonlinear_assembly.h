@@ -112,6 +112,12 @@ namespace MAST {
         virtual void
         init(const MAST::GeomElem& elem);
         
+        /*!
+         *   @returns a clone of this object for use in thread-parallel
+         *   element loops.
+         */
+        virtual std::unique_ptr<MAST::AssemblyElemOperations> clone() const;
+        
     protected:
         
     };
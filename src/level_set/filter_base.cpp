@@ -19,6 +19,9 @@
 
 // C++ includes
 #include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 // MAST includes
 #include "level_set/filter_base.h"
@@ -27,6 +30,9 @@
 #include "libmesh/mesh_base.h"
 #include "libmesh/node.h"
 #include "libmesh/numeric_vector.h"
+#include "libmesh/parallel_sync.h"
+#include "libmesh/petsc_vector.h"
+#include "libmesh/dof_map.h"
 
 
 
@@ -36,16 +42,23 @@ MAST::FilterBase::FilterBase(libMesh::System& sys,
 _level_set_system  (sys),
 _radius            (radius),
 _level_set_fe_size (0.),
-_dv_dof_ids        (dv_dof_ids) {
+_dv_dof_ids        (dv_dof_ids),
+_filter_mat        (nullptr) {
     
     libmesh_assert_greater(radius, 0.);
     
     _init();
+    _init_filter_matrix();
 }
 
 
 MAST::FilterBase::~FilterBase() {
     
+    if (_filter_mat) {
+        
+        PetscErrorCode ierr = MatDestroy(&_filter_mat);
+        CHKERRABORT(_level_set_system.comm().get(), ierr);
+    }
 }
 
 
@@ -53,36 +66,40 @@ void
 MAST::FilterBase::compute_filtered_values(const libMesh::NumericVector<Real>& input,
                                           libMesh::NumericVector<Real>& output) const {
     
-    libmesh_assert_equal_to(input.size(), _filter_map.size());
-    libmesh_assert_equal_to(output.size(), _filter_map.size());
+    libmesh_assert_equal_to(input.size(), _level_set_system.n_dofs());
+    libmesh_assert_equal_to(output.size(), _level_set_system.n_dofs());
     
-    output.zero();
+    libMesh::PetscVector<Real>
+    &in  = const_cast<libMesh::PetscVector<Real>&>
+    (dynamic_cast<const libMesh::PetscVector<Real>&>(input)),
+    &out = dynamic_cast<libMesh::PetscVector<Real>&>(output);
     
-    std::vector<Real> input_vals(input.size(), 0.);
-    input.localize(input_vals);
+    PetscErrorCode ierr = MatMult(_filter_mat, in.vec(), out.vec());
+    CHKERRABORT(_level_set_system.comm().get(), ierr);
     
-    std::map<unsigned int, std::vector<std::pair<unsigned int, Real>>>::const_iterator
-    map_it   = _filter_map.begin(),
-    map_end  = _filter_map.end();
+    // updates the ghosted values, if any
+    output.close();
+}
+
+
+
+void
+MAST::FilterBase::
+compute_filter_transpose_product(const libMesh::NumericVector<Real>& input,
+                                 libMesh::NumericVector<Real>& output) const {
     
-    for ( ; map_it != map_end; map_it++) {
-        
-        std::vector<std::pair<unsigned int, Real>>::const_iterator
-        vec_it  = map_it->second.begin(),
-        vec_end = map_it->second.end();
-        
-        for ( ; vec_it != vec_end; vec_it++) {
-            if (map_it->first >= input.first_local_index() &&
-                map_it->first <  input.last_local_index()) {
-                
-                if (_dv_dof_ids.count(map_it->first))
-                    output.add(map_it->first, input_vals[vec_it->first] * vec_it->second);
-                else
-                    output.set(map_it->first, input_vals[map_it->first]);
-            }
-        }
-    }
+    libmesh_assert_equal_to(input.size(), _level_set_system.n_dofs());
+    libmesh_assert_equal_to(output.size(), _level_set_system.n_dofs());
+    
+    libMesh::PetscVector<Real>
+    &in  = const_cast<libMesh::PetscVector<Real>&>
+    (dynamic_cast<const libMesh::PetscVector<Real>&>(input)),
+    &out = dynamic_cast<libMesh::PetscVector<Real>&>(output);
     
+    PetscErrorCode ierr = MatMultTranspose(_filter_mat, in.vec(), out.vec());
+    CHKERRABORT(_level_set_system.comm().get(), ierr);
+    
+    // updates the ghosted values, if any
     output.close();
 }
 
@@ -93,27 +110,25 @@ void
 MAST::FilterBase::compute_filtered_values(const std::vector<Real>& input,
                                           std::vector<Real>& output) const {
     
-    libmesh_assert_equal_to(input.size(), _filter_map.size());
-    libmesh_assert_equal_to(output.size(), _filter_map.size());
+    // on a distributed mesh this processor only has the rows of its own dofs
+    libmesh_assert(_level_set_system.get_mesh().is_replicated());
+    libmesh_assert_equal_to(input.size(), _level_set_system.n_dofs());
+    libmesh_assert_equal_to(output.size(), _level_set_system.n_dofs());
 
     std::fill(output.begin(), output.end(), 0.);
     
-    std::map<unsigned int, std::vector<std::pair<unsigned int, Real>>>::const_iterator
-    map_it   = _filter_map.begin(),
-    map_end  = _filter_map.end();
-    
-    for ( ; map_it != map_end; map_it++) {
+    for (unsigned int i=0; i<_filter_row_dofs.size(); i++) {
         
-        std::vector<std::pair<unsigned int, Real>>::const_iterator
-        vec_it  = map_it->second.begin(),
-        vec_end = map_it->second.end();
+        const libMesh::dof_id_type
+        dof = _filter_row_dofs[i];
         
-        for ( ; vec_it != vec_end; vec_it++) {
-            if (_dv_dof_ids.count(map_it->first))
-                output[map_it->first] += input[vec_it->first] * vec_it->second;
-            else
-                output[map_it->first] += input[map_it->first];
+        if (_dv_dof_ids.count(dof)) {
+            
+            for (unsigned int j=_filter_row_begin[i]; j<_filter_row_begin[i+1]; j++)
+                output[dof] += input[_filter_col_dofs[j]] * _filter_coeffs[j];
         }
+        else
+            output[dof] = input[dof];
     }
 }
 
@@ -151,19 +166,94 @@ if_elem_in_domain_of_influence(const libMesh::Elem& elem,
 void
 MAST::FilterBase::_init() {
     
-    libmesh_assert(!_filter_map.size());
+    libmesh_assert(_filter_row_dofs.empty());
     
     libMesh::MeshBase& mesh = _level_set_system.get_mesh();
     
-    // currently implemented for replicated mesh
-    libmesh_assert(mesh.is_replicated());
+    const unsigned int
+    sys_num = _level_set_system.number();
+    
+    // location of all nodes that can contribute to the filtered values
+    // on this processor, identified by their dof ids. On a replicated mesh
+    // this includes all nodes, and on a distributed mesh this includes the
+    // local and ghosted nodes and the nodes from other processors within
+    // the filter radius.
+    std::map<libMesh::dof_id_type, libMesh::Point>
+    nodes;
+    
+    // nodes for which the filtered values are computed on this processor
+    std::vector<const libMesh::Node*>
+    row_nodes;
     
-    // iterate over all nodes to compute the
     libMesh::MeshBase::const_node_iterator
-    node_it_1    =  mesh.nodes_begin(),
-    node_it_2    =  mesh.nodes_begin(),
+    node_it      =  mesh.nodes_begin(),
     node_end     =  mesh.nodes_end();
     
+    for ( ; node_it != node_end; node_it++) {
+        
+        const libMesh::Node* nd = *node_it;
+        
+        nodes[nd->dof_number(sys_num, 0, 0)] = *nd;
+        
+        if (mesh.is_replicated() ||
+            nd->processor_id() == mesh.processor_id())
+            row_nodes.push_back(nd);
+    }
+    
+    if (!mesh.is_replicated())
+        _add_remote_neighbor_nodes(nodes);
+    
+    // the nodes are sorted into uniform bins of size equal to the filter
+    // radius, so that the nodes within the radius of a given node are
+    // in the same or adjacent bins.
+    libMesh::Point
+    p_min,
+    p_max;
+    
+    for (unsigned int i=0; i<3; i++) {
+        p_min(i) =  std::numeric_limits<Real>::max();
+        p_max(i) = -std::numeric_limits<Real>::max();
+    }
+    
+    std::map<libMesh::dof_id_type, libMesh::Point>::const_iterator
+    it   = nodes.begin(),
+    end  = nodes.end();
+    
+    for ( ; it != end; it++)
+        for (unsigned int i=0; i<3; i++) {
+            p_min(i) = std::min(p_min(i), it->second(i));
+            p_max(i) = std::max(p_max(i), it->second(i));
+        }
+    
+    std::size_t
+    n_bins[3] = {1, 1, 1};
+    
+    if (!nodes.empty())
+        for (unsigned int i=0; i<3; i++)
+            n_bins[i] = (std::size_t)std::floor((p_max(i)-p_min(i))/_radius) + 1;
+    
+    // bin id and pointer to the node in the map of nodes
+    typedef std::pair<std::size_t, const std::pair<const libMesh::dof_id_type, libMesh::Point>*> BinEntry;
+    
+    std::vector<BinEntry>
+    bins;
+    bins.reserve(nodes.size());
+    
+    for (it = nodes.begin(); it != end; it++) {
+        
+        std::size_t b[3];
+        for (unsigned int i=0; i<3; i++)
+            b[i] = std::min((std::size_t)std::floor((it->second(i)-p_min(i))/_radius),
+                            n_bins[i]-1);
+        
+        bins.push_back(std::make_pair(b[0] + n_bins[0]*(b[1] + n_bins[1]*b[2]),
+                                      &(*it)));
+    }
+    
+    std::sort(bins.begin(), bins.end(),
+              [](const BinEntry& a, const BinEntry& b)
+              { return a.first < b.first; });
+    
     libMesh::Point
     d;
     
@@ -171,43 +261,75 @@ MAST::FilterBase::_init() {
     d_12 = 0.,
     sum  = 0.;
     
-    unsigned int
-    dof_1,
-    dof_2;
+    std::vector<std::pair<libMesh::dof_id_type, Real>>
+    row;
     
-    for ( ; node_it_1 != node_end; node_it_1++) {
+    _filter_row_dofs.reserve(row_nodes.size());
+    _filter_row_begin.reserve(row_nodes.size()+1);
+    _filter_row_begin.push_back(0);
+    
+    for (unsigned int n=0; n<row_nodes.size(); n++) {
         
-        dof_1 = (*node_it_1)->dof_number(_level_set_system.number(), 0, 0);
+        const libMesh::Node& nd = *row_nodes[n];
         
-        node_it_2 = mesh.nodes_begin();
-        sum       = 0.;
+        row.clear();
+        sum = 0.;
         
-        for ( ; node_it_2 != node_end; node_it_2++) {
-            
-            // compute the distance between the two nodes
-            d    = (**node_it_1) - (**node_it_2);
-            d_12 = d.norm();
-            
-            // if the nodes is within the filter radius, add it to the map
-            if (d_12 <= _radius) {
-                
-                sum  += _radius - d_12;
-                dof_2 = (*node_it_2)->dof_number(_level_set_system.number(), 0, 0);
-
-                _filter_map[dof_1].push_back(std::pair<unsigned int, Real>(dof_2, _radius - d_12));
-            }
+        std::size_t
+        b_lo[3],
+        b_hi[3];
+        
+        for (unsigned int i=0; i<3; i++) {
+            std::size_t b = std::min((std::size_t)std::floor((nd(i)-p_min(i))/_radius),
+                                     n_bins[i]-1);
+            b_lo[i] = (b > 0)? b-1: 0;
+            b_hi[i] = std::min(b+1, n_bins[i]-1);
         }
         
+        // search the adjacent bins for nodes within the filter radius
+        for (std::size_t k=b_lo[2]; k<=b_hi[2]; k++)
+            for (std::size_t j=b_lo[1]; j<=b_hi[1]; j++)
+                for (std::size_t i=b_lo[0]; i<=b_hi[0]; i++) {
+                    
+                    const std::size_t
+                    bin_id = i + n_bins[0]*(j + n_bins[1]*k);
+                    
+                    std::vector<BinEntry>::const_iterator
+                    b_it  = std::lower_bound(bins.begin(), bins.end(), bin_id,
+                                             [](const BinEntry& a, std::size_t v)
+                                             { return a.first < v; });
+                    
+                    for ( ; b_it != bins.end() && b_it->first == bin_id; b_it++) {
+                        
+                        // compute the distance between the two nodes
+                        d    = nd - b_it->second->second;
+                        d_12 = d.norm();
+                        
+                        // if the nodes is within the filter radius, add it to the map
+                        if (d_12 <= _radius) {
+                            
+                            sum  += _radius - d_12;
+                            row.push_back(std::pair<libMesh::dof_id_type, Real>
+                                          (b_it->second->first, _radius - d_12));
+                        }
+                    }
+                }
+        
         libmesh_assert_greater(sum, 0.);
         
-        // with the coefficients computed for dof_1, divide each coefficient
-        // with the sum
-        std::vector<std::pair<unsigned int, Real>>& vec = _filter_map[dof_1];
-        for (unsigned int i=0; i<vec.size(); i++) {
+        std::sort(row.begin(), row.end());
+        
+        // with the coefficients computed for this node, divide each
+        // coefficient with the sum
+        for (unsigned int i=0; i<row.size(); i++) {
             
-            vec[i].second /= sum;
-            libmesh_assert_less_equal(vec[i].second, 1.);
+            _filter_col_dofs.push_back(row[i].first);
+            _filter_coeffs.push_back(row[i].second/sum);
+            libmesh_assert_less_equal(_filter_coeffs.back(), 1.);
         }
+        
+        _filter_row_dofs.push_back(nd.dof_number(sys_num, 0, 0));
+        _filter_row_begin.push_back((unsigned int)_filter_col_dofs.size());
     }
     
     // compute the largest element size
@@ -222,9 +344,188 @@ MAST::FilterBase::_init() {
         if (_level_set_fe_size < d_12)
             _level_set_fe_size = d_12;
     }
+    
+    if (!mesh.is_replicated())
+        mesh.comm().max(_level_set_fe_size);
 }
 
 
+
+void
+MAST::FilterBase::
+_add_remote_neighbor_nodes(std::map<libMesh::dof_id_type, libMesh::Point>& nodes) const {
+    
+    libMesh::MeshBase& mesh = _level_set_system.get_mesh();
+    
+    const unsigned int
+    sys_num = _level_set_system.number();
+    
+    // bounding box of the local nodes, expanded by the filter radius
+    std::vector<Real>
+    box(6, 0.);
+    
+    for (unsigned int i=0; i<3; i++) {
+        box[i]   =  std::numeric_limits<Real>::max();
+        box[i+3] = -std::numeric_limits<Real>::max();
+    }
+    
+    libMesh::MeshBase::const_node_iterator
+    node_it      =  mesh.local_nodes_begin(),
+    node_end     =  mesh.local_nodes_end();
+    
+    for ( ; node_it != node_end; node_it++)
+        for (unsigned int i=0; i<3; i++) {
+            box[i]   = std::min(box[i],   (**node_it)(i) - _radius);
+            box[i+3] = std::max(box[i+3], (**node_it)(i) + _radius);
+        }
+    
+    // the boxes of all processors, in order of processor id
+    mesh.comm().allgather(box, true);
+    
+    // send the coordinates and dof id of each local node to the processors
+    // whose box contains the node
+    std::map<libMesh::processor_id_type, std::vector<Real>>
+    send_data;
+    
+    for (node_it = mesh.local_nodes_begin(); node_it != node_end; node_it++) {
+        
+        const libMesh::Node& nd = **node_it;
+        
+        for (libMesh::processor_id_type p=0; p<mesh.n_processors(); p++) {
+            
+            if (p == mesh.processor_id())
+                continue;
+            
+            bool
+            inside = true;
+            
+            for (unsigned int i=0; i<3; i++)
+                inside = inside && nd(i) >= box[6*p+i] && nd(i) <= box[6*p+i+3];
+            
+            if (inside) {
+                
+                std::vector<Real>& v = send_data[p];
+                v.push_back(nd(0));
+                v.push_back(nd(1));
+                v.push_back(nd(2));
+                v.push_back(nd.dof_number(sys_num, 0, 0));
+            }
+        }
+    }
+    
+    auto
+    recv_nodes = [&nodes] (libMesh::processor_id_type,
+                           const std::vector<Real>& v) {
+        
+        for (unsigned int i=0; i<v.size()/4; i++)
+            nodes[(libMesh::dof_id_type)v[4*i+3]] =
+            libMesh::Point(v[4*i], v[4*i+1], v[4*i+2]);
+    };
+    
+    libMesh::Parallel::push_parallel_vector_data(mesh.comm(), send_data, recv_nodes);
+}
+
+
+void
+MAST::FilterBase::_init_filter_matrix() {
+    
+    libmesh_assert(!_filter_mat);
+    
+    const libMesh::DofMap& dof_map = _level_set_system.get_dof_map();
+    
+    const libMesh::dof_id_type
+    n_dofs    = dof_map.n_dofs(),
+    first_dof = dof_map.first_dof(),
+    end_dof   = dof_map.end_dof();
+    
+    const PetscInt
+    n_local   = end_dof - first_dof;
+    
+    // number of nonzeros in the diagonal and off-diagonal blocks of
+    // the local rows
+    std::vector<PetscInt>
+    n_nz(n_local, 0),
+    n_oz(n_local, 0);
+    
+    for (unsigned int i=0; i<_filter_row_dofs.size(); i++) {
+        
+        const libMesh::dof_id_type
+        dof = _filter_row_dofs[i];
+        
+        if (dof < first_dof || dof >= end_dof)
+            continue;
+        
+        if (_dv_dof_ids.count(dof)) {
+            
+            for (unsigned int j=_filter_row_begin[i]; j<_filter_row_begin[i+1]; j++) {
+                
+                if (_filter_col_dofs[j] >= first_dof &&
+                    _filter_col_dofs[j] <  end_dof)
+                    n_nz[dof-first_dof]++;
+                else
+                    n_oz[dof-first_dof]++;
+            }
+        }
+        else
+            n_nz[dof-first_dof] = 1;
+    }
+    
+    PetscErrorCode ierr;
+    const MPI_Comm comm = _level_set_system.comm().get();
+    
+    ierr = MatCreateAIJ(comm,
+                        n_local, n_local,
+                        n_dofs, n_dofs,
+                        0, n_local? &n_nz[0]: nullptr,
+                        0, n_local? &n_oz[0]: nullptr,
+                        &_filter_mat);                              CHKERRABORT(comm, ierr);
+    ierr = MatSetOption(_filter_mat,
+                        MAT_NEW_NONZERO_ALLOCATION_ERR,
+                        PETSC_TRUE);                                CHKERRABORT(comm, ierr);
+    
+    std::vector<PetscInt>
+    cols;
+    std::vector<PetscScalar>
+    vals;
+    
+    for (unsigned int i=0; i<_filter_row_dofs.size(); i++) {
+        
+        const PetscInt
+        dof = _filter_row_dofs[i];
+        
+        if (dof < (PetscInt)first_dof || dof >= (PetscInt)end_dof)
+            continue;
+        
+        cols.clear();
+        vals.clear();
+        
+        if (_dv_dof_ids.count(dof)) {
+            
+            for (unsigned int j=_filter_row_begin[i]; j<_filter_row_begin[i+1]; j++) {
+                
+                cols.push_back(_filter_col_dofs[j]);
+                vals.push_back(_filter_coeffs[j]);
+            }
+        }
+        else {
+            
+            cols.push_back(dof);
+            vals.push_back(1.);
+        }
+        
+        ierr = MatSetValues(_filter_mat,
+                            1, &dof,
+                            (PetscInt)cols.size(), &cols[0],
+                            &vals[0],
+                            INSERT_VALUES);                         CHKERRABORT(comm, ierr);
+    }
+    
+    ierr = MatAssemblyBegin(_filter_mat, MAT_FINAL_ASSEMBLY);       CHKERRABORT(comm, ierr);
+    ierr = MatAssemblyEnd(_filter_mat, MAT_FINAL_ASSEMBLY);         CHKERRABORT(comm, ierr);
+}
+
+
+
 void
 MAST::FilterBase::print(std::ostream& o) const {
     
@@ -234,29 +535,22 @@ MAST::FilterBase::print(std::ostream& o) const {
     << std::setw(20) << "Filtered ID"
     << std::setw(20) << "Dependent Vars" << std::endl;
     
-    std::map<unsigned int, std::vector<std::pair<unsigned int, Real>>>::const_iterator
-    map_it   = _filter_map.begin(),
-    map_end  = _filter_map.end();
-    
-    for ( ; map_it != map_end; map_it++) {
+    for (unsigned int i=0; i<_filter_row_dofs.size(); i++) {
         
-        o
-        << std::setw(20) << map_it->first;
+        const libMesh::dof_id_type
+        dof = _filter_row_dofs[i];
         
-        std::vector<std::pair<unsigned int, Real>>::const_iterator
-        vec_it  = map_it->second.begin(),
-        vec_end = map_it->second.end();
+        o
+        << std::setw(20) << dof;
         
-        for ( ; vec_it != vec_end; vec_it++) {
-            
-            if (_dv_dof_ids.count(map_it->first))
+        if (_dv_dof_ids.count(dof))
+            for (unsigned int j=_filter_row_begin[i]; j<_filter_row_begin[i+1]; j++)
                 o
-                << " : " << std::setw(8) << vec_it->first
-                << " (" << std::setw(8) << vec_it->second << " )";
-            else
-                libMesh::out << " : " << map_it->first;
-        }
-        libMesh::out << std::endl;
+                << " : " << std::setw(8) << _filter_col_dofs[j]
+                << " (" << std::setw(8) << _filter_coeffs[j] << " )";
+        else
+            o << " : " << dof;
+        
+        o << std::endl;
     }
 }
-
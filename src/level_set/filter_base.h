@@ -30,6 +30,9 @@
 #include "libmesh/node.h"
 #include "libmesh/elem.h"
 
+// PETSc includes
+#include <petscmat.h>
+
 
 namespace MAST {
     
@@ -54,6 +57,23 @@ namespace MAST {
                                      libMesh::NumericVector<Real>& output) const;
 
         
+        /*!
+         *   computes the product of the transpose of the filter matrix with
+         *   \p input in \p output. This maps the sensitivity of a quantity
+         *   with respect to the filtered values to its sensitivity with
+         *   respect to the unfiltered design variables.
+         */
+        void compute_filter_transpose_product(const libMesh::NumericVector<Real>& input,
+                                              libMesh::NumericVector<Real>& output) const;
+        
+        
+        /*!
+         *   computes the filtered output from the provided input. The
+         *   values of dofs that are not design variables are copied from
+         *   \p input. Both vectors contain the values of all dofs, and
+         *   this is only available on a replicated mesh, where the filter
+         *   has rows for all dofs on every processor.
+         */
         void compute_filtered_values(const std::vector<Real>& input,
                                      std::vector<Real>& output) const;
 
@@ -82,6 +102,19 @@ namespace MAST {
          */
         void _init();
         
+        /*!
+         *   adds to \p nodes the location of nodes owned by other processors
+         *   that are within the filter radius of the bounding box of the
+         *   nodes local to this processor. This is used on a distributed mesh.
+         */
+        void _add_remote_neighbor_nodes(std::map<libMesh::dof_id_type, libMesh::Point>& nodes) const;
+        
+        /*!
+         *   initializes the distributed filter matrix from the filter
+         *   coefficients.
+         */
+        void _init_filter_matrix();
+        
         /*!
          *   system on which the level set discrete function is defined
          */
@@ -106,9 +139,26 @@ namespace MAST {
 
         /*!
          *   Algebraic relation between filtered level set values and the
-         *   design variables \f$ \tilde{\phi}_i = B_{ij} \phi_j \f$
+         *   design variables \f$ \tilde{\phi}_i = B_{ij} \phi_j \f$ stored
+         *   in compressed sparse row format. Rows are stored for all nodes on
+         *   a replicated mesh, and for the local nodes on a distributed mesh.
+         *   \p _filter_row_dofs is the dof id of each row, and the
+         *   coefficients of row \p i are in \p _filter_col_dofs and
+         *   \p _filter_coeffs between \p _filter_row_begin[i] and
+         *   \p _filter_row_begin[i+1].
+         */
+        std::vector<libMesh::dof_id_type>   _filter_row_dofs;
+        std::vector<unsigned int>           _filter_row_begin;
+        std::vector<libMesh::dof_id_type>   _filter_col_dofs;
+        std::vector<Real>                   _filter_coeffs;
+        
+        /*!
+         *   distributed matrix of the filter coefficients. Rows of dofs that
+         *   are not design variables have unit diagonal entries, so that
+         *   the filtered values are obtained with a single matrix-vector
+         *   product.
          */
-        std::map<unsigned int, std::vector<std::pair<unsigned int, Real>>> _filter_map;
+        Mat                                 _filter_mat;
     };
     
     
@@ -40,7 +40,9 @@ _if_elem_on_positive_phi         (false),
 _if_elem_on_negative_phi         (false),
 _mode                            (MAST::NO_INTERSECTION),
 _node_num_on_boundary            (0),
-_edge_num_on_boundary            (0){
+_edge_num_on_boundary            (0),
+_if_cache                        (false),
+_if_data_in_cache                (false) {
     
 }
     
@@ -48,6 +50,33 @@ _edge_num_on_boundary            (0){
 MAST::LevelSetIntersection::~LevelSetIntersection() {
 
     this->clear();
+    this->clear_cache();
+}
+
+
+
+MAST::LevelSetIntersection::IntersectionData::IntersectionData():
+phi                        (nullptr),
+t                          (0.),
+max_mesh_elem_id           (0),
+max_mesh_node_id           (0),
+if_elem_on_positive_phi    (false),
+if_elem_on_negative_phi    (false),
+mode                       (MAST::NO_INTERSECTION),
+node_num_on_boundary       (0),
+edge_num_on_boundary       (0) {
+    
+}
+
+
+
+MAST::LevelSetIntersection::IntersectionData::~IntersectionData() {
+    
+    for (unsigned int i=0; i<new_elems.size(); i++)
+        delete new_elems[i];
+    
+    for (unsigned int i=0; i<new_nodes.size(); i++)
+        delete new_nodes[i];
 }
 
 
@@ -199,23 +228,59 @@ MAST::LevelSetIntersection::clear() {
     _elem_sides_on_interface.clear();
     _node_local_coords.clear();
     
-    std::vector<libMesh::Elem*>::iterator
-    e_it  = _new_elems.begin(),
-    e_end = _new_elems.end();
-    
-    for ( ; e_it != e_end; e_it++)
-        delete *e_it;
+    // sub-elements and nodes owned by the cache are deleted with the cache
+    if (!_if_data_in_cache) {
+        
+        std::vector<libMesh::Elem*>::iterator
+        e_it  = _new_elems.begin(),
+        e_end = _new_elems.end();
+        
+        for ( ; e_it != e_end; e_it++)
+            delete *e_it;
+        
+        
+        std::vector<libMesh::Node*>::iterator
+        n_it  = _new_nodes.begin(),
+        n_end = _new_nodes.end();
+        
+        for ( ; n_it != n_end; n_it++)
+            delete *n_it;
+    }
+
+    _new_nodes.clear();
+    _new_elems.clear();
+    _if_data_in_cache = false;
+}
+
+
+
+void
+MAST::LevelSetIntersection::set_cache_intersections(bool f) {
     
+    libmesh_assert(!_initialized);
     
-    std::vector<libMesh::Node*>::iterator
-    n_it  = _new_nodes.begin(),
-    n_end = _new_nodes.end();
+    _if_cache = f;
     
-    for ( ; n_it != n_end; n_it++)
-        delete *n_it;
+    if (!f)
+        this->clear_cache();
+}
 
-    _new_nodes.clear();
-    _new_elems.clear();
+
+
+void
+MAST::LevelSetIntersection::clear_cache() {
+    
+    // the data of the current element should not be deleted while in use
+    libmesh_assert(!_initialized || !_if_data_in_cache);
+    
+    std::map<const libMesh::Elem*, IntersectionData*>::iterator
+    it   = _cache.begin(),
+    end  = _cache.end();
+    
+    for ( ; it != end; it++)
+        delete it->second;
+    
+    _cache.clear();
 }
 
 
@@ -235,6 +300,21 @@ MAST::LevelSetIntersection::init(const MAST::FieldFunction<Real>& phi,
     
     _elem      =  &e;
     
+    // level-set values at the element nodes are used to check the validity
+    // of the stored data
+    std::vector<Real>
+    node_vals;
+    
+    if (_if_cache) {
+        
+        node_vals.resize(e.n_nodes(), 0.);
+        for (unsigned int i=0; i<e.n_nodes(); i++)
+            phi(e.node_ref(i), t, node_vals[i]);
+        
+        if (_init_from_cache(phi, e, t, node_vals))
+            return;
+    }
+    
     switch (e.type()) {
         case libMesh::QUAD4:
             _init_on_first_order_ref_elem(phi, e, t);
@@ -252,6 +332,90 @@ MAST::LevelSetIntersection::init(const MAST::FieldFunction<Real>& phi,
             // currently only QUAD4/9 are handled.
             libmesh_error();
     }
+    
+    if (_if_cache)
+        _add_to_cache(phi, t, node_vals);
+}
+
+
+
+bool
+MAST::LevelSetIntersection::_init_from_cache(const MAST::FieldFunction<Real>& phi,
+                                             const libMesh::Elem& e,
+                                             const Real t,
+                                             const std::vector<Real>& node_vals) {
+    
+    std::map<const libMesh::Elem*, IntersectionData*>::const_iterator
+    it = _cache.find(&e);
+    
+    if (it == _cache.end())
+        return false;
+    
+    const IntersectionData& d = *it->second;
+    
+    if (d.phi              != &phi              ||
+        d.t                != t                 ||
+        d.max_mesh_elem_id != _max_mesh_elem_id ||
+        d.max_mesh_node_id != _max_mesh_node_id ||
+        d.node_vals        != node_vals)
+        return false;
+    
+    _if_elem_on_positive_phi  = d.if_elem_on_positive_phi;
+    _if_elem_on_negative_phi  = d.if_elem_on_negative_phi;
+    _mode                     = d.mode;
+    _node_num_on_boundary     = d.node_num_on_boundary;
+    _edge_num_on_boundary     = d.edge_num_on_boundary;
+    _positive_phi_elems       = d.positive_phi_elems;
+    _negative_phi_elems       = d.negative_phi_elems;
+    _elem_sides_on_interface  = d.elem_sides_on_interface;
+    _new_nodes                = d.new_nodes;
+    _new_elems                = d.new_elems;
+    _node_local_coords        = d.node_local_coords;
+    _node_phi_vals            = d.node_phi_vals;
+    _if_data_in_cache         = true;
+    _initialized              = true;
+    
+    return true;
+}
+
+
+
+void
+MAST::LevelSetIntersection::_add_to_cache(const MAST::FieldFunction<Real>& phi,
+                                          const Real t,
+                                          const std::vector<Real>& node_vals) {
+    
+    libmesh_assert(_initialized);
+    libmesh_assert(!_if_data_in_cache);
+    
+    IntersectionData*& d = _cache[_elem];
+    
+    // replace the outdated data, if any
+    if (d)
+        delete d;
+    
+    d = new IntersectionData;
+    
+    d->phi                      = &phi;
+    d->t                        = t;
+    d->max_mesh_elem_id         = _max_mesh_elem_id;
+    d->max_mesh_node_id         = _max_mesh_node_id;
+    d->node_vals                = node_vals;
+    d->if_elem_on_positive_phi  = _if_elem_on_positive_phi;
+    d->if_elem_on_negative_phi  = _if_elem_on_negative_phi;
+    d->mode                     = _mode;
+    d->node_num_on_boundary     = _node_num_on_boundary;
+    d->edge_num_on_boundary     = _edge_num_on_boundary;
+    d->positive_phi_elems       = _positive_phi_elems;
+    d->negative_phi_elems       = _negative_phi_elems;
+    d->elem_sides_on_interface  = _elem_sides_on_interface;
+    d->new_nodes                = _new_nodes;
+    d->new_elems                = _new_elems;
+    d->node_local_coords        = _node_local_coords;
+    d->node_phi_vals            = _node_phi_vals;
+    
+    // the sub-elements and nodes are now owned by the stored data
+    _if_data_in_cache = true;
 }
 
 
@@ -22,6 +22,7 @@
 
 // C++ includes
 #include <vector>
+#include <map>
 
 // MAST includes
 #include "base/mast_data_types.h"
@@ -70,6 +71,22 @@ namespace MAST {
          */
         void clear();
         
+        /*!
+         *   If \p f is \p true, the intersection data computed for an element
+         *   is stored and reused by subsequent calls to init() for the same
+         *   element, as long as the level-set function, the time, the
+         *   mesh ids and the level-set values at the element nodes have not
+         *   changed. Setting \p f to \p false clears the stored data.
+         */
+        void set_cache_intersections(bool f);
+        
+        /*!
+         *   clears the intersection data stored for all elements. This
+         *   should be called if the level-set function changes in a manner
+         *   that does not change its values at the element nodes.
+         */
+        void clear_cache();
+        
         /*!
          *   @return a reference to the element on which the intersection is
          *   defined
@@ -167,6 +184,55 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *   intersection data of an element stored for reuse. The sub-elements
+         *   and the nodes created for the element are owned by this object.
+         */
+        struct IntersectionData {
+            
+            IntersectionData();
+            
+            ~IntersectionData();
+            
+            const MAST::FieldFunction<Real>*             phi;
+            Real                                         t;
+            unsigned int                                 max_mesh_elem_id;
+            unsigned int                                 max_mesh_node_id;
+            std::vector<Real>                            node_vals;
+            bool                                         if_elem_on_positive_phi;
+            bool                                         if_elem_on_negative_phi;
+            MAST::LevelSet2DIntersectionMode             mode;
+            unsigned int                                 node_num_on_boundary;
+            unsigned int                                 edge_num_on_boundary;
+            std::vector<const libMesh::Elem*>            positive_phi_elems;
+            std::vector<const libMesh::Elem*>            negative_phi_elems;
+            std::map<const libMesh::Elem*, int>          elem_sides_on_interface;
+            std::vector<libMesh::Node*>                  new_nodes;
+            std::vector<libMesh::Elem*>                  new_elems;
+            std::map<const libMesh::Node*, libMesh::Point> node_local_coords;
+            std::map<const libMesh::Node*, std::pair<Real, bool> > node_phi_vals;
+        };
+        
+        /*!
+         *   initializes the intersection from the data stored for \p e, if
+         *   the data is available and consistent with the specified
+         *   arguments. \p node_vals are the level-set values at the element
+         *   nodes. @returns \p true if the data was used.
+         */
+        bool _init_from_cache(const MAST::FieldFunction<Real>& phi,
+                              const libMesh::Elem& e,
+                              const Real t,
+                              const std::vector<Real>& node_vals);
+        
+        /*!
+         *   stores the intersection data for the element with which this
+         *   object is initialized. The ownership of the sub-elements and
+         *   new nodes is transferred to the stored data.
+         */
+        void _add_to_cache(const MAST::FieldFunction<Real>& phi,
+                           const Real t,
+                           const std::vector<Real>& node_vals);
+        
         /*!
          *   creates a first order element from the given high-order element.
          *   For a QUAD9 a QUAD4 is obtained by only using the corner nodes.
@@ -245,6 +311,22 @@ namespace MAST {
         std::vector<libMesh::Elem*>                  _new_elems;
         std::map<const libMesh::Node*, libMesh::Point> _node_local_coords;
         std::map<const libMesh::Node*, std::pair<Real, bool> > _node_phi_vals;
+        
+        /*!
+         *   \p true if the intersection data of elements is stored for reuse
+         */
+        bool                                         _if_cache;
+        
+        /*!
+         *   \p true if the sub-elements and new nodes of the current element
+         *   are owned by the stored data, and must not be deleted by clear()
+         */
+        bool                                         _if_data_in_cache;
+        
+        /*!
+         *   stored intersection data for each element
+         */
+        std::map<const libMesh::Elem*, IntersectionData*> _cache;
     };
     
 }
@@ -31,6 +31,7 @@
 #include "base/mesh_field_function.h"
 #include "base/nonlinear_implicit_assembly_elem_operations.h"
 #include "base/output_assembly_elem_operations.h"
+#include "base/parameter_dependency_index.h"
 #include "base/elem_base.h"
 #include "numerics/utility.h"
 
@@ -111,6 +112,10 @@ set_level_set_function(MAST::FieldFunction<Real>& level_set,
     _level_set    = &level_set;
     _filter       = &filter;
     _intersection = new MAST::LevelSetIntersection();
+    // the level set does not change during the residual, output and
+    // sensitivity evaluations for a design, so the intersection of each
+    // element is computed once and reused until the level set changes.
+    _intersection->set_cache_intersections(true);
     if (_enable_dof_handler) {
         _dof_handler  = new MAST::LevelSetInterfaceDofHandler();
         _dof_handler->init(*_system, *_intersection, *_level_set);
@@ -1334,3 +1339,165 @@ calculate_output_direct_sensitivity(const libMesh::NumericVector<Real>& X,
     output.clear_assembly();
 }
 
+
+
+
+void
+MAST::LevelSetNonlinearImplicitAssembly::
+calculate_output_direct_sensitivities(const libMesh::NumericVector<Real>& X,
+                                      const std::vector<const libMesh::NumericVector<Real>*>& dXdp,
+                                      const std::vector<const MAST::FunctionBase*>& params,
+                                      MAST::OutputAssemblyElemOperations& output,
+                                      std::vector<Real>& dq_dp) {
+    
+    libmesh_assert(_system);
+    libmesh_assert(_discipline);
+    libmesh_assert(_level_set);
+    libmesh_assert(dXdp.empty() || dXdp.size() == params.size());
+    
+    // limit the number of localized solution sensitivity vectors
+    if (_calculate_output_direct_sensitivities_in_batches(X, dXdp, params, output, dq_dp))
+        return;
+    
+    const unsigned int
+    n_params = (unsigned int)params.size();
+    
+    dq_dp.assign(n_params, 0.);
+    
+    output.zero_for_sensitivity();
+    
+    MAST::NonlinearSystem& nonlin_sys = _system->system();
+    output.set_assembly(*this);
+    
+    // the dependency of the property cards and loads on all parameters
+    // is computed once, instead of once for each element and parameter.
+    MAST::ParameterDependencyIndex dependency;
+    _init_parameter_dependency(params, dependency);
+    
+    const Real
+    tol   = 1.e-10;
+    
+    // iterate over each element, initialize it and get the relevant
+    // analysis quantities
+    RealVectorX
+    sol,
+    dsol,
+    nd_indicator = RealVectorX::Ones(1),
+    indicator    = RealVectorX::Zero(1);
+    
+    std::vector<libMesh::dof_id_type> dof_indices;
+    std::vector<unsigned int>         p_ids;
+    const libMesh::DofMap& dof_map = _system->system().get_dof_map();
+    
+    
+    std::unique_ptr<libMesh::NumericVector<Real> >
+    localized_solution;
+    std::vector<std::unique_ptr<libMesh::NumericVector<Real> > >
+    localized_solution_sens(dXdp.size());
+    
+    localized_solution.reset(build_localized_vector(nonlin_sys,
+                                                    X).release());
+    for (unsigned int i=0; i<dXdp.size(); i++)
+        localized_solution_sens[i].reset(build_localized_vector(nonlin_sys,
+                                                                *dXdp[i]).release());
+    
+    
+    libMesh::MeshBase::const_element_iterator       el     =
+    nonlin_sys.get_mesh().active_local_elements_begin();
+    const libMesh::MeshBase::const_element_iterator end_el =
+    nonlin_sys.get_mesh().active_local_elements_end();
+    
+    
+    for ( ; el != end_el; ++el) {
+        
+        const libMesh::Elem* elem = *el;
+        
+        _elem_parameters(*elem, params, !dXdp.empty(), p_ids);
+        
+        // no sensitivity computation assembly is neeed in this case
+        if (p_ids.empty())
+            continue;
+        
+        // use the indicator if it was provided
+        if (_indicator) {
+            
+            nd_indicator.setZero(elem->n_nodes());
+            for (unsigned int i=0; i<elem->n_nodes(); i++) {
+                (*_indicator)(elem->node_ref(i), nonlin_sys.time, indicator);
+                nd_indicator(i) = indicator(0);
+            }
+        }
+        
+        _intersection->init(*_level_set, *elem, nonlin_sys.time,
+                            nonlin_sys.get_mesh().max_elem_id(),
+                            nonlin_sys.get_mesh().max_node_id());
+        
+        // sub-elements on which the output is evaluated
+        std::vector<const libMesh::Elem*>
+        sub_elems;
+        
+        if (_evaluate_output_on_negative_phi)
+            sub_elems.insert(sub_elems.end(),
+                             _intersection->get_sub_elems_negative_phi().begin(),
+                             _intersection->get_sub_elems_negative_phi().end());
+        
+        if (nd_indicator.maxCoeff() > tol &&
+            _intersection->if_elem_has_positive_phi_region())
+            sub_elems.insert(sub_elems.end(),
+                             _intersection->get_sub_elems_positive_phi().begin(),
+                             _intersection->get_sub_elems_positive_phi().end());
+        
+        if (sub_elems.size()) {
+            
+            dof_map.dof_indices (elem, dof_indices);
+            
+            // get the solution
+            unsigned int ndofs = (unsigned int)dof_indices.size();
+            sol.setZero(ndofs);
+            dsol.setZero(ndofs);
+            
+            for (unsigned int i=0; i<dof_indices.size(); i++)
+                sol(i)  = (*localized_solution)(dof_indices[i]);
+            
+            // if the element has been marked for factorization then
+            // get the void solution from the storage
+            if (_dof_handler && _dof_handler->if_factor_element(*elem))
+                _dof_handler->solution_of_factored_element(*elem, sol);
+            
+            for (unsigned int k=0; k<sub_elems.size(); k++) {
+                
+                MAST::LevelSetIntersectedElem geom_elem;
+                output.set_elem_data(elem->dim(), *elem, geom_elem);
+                geom_elem.init(*sub_elems[k], *_system, *_intersection);
+                
+                output.init(geom_elem);
+                output.set_elem_solution(sol);
+                
+                // the sub-element is initialized once and then used for all
+                // parameters that influence the element
+                for (unsigned int j=0; j<p_ids.size(); j++) {
+                    
+                    const unsigned int p = p_ids[j];
+                    
+                    if (!dXdp.empty())
+                        for (unsigned int i=0; i<dof_indices.size(); i++)
+                            dsol(i) = (*localized_solution_sens[p])(dof_indices[i]);
+                    
+                    output.set_elem_solution_sensitivity(dsol);
+                    dq_dp[p] += output.output_sensitivity_for_elem(*params[p]);
+                }
+                
+                output.clear_elem();
+            }
+        }
+        
+        _intersection->clear();
+    }
+    
+    output.clear_assembly();
+    
+    // sum over all processors since part of the mesh can live on different
+    // processors
+    nonlin_sys.comm().sum(dq_dp);
+}
+
@@ -165,6 +165,21 @@ namespace MAST {
                                             MAST::OutputAssemblyElemOperations& output);
         
         
+        /*!
+         *   evaluates the sensitivity of \p output with respect to each
+         *   parameter in \p params in a single pass over the elements. The
+         *   intersection of each element with the level set is computed once
+         *   and shared by all parameters that influence the element. See
+         *   MAST::AssemblyBase::calculate_output_direct_sensitivities().
+         */
+        virtual void
+        calculate_output_direct_sensitivities(const libMesh::NumericVector<Real>& X,
+                                              const std::vector<const libMesh::NumericVector<Real>*>& dXdp,
+                                              const std::vector<const MAST::FunctionBase*>& params,
+                                              MAST::OutputAssemblyElemOperations& output,
+                                              std::vector<Real>& dq_dp);
+        
+        
         /*!
          *   Evaluates the total sensitivity of \p output wrt \p p using
          *   the adjoint solution provided in \p dq_dX for a linearization
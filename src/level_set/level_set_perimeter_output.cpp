@@ -117,9 +117,10 @@ MAST::LevelSetPerimeter::output_sensitivity_for_elem(const MAST::FunctionBase& p
     const MAST::LevelSetIntersectedElem
     &elem = dynamic_cast<const MAST::LevelSetIntersectedElem&> (_physics_elem->elem());
     
-    if (this->if_evaluate_for_element(elem) &&
-        elem.if_elem_has_level_set_boundary() &&
-        elem.if_subelem_has_side_on_level_set_boundary()) {
+    // the perimeter is computed with a smoothed delta function, so the
+    // sensitivity is evaluated on all elements, consistent with
+    // evaluate_topology_sensitivity().
+    if (this->if_evaluate_for_element(elem)) {
         
         MAST::LevelSetElementBase&
         e = dynamic_cast<MAST::LevelSetElementBase&>(*_physics_elem);
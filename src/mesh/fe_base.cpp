@@ -31,18 +31,28 @@ _init_second_order_derivatives (false),
 _initialized                   (false),
 _elem                          (nullptr),
 _fe                            (nullptr),
-_qrule                         (nullptr) {
+_qrule                         (nullptr),
+_from_cache                    (false),
+_cache_key                     () {
     
 }
 
 
 MAST::FEBase::~FEBase() {
     
-    if (_fe)
-        delete _fe;
-    
-    if (_qrule)
-        delete _qrule;
+    if (_from_cache) {
+        
+        // return the objects for reuse by the next element
+        MAST::FECache::local_cache().release(_cache_key, _fe, _qrule);
+    }
+    else {
+        
+        if (_fe)
+            delete _fe;
+        
+        if (_qrule)
+            delete _qrule;
+    }
 }
 
 
@@ -86,8 +96,29 @@ MAST::FEBase::init(const MAST::GeomElem& elem,
     else
         q_elem = &elem.get_quadrature_elem();
     
-    // Create an adequate quadrature rule
-    _fe = libMesh::FEBase::build(q_elem->dim(), fe_type).release();
+    const int
+    q_order = _sys.system().extra_quadrature_order+_extra_quadrature_order;  // system extra quadrature
+    
+    // Create an adequate quadrature rule. If the quadrature rule is
+    // used, then the objects are obtained from the cache, which already
+    // attaches the quadrature rule to the FE object.
+    if (pts == nullptr) {
+        
+        _cache_key = MAST::FECache::Key(q_elem->type(),
+                                        fe_type,
+                                        q_order,
+                                        false,
+                                        init_grads,
+                                        _init_second_order_derivatives);
+        _from_cache = true;
+        MAST::FECache::local_cache().acquire(_cache_key,
+                                             q_elem->dim(),
+                                             _fe,
+                                             _qrule);
+    }
+    else
+        _fe = libMesh::FEBase::build(q_elem->dim(), fe_type).release();
+    
     _fe->get_phi();
     _fe->get_xyz();
     _fe->get_JxW();
@@ -99,13 +130,8 @@ MAST::FEBase::init(const MAST::GeomElem& elem,
     }
     if (_init_second_order_derivatives) _fe->get_d2phi();
     
-    if (pts == nullptr) {
-        _qrule = fe_type.default_quadrature_rule
-        (q_elem->dim(),
-         _sys.system().extra_quadrature_order+_extra_quadrature_order).release();  // system extra quadrature
-        _fe->attach_quadrature_rule(_qrule);
+    if (pts == nullptr)
         _fe->reinit(q_elem);
-    }
     else {
         _fe->reinit(q_elem, pts);
         _qpoints = *pts;
@@ -159,12 +185,23 @@ MAST::FEBase::init_for_side(const MAST::GeomElem& elem,
     else
         q_elem = &elem.get_quadrature_elem();
 
-    // Create an adequate quadrature rule
-    _fe     = libMesh::FEBase::build(q_elem->dim(), fe_type).release();
-    _qrule  = fe_type.default_quadrature_rule
-    (q_elem->dim()-1,
-     _sys.system().extra_quadrature_order+_extra_quadrature_order).release();  // system extra quadrature
-    _fe->attach_quadrature_rule(_qrule);
+    const int
+    q_order = _sys.system().extra_quadrature_order+_extra_quadrature_order;  // system extra quadrature
+    
+    // Create an adequate quadrature rule. The objects are obtained from
+    // the cache, which attaches the quadrature rule to the FE object.
+    // The same objects can be used for all sides of the element.
+    _cache_key = MAST::FECache::Key(q_elem->type(),
+                                    fe_type,
+                                    q_order,
+                                    true,
+                                    if_calculate_dphi,
+                                    if_calculate_dphi && _init_second_order_derivatives);
+    _from_cache = true;
+    MAST::FECache::local_cache().acquire(_cache_key,
+                                         q_elem->dim(),
+                                         _fe,
+                                         _qrule);
     _fe->get_phi();
     _fe->get_xyz();
     _fe->get_JxW();
@@ -23,6 +23,7 @@
 
 // MAST includes
 #include "base/mast_data_types.h"
+#include "mesh/fe_cache.h"
 
 // libMesh includes
 #include "libmesh/elem.h"
@@ -36,6 +37,14 @@ namespace MAST {
     class SystemInitialization;
     class GeomElem;
     
+    /*!
+     *   Wrapper around the libMesh finite element and quadrature objects.
+     *   Unless specific points are provided for initialization, the libMesh
+     *   objects are obtained from the MAST::FECache of the calling thread
+     *   and are returned to it on destruction. This avoids reallocation
+     *   and recomputation of reference element shape functions for each
+     *   element in assembly loops.
+     */
     class FEBase {
     
     public:
@@ -183,6 +192,12 @@ namespace MAST {
         const MAST::GeomElem*             _elem;
         libMesh::FEBase*                  _fe;
         libMesh::QBase*                   _qrule;
+        /*!
+         *   \p true if \p _fe and \p _qrule were obtained from
+         *   MAST::FECache with \p _cache_key and will be returned to it
+         */
+        bool                              _from_cache;
+        MAST::FECache::Key                _cache_key;
         std::vector<libMesh::Point>       _qpoints;
         std::vector<libMesh::Point>       _global_xyz;
         std::vector<libMesh::Point>       _local_normals;
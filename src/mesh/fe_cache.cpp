@@ -0,0 +1,178 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// C++ includes
+#include <tuple>
+
+// MAST includes
+#include "mesh/fe_cache.h"
+
+// libMesh includes
+#include "libmesh/threads.h"
+
+
+MAST::FECache::Key::Key():
+elem_type          (libMesh::INVALID_ELEM),
+fe_type            (),
+q_order            (0),
+if_side            (false),
+if_grads           (false),
+if_second_derivs   (false) {
+    
+}
+
+
+
+MAST::FECache::Key::Key(libMesh::ElemType e_type,
+                        const libMesh::FEType& fe_t,
+                        int q_o,
+                        bool side,
+                        bool grads,
+                        bool second_derivs):
+elem_type          (e_type),
+fe_type            (fe_t),
+q_order            (q_o),
+if_side            (side),
+if_grads           (grads),
+if_second_derivs   (second_derivs) {
+    
+}
+
+
+bool
+MAST::FECache::Key::operator< (const MAST::FECache::Key& k) const {
+    
+    return
+    std::tie(  elem_type,   fe_type,   q_order,   if_side,   if_grads,   if_second_derivs) <
+    std::tie(k.elem_type, k.fe_type, k.q_order, k.if_side, k.if_grads, k.if_second_derivs);
+}
+
+
+
+MAST::FECache::FECache() {
+    
+    libMesh::Threads::spin_mutex::scoped_lock
+    lock(libMesh::Threads::spin_mtx);
+    _all_caches().insert(this);
+}
+
+
+MAST::FECache::~FECache() {
+    
+    this->clear();
+    
+    libMesh::Threads::spin_mutex::scoped_lock
+    lock(libMesh::Threads::spin_mtx);
+    _all_caches().erase(this);
+}
+
+
+
+void
+MAST::FECache::acquire(const MAST::FECache::Key& key,
+                       unsigned int dim,
+                       libMesh::FEBase*& fe,
+                       libMesh::QBase*&  qrule) {
+    
+    std::multimap<MAST::FECache::Key,
+    std::pair<libMesh::FEBase*, libMesh::QBase*> >::iterator
+    it = _objects.find(key);
+    
+    if (it != _objects.end()) {
+        
+        fe    = it->second.first;
+        qrule = it->second.second;
+        _objects.erase(it);
+    }
+    else {
+        
+        // the quadrature rule for side integration is one dimension lower
+        // than the element
+        fe    = libMesh::FEBase::build(dim, key.fe_type).release();
+        qrule = key.fe_type.default_quadrature_rule
+        (key.if_side?dim-1:dim, key.q_order).release();
+        fe->attach_quadrature_rule(qrule);
+    }
+}
+
+
+
+void
+MAST::FECache::release(const MAST::FECache::Key& key,
+                       libMesh::FEBase* fe,
+                       libMesh::QBase*  qrule) {
+    
+    libmesh_assert(fe);
+    libmesh_assert(qrule);
+    
+    _objects.insert(std::make_pair(key, std::make_pair(fe, qrule)));
+}
+
+
+
+void
+MAST::FECache::clear() {
+    
+    std::multimap<MAST::FECache::Key,
+    std::pair<libMesh::FEBase*, libMesh::QBase*> >::iterator
+    it  = _objects.begin(),
+    end = _objects.end();
+    
+    for ( ; it != end; it++) {
+        
+        delete it->second.first;
+        delete it->second.second;
+    }
+    
+    _objects.clear();
+}
+
+
+
+MAST::FECache&
+MAST::FECache::local_cache() {
+    
+    static thread_local MAST::FECache cache;
+    return cache;
+}
+
+
+
+void
+MAST::FECache::clear_all() {
+    
+    libMesh::Threads::spin_mutex::scoped_lock
+    lock(libMesh::Threads::spin_mtx);
+    
+    std::set<MAST::FECache*>::iterator
+    it  = _all_caches().begin(),
+    end = _all_caches().end();
+    
+    for ( ; it != end; it++)
+        (*it)->clear();
+}
+
+
+
+std::set<MAST::FECache*>&
+MAST::FECache::_all_caches() {
+    
+    static std::set<MAST::FECache*> caches;
+    return caches;
+}
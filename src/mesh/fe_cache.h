@@ -0,0 +1,158 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef __mast_fe_cache_h__
+#define __mast_fe_cache_h__
+
+// C++ includes
+#include <map>
+#include <set>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+// libMesh includes
+#include "libmesh/fe_base.h"
+#include "libmesh/quadrature.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   Pool of libMesh finite element and quadrature objects that are
+     *   reinitialized in place for each new element instead of being
+     *   reallocated. A libMesh::FEBase object only recomputes the shape
+     *   functions on the reference element if the element type or
+     *   quadrature rule changes. Hence, reuse of these objects also
+     *   shares the reference element shape data among all elements of
+     *   the same type, and only the mapping to the physical element is
+     *   recomputed.
+     *
+     *   Each thread has its own pool, which is obtained from
+     *   \p local_cache(). Objects are checked out by MAST::FEBase and
+     *   returned to the pool when the MAST::FEBase object is destroyed.
+     *   The pools live until the threads exit, which for the main thread
+     *   is after libMesh has been finalized. Hence, \p clear_all() must
+     *   be called before libMesh::LibMeshInit is destroyed, which is most
+     *   easily done by creating a MAST::FECache::Guard right after it.
+     */
+    class FECache {
+        
+    public:
+        
+        /*!
+         *   identifies the FE and quadrature objects that can be reused
+         *   for an initialization.
+         */
+        class Key {
+        public:
+            Key();
+            
+            Key(libMesh::ElemType e_type,
+                const libMesh::FEType& fe_type,
+                int q_order,
+                bool if_side,
+                bool if_grads,
+                bool if_second_derivs);
+            
+            bool operator< (const MAST::FECache::Key& k) const;
+            
+            libMesh::ElemType  elem_type;
+            libMesh::FEType    fe_type;
+            int                q_order;
+            bool               if_side;
+            bool               if_grads;
+            bool               if_second_derivs;
+        };
+        
+        FECache();
+        
+        virtual ~FECache();
+        
+        /*!
+         *   provides FE and quadrature objects in \p fe and \p qrule for
+         *   \p key. The objects are taken from the pool if available, or
+         *   created otherwise. For a newly created object the quadrature
+         *   rule is attached to the FE object, but no other initialization
+         *   is performed. The objects should be returned with
+         *   \p release() once they are no longer needed.
+         */
+        void acquire(const MAST::FECache::Key& key,
+                     unsigned int dim,
+                     libMesh::FEBase*& fe,
+                     libMesh::QBase*&  qrule);
+        
+        /*!
+         *   returns the objects obtained from \p acquire() to the pool.
+         */
+        void release(const MAST::FECache::Key& key,
+                     libMesh::FEBase* fe,
+                     libMesh::QBase*  qrule);
+        
+        /*!
+         *   deletes all objects in the pool.
+         */
+        void clear();
+        
+        /*!
+         *   @returns the number of objects currently stored in the pool.
+         */
+        unsigned int size() const { return (unsigned int)_objects.size(); }
+        
+        /*!
+         *   @returns the pool for the calling thread.
+         */
+        static MAST::FECache& local_cache();
+        
+        /*!
+         *   deletes all objects in the pools of all threads. This must not
+         *   be called while elements are being processed on other threads.
+         */
+        static void clear_all();
+        
+        /*!
+         *   calls \p clear_all() when it goes out of scope. This should be
+         *   created right after libMesh::LibMeshInit so that the pooled
+         *   objects are deleted before libMesh is finalized.
+         */
+        class Guard {
+        public:
+            Guard() { }
+            
+            ~Guard() { MAST::FECache::clear_all(); }
+        };
+        
+    protected:
+        
+        /*!
+         *   @returns the set of all pools, which is used by
+         *   \p clear_all(). Access is guarded by libMesh::Threads::spin_mtx.
+         */
+        static std::set<MAST::FECache*>& _all_caches();
+        
+        /*!
+         *   objects that are available for reuse.
+         */
+        std::multimap<MAST::FECache::Key,
+        std::pair<libMesh::FEBase*, libMesh::QBase*> > _objects;
+    };
+}
+
+
+#endif // __mast_fe_cache_h__
@@ -118,7 +118,8 @@ namespace MAST {
         /*!
          *   initializes the finite element shape function and quadrature
          *   object with the order of quadrature rule changed based on the
-         *   \p extra_quadrature_order.
+         *   \p extra_quadrature_order. The underlying libMesh objects are
+         *   reused from the MAST::FECache of the calling thread.
          */
         virtual std::unique_ptr<MAST::FEBase>
         init_fe(bool init_grads,
@@ -129,7 +130,9 @@ namespace MAST {
         /*!
          *   initializes the finite element shape function and quadrature
          *   object for the side with the order of quadrature rule
-         *   changed based on the \p extra_quadrature_order
+         *   changed based on the \p extra_quadrature_order. The underlying
+         *   libMesh objects are reused from the MAST::FECache of the
+         *   calling thread.
          */
         virtual std::unique_ptr<MAST::FEBase>
         init_side_fe(unsigned int s,
@@ -68,11 +68,13 @@ namespace MAST {
          *   \p interpolated_var and \p discrete_var. This means that the row
          *   \p interpolated_var, the value in columns
          *   \p discrete_vars*n_discrete_dofs_per_var - (discrete_vars+1)*n_discrete_dofs_per_var-1)
-         *    will be set equal to \p shape_func .
+         *    will be set equal to \p shape_func . The vector type is a
+         *    template parameter so that fixed size vectors may be provided.
          */
+        template <typename VecType>
         void set_shape_function(unsigned int interpolated_var,
                                 unsigned int discrete_var,
-                                const RealVectorX& shape_func);
+                                const VecType& shape_func);
         
         /*!
          *   this initializes all variables to use the same interpolation function.
@@ -86,29 +88,29 @@ namespace MAST {
         /*!
          *   res = [this] * v
          */
-        template <typename T>
-        void vector_mult(T& res, const T& v) const;
+        template <typename T1, typename T2>
+        void vector_mult(T1& res, const T2& v) const;
         
         
         /*!
          *   res = v^T * [this]
          */
-        template <typename T>
-        void vector_mult_transpose(T& res, const T& v) const;
+        template <typename T1, typename T2>
+        void vector_mult_transpose(T1& res, const T2& v) const;
         
         
         /*!
          *   [R] = [this] * [M]
          */
-        template <typename T>
-        void right_multiply(T& r, const T& m) const;
+        template <typename T1, typename T2>
+        void right_multiply(T1& r, const T2& m) const;
         
         
         /*!
          *   [R] = [this]^T * [M]
          */
-        template <typename T>
-        void right_multiply_transpose(T& r, const T& m) const;
+        template <typename T1, typename T2>
+        void right_multiply_transpose(T1& r, const T2& m) const;
         
         
         /*!
@@ -121,15 +123,15 @@ namespace MAST {
         /*!
          *   [R] = [M] * [this]
          */
-        template <typename T>
-        void left_multiply(T& r, const T& m) const;
+        template <typename T1, typename T2>
+        void left_multiply(T1& r, const T2& m) const;
         
         
         /*!
          *   [R] = [M] * [this]^T
          */
-        template <typename T>
-        void left_multiply_transpose(T& r, const T& m) const;
+        template <typename T1, typename T2>
+        void left_multiply_transpose(T1& r, const T2& m) const;
         
         
     protected:
@@ -150,12 +152,20 @@ namespace MAST {
         unsigned int _n_dofs_per_var;
         
         /*!
-         *    stores the shape function values that defines the coupling
-         *    of i_th interpolated var and j_th discrete var. Stored in
-         *    column major format. nullptr, if values are zero, otherwise the
-         *    value is set in the vector.
+         *    identifies the blocks with nonzero shape functions. The block
+         *    that defines the coupling of the i_th interpolated var and
+         *    j_th discrete var has index j*_n_interpolated_vars+i.
          */
-        std::vector<RealVectorX*>  _var_shape_functions;
+        std::vector<bool>          _if_shape_function;
+        
+        /*!
+         *    shape function values of all blocks, with the values of block
+         *    \p b stored from \p b*_n_dofs_per_var. The storage is
+         *    retained by \p clear(), so that an operator reinitialized with
+         *    the same dimensions, for instance for each element, does not
+         *    reallocate memory.
+         */
+        RealVectorX                _shape_values;
     };
     
 }
@@ -170,9 +180,9 @@ MAST::FEMOperatorMatrix::print(std::ostream& o) {
     for (unsigned int i=0; i<_n_interpolated_vars; i++) {// row
         for (unsigned int j=0; j<_n_discrete_vars; j++) { // column
             index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) // check if this is non-nullptr
+            if (_if_shape_function[index]) // check if this block is nonzero
                 for (unsigned int k=0; k<_n_dofs_per_var; k++)
-                    o << std::setw(15) << (*_var_shape_functions[index])(k);
+                    o << std::setw(15) << _shape_values(index*_n_dofs_per_var+k);
             else
                 for (unsigned int k=0; k<_n_dofs_per_var; k++)
                     o << std::setw(15) << 0.;
@@ -190,15 +200,7 @@ MAST::FEMOperatorMatrix::clear() {
     _n_discrete_vars     = 0;
     _n_dofs_per_var      = 0;
     
-    // iterate over the shape function entries and delete the non-nullptr values
-    std::vector<RealVectorX*>::iterator it = _var_shape_functions.begin(),
-    end = _var_shape_functions.end();
-    
-    for ( ; it!=end; it++)
-        if ( *it != nullptr)
-            delete *it;
-    
-    _var_shape_functions.clear();
+    _if_shape_function.clear();
 }
 
 
@@ -215,37 +217,35 @@ reinit(unsigned int n_interpolated_vars,
     _n_interpolated_vars = n_interpolated_vars;
     _n_discrete_vars = n_discrete_vars;
     _n_dofs_per_var = n_discrete_dofs_per_var;
-    _var_shape_functions.resize(_n_interpolated_vars*_n_discrete_vars);
-    for (unsigned int i=0; i<_var_shape_functions.size(); i++)
-        _var_shape_functions[i] = nullptr;
+    _if_shape_function.resize(_n_interpolated_vars*_n_discrete_vars, false);
+    
+    // this does not reallocate if the size is unchanged
+    _shape_values.resize(_n_interpolated_vars*_n_discrete_vars*_n_dofs_per_var);
 }
 
 
 
+template <typename VecType>
 inline
 void
 MAST::FEMOperatorMatrix::
 set_shape_function(unsigned int interpolated_var,
                    unsigned int discrete_var,
-                   const RealVectorX& shape_func) {
+                   const VecType& shape_func) {
     
     // make sure that reinit has been called.
-    libmesh_assert(_var_shape_functions.size());
+    libmesh_assert(_if_shape_function.size());
     
     // also make sure that the specified indices are within bounds
     libmesh_assert(interpolated_var < _n_interpolated_vars);
     libmesh_assert(discrete_var < _n_discrete_vars);
+    libmesh_assert_equal_to(shape_func.size(), _n_dofs_per_var);
     
-    RealVectorX* vec =
-    _var_shape_functions[discrete_var*_n_interpolated_vars+interpolated_var];
+    const unsigned int
+    index = discrete_var*_n_interpolated_vars+interpolated_var;
     
-    if (!vec)
-    {
-        vec = new RealVectorX;
-        _var_shape_functions[discrete_var*_n_interpolated_vars+interpolated_var] = vec;
-    }
-    
-    *vec = shape_func;
+    _if_shape_function[index] = true;
+    _shape_values.segment(index*_n_dofs_per_var, _n_dofs_per_var) = shape_func;
 }
 
 
@@ -256,28 +256,19 @@ MAST::FEMOperatorMatrix::
 reinit(unsigned int n_vars,
        const RealVectorX& shape_func) {
     
-    this->clear();
-    
-    _n_interpolated_vars = n_vars;
-    _n_discrete_vars = n_vars;
-    _n_dofs_per_var = (unsigned int)shape_func.size();
-    _var_shape_functions.resize(n_vars*n_vars);
+    this->reinit(n_vars, n_vars, (unsigned int)shape_func.size());
     
     for (unsigned int i=0; i<n_vars; i++)
-    {
-        RealVectorX*  vec = new RealVectorX;
-        *vec = shape_func;
-        _var_shape_functions[i*n_vars+i] = vec;
-    }
+        this->set_shape_function(i, i, shape_func);
 }
 
 
 
-template <typename T>
+template <typename T1, typename T2>
 inline
 void
 MAST::FEMOperatorMatrix::
-vector_mult(T& res, const T& v) const {
+vector_mult(T1& res, const T2& v) const {
     
     libmesh_assert_equal_to(res.size(), _n_interpolated_vars);
     libmesh_assert_equal_to(v.size(), n());
@@ -288,19 +279,19 @@ vector_mult(T& res, const T& v) const {
     for (unsigned int i=0; i<_n_interpolated_vars; i++) // row
         for (unsigned int j=0; j<_n_discrete_vars; j++) { // column
             index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) // check if this is non-nullptr
+            if (_if_shape_function[index]) // check if this block is nonzero
                 for (unsigned int k=0; k<_n_dofs_per_var; k++)
                     res(i) +=
-                    (*_var_shape_functions[index])(k) * v(j*_n_dofs_per_var+k);
+                    _shape_values(index*_n_dofs_per_var+k) * v(j*_n_dofs_per_var+k);
         }
 }
 
 
-template <typename T>
+template <typename T1, typename T2>
 inline
 void
 MAST::FEMOperatorMatrix::
-vector_mult_transpose(T& res, const T& v) const {
+vector_mult_transpose(T1& res, const T2& v) const {
     
     libmesh_assert_equal_to(res.size(), n());
     libmesh_assert_equal_to(v.size(), _n_interpolated_vars);
@@ -311,20 +302,20 @@ vector_mult_transpose(T& res, const T& v) const {
     for (unsigned int i=0; i<_n_interpolated_vars; i++) // row
         for (unsigned int j=0; j<_n_discrete_vars; j++) { // column
             index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) // check if this is non-nullptr
+            if (_if_shape_function[index]) // check if this block is nonzero
                 for (unsigned int k=0; k<_n_dofs_per_var; k++)
                     res(j*_n_dofs_per_var+k) +=
-                    (*_var_shape_functions[index])(k) * v(i);
+                    _shape_values(index*_n_dofs_per_var+k) * v(i);
         }
 }
 
 
 
-template <typename T>
+template <typename T1, typename T2>
 inline
 void
 MAST::FEMOperatorMatrix::
-right_multiply(T& r, const T& m) const {
+right_multiply(T1& r, const T2& m) const {
     
     libmesh_assert_equal_to(r.rows(), _n_interpolated_vars);
     libmesh_assert_equal_to(r.cols(), m.cols());
@@ -336,11 +327,11 @@ right_multiply(T& r, const T& m) const {
     for (unsigned int i=0; i<_n_interpolated_vars; i++) // row
         for (unsigned int j=0; j<_n_discrete_vars; j++) { // column of operator
             index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) { // check if this is non-nullptr
+            if (_if_shape_function[index]) { // check if this block is nonzero
                 for (unsigned int l=0; l<m.cols(); l++) // column of matrix
                     for (unsigned int k=0; k<_n_dofs_per_var; k++)
                         r(i,l) +=
-                        (*_var_shape_functions[index])(k) * m(j*_n_dofs_per_var+k,l);
+                        _shape_values(index*_n_dofs_per_var+k) * m(j*_n_dofs_per_var+k,l);
             }
         }
 }
@@ -348,11 +339,11 @@ right_multiply(T& r, const T& m) const {
 
 
 
-template <typename T>
+template <typename T1, typename T2>
 inline
 void
 MAST::FEMOperatorMatrix::
-right_multiply_transpose(T& r, const T& m) const {
+right_multiply_transpose(T1& r, const T2& m) const {
     
     libmesh_assert_equal_to(r.rows(), n());
     libmesh_assert_equal_to(r.cols(), m.cols());
@@ -364,11 +355,11 @@ right_multiply_transpose(T& r, const T& m) const {
     for (unsigned int i=0; i<_n_interpolated_vars; i++) // row
         for (unsigned int j=0; j<_n_discrete_vars; j++) { // column of operator
             index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) { // check if this is non-nullptr
+            if (_if_shape_function[index]) { // check if this block is nonzero
                 for (unsigned int l=0; l<m.cols(); l++) // column of matrix
                     for (unsigned int k=0; k<_n_dofs_per_var; k++)
                         r(j*_n_dofs_per_var+k,l) +=
-                        (*_var_shape_functions[index])(k) * m(i,l);
+                        _shape_values(index*_n_dofs_per_var+k) * m(i,l);
             }
         }
 }
@@ -393,14 +384,14 @@ right_multiply_transpose(T& r, const MAST::FEMOperatorMatrix& m) const {
             for (unsigned int k=0; k<_n_interpolated_vars; k++) {
                 index_i = i*_n_interpolated_vars+k;
                 index_j = j*m._n_interpolated_vars+k;
-                if (_var_shape_functions[index_i] &&
-                    m._var_shape_functions[index_j]) { // if shape function exists for both
-                    const RealVectorX &n1 = *_var_shape_functions[index_i],
-                    &n2 = *m._var_shape_functions[index_j];
-                    for (unsigned int i_n1=0; i_n1<n1.size(); i_n1++)
-                        for (unsigned int i_n2=0; i_n2<n2.size(); i_n2++)
+                if (_if_shape_function[index_i] &&
+                    m._if_shape_function[index_j]) { // if shape function exists for both
+                    for (unsigned int i_n1=0; i_n1<_n_dofs_per_var; i_n1++)
+                        for (unsigned int i_n2=0; i_n2<m._n_dofs_per_var; i_n2++)
                             r (i*_n_dofs_per_var+i_n1,
-                               j*m._n_dofs_per_var+i_n2) += n1(i_n1) * n2(i_n2);
+                               j*m._n_dofs_per_var+i_n2) +=
+                            _shape_values(index_i*_n_dofs_per_var+i_n1) *
+                            m._shape_values(index_j*m._n_dofs_per_var+i_n2);
                 }
             }
 }
@@ -408,11 +399,11 @@ right_multiply_transpose(T& r, const MAST::FEMOperatorMatrix& m) const {
 
 
 
-template <typename T>
+template <typename T1, typename T2>
 inline
 void
 MAST::FEMOperatorMatrix::
-left_multiply(T& r, const T& m) const {
+left_multiply(T1& r, const T2& m) const {
     
     libmesh_assert_equal_to(r.rows(), m.rows());
     libmesh_assert_equal_to(r.cols(), n());
@@ -424,22 +415,22 @@ left_multiply(T& r, const T& m) const {
     for (unsigned int i=0; i<_n_interpolated_vars; i++) // row
         for (unsigned int j=0; j<_n_discrete_vars; j++) { // column of operator
             index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) { // check if this is non-nullptr
+            if (_if_shape_function[index]) { // check if this block is nonzero
                 for (unsigned int l=0; l<m.rows(); l++) // rows of matrix
                     for (unsigned int k=0; k<_n_dofs_per_var; k++)
                         r(l,j*_n_dofs_per_var+k) +=
-                        (*_var_shape_functions[index])(k) * m(l,i);
+                        _shape_values(index*_n_dofs_per_var+k) * m(l,i);
             }
         }
 }
 
 
 
-template <typename T>
+template <typename T1, typename T2>
 inline
 void
 MAST::FEMOperatorMatrix::
-left_multiply_transpose(T& r, const T& m) const {
+left_multiply_transpose(T1& r, const T2& m) const {
     
     libmesh_assert_equal_to(r.rows(), m.rows());
     libmesh_assert_equal_to(r.cols(), _n_interpolated_vars);
@@ -451,11 +442,11 @@ left_multiply_transpose(T& r, const T& m) const {
     for (unsigned int i=0; i<_n_interpolated_vars; i++) // row
         for (unsigned int j=0; j<_n_discrete_vars; j++) { // column of operator
             index = j*_n_interpolated_vars+i;
-            if (_var_shape_functions[index]) { // check if this is non-nullptr
+            if (_if_shape_function[index]) { // check if this block is nonzero
                 for (unsigned int l=0; l<m.rows(); l++) // column of matrix
                     for (unsigned int k=0; k<_n_dofs_per_var; k++)
                         r(l,i) +=
-                        (*_var_shape_functions[index])(k) * m(l,j*_n_dofs_per_var+k);
+                        _shape_values(index*_n_dofs_per_var+k) * m(l,j*_n_dofs_per_var+k);
             }
         }
 }
@@ -110,6 +110,82 @@ namespace MAST {
             }
         }
         
+        /*!
+         *    @returns the number of real values required by pack() for
+         *    an \p n x \p n eigenproblem.
+         */
+        static unsigned int packed_size(const unsigned int n) {
+
+            return 2*(2*n*n + 2*n) + 1;
+        }
+
+
+        /*!
+         *    writes the eigensolution and the LAPACK return code to \p v as
+         *    a sequence of real and imaginary components. \p v must have
+         *    space for packed_size() values. The matrices \f$A\f$ and
+         *    \f$B\f$ are not written since the receiving processor can
+         *    recreate them, and should provide them to unpack(). This is
+         *    used to communicate a solution computed on one processor to
+         *    the other processors.
+         */
+        void pack(Real* v) const {
+
+            const unsigned int n = (unsigned int)_A.rows();
+            unsigned int i = 0;
+
+            libmesh_assert_equal_to(VL.rows(), n);
+            libmesh_assert_equal_to(VR.rows(), n);
+            
+            _pack(VL, i, v);
+            _pack(VR, i, v);
+
+            for (unsigned int j=0; j<n; j++) {
+                v[i++] = alpha(j).real();
+                v[i++] = alpha(j).imag();
+            }
+            for (unsigned int j=0; j<n; j++) {
+                v[i++] = beta(j).real();
+                v[i++] = beta(j).imag();
+            }
+            
+            v[i++] = (Real)info_val;
+        }
+
+
+        /*!
+         *    initializes this object with the eigensolution written to
+         *    \p v by pack() for the eigenproblem defined by matrices
+         *    \p A and \p B.
+         */
+        void unpack(const ComplexMatrixX& A,
+                    const ComplexMatrixX& B,
+                    const Real* v) {
+
+            const unsigned int n = (unsigned int)A.rows();
+            unsigned int i = 0;
+
+            _A = A;
+            _B = B;
+            
+            _unpack(n, VL, i, v);
+            _unpack(n, VR, i, v);
+
+            alpha.resize(n);
+            beta.resize(n);
+            for (unsigned int j=0; j<n; j++) {
+                alpha(j) = Complex(v[i], v[i+1]);
+                i += 2;
+            }
+            for (unsigned int j=0; j<n; j++) {
+                beta(j) = Complex(v[i], v[i+1]);
+                i += 2;
+            }
+
+            info_val = (int)v[i++];
+        }
+
+
         void print_inner_product(std::ostream& out) const {
             libmesh_assert(info_val == 0);
             ComplexMatrixX r;
@@ -124,7 +200,29 @@ namespace MAST {
         }
         
     protected:
-        
+
+        static void _pack(const ComplexMatrixX& m, unsigned int& i, Real* v) {
+            for (unsigned int c=0; c<m.cols(); c++)
+                for (unsigned int r=0; r<m.rows(); r++) {
+                    v[i++] = m(r,c).real();
+                    v[i++] = m(r,c).imag();
+                }
+        }
+
+
+        static void _unpack(const unsigned int n,
+                            ComplexMatrixX& m,
+                            unsigned int& i,
+                            const Real* v) {
+            m.resize(n, n);
+            for (unsigned int c=0; c<n; c++)
+                for (unsigned int r=0; r<n; r++) {
+                    m(r,c) = Complex(v[i], v[i+1]);
+                    i += 2;
+                }
+        }
+
+
         ComplexMatrixX _A;
         
         ComplexMatrixX _B;
@@ -0,0 +1,210 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// C++ includes
+#include <algorithm>
+
+// MAST includes
+#include "numerics/localized_multi_vector.h"
+
+// libMesh includes
+#include "libmesh/dof_map.h"
+
+
+
+MAST::LocalizedMultiVector::LocalizedMultiVector():
+_n_vecs           (0),
+_first_local_dof  (0),
+_n_local_dofs     (0),
+_vec              (nullptr) {
+    
+}
+
+
+
+MAST::LocalizedMultiVector::~LocalizedMultiVector() {
+    
+    this->clear();
+}
+
+
+
+void
+MAST::LocalizedMultiVector::clear() {
+    
+    if (_vec) {
+        
+        PetscErrorCode ierr = VecDestroy(&_vec);
+        CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    }
+    
+    _vec             = nullptr;
+    _n_vecs          = 0;
+    _first_local_dof = 0;
+    _n_local_dofs    = 0;
+    _ghost_dofs.clear();
+    _vals.clear();
+}
+
+
+
+void
+MAST::LocalizedMultiVector::init(const libMesh::System& sys,
+                                 const std::vector<libMesh::NumericVector<Real>*>& vecs) {
+    
+    const libMesh::DofMap& dof_map = sys.get_dof_map();
+    
+    const unsigned int
+    n_vecs    = (unsigned int)vecs.size();
+    
+    const libMesh::dof_id_type
+    first_dof = dof_map.first_dof(),
+    n_local   = dof_map.n_local_dofs();
+    
+    // the ghosted dofs are the entries of the send list not owned by this
+    // processor
+    std::vector<libMesh::dof_id_type>
+    ghosts;
+    
+    const std::vector<libMesh::dof_id_type>&
+    send_list = dof_map.get_send_list();
+    
+    for (unsigned int i=0; i<send_list.size(); i++)
+        if (send_list[i] < first_dof || send_list[i] >= first_dof+n_local)
+            ghosts.push_back(send_list[i]);
+    
+    std::sort(ghosts.begin(), ghosts.end());
+    ghosts.erase(std::unique(ghosts.begin(), ghosts.end()), ghosts.end());
+    
+    PetscErrorCode ierr;
+    const MPI_Comm comm = sys.comm().get();
+    
+    // the work vector is recreated only if its layout has changed
+    if (_vec &&
+        (_n_vecs          != n_vecs    ||
+         _first_local_dof != first_dof ||
+         _n_local_dofs    != n_local   ||
+         _ghost_dofs      != ghosts)) {
+        
+        ierr = VecDestroy(&_vec);                                 CHKERRABORT(comm, ierr);
+        _vec = nullptr;
+    }
+    
+    _n_vecs          = n_vecs;
+    _first_local_dof = first_dof;
+    _n_local_dofs    = n_local;
+    _ghost_dofs.swap(ghosts);
+    
+    if (!n_vecs) {
+        
+        _vals.clear();
+        return;
+    }
+    
+    if (!_vec) {
+        
+        std::vector<PetscInt>
+        ghost_ids(_ghost_dofs.begin(), _ghost_dofs.end());
+        
+        ierr = VecCreateGhostBlock(comm,
+                                   n_vecs,
+                                   n_vecs*n_local,
+                                   n_vecs*sys.n_dofs(),
+                                   (PetscInt)ghost_ids.size(),
+                                   ghost_ids.size()? &ghost_ids[0]: nullptr,
+                                   &_vec);                        CHKERRABORT(comm, ierr);
+    }
+    
+    // copy the local values of all vectors into the blocked vector
+    std::vector<libMesh::numeric_index_type>
+    ids(n_local);
+    std::vector<Real>
+    v(n_local);
+    
+    for (libMesh::dof_id_type i=0; i<n_local; i++)
+        ids[i] = first_dof + i;
+    
+    PetscScalar *arr = nullptr;
+    
+    ierr = VecGetArray(_vec, &arr);                               CHKERRABORT(comm, ierr);
+    
+    for (unsigned int j=0; j<n_vecs; j++) {
+        
+        if (n_local)
+            vecs[j]->get(ids, &v[0]);
+        
+        for (libMesh::dof_id_type i=0; i<n_local; i++)
+            arr[i*n_vecs+j] = v[i];
+    }
+    
+    ierr = VecRestoreArray(_vec, &arr);                           CHKERRABORT(comm, ierr);
+    
+    // a single communication updates the ghosted values of all vectors
+    ierr = VecGhostUpdateBegin(_vec, INSERT_VALUES, SCATTER_FORWARD); CHKERRABORT(comm, ierr);
+    ierr = VecGhostUpdateEnd(_vec, INSERT_VALUES, SCATTER_FORWARD);   CHKERRABORT(comm, ierr);
+    
+    // copy the values from the local form, which stores the local
+    // entries followed by the ghosted entries
+    Vec                local_form;
+    const PetscScalar *local_arr = nullptr;
+    
+    ierr = VecGhostGetLocalForm(_vec, &local_form);               CHKERRABORT(comm, ierr);
+    ierr = VecGetArrayRead(local_form, &local_arr);               CHKERRABORT(comm, ierr);
+    
+    _vals.assign(local_arr,
+                 local_arr + n_vecs * (n_local + _ghost_dofs.size()));
+    
+    ierr = VecRestoreArrayRead(local_form, &local_arr);           CHKERRABORT(comm, ierr);
+    ierr = VecGhostRestoreLocalForm(_vec, &local_form);           CHKERRABORT(comm, ierr);
+}
+
+
+
+void
+MAST::LocalizedMultiVector::get_values(const std::vector<libMesh::dof_id_type>& dofs,
+                                       RealMatrixX& mat) const {
+    
+    mat.setZero(dofs.size(), _n_vecs);
+    
+    for (unsigned int i=0; i<dofs.size(); i++) {
+        
+        const libMesh::dof_id_type
+        dof = dofs[i];
+        
+        std::size_t
+        row = 0;
+        
+        if (dof >= _first_local_dof && dof < _first_local_dof+_n_local_dofs)
+            row = dof - _first_local_dof;
+        else {
+            
+            std::vector<libMesh::dof_id_type>::const_iterator
+            it = std::lower_bound(_ghost_dofs.begin(), _ghost_dofs.end(), dof);
+            
+            // the dof must be available on this processor
+            libmesh_assert(it != _ghost_dofs.end() && *it == dof);
+            
+            row = _n_local_dofs + (it - _ghost_dofs.begin());
+        }
+        
+        for (unsigned int j=0; j<_n_vecs; j++)
+            mat(i, j) = _vals[row*_n_vecs + j];
+    }
+}
@@ -0,0 +1,115 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef __mast__localized_multi_vector_h__
+#define __mast__localized_multi_vector_h__
+
+// C++ includes
+#include <vector>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+// libMesh includes
+#include "libmesh/system.h"
+#include "libmesh/numeric_vector.h"
+
+// PETSc includes
+#include <petscvec.h>
+
+
+namespace MAST {
+    
+    /*!
+     *   Stores the local and ghosted values of a set of parallel vectors
+     *   defined on the same system. The values of all vectors are
+     *   communicated in a single ghost update, and are stored contiguously
+     *   for each dof so that the values for the dofs of an element can be
+     *   gathered into a matrix with one column per vector. The PETSc
+     *   work vector is retained across calls to init() if the number of
+     *   vectors and the dof distribution do not change.
+     */
+    class LocalizedMultiVector {
+        
+    public:
+        
+        LocalizedMultiVector();
+        
+        virtual ~LocalizedMultiVector();
+        
+        /*!
+         *   localizes the values of \p vecs for the dofs needed by the
+         *   local elements of \p sys.
+         */
+        void init(const libMesh::System& sys,
+                  const std::vector<libMesh::NumericVector<Real>*>& vecs);
+        
+        /*!
+         *   clears the stored values and the work vector
+         */
+        void clear();
+        
+        /*!
+         *   @returns the number of vectors
+         */
+        unsigned int n_vecs() const { return _n_vecs; }
+        
+        /*!
+         *   sets \p mat to a matrix with one row for each dof in \p dofs and
+         *   one column for each vector.
+         */
+        void get_values(const std::vector<libMesh::dof_id_type>& dofs,
+                        RealMatrixX& mat) const;
+        
+    protected:
+        
+        /*!
+         *   number of vectors
+         */
+        unsigned int                       _n_vecs;
+        
+        /*!
+         *   first dof and number of dofs owned by this processor
+         */
+        libMesh::dof_id_type               _first_local_dof;
+        libMesh::dof_id_type               _n_local_dofs;
+        
+        /*!
+         *   sorted ids of the ghosted dofs
+         */
+        std::vector<libMesh::dof_id_type>  _ghost_dofs;
+        
+        /*!
+         *   values of all vectors, with the local dofs followed by the
+         *   ghosted dofs, and the values of all vectors for a dof stored
+         *   contiguously.
+         */
+        std::vector<Real>                  _vals;
+        
+        /*!
+         *   ghosted PETSc vector with block size equal to the number of
+         *   vectors
+         */
+        Vec                                _vec;
+    };
+}
+
+
+#endif // __mast__localized_multi_vector_h__
@@ -183,9 +183,9 @@ namespace MAST {
 
 
 bool
-MAST::IsotropicElementPropertyCard3D::depends_on(const MAST::FunctionBase& f) const {
+MAST::IsotropicElementPropertyCard3D::_depends_on(const MAST::FunctionBase& f) const {
     return _material->depends_on(f) ||            // check if the material property depends on the function
-    MAST::ElementPropertyCardBase::depends_on(f); // check with this property card
+    MAST::ElementPropertyCardBase::_depends_on(f); // check with this property card
 }
 
 
@@ -45,6 +45,10 @@ namespace MAST {
                                     const Real t,
                                     RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<Real>& _E;
@@ -71,6 +75,10 @@ namespace MAST {
                                     const Real t,
                                     RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<Real>& _E;
@@ -98,6 +106,10 @@ namespace MAST {
                                     const Real t,
                                     RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<Real>& _E;
@@ -123,6 +135,10 @@ namespace MAST {
                                     const Real t,
                                     RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<Real>& _E;
@@ -147,6 +163,10 @@ namespace MAST {
                                     const Real t,
                                     RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<Real>& _rho;
@@ -178,6 +198,10 @@ namespace MAST {
                                     const Real t,
                                     RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const unsigned int _dim;
@@ -212,6 +236,10 @@ namespace MAST {
                                     const Real t,
                                     RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const unsigned int _dim;
@@ -249,6 +277,10 @@ namespace MAST {
                                     const Real t,
                                     RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const unsigned int _dim;
@@ -223,7 +223,7 @@ MAST::Multilayer1DSectionElementPropertyCard::if_isotropic() const {
 
 
 bool
-MAST::Multilayer1DSectionElementPropertyCard::depends_on(const MAST::FunctionBase& f) const {
+MAST::Multilayer1DSectionElementPropertyCard::_depends_on(const MAST::FunctionBase& f) const {
     
     // ask each layer for the dependence
     for (unsigned int i=0; i<_layers.size(); i++)
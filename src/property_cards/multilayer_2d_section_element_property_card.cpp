@@ -22,6 +22,7 @@
 #include "property_cards/multilayer_2d_section_element_property_card.h"
 #include "property_cards/solid_2d_section_element_property_card.h"
 #include "base/field_function_base.h"
+#include "base/cached_field_function.h"
 
 
 namespace MAST {
@@ -90,6 +91,10 @@ namespace MAST {
                 }
             }
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const Real _base;
@@ -151,6 +156,10 @@ namespace MAST {
             }
             
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             std::vector<MAST::FieldFunction<RealMatrixX>*> _layer_mats;
@@ -231,7 +240,7 @@ MAST::Multilayer2DSectionElementPropertyCard::if_isotropic() const {
 
 
 bool
-MAST::Multilayer2DSectionElementPropertyCard::depends_on(const MAST::FunctionBase& f) const {
+MAST::Multilayer2DSectionElementPropertyCard::_depends_on(const MAST::FunctionBase& f) const {
     // ask each layer for the dependence
     for (unsigned int i=0; i<_layers.size(); i++)
         if (_layers[i]->depends_on(f))
@@ -258,10 +267,8 @@ stiffness_A_matrix(const MAST::ElementBase& e) {
         layer_mats[i] = _layers[i]->stiffness_A_matrix(e).release();
     
     // now create the integrated object
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX> > rval
+    return MAST::build_cached_field_function<RealMatrixX>
     (new MAST::Multilayer2DSectionProperty::Matrix(layer_mats));
-    
-    return rval;
 }
 
 
@@ -276,10 +283,8 @@ stiffness_B_matrix(const MAST::ElementBase& e) {
         layer_mats[i] = _layers[i]->stiffness_B_matrix(e).release();
     
     // now create the integrated object
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX> > rval
+    return MAST::build_cached_field_function<RealMatrixX>
     (new MAST::Multilayer2DSectionProperty::Matrix(layer_mats));
-    
-    return rval;
 }
 
 
@@ -295,10 +300,8 @@ stiffness_D_matrix(const MAST::ElementBase& e) {
         layer_mats[i] = _layers[i]->stiffness_D_matrix(e).release();
     
     // now create the integrated object
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX> > rval
+    return MAST::build_cached_field_function<RealMatrixX>
     (new MAST::Multilayer2DSectionProperty::Matrix(layer_mats));
-    
-    return rval;
 }
 
 
@@ -331,10 +334,8 @@ inertia_matrix(const MAST::ElementBase& e) {
         layer_mats[i] = _layers[i]->inertia_matrix(e).release();
     
     // now create the integrated object
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX> > rval
+    return MAST::build_cached_field_function<RealMatrixX>
     (new MAST::Multilayer2DSectionProperty::Matrix(layer_mats));
-    
-    return rval;
 }
 
 
@@ -385,10 +386,8 @@ transverse_shear_stiffness_matrix(const MAST::ElementBase& e) {
         layer_mats[i] = _layers[i]->transverse_shear_stiffness_matrix(e).release();
     
     // now create the integrated object
-    std::unique_ptr<MAST::FieldFunction<RealMatrixX> > rval
+    return MAST::build_cached_field_function<RealMatrixX>
     (new MAST::Multilayer2DSectionProperty::Matrix(layer_mats));
-    
-    return rval;
 }
 
 
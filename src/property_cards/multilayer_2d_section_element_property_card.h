@@ -73,10 +73,6 @@ namespace MAST {
          */
         virtual bool if_isotropic() const;
         
-        /*!
-         *  returns true if the property card depends on the function \p f
-         */
-        virtual bool depends_on(const MAST::FunctionBase& f) const;
         
         
         
@@ -113,6 +109,13 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *  returns true if the property card depends on the function \p f.
+         *  This is called by \p depends_on() if the dependency has not
+         *  been precomputed by a \p MAST::ParameterDependencyIndex.
+         */
+        virtual bool _depends_on(const MAST::FunctionBase& f) const;
+        
         std::vector<MAST::FieldFunction<Real>*> _layer_offsets;
         
         /*!
@@ -107,10 +107,6 @@ namespace MAST
             return 0;
         }
         
-        /*!
-         *  returns true if the property card depends on the function \p f
-         */
-        virtual bool depends_on(const MAST::FunctionBase& f) const;
         
         
         virtual std::unique_ptr<MAST::FieldFunction<RealMatrixX> >
@@ -150,6 +146,13 @@ namespace MAST
         thermal_capacitance_matrix(const MAST::ElementBase& e) const;
         
     protected:
+        
+        /*!
+         *  returns true if the property card depends on the function \p f.
+         *  This is called by \p depends_on() if the dependency has not
+         *  been precomputed by a \p MAST::ParameterDependencyIndex.
+         */
+        virtual bool _depends_on(const MAST::FunctionBase& f) const;
 
         /*!
          *    pointer to the material property card
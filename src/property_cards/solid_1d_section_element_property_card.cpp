@@ -21,6 +21,7 @@
 #include "property_cards/solid_1d_section_element_property_card.h"
 #include "property_cards/material_property_card_base.h"
 #include "base/field_function_base.h"
+#include "base/cached_field_function.h"
 #include "base/elem_base.h"
 
 
@@ -62,6 +63,10 @@ namespace MAST {
                 m = dhy*hz + hy*dhz;
             }
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<Real>& _hy, &_hz;
@@ -132,6 +137,10 @@ namespace MAST {
                                        4.*pow(b,4)/pow(a,5)*da/12.)));
             }
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<Real>& _hy, &_hz;
@@ -189,6 +198,10 @@ namespace MAST {
                           offy*doffy + offz*doffz);
             }
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<Real>& _hy, &_hz, &_hy_offset, &_hz_offset;
@@ -241,6 +254,10 @@ namespace MAST {
                 m = dhy*hz*off + hy*dhz*off + hy*hz*doff;
             }
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<Real>& _hy, &_hz, &_hz_offset;
@@ -292,6 +309,10 @@ namespace MAST {
                 m = dhy*hz*off + hy*dhz*off + hy*hz*doff;
             }
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<Real>& _hy, &_hz, &_hy_offset;
@@ -365,6 +386,10 @@ namespace MAST {
                 dhy*hz*pow(offz,2) + hy*dhz*pow(offz,2) + 2.*hy*hz*offz*doffz ;
             }
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<Real>& _hy, &_hz, &_hy_offset, &_hz_offset;
@@ -390,6 +415,10 @@ namespace MAST {
                                      const Real t,
                                      RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _material_stiffness;
@@ -417,6 +446,10 @@ namespace MAST {
                                      const Real t,
                                      RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _material_stiffness;
@@ -442,6 +475,10 @@ namespace MAST {
                                      const Real t,
                                      RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _material_stiffness;
@@ -484,6 +521,10 @@ namespace MAST {
                 m += A*dm;
             }
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _material_stiffness;
@@ -513,6 +554,10 @@ namespace MAST {
                                      const Real t,
                                      RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<Real>& _rho, &_A, &_A_y_moment, &_A_z_moment, &_Ip;
@@ -540,6 +585,10 @@ namespace MAST {
                                      const Real t,
                                      RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _material_stiffness;
@@ -569,6 +618,10 @@ namespace MAST {
                                      const Real t,
                                      RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _material_stiffness;
@@ -601,6 +654,10 @@ namespace MAST {
             
             //virtual void convert_to_vector(const RealMatrixX& m, DenseRealVector& v) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _prestress, &_T;
@@ -632,6 +689,10 @@ namespace MAST {
             
             //virtual void convert_to_vector(const RealMatrixX& m, DenseRealVector& v) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _prestress, &_T;
@@ -662,6 +723,10 @@ namespace MAST {
                                      const Real t,
                                      RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _mat_cond;
@@ -693,6 +758,10 @@ namespace MAST {
                                      const Real t,
                                      RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _mat_cap;
@@ -1378,9 +1447,9 @@ MAST::Solid1DSectionProperty::ThermalCapacitanceMatrix::derivative (
 
 bool
 MAST::Solid1DSectionElementPropertyCard::
-depends_on(const MAST::FunctionBase& f) const {
+_depends_on(const MAST::FunctionBase& f) const {
     return _material->depends_on(f) ||            // check if the material property depends on the function
-    MAST::ElementPropertyCardBase::depends_on(f); // check with this property card
+    MAST::ElementPropertyCardBase::_depends_on(f); // check with this property card
 }
 
 
@@ -1550,7 +1619,7 @@ stiffness_A_matrix(const MAST::ElementBase& e) const {
     new MAST::Solid1DSectionProperty::ExtensionStiffnessMatrix
     (_material->stiffness_matrix(1), *_A, *_J);
     
-    return std::unique_ptr<MAST::FieldFunction<RealMatrixX> > (rval);
+    return MAST::build_cached_field_function(rval);
 }
 
 
@@ -1565,7 +1634,7 @@ stiffness_B_matrix(const MAST::ElementBase& e) const {
     new MAST::Solid1DSectionProperty::ExtensionBendingStiffnessMatrix
     (_material->stiffness_matrix(1), *_Ay, *_Az);
     
-    return std::unique_ptr<MAST::FieldFunction<RealMatrixX> > (rval);
+    return MAST::build_cached_field_function(rval);
 }
 
 
@@ -1580,7 +1649,7 @@ stiffness_D_matrix(const MAST::ElementBase& e) const {
     new MAST::Solid1DSectionProperty::BendingStiffnessMatrix
     (_material->stiffness_matrix(1), *_AI);
     
-    return std::unique_ptr<MAST::FieldFunction<RealMatrixX> > (rval);
+    return MAST::build_cached_field_function(rval);
 }
 
 
@@ -1611,7 +1680,7 @@ inertia_matrix(const MAST::ElementBase& e) const {
      *_Ip,
      *_AI);
     
-    return std::unique_ptr<MAST::FieldFunction<RealMatrixX> > (rval);
+    return MAST::build_cached_field_function(rval);
 }
 
 
@@ -1666,7 +1735,7 @@ transverse_shear_stiffness_matrix(const MAST::ElementBase& e) const {
     (_material->transverse_shear_stiffness_matrix(),
      *_A);
     
-    return std::unique_ptr<MAST::FieldFunction<RealMatrixX> > (rval);
+    return MAST::build_cached_field_function(rval);
 }
 
 
@@ -180,10 +180,6 @@ namespace MAST {
          */
         virtual MAST::FieldFunction<RealMatrixX>& I();
 
-        /*!
-         *  returns true if the property card depends on the function \p f
-         */
-        virtual bool depends_on(const MAST::FunctionBase& f) const;
 
         
         virtual void clear();
@@ -191,6 +187,13 @@ namespace MAST {
         virtual void init();
         
     protected:
+        
+        /*!
+         *  returns true if the property card depends on the function \p f.
+         *  This is called by \p depends_on() if the dependency has not
+         *  been precomputed by a \p MAST::ParameterDependencyIndex.
+         */
+        virtual bool _depends_on(const MAST::FunctionBase& f) const;
 
         bool _initialized;
         
@@ -21,6 +21,7 @@
 #include "property_cards/solid_2d_section_element_property_card.h"
 #include "property_cards/material_property_card_base.h"
 #include "base/field_function_base.h"
+#include "base/cached_field_function.h"
 #include "base/elem_base.h"
 
 
@@ -44,6 +45,10 @@ namespace MAST {
                                      const Real t,
                                      RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _material_stiffness;
@@ -71,6 +76,10 @@ namespace MAST {
                                      const Real t,
                                      RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _material_stiffness;
@@ -96,6 +105,10 @@ namespace MAST {
                                      const Real t,
                                      RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _material_stiffness;
@@ -141,6 +154,10 @@ namespace MAST {
                 m += h*dm;
             }
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _material_stiffness;
@@ -167,6 +184,10 @@ namespace MAST {
                                      const Real t,
                                      RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<Real>& _rho, &_h, &_off;
@@ -195,6 +216,10 @@ namespace MAST {
                                      const Real t,
                                      RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _material_stiffness;
@@ -226,6 +251,10 @@ namespace MAST {
                                      RealMatrixX& m) const;
             
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _material_stiffness;
@@ -257,6 +286,10 @@ namespace MAST {
             
             //virtual void convert_to_vector(const RealMatrixX& m, DenseRealVector& v) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _prestress, &_T;
@@ -287,6 +320,10 @@ namespace MAST {
             
             //virtual void convert_to_vector(const RealMatrixX& m, DenseRealVector& v) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _prestress, &_T;
@@ -316,6 +353,10 @@ namespace MAST {
                                      const Real t,
                                      RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _mat_cond;
@@ -348,6 +389,10 @@ namespace MAST {
                                      const Real t,
                                      RealMatrixX& m) const;
             
+            virtual bool is_constant() const {
+                return _all_functions_constant();
+            }
+            
         protected:
             
             const MAST::FieldFunction<RealMatrixX>& _mat_cap;
@@ -361,10 +406,10 @@ namespace MAST {
 
 
 bool
-MAST::Solid2DSectionElementPropertyCard::depends_on(const MAST::FunctionBase& f) const {
+MAST::Solid2DSectionElementPropertyCard::_depends_on(const MAST::FunctionBase& f) const {
     
     return _material->depends_on(f) ||            // check if the material property depends on the function
-    MAST::ElementPropertyCardBase::depends_on(f); // check with this property card
+    MAST::ElementPropertyCardBase::_depends_on(f); // check with this property card
 }
 
 
@@ -1039,7 +1084,7 @@ stiffness_A_matrix(const MAST::ElementBase& e) const {
     (_material->stiffness_matrix(2),
      this->get<const FieldFunction<Real> >("h"));
     
-    return std::unique_ptr<MAST::FieldFunction<RealMatrixX> > (rval);
+    return MAST::build_cached_field_function(rval);
 }
 
 
@@ -1053,7 +1098,7 @@ stiffness_B_matrix(const MAST::ElementBase& e) const {
      this->get<FieldFunction<Real> >("h"),
      this->get<FieldFunction<Real> >("off"));
     
-    return std::unique_ptr<MAST::FieldFunction<RealMatrixX> > (rval);
+    return MAST::build_cached_field_function(rval);
 }
 
 
@@ -1068,7 +1113,7 @@ stiffness_D_matrix(const MAST::ElementBase& e) const {
      this->get<FieldFunction<Real> >("h"),
      this->get<FieldFunction<Real> >("off"));
     
-    return std::unique_ptr<MAST::FieldFunction<RealMatrixX> > (rval);
+    return MAST::build_cached_field_function(rval);
 }
 
 
@@ -1094,7 +1139,7 @@ inertia_matrix(const MAST::ElementBase& e) const {
      this->get<FieldFunction<Real> >("h"),
      this->get<FieldFunction<Real> >("off"));
     
-    return std::unique_ptr<MAST::FieldFunction<RealMatrixX> > (rval);
+    return MAST::build_cached_field_function(rval);
 }
 
 
@@ -1140,7 +1185,7 @@ transverse_shear_stiffness_matrix(const MAST::ElementBase& e) const {
     (_material->transverse_shear_stiffness_matrix(),
      this->get<FieldFunction<Real> >("h"));
     
-    return std::unique_ptr<MAST::FieldFunction<RealMatrixX> > (rval);
+    return MAST::build_cached_field_function(rval);
 }
 
 
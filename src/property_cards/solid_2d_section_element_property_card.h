@@ -80,10 +80,6 @@ namespace MAST {
         }
 
         
-        /*!
-         *  returns true if the property card depends on the function \p f
-         */
-        virtual bool depends_on(const MAST::FunctionBase& f) const;
         
         
         virtual std::unique_ptr<MAST::FieldFunction<RealMatrixX> >
@@ -129,6 +125,13 @@ namespace MAST {
 
     protected:
         
+        /*!
+         *  returns true if the property card depends on the function \p f.
+         *  This is called by \p depends_on() if the dependency has not
+         *  been precomputed by a \p MAST::ParameterDependencyIndex.
+         */
+        virtual bool _depends_on(const MAST::FunctionBase& f) const;
+        
         /*!
          *   material property card
          */
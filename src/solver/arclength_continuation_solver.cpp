@@ -106,7 +106,7 @@ _solve_NR_iterate(libMesh::NumericVector<Real>       &X,
                *dX, dp);
     else
         _solve_schur_factorization(X, p,
-                                   jac,                          true,  // update jac
+                                   jac,                          _update_jac,  // update jac unless lagged
                                    *f,                           true,  // update f
                                    *dfdp,                        false, // update dfdp
                                    *dXdp,                        false, // update dXdp
@@ -149,11 +149,16 @@ _dXdp(const libMesh::NumericVector<Real> &X,
 
     dXdp.zero();
     
+    // the preconditioner is reused if it was computed for the current
+    // Jacobian in this load step
+    system.linear_solver->reuse_preconditioner(_pc_valid);
     rval = system.linear_solver->solve (*system.matrix, pc,
                                         dXdp,
                                         dfdp,
                                         solver_params.second,
                                         solver_params.first);
+    system.linear_solver->reuse_preconditioner(false);
+    _pc_valid = true;
     
     dXdp.scale(-1.);
     dXdp.close();
@@ -37,9 +37,14 @@
 
 
 MAST::ComplexSolverBase::ComplexSolverBase():
-tol        (1.0e-3),
-max_iters  (20),
-_assembly  (nullptr) {
+tol                     (1.0e-3),
+max_iters               (20),
+_assembly               (nullptr),
+_if_reuse_block_matrix  (false),
+_block_mat              (nullptr),
+_block_res_vec          (nullptr),
+_block_sol_vec          (nullptr),
+_block_ksp              (nullptr) {
     
 }
 
@@ -47,6 +52,7 @@ _assembly  (nullptr) {
 
 MAST::ComplexSolverBase::~ComplexSolverBase() {
     
+    this->_clear_block_matrix();
 }
 
 
@@ -64,6 +70,9 @@ MAST::ComplexSolverBase::set_assembly(MAST::ComplexAssemblyBase &assemble) {
 void
 MAST::ComplexSolverBase::clear_assembly() {
     
+    this->_clear_block_matrix();
+    _if_reuse_block_matrix = false;
+    
     MAST::NonlinearSystem& sys = _assembly->system();
     
     // remove the real part of the vector
@@ -329,6 +338,43 @@ MAST::ComplexSolverBase::solve_pc_fieldsplit() {
 
 
 
+void
+MAST::ComplexSolverBase::set_reuse_block_matrix(bool f) {
+    
+    _if_reuse_block_matrix = f;
+    
+    if (!f)
+        this->_clear_block_matrix();
+}
+
+
+
+void
+MAST::ComplexSolverBase::_clear_block_matrix() {
+    
+    PetscErrorCode   ierr;
+    
+    if (_block_ksp) {
+        ierr = KSPDestroy(&_block_ksp);      CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    }
+    if (_block_mat) {
+        ierr = MatDestroy(&_block_mat);      CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    }
+    if (_block_res_vec) {
+        ierr = VecDestroy(&_block_res_vec);  CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    }
+    if (_block_sol_vec) {
+        ierr = VecDestroy(&_block_sol_vec);  CHKERRABORT(PETSC_COMM_WORLD, ierr);
+    }
+    
+    _block_ksp     = nullptr;
+    _block_mat     = nullptr;
+    _block_res_vec = nullptr;
+    _block_sol_vec = nullptr;
+}
+
+
+
 void
 MAST::ComplexSolverBase::solve_block_matrix(MAST::Parameter* p)  {
     
@@ -342,83 +388,90 @@ MAST::ComplexSolverBase::solve_block_matrix(MAST::Parameter* p)  {
     
     libMesh::DofMap& dof_map = sys.get_dof_map();
     
-    const PetscInt
-    my_m = dof_map.n_dofs(),
-    my_n = my_m,
-    n_l  = dof_map.n_dofs_on_processor(sys.processor_id()),
-    m_l  = n_l;
-    
-    const std::vector<libMesh::dof_id_type>
-    & n_nz       = dof_map.get_n_nz(),
-    & n_oz       = dof_map.get_n_oz();
+    PetscErrorCode   ierr;
     
-    std::vector<libMesh::dof_id_type>
-    complex_n_nz (2*n_nz.size()),
-    complex_n_oz (2*n_oz.size());
+    // the Jacobian is assembled and the KSP is set up only if these were
+    // not retained from a previous solve.
+    const bool
+    if_assemble_jac = (_block_ksp == nullptr);
     
-    // create the n_nz and n_oz for the complex matrix without block format
-    for (unsigned int i=0; i<n_nz.size(); i++) {
+    if (if_assemble_jac) {
         
-        complex_n_nz[2*i]   = 2*n_nz[i];
-        complex_n_nz[2*i+1] = 2*n_nz[i];
-    }
-    
-    for (unsigned int i=0; i<n_oz.size(); i++) {
+        const PetscInt
+        my_m = dof_map.n_dofs(),
+        my_n = my_m,
+        n_l  = dof_map.n_dofs_on_processor(sys.processor_id()),
+        m_l  = n_l;
         
-        complex_n_oz[2*i]   = 2*n_oz[i];
-        complex_n_oz[2*i+1] = 2*n_oz[i];
-    }
-    
-    
-    
-    // create the matrix
-    PetscErrorCode   ierr;
-    Mat              mat;
-    
-    ierr = MatCreate(sys.comm().get(), &mat);                      CHKERRABORT(sys.comm().get(), ierr);
-    ierr = MatSetSizes(mat, 2*m_l, 2*n_l, 2*my_m, 2*my_n);         CHKERRABORT(sys.comm().get(), ierr);
-
-    if (libMesh::on_command_line("--solver_system_names")) {
+        const std::vector<libMesh::dof_id_type>
+        & n_nz       = dof_map.get_n_nz(),
+        & n_oz       = dof_map.get_n_oz();
+        
+        std::vector<libMesh::dof_id_type>
+        complex_n_nz (2*n_nz.size()),
+        complex_n_oz (2*n_oz.size());
+        
+        // create the n_nz and n_oz for the complex matrix without block format
+        for (unsigned int i=0; i<n_nz.size(); i++) {
+            
+            complex_n_nz[2*i]   = 2*n_nz[i];
+            complex_n_nz[2*i+1] = 2*n_nz[i];
+        }
         
-        std::string nm = _assembly->system().name() + "_complex_";
-        MatSetOptionsPrefix(mat, nm.c_str());
+        for (unsigned int i=0; i<n_oz.size(); i++) {
+            
+            complex_n_oz[2*i]   = 2*n_oz[i];
+            complex_n_oz[2*i+1] = 2*n_oz[i];
+        }
+        
+        
+        
+        // create the matrix
+        ierr = MatCreate(sys.comm().get(), &_block_mat);                   CHKERRABORT(sys.comm().get(), ierr);
+        ierr = MatSetSizes(_block_mat, 2*m_l, 2*n_l, 2*my_m, 2*my_n);      CHKERRABORT(sys.comm().get(), ierr);
+        
+        if (libMesh::on_command_line("--solver_system_names")) {
+            
+            std::string nm = _assembly->system().name() + "_complex_";
+            MatSetOptionsPrefix(_block_mat, nm.c_str());
+        }
+        ierr = MatSetFromOptions(_block_mat);                              CHKERRABORT(sys.comm().get(), ierr);
+        
+        //ierr = MatSetType(mat, MATBAIJ);                                CHKERRABORT(sys.comm().get(), ierr);
+        ierr = MatSetBlockSize(_block_mat, 2);                             CHKERRABORT(sys.comm().get(), ierr);
+        ierr = MatSeqAIJSetPreallocation(_block_mat,
+                                         2*my_m,
+                                         (PetscInt*)&complex_n_nz[0]);     CHKERRABORT(sys.comm().get(), ierr);
+        ierr = MatMPIAIJSetPreallocation(_block_mat,
+                                         0,
+                                         (PetscInt*)&complex_n_nz[0],
+                                         0,
+                                         (PetscInt*)&complex_n_oz[0]);     CHKERRABORT(sys.comm().get(), ierr);
+        ierr = MatSeqBAIJSetPreallocation (_block_mat, 2,
+                                           0, (PetscInt*)&n_nz[0]);        CHKERRABORT(sys.comm().get(), ierr);
+        ierr = MatMPIBAIJSetPreallocation (_block_mat, 2,
+                                           0, (PetscInt*)&n_nz[0],
+                                           0, (PetscInt*)&n_oz[0]);        CHKERRABORT(sys.comm().get(), ierr);
+        ierr = MatSetOption(_block_mat,
+                            MAT_NEW_NONZERO_ALLOCATION_ERR,
+                            PETSC_TRUE);                                   CHKERRABORT(sys.comm().get(), ierr);
+        
+        
+        // now create the vectors
+        ierr = MatCreateVecs(_block_mat, &_block_res_vec, PETSC_NULL);     CHKERRABORT(sys.comm().get(), ierr);
+        ierr = MatCreateVecs(_block_mat, &_block_sol_vec, PETSC_NULL);     CHKERRABORT(sys.comm().get(), ierr);
     }
-    ierr = MatSetFromOptions(mat);                                 CHKERRABORT(sys.comm().get(), ierr);
-    
-    //ierr = MatSetType(mat, MATBAIJ);                                CHKERRABORT(sys.comm().get(), ierr);
-    ierr = MatSetBlockSize(mat, 2);                                CHKERRABORT(sys.comm().get(), ierr);
-    ierr = MatSeqAIJSetPreallocation(mat,
-                                     2*my_m,
-                                     (PetscInt*)&complex_n_nz[0]); CHKERRABORT(sys.comm().get(), ierr);
-    ierr = MatMPIAIJSetPreallocation(mat,
-                                     0,
-                                     (PetscInt*)&complex_n_nz[0],
-                                     0,
-                                     (PetscInt*)&complex_n_oz[0]); CHKERRABORT(sys.comm().get(), ierr);
-    ierr = MatSeqBAIJSetPreallocation (mat, 2,
-                                       0, (PetscInt*)&n_nz[0]);    CHKERRABORT(sys.comm().get(), ierr);
-    ierr = MatMPIBAIJSetPreallocation (mat, 2,
-                                       0, (PetscInt*)&n_nz[0],
-                                       0, (PetscInt*)&n_oz[0]);    CHKERRABORT(sys.comm().get(), ierr);
-    ierr = MatSetOption(mat,
-                        MAT_NEW_NONZERO_ALLOCATION_ERR,
-                        PETSC_TRUE);                               CHKERRABORT(sys.comm().get(), ierr);
-    
-    
-    // now create the vectors
-    Vec              res_vec, sol_vec;
-    
-    ierr = MatCreateVecs(mat, &res_vec, PETSC_NULL);               CHKERRABORT(sys.comm().get(), ierr);
-    ierr = MatCreateVecs(mat, &sol_vec, PETSC_NULL);               CHKERRABORT(sys.comm().get(), ierr);
     
     
     std::unique_ptr<libMesh::SparseMatrix<Real> >
-    jac_mat(new libMesh::PetscMatrix<Real>(mat, sys.comm()));
+    jac_mat(new libMesh::PetscMatrix<Real>(_block_mat, sys.comm()));
     
     std::unique_ptr<libMesh::NumericVector<Real> >
-    res(new libMesh::PetscVector<Real>(res_vec, sys.comm())),
-    sol(new libMesh::PetscVector<Real>(sol_vec, sys.comm()));
+    res(new libMesh::PetscVector<Real>(_block_res_vec, sys.comm())),
+    sol(new libMesh::PetscVector<Real>(_block_sol_vec, sys.comm()));
     
+    // the solution vector may contain the solution of a previous solve
+    sol->zero();
     
     // if sensitivity analysis is requested, then set the complex solution in
     // the solution vector
@@ -438,44 +491,51 @@ MAST::ComplexSolverBase::solve_block_matrix(MAST::Parameter* p)  {
             sol->set(  2*i, sol_R(i));
             sol->set(2*i+1, sol_I(i));
         }
-        
-        sol->close();
     }
     
+    sol->close();
     
-    // assemble the matrix
-    _assembly->residual_and_jacobian_blocked(*sol,
-                                             *res,
-                                             *jac_mat,
-                                             p);
+    
+    // assemble the matrix, or only the right-hand side if the matrix
+    // is reused from a previous solve
+    if (if_assemble_jac)
+        _assembly->residual_and_jacobian_blocked(*sol,
+                                                 *res,
+                                                 *jac_mat,
+                                                 p);
+    else
+        _assembly->residual_blocked(*sol, *res, p);
     res->scale(-1.);
     
     // now initialize the KSP and ask for solution.
-    KSP        ksp;
-    PC         pc;
-    
-    // setup the KSP
-    ierr = KSPCreate(sys.comm().get(), &ksp); CHKERRABORT(sys.comm().get(), ierr);
-    
-    if (libMesh::on_command_line("--solver_system_names")) {
+    if (if_assemble_jac) {
+        
+        PC         pc;
+        
+        // setup the KSP
+        ierr = KSPCreate(sys.comm().get(), &_block_ksp); CHKERRABORT(sys.comm().get(), ierr);
         
-        std::string nm = _assembly->system().name() + "_complex_";
-        KSPSetOptionsPrefix(ksp, nm.c_str());
+        if (libMesh::on_command_line("--solver_system_names")) {
+            
+            std::string nm = _assembly->system().name() + "_complex_";
+            KSPSetOptionsPrefix(_block_ksp, nm.c_str());
+        }
+        
+        ierr = KSPSetOperators(_block_ksp, _block_mat, _block_mat); CHKERRABORT(sys.comm().get(), ierr);
+        ierr = KSPSetFromOptions(_block_ksp);                       CHKERRABORT(sys.comm().get(), ierr);
+        
+        // setup the PC
+        ierr = KSPGetPC(_block_ksp, &pc);                           CHKERRABORT(sys.comm().get(), ierr);
+        ierr = PCSetFromOptions(pc);                                CHKERRABORT(sys.comm().get(), ierr);
     }
     
-    ierr = KSPSetOperators(ksp, mat, mat);    CHKERRABORT(sys.comm().get(), ierr);
-    ierr = KSPSetFromOptions(ksp);            CHKERRABORT(sys.comm().get(), ierr);
-    
-    // setup the PC
-    ierr = KSPGetPC(ksp, &pc);                CHKERRABORT(sys.comm().get(), ierr);
-    ierr = PCSetFromOptions(pc);              CHKERRABORT(sys.comm().get(), ierr);
-    
     
     START_LOG("KSPSolve", "ComplexSolve");
     
-    // now solve
-    ierr = KSPSolve(ksp, res_vec, sol_vec);
-
+    // now solve. The preconditioner is set up only in the first solve
+    // with a new operator.
+    ierr = KSPSolve(_block_ksp, _block_res_vec, _block_sol_vec);
+    
     STOP_LOG("KSPSolve", "ComplexSolve");
     
     
@@ -497,10 +557,14 @@ MAST::ComplexSolverBase::solve_block_matrix(MAST::Parameter* p)  {
     sol_I.close();
     sol->close();
     
-    ierr = KSPDestroy(&ksp);                  CHKERRABORT(sys.comm().get(), ierr);
-    ierr = MatDestroy(&mat);                  CHKERRABORT(sys.comm().get(), ierr);
-    ierr = VecDestroy(&res_vec);              CHKERRABORT(sys.comm().get(), ierr);
-    ierr = VecDestroy(&sol_vec);              CHKERRABORT(sys.comm().get(), ierr);
+    // the wrappers do not own the PETSc objects, and are cleared before
+    // the objects are destroyed
+    jac_mat.reset();
+    res.reset();
+    sol.reset();
+    
+    if (!_if_reuse_block_matrix)
+        this->_clear_block_matrix();
     
     STOP_LOG("solve_block_matrix()", "ComplexSolve");
 }
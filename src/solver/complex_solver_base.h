@@ -26,6 +26,9 @@
 // libMesh includes
 #include "libmesh/numeric_vector.h"
 
+// PETSc includes
+#include <petscksp.h>
+
 
 namespace MAST {
     
@@ -82,6 +85,21 @@ namespace MAST {
         virtual void solve_block_matrix(MAST::Parameter* p = nullptr);
 
         
+        /*!
+         *  If \p f is \p true, the blocked Jacobian matrix and the KSP
+         *  solver created by the next call to \p solve_block_matrix() are
+         *  retained and reused by all subsequent calls, which then only
+         *  assemble the right-hand side. Since the preconditioner (or
+         *  factorization) is set up only once, this should be used for a
+         *  sequence of solutions with the same operator and different
+         *  right-hand sides, for example the fluid response to multiple
+         *  structural modes at the same reduced frequency. Calling this
+         *  with \p false releases the retained data, and must be done
+         *  before the operator changes.
+         */
+        void set_reuse_block_matrix(bool f);
+
+        
         /*!
          *  @returns a reference to the real part of the solution. If 
          *  \p if_sens is true, the the sensitivity vector is returned. Note,
@@ -124,6 +142,11 @@ namespace MAST {
         
     protected:
         
+        /*!
+         *   destroys the blocked matrix, vectors and KSP solver, if they
+         *   were retained from a previous solve
+         */
+        void _clear_block_matrix();
         
         /*!
          *   Associated ComplexAssembly object that provides the
@@ -131,6 +154,21 @@ namespace MAST {
          */
         MAST::ComplexAssemblyBase* _assembly;
         
+        /*!
+         *   if \p true, the blocked matrix and KSP solver are retained
+         *   between successive calls to \p solve_block_matrix()
+         */
+        bool _if_reuse_block_matrix;
+        
+        /*!
+         *   blocked Jacobian matrix, residual and solution vectors and
+         *   the KSP solver used in \p solve_block_matrix().
+         */
+        Mat  _block_mat;
+        Vec  _block_res_vec;
+        Vec  _block_sol_vec;
+        KSP  _block_ksp;
+        
     };
 }
 
@@ -44,7 +44,11 @@ max_step                  (20.),
 step_size_change_exponent (0.5),
 step_desired_iters        (5),
 schur_factorization       (true),
+lag_jacobian              (false),
+jacobian_lag_rate         (0.5),
 _initialized              (false),
+_update_jac               (true),
+_pc_valid                 (false),
 _elem_ops                 (nullptr),
 _assembly                 (nullptr),
 _p                        (nullptr),
@@ -74,6 +78,9 @@ set_assembly_and_load_parameter(MAST::AssemblyElemOperations&   elem_ops,
     _assembly  =  &assembly;
     _p         =  &p;
     
+    _update_jac = true;
+    _pc_valid   = false;
+    
     
 }
 
@@ -103,9 +110,16 @@ MAST::ContinuationSolverBase::solve()  {
     _p0     = (*_p)();
     _X0.reset(X.clone().release());
     
+    // the preconditioner is computed at least once in each load step, and
+    // the Jacobian is reassembled for each iterate unless it is lagged
+    _pc_valid = false;
+    if (!lag_jacobian)
+        _update_jac = true;
+    
     Real
-    norm0   = _res_norm(X, *_p),
-    norm    = norm0;
+    norm0     = _res_norm(X, *_p),
+    norm      = norm0,
+    norm_prev = norm0;
     
     bool
     cont    = true;
@@ -123,10 +137,16 @@ MAST::ContinuationSolverBase::solve()  {
         << std::setw(20) << "relative res-l2: "
         << std::setw(15) << norm/norm0 << std::endl;
         
+        norm_prev = norm;
         _solve_NR_iterate(X, *_p);
         norm = _res_norm(X, *_p);
         iter++;
         
+        // reassemble the Jacobian for the next iterate if it is not lagged
+        // or if the convergence with the lagged Jacobian is slow
+        if (!lag_jacobian || norm > jacobian_lag_rate * norm_prev)
+            _update_jac = true;
+        
         if (norm < abs_tol)       cont = false;
         if (norm/norm0 < rel_tol) cont = false;
         if (iter >= max_it) {
@@ -144,6 +164,8 @@ MAST::ContinuationSolverBase::solve()  {
                 X.close();
                 *_p = _p0;
                 _reset_iterations();
+                _update_jac = true;
+                _pc_valid   = false;
                 cont = true;
             }
             else
@@ -160,6 +182,11 @@ MAST::ContinuationSolverBase::solve()  {
     << std::setw(15) << norm/norm0
     << std::setw(20) << "Terminated"  << std::endl;
     
+    // the lagged Jacobian is not reused in the next load step if this
+    // step needed more than the desired number of iterates
+    if (iter > step_desired_iters)
+        _update_jac = true;
+    
     if (iter) {
         Real
         factor   = std::pow((1.*step_desired_iters)/(1.*iter+1.), step_size_change_exponent);
@@ -478,6 +505,11 @@ _solve_schur_factorization(const libMesh::NumericVector<Real>  &X,
     Real
     a    = 0.;
     
+    // dXdp is consistent with the Jacobian unless the Jacobian is
+    // reassembled here without an update of dXdp
+    const bool
+    if_dXdp_consistent = !update_jac || update_dfdp || update_dXdp;
+    
     //////////////////////////////////////////////////////////
     //         STEP 1:  r1  = inv(df/dX) f
     //////////////////////////////////////////////////////////
@@ -489,17 +521,34 @@ _solve_schur_factorization(const libMesh::NumericVector<Real>  &X,
                                          update_f?     &f:nullptr,
                                          update_jac? &jac:nullptr,
                                          system);
-    rval = system.linear_solver->solve (jac, pc,
-                                        *r1,
-                                        f,
-                                        solver_params.second,
-                                        solver_params.first);
-
+    
+    if (update_jac) {
+        
+        // the preconditioner is recomputed for the new Jacobian
+        _update_jac = false;
+        _pc_valid   = false;
+    }
+    
+    // r1 is zero for a zero f, which is the case for the update of the
+    // search direction
+    if (f.linfty_norm() > 0.) {
+        
+        // the preconditioner is computed only in the first solve with
+        // this Jacobian and is reused for all subsequent solves
+        system.linear_solver->reuse_preconditioner(_pc_valid);
+        rval = system.linear_solver->solve (jac, pc,
+                                            *r1,
+                                            f,
+                                            solver_params.second,
+                                            solver_params.first);
+        _pc_valid = true;
+        
 #ifdef LIBMESH_ENABLE_CONSTRAINTS
-    system.get_dof_map().enforce_constraints_exactly (system,
-                                                      r1.get(),
-                                                      /* homogeneous = */ true);
+        system.get_dof_map().enforce_constraints_exactly (system,
+                                                          r1.get(),
+                                                          /* homogeneous = */ true);
 #endif
+    }
 
 
     //////////////////////////////////////////////////////////
@@ -511,11 +560,13 @@ _solve_schur_factorization(const libMesh::NumericVector<Real>  &X,
 
     if (update_dfdp || update_dXdp) {
         
+        system.linear_solver->reuse_preconditioner(_pc_valid);
         rval = system.linear_solver->solve (jac, pc,
                                             dXdp,
                                             dfdp,
                                             solver_params.second,
                                             solver_params.first);
+        _pc_valid = true;
         
         dXdp.scale(-1.);
         dXdp.close();
@@ -541,24 +592,41 @@ _solve_schur_factorization(const libMesh::NumericVector<Real>  &X,
     //////////////////////////////////////////////////////////
     //         STEP 5:  df/dX  dX =    -f - df/dp dp
     //////////////////////////////////////////////////////////
-    r1->zero();
-    r1->add(1., f);
-    r1->add(dp, dfdp);
-    r1->scale(-1.);
-    r1->close();
-    rval = system.linear_solver->solve (jac, pc,
-                                        dX,
-                                        *r1,
-                                        solver_params.second,
-                                        solver_params.first);
-    
-    
-    // The linear solver may not have fit our constraints exactly
+    if (if_dXdp_consistent) {
+        
+        // by linearity of the solve, dX = -r1 + dXdp dp, which does not
+        // need another solve
+        dX.zero();
+        dX.add(-1., *r1);
+        dX.add(dp, dXdp);
+        dX.close();
+    }
+    else {
+        
+        r1->zero();
+        r1->add(1., f);
+        r1->add(dp, dfdp);
+        r1->scale(-1.);
+        r1->close();
+        
+        system.linear_solver->reuse_preconditioner(_pc_valid);
+        rval = system.linear_solver->solve (jac, pc,
+                                            dX,
+                                            *r1,
+                                            solver_params.second,
+                                            solver_params.first);
+        _pc_valid = true;
+        
+        // The linear solver may not have fit our constraints exactly
 #ifdef LIBMESH_ENABLE_CONSTRAINTS
-    system.get_dof_map().enforce_constraints_exactly (system,
-                                                      &dX,
-                                                      /* homogeneous = */ true);
+        system.get_dof_map().enforce_constraints_exactly (system,
+                                                          &dX,
+                                                          /* homogeneous = */ true);
 #endif
+    }
+    
+    // other solves with this linear solver compute their own preconditioner
+    system.linear_solver->reuse_preconditioner(false);
 
     _assembly->clear_elem_operation_object();
     system.set_operation(MAST::NonlinearSystem::NONE);
@@ -140,6 +140,23 @@ namespace MAST {
          */
         bool schur_factorization;
         
+        /*!
+         *   if true, the Jacobian and its preconditioner are reused in the
+         *   Schur-factorization solver for subsequent N-R iterates and
+         *   load steps. The Jacobian is reassembled if an iterate reduces
+         *   the residual norm by less than the factor
+         *   \p jacobian_lag_rate, if a load step needs more than
+         *   \p step_desired_iters iterates, or if a load step is
+         *   restarted. Default is false.
+         */
+        bool lag_jacobian;
+        
+        /*!
+         *   required ratio of residual norms of consecutive iterates for
+         *   reuse of the Jacobian with \p lag_jacobian. Default is 0.5.
+         */
+        Real jacobian_lag_rate;
+        
     protected:
 
         virtual void
@@ -178,7 +195,12 @@ namespace MAST {
          *          \left\{ \begin{array}{c} dx \\ dp \end{array} \right\}  =
          *          - \left\{ \begin{array}{c} f \\ g \end{array} \right\}
          *    \f]
-         *   \p dX and \p dp are returned from the solution
+         *   \p dX and \p dp are returned from the solution. If \p dXdp
+         *   is not updated, it should have been computed with \p jac
+         *   as provided on entry. The Jacobian is factored once and reused
+         *   for all solves, and the solve for \p dX is replaced by
+         *   \f$ dX = -r_1 + dp ~ dX/dp \f$ when \p dXdp is consistent
+         *   with the Jacobian.
          */
         void
         _solve_schur_factorization(const libMesh::NumericVector<Real>  &X,
@@ -220,6 +242,18 @@ namespace MAST {
         
         bool                           _initialized;
         
+        /*!
+         *   true if the Jacobian should be assembled in the next N-R
+         *   iterate. This is always true if \p lag_jacobian is false.
+         */
+        bool                           _update_jac;
+        
+        /*!
+         *   true if the preconditioner of the system linear solver has
+         *   been computed for the current Jacobian in this load step
+         */
+        bool                           _pc_valid;
+        
         MAST::AssemblyElemOperations   *_elem_ops;
         MAST::AssemblyBase             *_assembly;
         MAST::Parameter                *_p;
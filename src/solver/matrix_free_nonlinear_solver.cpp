@@ -0,0 +1,412 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+// MAST includes
+#include "solver/matrix_free_nonlinear_solver.h"
+#include "base/nonlinear_implicit_assembly.h"
+#include "base/nonlinear_system.h"
+
+// libMesh includes
+#include "libmesh/dof_map.h"
+#include "libmesh/sparse_matrix.h"
+#include "libmesh/petsc_matrix.h"
+#include "libmesh/petsc_vector.h"
+
+
+//---------------------------------------------------------------
+// method for matrix vector multiplication with the Jacobian y=Jx
+PetscErrorCode
+__mast_matrix_free_petsc_mat_mult(Mat mat, Vec x, Vec y) {
+    
+    LOG_SCOPE("mat_mult()", "MatrixFreeNonlinearSolver");
+    
+    PetscErrorCode ierr=0;
+    
+    libmesh_assert(mat);
+    libmesh_assert(x);
+    libmesh_assert(y);
+    
+    void * ctx = PETSC_NULL;
+    ierr = MatShellGetContext(mat, &ctx);
+    
+    MAST::MatrixFreeNonlinearSolver
+    *solver = static_cast<MAST::MatrixFreeNonlinearSolver*> (ctx);
+    CHKERRABORT(solver->comm().get(), ierr);
+    
+    solver->jacobian_product(x, y);
+    
+    return ierr;
+}
+
+
+//---------------------------------------------------------------
+// method to get the diagonal of the Jacobian
+PetscErrorCode
+__mast_matrix_free_petsc_mat_get_diagonal(Mat mat, Vec d) {
+    
+    PetscErrorCode ierr=0;
+    
+    libmesh_assert(mat);
+    libmesh_assert(d);
+    
+    void * ctx = PETSC_NULL;
+    ierr = MatShellGetContext(mat, &ctx);
+    
+    MAST::MatrixFreeNonlinearSolver
+    *solver = static_cast<MAST::MatrixFreeNonlinearSolver*> (ctx);
+    CHKERRABORT(solver->comm().get(), ierr);
+    
+    solver->jacobian_diagonal(d);
+    
+    return ierr;
+}
+
+
+//---------------------------------------------------------------
+// this function is called by PETSc to evaluate the residual at X
+PetscErrorCode
+__mast_matrix_free_petsc_snes_residual (SNES snes, Vec x, Vec r, void * ctx) {
+    
+    LOG_SCOPE("residual()", "MatrixFreeNonlinearSolver");
+    
+    PetscErrorCode ierr=0;
+    
+    libmesh_assert(x);
+    libmesh_assert(r);
+    libmesh_assert(ctx);
+    
+    MAST::MatrixFreeNonlinearSolver * solver =
+    static_cast<MAST::MatrixFreeNonlinearSolver*> (ctx);
+    
+    MAST::NonlinearImplicitAssembly& assembly = solver->get_assembly();
+    MAST::NonlinearSystem& sys = assembly.system();
+    
+    libMesh::PetscVector<Real>
+    X_petsc(x, sys.comm()),
+    R      (r, sys.comm());
+    
+    // Enforce constraints (if any) on a copy of the solution, since
+    // "x" is locked by debug-enabled PETSc.
+    std::unique_ptr<libMesh::NumericVector<Real> >
+    X(X_petsc.clone().release());
+    sys.get_dof_map().enforce_constraints_exactly(sys, X.get());
+    
+    assembly.residual_and_jacobian(*X, &R, nullptr, sys);
+    
+    R.close();
+    
+    return ierr;
+}
+
+
+
+//---------------------------------------------------------------
+// this function is called by PETSc to evaluate the Jacobian at X
+PetscErrorCode
+__mast_matrix_free_petsc_snes_jacobian(SNES snes, Vec x, Mat jac, Mat pc, void * ctx)
+{
+    LOG_SCOPE("jacobian()", "MatrixFreeNonlinearSolver");
+    
+    PetscErrorCode ierr=0;
+    
+    libmesh_assert(x);
+    libmesh_assert(jac);
+    libmesh_assert(pc);
+    libmesh_assert(ctx);
+    
+    MAST::MatrixFreeNonlinearSolver * solver =
+    static_cast<MAST::MatrixFreeNonlinearSolver*> (ctx);
+    
+    solver->update_jacobian(x, pc);
+    
+    ierr = MatAssemblyBegin(jac, MAT_FINAL_ASSEMBLY);  CHKERRABORT(solver->comm().get(), ierr);
+    ierr = MatAssemblyEnd(jac, MAT_FINAL_ASSEMBLY);    CHKERRABORT(solver->comm().get(), ierr);
+    
+    return ierr;
+}
+
+
+
+
+MAST::MatrixFreeNonlinearSolver::
+MatrixFreeNonlinearSolver(const libMesh::Parallel::Communicator& comm_in,
+                          const std::string& nm):
+libMesh::ParallelObject       (comm_in),
+_name                         (nm),
+_assembly                     (nullptr),
+_pc_assembly                  (nullptr),
+_converged_reason             (SNES_CONVERGED_ITERATING),
+_final_residual_norm          (0.) {
+    
+}
+
+
+
+MAST::MatrixFreeNonlinearSolver::~MatrixFreeNonlinearSolver() {
+    
+}
+
+
+
+void
+MAST::MatrixFreeNonlinearSolver::
+set_assembly(MAST::NonlinearImplicitAssembly& assembly) {
+    
+    _assembly = &assembly;
+}
+
+
+
+MAST::NonlinearImplicitAssembly&
+MAST::MatrixFreeNonlinearSolver::get_assembly() {
+    
+    libmesh_assert(_assembly);
+    
+    return *_assembly;
+}
+
+
+
+void
+MAST::MatrixFreeNonlinearSolver::
+set_preconditioner_assembly(MAST::NonlinearImplicitAssembly& assembly) {
+    
+    _pc_assembly = &assembly;
+}
+
+
+
+void
+MAST::MatrixFreeNonlinearSolver::clear_preconditioner_assembly() {
+    
+    _pc_assembly = nullptr;
+}
+
+
+
+void
+MAST::MatrixFreeNonlinearSolver::solve() {
+    
+    libmesh_assert(_assembly);
+    
+    MAST::NonlinearSystem& sys = _assembly->system();
+    const libMesh::DofMap& dof_map = sys.get_dof_map();
+    
+    PetscErrorCode   ierr;
+    SNES             snes;
+    Mat              mat;
+    KSP              ksp;
+    PC               pc;
+    
+    const bool       sys_name = libMesh::on_command_line("--solver_system_names");
+    std::string      nm;
+    
+    // vectors for the Jacobian data and the residual
+    _X.reset(sys.solution->zero_clone().release());
+    _dX.reset(sys.solution->zero_clone().release());
+    _diag.reset(sys.solution->zero_clone().release());
+    
+    std::unique_ptr<libMesh::NumericVector<Real> >
+    res(sys.solution->zero_clone().release());
+    
+    // the operator uses identity rows for the constrained dofs
+    _constrained_dofs.clear();
+    for (libMesh::dof_id_type i=dof_map.first_dof(); i<dof_map.end_dof(); i++)
+        if (dof_map.is_constrained_dof(i))
+            _constrained_dofs.push_back(i);
+    
+    //////////////////////////////////////////////////////////////////////
+    // create the shell matrix for the Jacobian
+    //////////////////////////////////////////////////////////////////////
+    ierr = SNESCreate(this->comm().get(), &snes);      CHKERRABORT(this->comm().get(), ierr);
+    
+    ierr = MatCreateShell(this->comm().get(),
+                          dof_map.n_local_dofs(),
+                          dof_map.n_local_dofs(),
+                          dof_map.n_dofs(),
+                          dof_map.n_dofs(),
+                          this,
+                          &mat);
+    CHKERRABORT(this->comm().get(), ierr);
+    
+    ierr = MatShellSetOperation(mat,
+                                MATOP_MULT,
+                                (void(*)(void))__mast_matrix_free_petsc_mat_mult);
+    CHKERRABORT(this->comm().get(), ierr);
+    
+    ierr = MatShellSetOperation(mat,
+                                MATOP_GET_DIAGONAL,
+                                (void(*)(void))__mast_matrix_free_petsc_mat_get_diagonal);
+    CHKERRABORT(this->comm().get(), ierr);
+    
+    // the system matrix is used for preconditioning if a preconditioner
+    // assembly is provided. Otherwise, the shell matrix provides the
+    // diagonal for the Jacobi preconditioner.
+    Mat
+    pc_mat = mat;
+    if (_pc_assembly)
+        pc_mat = dynamic_cast<libMesh::PetscMatrix<Real>&>(*sys.matrix).mat();
+    
+    //////////////////////////////////////////////////////////////////////
+    // initialize the solver context
+    //////////////////////////////////////////////////////////////////////
+    ierr = SNESSetFunction (snes,
+                            dynamic_cast<libMesh::PetscVector<Real>&>(*res).vec(),
+                            __mast_matrix_free_petsc_snes_residual,
+                            this);
+    CHKERRABORT(this->comm().get(), ierr);
+    
+    ierr = SNESSetJacobian(snes,
+                           mat,
+                           pc_mat,
+                           __mast_matrix_free_petsc_snes_jacobian,
+                           this);
+    CHKERRABORT(this->comm().get(), ierr);
+    
+    if (sys_name) {
+        
+        nm = this->name() + "_";
+        SNESSetOptionsPrefix(snes, nm.c_str());
+    }
+    
+    ierr = SNESGetKSP (snes, &ksp);                   CHKERRABORT(this->comm().get(), ierr);
+    ierr = KSPGetPC(ksp, &pc);                        CHKERRABORT(this->comm().get(), ierr);
+    
+    // Jacobi is the default preconditioner for the shell matrix, which can
+    // be changed through the command line options
+    if (!_pc_assembly) {
+        
+        ierr = PCSetType(pc, PCJACOBI);               CHKERRABORT(this->comm().get(), ierr);
+    }
+    
+    ierr = SNESSetFromOptions(snes);                  CHKERRABORT(this->comm().get(), ierr);
+    
+    //////////////////////////////////////////////////////////////////////
+    // now, solve with the system solution as the initial guess
+    //////////////////////////////////////////////////////////////////////
+    sys.solution->close();
+    
+    START_LOG("SNESSolve", this->name()+"_MatrixFreeSolve");
+    
+    ierr = SNESSolve(snes,
+                     PETSC_NULL,
+                     dynamic_cast<libMesh::PetscVector<Real>&>(*sys.solution).vec());
+    CHKERRABORT(this->comm().get(), ierr);
+    
+    STOP_LOG("SNESSolve", this->name()+"_MatrixFreeSolve");
+    
+    Vec
+    f;
+    PetscReal
+    norm = 0.;
+    ierr = SNESGetConvergedReason(snes, &_converged_reason);       CHKERRABORT(this->comm().get(), ierr);
+    ierr = SNESGetFunction(snes, &f, PETSC_NULL, PETSC_NULL);       CHKERRABORT(this->comm().get(), ierr);
+    ierr = VecNorm(f, NORM_2, &norm);                               CHKERRABORT(this->comm().get(), ierr);
+    _final_residual_norm = norm;
+    
+    // enforce the constraints on the solution and localize it
+    dof_map.enforce_constraints_exactly(sys);
+    sys.update();
+    
+    // destroy the Petsc contexts
+    ierr = SNESDestroy(&snes);                        CHKERRABORT(this->comm().get(), ierr);
+    ierr = MatDestroy(&mat);                          CHKERRABORT(this->comm().get(), ierr);
+    
+    _X.reset();
+    _dX.reset();
+    _diag.reset();
+    _constrained_dofs.clear();
+}
+
+
+
+void
+MAST::MatrixFreeNonlinearSolver::update_jacobian(Vec x, Mat pc) {
+    
+    libmesh_assert(_assembly);
+    libmesh_assert(_X);
+    
+    MAST::NonlinearSystem& sys = _assembly->system();
+    
+    libMesh::PetscVector<Real>
+    X_petsc(x, sys.comm());
+    
+    // store the solution at which the Jacobian is evaluated
+    *_X = X_petsc;
+    sys.get_dof_map().enforce_constraints_exactly(sys, _X.get());
+    
+    if (_pc_assembly) {
+        
+        // assemble the preconditioning matrix provided by SNES
+        libMesh::PetscMatrix<Real>
+        PC(pc, sys.comm());
+        
+        _pc_assembly->residual_and_jacobian(*_X, nullptr, &PC, sys);
+        PC.close();
+    }
+    else {
+        
+        // the diagonal for the Jacobi preconditioner, with unit values for
+        // the identity rows of the constrained dofs
+        _assembly->jacobian_diagonal(*_X, *_diag, sys);
+        
+        for (unsigned int i=0; i<_constrained_dofs.size(); i++)
+            _diag->set(_constrained_dofs[i], 1.);
+        _diag->close();
+    }
+}
+
+
+
+void
+MAST::MatrixFreeNonlinearSolver::jacobian_product(Vec x, Vec y) {
+    
+    libmesh_assert(_assembly);
+    libmesh_assert(_X);
+    
+    MAST::NonlinearSystem& sys = _assembly->system();
+    
+    libMesh::PetscVector<Real>
+    dX(x, sys.comm()),
+    JdX(y, sys.comm());
+    
+    // homogeneous constraints on the perturbation
+    *_dX = dX;
+    sys.get_dof_map().enforce_constraints_exactly(sys, _dX.get(), true);
+    
+    _assembly->linearized_jacobian_solution_product(*_X, *_dX, JdX, sys);
+    
+    // identity rows for the constrained dofs
+    for (unsigned int i=0; i<_constrained_dofs.size(); i++)
+        JdX.set(_constrained_dofs[i], dX(_constrained_dofs[i]));
+    JdX.close();
+}
+
+
+
+void
+MAST::MatrixFreeNonlinearSolver::jacobian_diagonal(Vec d) {
+    
+    libmesh_assert(_diag);
+    
+    PetscErrorCode
+    ierr = VecCopy(dynamic_cast<libMesh::PetscVector<Real>&>(*_diag).vec(), d);
+    CHKERRABORT(this->comm().get(), ierr);
+}
@@ -0,0 +1,188 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef __mast__matrix_free_nonlinear_solver_h__
+#define __mast__matrix_free_nonlinear_solver_h__
+
+// C++ includes
+#include <vector>
+#include <string>
+#include <memory>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+// libMesh includes
+#include "libmesh/parallel_object.h"
+#include "libmesh/numeric_vector.h"
+
+// PETSc includes
+#include <petscmat.h>
+#include <petscsnes.h>
+
+
+namespace MAST {
+    
+    // Forward declerations
+    class NonlinearImplicitAssembly;
+    
+    
+    /*!
+     *   Solves the nonlinear system of a NonlinearImplicitAssembly with PETSc
+     *   SNES without assembling the Jacobian. The Jacobian is a PETSc
+     *   MATSHELL that computes the product with a vector element-by-element
+     *   using \p NonlinearImplicitAssembly::linearized_jacobian_solution_product
+     *   at the current Newton iterate. Rows of constrained dofs act as
+     *   identity rows.
+     *
+     *   By default, the preconditioner is Jacobi with the diagonal of the
+     *   Jacobian, which is assembled as a vector. Alternatively, a
+     *   separate assembly object, for example of a low-order or simplified
+     *   model of the same system, can be provided to assemble the system
+     *   matrix for use as the preconditioning matrix. The options of the
+     *   solver can be changed through the PETSc command line options.
+     */
+    class MatrixFreeNonlinearSolver:
+    public libMesh::ParallelObject {
+        
+    public:
+        
+        /*!
+         *   default constructor
+         */
+        MatrixFreeNonlinearSolver(const libMesh::Parallel::Communicator& comm_in,
+                                  const std::string& nm);
+        
+        /*!
+         *   destructor
+         */
+        virtual ~MatrixFreeNonlinearSolver();
+        
+        /*!
+         *    @returns the name of this solver
+         */
+        const std::string name() const {
+            
+            return _name;
+        }
+        
+        /*!
+         *   sets the assembly object that provides the residual and the
+         *   Jacobian-vector product
+         */
+        void set_assembly(MAST::NonlinearImplicitAssembly& assembly);
+        
+        /*!
+         *   @returns a reference to the assembly object
+         */
+        MAST::NonlinearImplicitAssembly& get_assembly();
+        
+        /*!
+         *   sets the assembly object that is used to assemble the system
+         *   matrix used as the preconditioning matrix. The Jacobi
+         *   preconditioner is used if this is not provided.
+         */
+        void set_preconditioner_assembly(MAST::NonlinearImplicitAssembly& assembly);
+        
+        /*!
+         *   clears the preconditioner assembly object.
+         */
+        void clear_preconditioner_assembly();
+        
+        /*!
+         *   solves the nonlinear problem with the current system solution as
+         *   the initial guess. The converged solution is stored in the
+         *   system solution.
+         */
+        void solve();
+        
+        /*!
+         *   @returns the converged reason of the last call to \p solve()
+         */
+        SNESConvergedReason get_converged_reason() const {
+            
+            return _converged_reason;
+        }
+        
+        /*!
+         *   @returns the norm of the residual at the end of the last call
+         *   to \p solve()
+         */
+        Real final_residual_norm() const {
+            
+            return _final_residual_norm;
+        }
+        
+        /*!
+         *   updates the data for the Jacobian at \p x. This is called by the
+         *   SNES Jacobian function. If a preconditioner assembly is
+         *   provided, the preconditioning matrix is assembled in \p pc.
+         */
+        void update_jacobian(Vec x, Mat pc);
+        
+        /*!
+         *   computes \p y = J \p x. This is the multiplication operation of
+         *   the shell matrix.
+         */
+        void jacobian_product(Vec x, Vec y);
+        
+        /*!
+         *   copies the diagonal of the Jacobian to \p d. This is used by the
+         *   Jacobi preconditioner of the shell matrix.
+         */
+        void jacobian_diagonal(Vec d);
+        
+    protected:
+        
+        /*!
+         *   name of this solver
+         */
+        std::string _name;
+        
+        /*!
+         *   assembly object for the residual and Jacobian-vector products
+         */
+        MAST::NonlinearImplicitAssembly* _assembly;
+        
+        /*!
+         *   assembly object for the preconditioning matrix, if provided
+         */
+        MAST::NonlinearImplicitAssembly* _pc_assembly;
+        
+        /*!
+         *   solution at which the Jacobian is evaluated, the diagonal of the
+         *   Jacobian, and a work vector for the Jacobian-vector product
+         */
+        std::unique_ptr<libMesh::NumericVector<Real>> _X, _diag, _dX;
+        
+        /*!
+         *   constrained dofs owned by this processor
+         */
+        std::vector<libMesh::dof_id_type> _constrained_dofs;
+        
+        /*!
+         *   converged reason and residual norm of the last solve
+         */
+        SNESConvergedReason _converged_reason;
+        
+        Real _final_residual_norm;
+    };
+}
+
+#endif // __mast__matrix_free_nonlinear_solver_h__
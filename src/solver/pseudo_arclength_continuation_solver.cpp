@@ -105,6 +105,8 @@ _solve_NR_iterate(libMesh::NumericVector<Real>       &X,
     
     _update_search_direction(X, p,
                              jac,
+                             *dfdp,
+                             *dXdp,
                              *t1_X,
                              t1_p);
     
@@ -123,11 +125,13 @@ _solve_NR_iterate(libMesh::NumericVector<Real>       &X,
                *t1_X, t1_p, g,           // dgdX = X_scale * t1^X, dgdp = p_scale *t1^p
                *dX, dp);
     else
+        // dfdp and dXdp from the search direction update are computed with
+        // the same Jacobian and are reused after removal of the scaling
         _solve_schur_factorization(X, p,
                                    jac,                          false, // do not update jac
                                    *f,                           true,  // update f
-                                   *dfdp,                        true,  // update dfdp
-                                   *dXdp,                        true,  // update dXdp
+                                   *dfdp,                        false, // do not update dfdp
+                                   *dXdp,                        false, // do not update dXdp
                                    *t1_X, t1_p, g,           // dgdX = X_scale * t1^X, dgdp = p_scale *t1^p
                                    *dX, dp);
     
@@ -144,15 +148,15 @@ MAST::PseudoArclengthContinuationSolver::
 _update_search_direction(const libMesh::NumericVector<Real> &X,
                          const MAST::Parameter              &p,
                          libMesh::SparseMatrix<Real>        &jac,
+                         libMesh::NumericVector<Real>       &dfdp,
+                         libMesh::NumericVector<Real>       &dXdp,
                          libMesh::NumericVector<Real>       &t1_X,
                          Real                               &t1_p) {
     
     libmesh_assert(_initialized);
 
     std::unique_ptr<libMesh::NumericVector<Real>>
-    f(X.zero_clone().release()),
-    dfdp(X.zero_clone().release()),
-    dXdp(X.zero_clone().release());
+    f(X.zero_clone().release());
 
     MAST::NonlinearSystem
     &system    = _assembly->system();
@@ -160,9 +164,9 @@ _update_search_direction(const libMesh::NumericVector<Real> &X,
     system.set_operation(MAST::NonlinearSystem::FORWARD_SENSITIVITY_SOLVE);
     _assembly->set_elem_operation_object(*_elem_ops);
 
-    _assembly->sensitivity_assemble(p, *dfdp);
-    dfdp->scale(_X_scale/_p_scale);
-    dfdp->close();
+    _assembly->sensitivity_assemble(p, dfdp);
+    dfdp.scale(_X_scale/_p_scale);
+    dfdp.close();
 
     _assembly->clear_elem_operation_object();
     system.set_operation(MAST::NonlinearSystem::NONE);
@@ -172,17 +176,26 @@ _update_search_direction(const libMesh::NumericVector<Real> &X,
     if (!schur_factorization)
         _solve(X, p,
                *f,                false, // do not update f
-               *dfdp,             false, // do not update dfdp
+               dfdp,              false, // do not update dfdp
                *_t0_X, _t0_p,  -1.,  // dgdX = t0^X, dgdp = t0^p, g = -1
                t1_X, t1_p);
-    else
+    else {
         _solve_schur_factorization(X, p,
-                                   jac,               true,  // update jac
+                                   jac,               _update_jac,  // update jac unless lagged
                                    *f,                false, // do not update f
-                                   *dfdp,             false, // do not update dfdp
-                                   *dXdp,             true,  // update dXdp
+                                   dfdp,              false, // do not update dfdp
+                                   dXdp,              true,  // update dXdp
                                    *_t0_X, _t0_p,  -1.,  // dgdX = t0^X, dgdp = t0^p, g = -1
                                    t1_X, t1_p);
+        
+        // remove the scaling from dXdp
+        dXdp.scale(_p_scale/_X_scale);
+        dXdp.close();
+    }
+    
+    // remove the scaling from dfdp
+    dfdp.scale(_p_scale/_X_scale);
+    dfdp.close();
 
     // now scale the vector for unit magnitude
     Real
@@ -71,13 +71,15 @@ namespace MAST {
         /*!
          *  updates \f$ t_1 \f$ for the current iterate \p X and \p p, and
          *  stores these values to \p _t0_X and \p _t0_p for next computation.
+         *  \p dfdp and \p dXdp are returned for the current iterate, so that
+         *  they can be reused in the N-R update with the same Jacobian.
          */
         void
         _update_search_direction(const libMesh::NumericVector<Real> &X,
                                  const MAST::Parameter              &p,
                                  libMesh::SparseMatrix<Real>        &jac,
-                                 /*libMesh::NumericVector<Real>       &dfdp,
-                                 libMesh::NumericVector<Real>       &dXdp,*/
+                                 libMesh::NumericVector<Real>       &dfdp,
+                                 libMesh::NumericVector<Real>       &dXdp,
                                  libMesh::NumericVector<Real>       &t1_X,
                                  Real                               &t1_p);
         
@@ -18,9 +18,13 @@
  */
 
 
+// C++ includes
+#include <cmath>
+
 // MAST includes
 #include "solver/stabilized_first_order_transient_sensitivity_solver.h"
 #include "solver/slepc_eigen_solver.h"
+#include "solver/transient_checkpoint_store.h"
 #include "base/transient_assembly_elem_operations.h"
 #include "base/elem_base.h"
 #include "base/nonlinear_system.h"
@@ -43,11 +47,17 @@ MAST::TransientSolverBase(1, 2),
 max_amp                       (1.),
 beta                          (1.),
 max_index                     (0),
+power_iteration_max_its       (20),
+power_iteration_tol           (1.e-3),
 _use_eigenvalue_stabilization (true),
+_time_invariant_operators     (false),
+_use_power_iteration          (false),
 _assemble_mass                (false),
 _t0                           (0.),
 _index0                       (0),
-_index1                       (0) {
+_index1                       (0),
+_pc_dt                        (0.),
+_pc_n_steps                   (0) {
     
 }
 
@@ -66,6 +76,35 @@ set_eigenvalue_stabilization(bool f) {
 }
 
 
+void
+MAST::StabilizedFirstOrderNewmarkTransientSensitivitySolver::
+set_time_invariant_operators(bool f) {
+    
+    _time_invariant_operators = f;
+    this->clear_operator_cache();
+}
+
+
+void
+MAST::StabilizedFirstOrderNewmarkTransientSensitivitySolver::
+clear_operator_cache() {
+    
+    _jac_cache.reset();
+    _mass_cache.reset();
+    _linear_solver.reset();
+    _pc_dt      = 0.;
+    _pc_n_steps = 0;
+}
+
+
+void
+MAST::StabilizedFirstOrderNewmarkTransientSensitivitySolver::
+set_power_iteration_amplification(bool f) {
+    
+    _use_power_iteration = f;
+}
+
+
 void
 MAST::StabilizedFirstOrderNewmarkTransientSensitivitySolver::
 set_nolinear_solution_location(std::string& file_root,
@@ -83,8 +122,8 @@ sensitivity_solve(MAST::AssemblyBase& assembly,
     
     libmesh_assert_greater(  max_amp, 0.);
     libmesh_assert_greater(max_index,  0);
-    libmesh_assert(_sol_name_root.size());
-    libmesh_assert(_sol_dir.size());
+    libmesh_assert(_checkpoint_store ||
+                   (_sol_name_root.size() && _sol_dir.size()));
 
     // Log how long the linear solve takes.
     LOG_SCOPE("sensitivity_solve()", "StabilizedSensitivity");
@@ -141,22 +180,34 @@ sensitivity_solve(MAST::AssemblyBase& assembly,
     while (continue_it) {
         
         // update the solution vector
-        std::ostringstream oss;
-        oss << _sol_name_root << _index1;
-        sys.read_in_vector(sol, _sol_dir, oss.str(), true);
-
-        // assemble the Jacobian matrix
-        _assemble_mass = false;
-        assembly.residual_and_jacobian(sol, nullptr, &M1, sys);
-        J_int.add(this->dt, M1);
-        
-        // assemble the mass matrix
-        _assemble_mass = true;
-        assembly.residual_and_jacobian(sol, nullptr, &M1, sys);
-        Mat M_avg_mat = dynamic_cast<libMesh::PetscMatrix<Real>&>(M_avg).mat();
-        PetscErrorCode ierr = MatScale(M_avg_mat, (sys.time - _t0 - this->dt)/(sys.time - _t0));
-        CHKERRABORT(sys.comm().get(), ierr);
-        M_avg.add(this->dt/(sys.time - _t0), M1);
+        _read_primal_solution(sys, _index1);
+
+        if (_time_invariant_operators) {
+            
+            if (!_jac_cache)
+                _assemble_time_invariant_operators(assembly, sys);
+            
+            J_int.add(this->dt, *_jac_cache);
+            
+            // the time-average of a constant mass matrix is the matrix itself
+            M_avg.zero();
+            M_avg.add(1., *_mass_cache);
+        }
+        else {
+            
+            // assemble the Jacobian matrix
+            _assemble_mass = false;
+            assembly.residual_and_jacobian(sol, nullptr, &M1, sys);
+            J_int.add(this->dt, M1);
+            
+            // assemble the mass matrix
+            _assemble_mass = true;
+            assembly.residual_and_jacobian(sol, nullptr, &M1, sys);
+            Mat M_avg_mat = dynamic_cast<libMesh::PetscMatrix<Real>&>(M_avg).mat();
+            PetscErrorCode ierr = MatScale(M_avg_mat, (sys.time - _t0 - this->dt)/(sys.time - _t0));
+            CHKERRABORT(sys.comm().get(), ierr);
+            M_avg.add(this->dt/(sys.time - _t0), M1);
+        }
         
         // close the quantities
         J_int.close();
@@ -198,12 +249,37 @@ sensitivity_solve(MAST::AssemblyBase& assembly,
         // Solve the linear system.
         libMesh::SparseMatrix<Real> * pc = sys.request_matrix("Preconditioner");
         
+        // for time-invariant operators the matrix depends only on the time
+        // step and the number of steps in this interval. A dedicated linear
+        // solver is used so that its preconditioner can be reused whenever
+        // these are the same as for the previous solve.
+        libMesh::LinearSolver<Real>* linear_solver = sys.linear_solver.get();
+        
+        if (_time_invariant_operators) {
+            
+            if (!_linear_solver) {
+                
+                _linear_solver.reset(libMesh::LinearSolver<Real>::build(sys.comm()).release());
+                if (libMesh::on_command_line("--solver_system_names"))
+                    _linear_solver->init((sys.name()+"_").c_str());
+                else
+                    _linear_solver->init();
+                _pc_n_steps = 0;
+            }
+            
+            linear_solver = _linear_solver.get();
+            linear_solver->reuse_preconditioner(_pc_n_steps == _index1 - _index0 &&
+                                                _pc_dt      == this->dt);
+            _pc_n_steps = _index1 - _index0;
+            _pc_dt      = this->dt;
+        }
+        
         std::pair<unsigned int, Real> rval =
-        sys.linear_solver->solve (M1, pc,
-                                  dsol1,
-                                  rhs,
-                                  solver_params.second,
-                                  solver_params.first);
+        linear_solver->solve (M1, pc,
+                              dsol1,
+                              rhs,
+                              solver_params.second,
+                              solver_params.first);
         
         // The linear solver may not have fit our constraints exactly
 #ifdef LIBMESH_ENABLE_CONSTRAINTS
@@ -216,8 +292,20 @@ sensitivity_solve(MAST::AssemblyBase& assembly,
         // works for beta = 1 (backward Euler).
         if (!_use_eigenvalue_stabilization && this->beta == 1.)
             amp = _compute_norm_amplification_factor(rhs, *vec1);
-        else
-            amp = _compute_eig_amplification_factor(*M0, M1);
+        else {
+            
+            bool
+            converged = false;
+            
+            if (_use_power_iteration)
+                amp = _compute_power_amplification_factor(*linear_solver, *M0, M1, converged);
+            
+            if (!converged)
+                amp = _compute_eig_amplification_factor(*M0, M1);
+        }
+        
+        if (_time_invariant_operators)
+            linear_solver->reuse_preconditioner(false);
         
         if (amp <= this->max_amp ||  _index1 > max_index) {
             
@@ -281,9 +369,7 @@ evaluate_q_sens_for_previous_interval(MAST::AssemblyBase& assembly,
     for (unsigned int i=_index0; i<_index1; i++) {
         
         // update the nonlinear solution
-        std::ostringstream oss;
-        oss << _sol_name_root << _index1;
-        sys.read_in_vector(sol, _sol_dir, oss.str(), true);
+        _read_primal_solution(sys, _index1);
         
         sys.time  = _t0 + this->dt * ( i - _index0);
         
@@ -558,3 +644,139 @@ _compute_eig_amplification_factor(libMesh::SparseMatrix<Real>& A,
     libMesh::out << "amp coeffs: " << amp << std::endl;
     return amp;
 }
+
+
+
+void
+MAST::StabilizedFirstOrderNewmarkTransientSensitivitySolver::
+_read_primal_solution(MAST::NonlinearSystem& sys,
+                      unsigned int index) {
+    
+    if (_checkpoint_store) {
+        
+        bool
+        found = _checkpoint_store->retrieve(index, *sys.solution);
+        if (!found)
+            libmesh_error_msg("Checkpoint not found for time step: " << index);
+        
+        // localize into the ghosted solution used for assembly
+        sys.update();
+    }
+    else {
+        
+        std::ostringstream oss;
+        oss << _sol_name_root << index;
+        sys.read_in_vector(this->solution(), _sol_dir, oss.str(), true);
+    }
+}
+
+
+
+Real
+MAST::StabilizedFirstOrderNewmarkTransientSensitivitySolver::
+_compute_power_amplification_factor(libMesh::LinearSolver<Real>& solver,
+                                    libMesh::SparseMatrix<Real>& A,
+                                    libMesh::SparseMatrix<Real>& B,
+                                    bool& converged) {
+    
+    libmesh_assert(_system);
+    
+    MAST::NonlinearSystem&
+    sys = _system->system();
+    
+    libMesh::NumericVector<Real>
+    &dsol = this->solution_sensitivity();
+    
+    // start from the dominant vector of the previous estimate, if available
+    if (!_amp_vec || _amp_vec->size() != dsol.size()) {
+        
+        _amp_vec.reset(dsol.zero_clone().release());
+        _amp_vec->add(1.);
+        _amp_vec->close();
+    }
+    
+    std::unique_ptr<libMesh::NumericVector<Real>>
+    Ax(dsol.zero_clone().release()),
+    y(dsol.zero_clone().release());
+    
+    std::pair<unsigned int, Real>
+    solver_params = sys.get_linear_solve_parameters();
+    
+    Real
+    amp      = 0.,
+    amp_prev = 0.,
+    nrm      = _amp_vec->l2_norm();
+    
+    converged = false;
+    
+    if (nrm == 0.)
+        return amp;
+    _amp_vec->scale(1./nrm);
+    
+    // B has just been factored for the sensitivity solve, so the
+    // preconditioner is reused for all iterations
+    solver.reuse_preconditioner(true);
+    
+    for (unsigned int i=0; i<power_iteration_max_its; i++) {
+        
+        // y = B^{-1} A x
+        A.vector_mult(*Ax, *_amp_vec);
+        solver.solve(B, *y, *Ax, solver_params.second, solver_params.first);
+        
+        amp = y->l2_norm();
+        
+        if (amp == 0.) {
+            
+            converged = true;
+            break;
+        }
+        
+        _amp_vec->zero();
+        _amp_vec->add(1./amp, *y);
+        _amp_vec->close();
+        
+        if (i > 0 && std::fabs(amp - amp_prev) <= power_iteration_tol * amp) {
+            
+            converged = true;
+            break;
+        }
+        
+        amp_prev = amp;
+    }
+    
+    solver.reuse_preconditioner(false);
+    
+    if (converged)
+        libMesh::out << "amp coeffs: " << amp << std::endl;
+    
+    return amp;
+}
+
+
+
+void
+MAST::StabilizedFirstOrderNewmarkTransientSensitivitySolver::
+_assemble_time_invariant_operators(MAST::AssemblyBase& assembly,
+                                   MAST::NonlinearSystem& sys) {
+    
+    libMesh::NumericVector<Real>
+    &sol = this->solution();
+    
+    _jac_cache.reset(libMesh::SparseMatrix<Real>::build(sys.comm()).release());
+    _mass_cache.reset(libMesh::SparseMatrix<Real>::build(sys.comm()).release());
+    
+    sys.get_dof_map().attach_matrix(*_jac_cache);
+    sys.get_dof_map().attach_matrix(*_mass_cache);
+    _jac_cache->init();
+    _mass_cache->init();
+    
+    // assemble the Jacobian matrix
+    _assemble_mass = false;
+    assembly.residual_and_jacobian(sol, nullptr, _jac_cache.get(), sys);
+    _jac_cache->close();
+    
+    // assemble the mass matrix
+    _assemble_mass = true;
+    assembly.residual_and_jacobian(sol, nullptr, _mass_cache.get(), sys);
+    _mass_cache->close();
+}
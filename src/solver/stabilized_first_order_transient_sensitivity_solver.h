@@ -20,9 +20,16 @@
 #ifndef __mast__stabilized_first_order_newmark_transient_sensitivity_solver__
 #define __mast__stabilized_first_order_newmark_transient_sensitivity_solver__
 
+// C++ includes
+#include <memory>
+
 // MAST includes
 #include "solver/transient_solver_base.h"
 
+// libMesh includes
+#include "libmesh/sparse_matrix.h"
+#include "libmesh/linear_solver.h"
+
 
 namespace MAST {
     
@@ -57,6 +64,39 @@ namespace MAST {
          */
         void set_eigenvalue_stabilization(bool f);
         
+        /*!
+         *   declares that the Jacobian and mass matrices do not change with
+         *   the solution or time, as for linear problems. If true, the two
+         *   matrices are assembled once and reused in all subsequent time
+         *   steps, and the preconditioner of the linear solver is reused
+         *   for steps with the same operator, i.e. the same time step and
+         *   number of steps in the stabilization interval. Call
+         *   clear_operator_cache() if the operators are changed.
+         */
+        void set_time_invariant_operators(bool f);
+        
+        /*!
+         *   clears the matrices and preconditioner stored for time-invariant
+         *   operators.
+         */
+        void clear_operator_cache();
+        
+        /*!
+         *   sets if the amplification factor for eigenvalue stabilization is
+         *   estimated with a power iteration, warm-started from the dominant
+         *   vector of the previous estimate and using the preconditioner of
+         *   the current linear solve. The eigensolver is used if the power
+         *   iteration does not converge within \p power_iteration_max_its.
+         */
+        void set_power_iteration_amplification(bool f);
+        
+        /*!
+         *   maximum number of iterations and relative tolerance on the
+         *   amplification factor for the power iteration
+         */
+        unsigned int power_iteration_max_its;
+        Real         power_iteration_tol;
+        
         /*!
          *   sets the directory where the nonlinear solutions are stored. The
          *   name of the solution is assumed to be file_root + std::string(index)
@@ -168,14 +208,57 @@ namespace MAST {
         Real _compute_eig_amplification_factor(libMesh::SparseMatrix<Real>& A,
                                                libMesh::SparseMatrix<Real>& B);
 
+        /*!
+         *   estimates the largest magnitude eigenvalue of \f$ B^{-1} A \f$
+         *   with a power iteration using \p solver, which should have been
+         *   set up for \p B. @returns false in \p converged if the
+         *   iterations did not converge.
+         */
+        Real _compute_power_amplification_factor(libMesh::LinearSolver<Real>& solver,
+                                                 libMesh::SparseMatrix<Real>& A,
+                                                 libMesh::SparseMatrix<Real>& B,
+                                                 bool& converged);
+
+        /*!
+         *   assembles the Jacobian and mass matrices that are reused for
+         *   time-invariant operators.
+         */
+        void _assemble_time_invariant_operators(MAST::AssemblyBase& assembly,
+                                                MAST::NonlinearSystem& sys);
+
+        /*!
+         *   reads the nonlinear solution for time step \p index into the
+         *   system solution. The attached checkpoint store is used if
+         *   available, otherwise the solution is read from disk.
+         */
+        void _read_primal_solution(MAST::NonlinearSystem& sys,
+                                   unsigned int index);
+
 
         bool         _use_eigenvalue_stabilization;
+        bool         _time_invariant_operators;
+        bool         _use_power_iteration;
         bool         _assemble_mass;
         Real         _t0;
         unsigned int _index0, _index1;
         
         // nonlinear solutions are stored in this directory
         std::string  _sol_name_root, _sol_dir;
+        
+        // Jacobian and mass matrices stored for time-invariant operators
+        std::unique_ptr<libMesh::SparseMatrix<Real>> _jac_cache, _mass_cache;
+        
+        // linear solver that retains its preconditioner across time steps
+        // for time-invariant operators
+        std::unique_ptr<libMesh::LinearSolver<Real>> _linear_solver;
+        
+        // time step and number of steps in the interval for the operator
+        // used to compute the current preconditioner of _linear_solver
+        Real         _pc_dt;
+        unsigned int _pc_n_steps;
+        
+        // dominant vector from the previous power iteration
+        std::unique_ptr<libMesh::NumericVector<Real>> _amp_vec;
     };
     
 }
@@ -0,0 +1,378 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+// C++ includes
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cmath>
+
+// MAST includes
+#include "solver/transient_checkpoint_store.h"
+
+// libMesh includes
+#include "libmesh/utility.h"
+
+
+MAST::TransientCheckpointStoreBase::TransientCheckpointStoreBase():
+_tol   (0.) {
+    
+}
+
+
+
+MAST::TransientCheckpointStoreBase::~TransientCheckpointStoreBase() {
+    
+}
+
+
+
+void
+MAST::TransientCheckpointStoreBase::set_compression_tolerance(Real tol) {
+    
+    libmesh_assert_greater_equal(tol, 0.);
+    
+    _tol = tol;
+}
+
+
+
+void
+MAST::TransientCheckpointStoreBase::_encode(const libMesh::NumericVector<Real>& vec,
+                                            Checkpoint& c) const {
+    
+    const libMesh::numeric_index_type
+    first = vec.first_local_index(),
+    last  = vec.last_local_index();
+    
+    c.first_local_index = first;
+    c.dvals.clear();
+    c.fvals.clear();
+    
+    bool
+    if_single = _tol > 0.;
+    
+    if (if_single) {
+        
+        c.fvals.resize(last-first);
+        
+        for (libMesh::numeric_index_type i=first; i<last; i++) {
+            
+            const Real v = vec(i);
+            c.fvals[i-first] = (float)v;
+            
+            // values that cannot be represented within the tolerance
+            // are stored in double precision
+            if (std::fabs(v - (Real)c.fvals[i-first]) > _tol) {
+                
+                if_single = false;
+                c.fvals.clear();
+                break;
+            }
+        }
+    }
+    
+    if (!if_single) {
+        
+        c.dvals.resize(last-first);
+        
+        for (libMesh::numeric_index_type i=first; i<last; i++)
+            c.dvals[i-first] = vec(i);
+    }
+}
+
+
+
+void
+MAST::TransientCheckpointStoreBase::_decode(const Checkpoint& c,
+                                            libMesh::NumericVector<Real>& vec) const {
+    
+    // the vector is expected to have the same partitioning as the
+    // stored vector. This is checked in optimized builds as well, since
+    // a mismatch would silently restore a wrong state.
+    if (vec.type() == libMesh::SERIAL)
+        libmesh_error_msg("Checkpoint cannot be restored to a SERIAL vector.");
+    
+    const libMesh::numeric_index_type
+    first = vec.first_local_index(),
+    last  = vec.last_local_index();
+    
+    if (first != c.first_local_index)
+        libmesh_error_msg("Checkpoint partitioning mismatch: stored first index "
+                          << c.first_local_index
+                          << ", vector first index " << first);
+    
+    if (c.fvals.size()) {
+        
+        if (c.fvals.size() != last-first)
+            libmesh_error_msg("Checkpoint length mismatch: stored "
+                              << c.fvals.size() << " values, vector has "
+                              << last-first << " local entries");
+        
+        for (libMesh::numeric_index_type i=first; i<last; i++)
+            vec.set(i, c.fvals[i-first]);
+    }
+    else {
+        
+        if (c.dvals.size() != last-first)
+            libmesh_error_msg("Checkpoint length mismatch: stored "
+                              << c.dvals.size() << " values, vector has "
+                              << last-first << " local entries");
+        
+        for (libMesh::numeric_index_type i=first; i<last; i++)
+            vec.set(i, c.dvals[i-first]);
+    }
+    
+    vec.close();
+}
+
+
+
+
+MAST::MemoryCheckpointStore::MemoryCheckpointStore(const unsigned int capacity):
+MAST::TransientCheckpointStoreBase(),
+_capacity  (capacity) {
+    
+    libmesh_assert_greater(capacity, 0);
+}
+
+
+
+MAST::MemoryCheckpointStore::~MemoryCheckpointStore() {
+    
+}
+
+
+
+void
+MAST::MemoryCheckpointStore::store(const unsigned int index,
+                                   const libMesh::NumericVector<Real>& vec) {
+    
+    // if a checkpoint exists for this index, it is replaced
+    this->remove(index);
+    
+    // replace the oldest checkpoint if the buffer is full
+    if (_order.size() == _capacity) {
+        
+        _data.erase(_order.front());
+        _order.pop_front();
+    }
+    
+    this->_encode(vec, _data[index]);
+    _order.push_back(index);
+}
+
+
+
+bool
+MAST::MemoryCheckpointStore::retrieve(const unsigned int index,
+                                      libMesh::NumericVector<Real>& vec) {
+    
+    std::map<unsigned int, MAST::TransientCheckpointStoreBase::Checkpoint>::const_iterator
+    it = _data.find(index);
+    
+    if (it == _data.end())
+        return false;
+    
+    this->_decode(it->second, vec);
+    
+    return true;
+}
+
+
+
+bool
+MAST::MemoryCheckpointStore::has_checkpoint(const unsigned int index) const {
+    
+    return _data.count(index);
+}
+
+
+
+void
+MAST::MemoryCheckpointStore::remove(const unsigned int index) {
+    
+    if (!_data.erase(index))
+        return;
+    
+    std::deque<unsigned int>::iterator
+    it  = _order.begin(),
+    end = _order.end();
+    
+    for ( ; it != end; it++)
+        if (*it == index) {
+            _order.erase(it);
+            break;
+        }
+}
+
+
+
+void
+MAST::MemoryCheckpointStore::clear() {
+    
+    _data.clear();
+    _order.clear();
+}
+
+
+
+
+MAST::DiskCheckpointStore::DiskCheckpointStore(const libMesh::Parallel::Communicator& comm,
+                                               const std::string& dir,
+                                               const std::string& file_root):
+MAST::TransientCheckpointStoreBase(),
+_comm       (comm),
+_dir        (dir),
+_file_root  (file_root) {
+    
+    // the directory is expected to be on a disk local to each processor.
+    // Hence, each processor makes sure that it exists.
+    libMesh::Utility::mkdir(_dir.c_str());
+}
+
+
+
+MAST::DiskCheckpointStore::~DiskCheckpointStore() {
+    
+}
+
+
+
+std::string
+MAST::DiskCheckpointStore::_file_name(const unsigned int index) const {
+    
+    std::ostringstream oss;
+    oss << _dir << "/" << _file_root << "_" << index << "." << _comm.rank();
+    
+    return oss.str();
+}
+
+
+
+void
+MAST::DiskCheckpointStore::store(const unsigned int index,
+                                 const libMesh::NumericVector<Real>& vec) {
+    
+    MAST::TransientCheckpointStoreBase::Checkpoint c;
+    this->_encode(vec, c);
+    
+    std::ofstream
+    file(this->_file_name(index).c_str(), std::ios::binary | std::ios::trunc);
+    
+    if (!file)
+        libmesh_error_msg("Unable to open file: " + this->_file_name(index));
+    
+    // header: first local index, number of values and precision
+    const unsigned long long
+    first = c.first_local_index,
+    n     = c.fvals.size() ? c.fvals.size() : c.dvals.size();
+    
+    const char
+    if_single = c.fvals.size() ? 1 : 0;
+    
+    file.write(reinterpret_cast<const char*>(&first), sizeof(first));
+    file.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    file.write(&if_single, sizeof(if_single));
+    
+    if (if_single)
+        file.write(reinterpret_cast<const char*>(c.fvals.data()), n*sizeof(float));
+    else
+        file.write(reinterpret_cast<const char*>(c.dvals.data()), n*sizeof(double));
+    
+    if (!file)
+        libmesh_error_msg("Error writing file: " + this->_file_name(index));
+    
+    _indices.insert(index);
+}
+
+
+
+bool
+MAST::DiskCheckpointStore::retrieve(const unsigned int index,
+                                    libMesh::NumericVector<Real>& vec) {
+    
+    std::ifstream
+    file(this->_file_name(index).c_str(), std::ios::binary);
+    
+    if (!file)
+        return false;
+    
+    unsigned long long
+    first = 0,
+    n     = 0;
+    
+    char
+    if_single = 0;
+    
+    file.read(reinterpret_cast<char*>(&first), sizeof(first));
+    file.read(reinterpret_cast<char*>(&n), sizeof(n));
+    file.read(&if_single, sizeof(if_single));
+    
+    MAST::TransientCheckpointStoreBase::Checkpoint c;
+    c.first_local_index = first;
+    
+    if (if_single) {
+        c.fvals.resize(n);
+        file.read(reinterpret_cast<char*>(c.fvals.data()), n*sizeof(float));
+    }
+    else {
+        c.dvals.resize(n);
+        file.read(reinterpret_cast<char*>(c.dvals.data()), n*sizeof(double));
+    }
+    
+    if (!file)
+        libmesh_error_msg("Error reading file: " + this->_file_name(index));
+    
+    this->_decode(c, vec);
+    
+    return true;
+}
+
+
+
+bool
+MAST::DiskCheckpointStore::has_checkpoint(const unsigned int index) const {
+    
+    return (bool)std::ifstream(this->_file_name(index).c_str());
+}
+
+
+
+void
+MAST::DiskCheckpointStore::remove(const unsigned int index) {
+    
+    std::remove(this->_file_name(index).c_str());
+    _indices.erase(index);
+}
+
+
+
+void
+MAST::DiskCheckpointStore::clear() {
+    
+    std::set<unsigned int>::const_iterator
+    it  = _indices.begin(),
+    end = _indices.end();
+    
+    for ( ; it != end; it++)
+        std::remove(this->_file_name(*it).c_str());
+    
+    _indices.clear();
+}
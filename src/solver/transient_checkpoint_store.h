@@ -0,0 +1,236 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef __mast__transient_checkpoint_store_h__
+#define __mast__transient_checkpoint_store_h__
+
+// C++ includes
+#include <map>
+#include <deque>
+#include <set>
+#include <vector>
+#include <string>
+
+// MAST includes
+#include "base/mast_data_types.h"
+
+// libMesh includes
+#include "libmesh/numeric_vector.h"
+#include "libmesh/parallel.h"
+
+
+namespace MAST {
+    
+    /*!
+     *   Base class for storage of the solution history of a transient
+     *   analysis, for use by the sensitivity and adjoint solvers that need
+     *   to revisit the primal solution at previous time steps. Each
+     *   processor stores only the locally owned entries of the vector
+     *   in the native dof ordering, so that no communication or
+     *   renumbering of the mesh is needed to store or retrieve a
+     *   checkpoint.
+     *
+     *   If a compression tolerance is specified, the values are stored in
+     *   single precision if all local entries can be represented with
+     *   an absolute error less than the tolerance. Otherwise, the values
+     *   are stored without loss in double precision.
+     */
+    class TransientCheckpointStoreBase {
+        
+    public:
+        
+        TransientCheckpointStoreBase();
+        
+        virtual ~TransientCheckpointStoreBase();
+        
+        /*!
+         *   sets the absolute tolerance on the error of the stored values.
+         *   A value of zero, which is the default, stores the values without
+         *   loss.
+         */
+        void set_compression_tolerance(Real tol);
+        
+        /*!
+         *   stores the vector \p vec as checkpoint for time step \p index.
+         *   An existing checkpoint with the same index is replaced.
+         */
+        virtual void store(const unsigned int index,
+                           const libMesh::NumericVector<Real>& vec) = 0;
+        
+        /*!
+         *   retrieves the checkpoint for time step \p index in \p vec, which
+         *   should be a parallel or ghosted vector with the same partitioning
+         *   as the vector that was stored. @returns false if the checkpoint
+         *   is not available.
+         */
+        virtual bool retrieve(const unsigned int index,
+                              libMesh::NumericVector<Real>& vec) = 0;
+        
+        /*!
+         *   @returns true if the checkpoint for time step \p index is
+         *   available.
+         */
+        virtual bool has_checkpoint(const unsigned int index) const = 0;
+        
+        /*!
+         *   removes the checkpoint for time step \p index, if it exists.
+         */
+        virtual void remove(const unsigned int index) = 0;
+        
+        /*!
+         *   removes all checkpoints.
+         */
+        virtual void clear() = 0;
+        
+    protected:
+        
+        /*!
+         *   local entries of a checkpoint. Only one of the two value vectors
+         *   is used depending on the precision of storage.
+         */
+        struct Checkpoint {
+            
+            libMesh::numeric_index_type   first_local_index;
+            std::vector<double>           dvals;
+            std::vector<float>            fvals;
+        };
+        
+        /*!
+         *   copies the local entries of \p vec to \p c
+         */
+        void _encode(const libMesh::NumericVector<Real>& vec,
+                     Checkpoint& c) const;
+        
+        /*!
+         *   copies the entries of \p c to the local entries of \p vec
+         */
+        void _decode(const Checkpoint& c,
+                     libMesh::NumericVector<Real>& vec) const;
+        
+        /*!
+         *   absolute tolerance for storage in single precision
+         */
+        Real _tol;
+    };
+    
+    
+    
+    /*!
+     *   Stores the checkpoints in memory in a ring buffer of fixed capacity.
+     *   Once the capacity is reached, the oldest checkpoint is replaced by
+     *   the new checkpoint.
+     */
+    class MemoryCheckpointStore:
+    public MAST::TransientCheckpointStoreBase {
+        
+    public:
+        
+        MemoryCheckpointStore(const unsigned int capacity);
+        
+        virtual ~MemoryCheckpointStore();
+        
+        virtual void store(const unsigned int index,
+                           const libMesh::NumericVector<Real>& vec);
+        
+        virtual bool retrieve(const unsigned int index,
+                              libMesh::NumericVector<Real>& vec);
+        
+        virtual bool has_checkpoint(const unsigned int index) const;
+        
+        virtual void remove(const unsigned int index);
+        
+        virtual void clear();
+        
+    protected:
+        
+        /*!
+         *   maximum number of checkpoints stored
+         */
+        const unsigned int                                _capacity;
+        
+        /*!
+         *   indices of stored checkpoints in the order of storage
+         */
+        std::deque<unsigned int>                          _order;
+        
+        /*!
+         *   map of index and checkpoint data
+         */
+        std::map<unsigned int, MAST::TransientCheckpointStoreBase::Checkpoint> _data;
+    };
+    
+    
+    
+    /*!
+     *   Stores the checkpoints on disk, with one binary file per processor
+     *   and time step. The files contain the locally owned entries in
+     *   native dof ordering, so this should be used with a directory on
+     *   a local disk and the same mesh partitioning for write and read.
+     */
+    class DiskCheckpointStore:
+    public MAST::TransientCheckpointStoreBase {
+        
+    public:
+        
+        /*!
+         *   the files are written in directory \p dir, which is
+         *   created if it does not exist, with names
+         *   \p file_root_<index>.<rank>.
+         */
+        DiskCheckpointStore(const libMesh::Parallel::Communicator& comm,
+                            const std::string& dir,
+                            const std::string& file_root);
+        
+        virtual ~DiskCheckpointStore();
+        
+        virtual void store(const unsigned int index,
+                           const libMesh::NumericVector<Real>& vec);
+        
+        virtual bool retrieve(const unsigned int index,
+                              libMesh::NumericVector<Real>& vec);
+        
+        virtual bool has_checkpoint(const unsigned int index) const;
+        
+        virtual void remove(const unsigned int index);
+        
+        virtual void clear();
+        
+    protected:
+        
+        /*!
+         *   @returns the name of the file of this processor for
+         *   checkpoint \p index
+         */
+        std::string _file_name(const unsigned int index) const;
+        
+        const libMesh::Parallel::Communicator&   _comm;
+        
+        const std::string                        _dir;
+        
+        const std::string                        _file_root;
+        
+        /*!
+         *   indices of checkpoints written by this object
+         */
+        std::set<unsigned int>                   _indices;
+    };
+}
+
+
+#endif // __mast__transient_checkpoint_store_h__
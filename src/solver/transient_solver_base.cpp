@@ -19,6 +19,7 @@
 
 // MAST includes
 #include "solver/transient_solver_base.h"
+#include "solver/transient_checkpoint_store.h"
 #include "base/transient_assembly_elem_operations.h"
 #include "base/assembly_base.h"
 #include "base/transient_assembly.h"
@@ -42,7 +43,8 @@ _first_sensitivity_step         (true),
 _ode_order                      (o),
 _n_iters_to_store               (n),
 _assembly_ops                   (nullptr),
-_if_highest_derivative_solution (false) {
+_if_highest_derivative_solution (false),
+_checkpoint_store               (nullptr) {
 
 }
 
@@ -65,6 +67,33 @@ MAST::TransientSolverBase::set_assembly(MAST::AssemblyBase &assembly) {
 }
 
 
+void
+MAST::TransientSolverBase::set_checkpoint_store(MAST::TransientCheckpointStoreBase& store) {
+    
+    _checkpoint_store = &store;
+}
+
+
+
+void
+MAST::TransientSolverBase::clear_checkpoint_store() {
+    
+    _checkpoint_store = nullptr;
+}
+
+
+
+void
+MAST::TransientSolverBase::store_solution_checkpoint(unsigned int index) {
+    
+    libmesh_assert(_system);
+    libmesh_assert(_checkpoint_store);
+    
+    _checkpoint_store->store(index, *_system->system().solution);
+}
+
+
+
 void
 MAST::TransientSolverBase::clear_assembly() {
     
@@ -35,6 +35,7 @@ namespace MAST {
     class TransientAssemblyElemOperations;
     class ElementBase;
     class NonlinearSystem;
+    class TransientCheckpointStoreBase;
     
     
     class TransientSolverBase:
@@ -71,6 +72,32 @@ namespace MAST {
          */
         virtual void clear_elem_operation_object();
         
+        /*!
+         *   Attaches a checkpoint store that is used, instead of files on
+         *   disk, to save and retrieve the primal solution at each time
+         *   step during sensitivity and adjoint sweeps. The store is
+         *   owned by the caller and must outlive this solver.
+         */
+        void set_checkpoint_store(MAST::TransientCheckpointStoreBase& store);
+        
+        /*!
+         *   Detaches the checkpoint store, if one was attached.
+         */
+        void clear_checkpoint_store();
+        
+        /*!
+         *   @returns the attached checkpoint store, or \p nullptr.
+         */
+        MAST::TransientCheckpointStoreBase* get_checkpoint_store() {
+            return _checkpoint_store;
+        }
+        
+        /*!
+         *   Saves the current solution of the system as the checkpoint
+         *   for time step \p index. Requires a checkpoint store.
+         */
+        void store_solution_checkpoint(unsigned int index);
+        
         /*!
          *   time step
          */
@@ -337,6 +364,11 @@ namespace MAST {
          *    derivative solution, or to evaluate solution at current time step.
          */
         bool   _if_highest_derivative_solution;
+        
+        /*!
+         *   checkpoint store for primal solutions, if attached
+         */
+        MAST::TransientCheckpointStoreBase* _checkpoint_store;
 
     };
 
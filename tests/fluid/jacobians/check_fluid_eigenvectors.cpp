@@ -29,6 +29,7 @@
 
 // MAST includes
 #include "base/mast_data_types.h"
+#include "mesh/fe_cache.h"
 
 // libMesh includes
 #include "libmesh/libmesh.h"
@@ -51,6 +52,8 @@ struct GlobalTestFixture {
     
     ~GlobalTestFixture() {
         
+        // pooled finite element objects are deleted before libMesh is finalized
+        MAST::FECache::clear_all();
         delete _libmesh_init;
     }
     
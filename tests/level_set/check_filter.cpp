@@ -0,0 +1,271 @@
+/*
+ * MAST: Multidisciplinary-design Adaptation and Sensitivity Toolkit
+ * Copyright (C) 2013-2019  Manav Bhatia
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE MAST_TESTS
+#include <boost/test/unit_test.hpp>
+#include <boost/version.hpp>
+
+// C++ includes
+#include <memory>
+#include <set>
+#include <cmath>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "level_set/filter_base.h"
+#include "mesh/fe_cache.h"
+
+// libMesh includes
+#include "libmesh/libmesh.h"
+#include "libmesh/replicated_mesh.h"
+#include "libmesh/mesh_generation.h"
+#include "libmesh/equation_systems.h"
+#include "libmesh/explicit_system.h"
+#include "libmesh/fe_type.h"
+#include "libmesh/numeric_vector.h"
+
+
+libMesh::LibMeshInit     *_libmesh_init         = nullptr;
+const Real                _tol                  = 1.e-10;
+
+struct GlobalTestFixture {
+    
+    GlobalTestFixture() {
+        
+        // create the libMeshInit function
+        _libmesh_init =
+        new libMesh::LibMeshInit(boost::unit_test::framework::master_test_suite().argc,
+                                 boost::unit_test::framework::master_test_suite().argv);
+    }
+    
+    ~GlobalTestFixture() {
+        
+        // pooled finite element objects are deleted before libMesh is finalized
+        MAST::FECache::clear_all();
+        delete _libmesh_init;
+    }
+    
+};
+
+
+#if BOOST_VERSION > 106100
+BOOST_TEST_GLOBAL_FIXTURE( GlobalTestFixture );
+#else
+BOOST_GLOBAL_FIXTURE( GlobalTestFixture );
+#endif
+
+
+// Test includes
+#include "base/test_comparisons.h"
+
+
+struct BuildFilter {
+    
+    libMesh::ReplicatedMesh*     _mesh;
+    libMesh::EquationSystems*    _eq_sys;
+    libMesh::ExplicitSystem*     _sys;
+    MAST::FilterBase*            _filter;
+    std::set<unsigned int>       _dv_dof_ids;
+    Real                         _radius;
+    
+    /*!
+     *   filter matrix computed by comparing the distance between all
+     *   pairs of nodes. Rows of dofs that are not design variables have
+     *   a unit diagonal.
+     */
+    RealMatrixX                  _B;
+    
+    BuildFilter():
+    _mesh    (nullptr),
+    _eq_sys  (nullptr),
+    _sys     (nullptr),
+    _filter  (nullptr),
+    _radius  (0.27) {
+        
+        _mesh   = new libMesh::ReplicatedMesh(_libmesh_init->comm());
+        
+        // a non-square domain and unequal divisions are used so that the
+        // bins of the neighbor search are not aligned with the nodes
+        libMesh::MeshTools::Generation::build_square(*_mesh,
+                                                     13, 7,
+                                                     0., 1.3,
+                                                     0., 0.6,
+                                                     libMesh::QUAD4);
+        
+        _eq_sys = new libMesh::EquationSystems(*_mesh);
+        _sys    = &(_eq_sys->add_system<libMesh::ExplicitSystem>("phi"));
+        _sys->add_variable("phi", libMesh::FEType(libMesh::FIRST, libMesh::LAGRANGE));
+        _eq_sys->init();
+        
+        const unsigned int
+        n_dofs  = _sys->n_dofs(),
+        sys_num = _sys->number();
+        
+        // every fifth dof is not a design variable
+        for (unsigned int i=0; i<n_dofs; i++)
+            if (i%5)
+                _dv_dof_ids.insert(i);
+        
+        _filter = new MAST::FilterBase(*_sys, _radius, _dv_dof_ids);
+        
+        _B = RealMatrixX::Zero(n_dofs, n_dofs);
+        
+        libMesh::MeshBase::const_node_iterator
+        it_1   = _mesh->nodes_begin(),
+        end    = _mesh->nodes_end();
+        
+        for ( ; it_1 != end; it_1++) {
+            
+            const unsigned int
+            i = (*it_1)->dof_number(sys_num, 0, 0);
+            
+            if (!_dv_dof_ids.count(i)) {
+                
+                _B(i, i) = 1.;
+                continue;
+            }
+            
+            libMesh::MeshBase::const_node_iterator
+            it_2   = _mesh->nodes_begin();
+            
+            for ( ; it_2 != end; it_2++) {
+                
+                libMesh::Point d = **it_1 - **it_2;
+                
+                if (d.norm() <= _radius)
+                    _B(i, (*it_2)->dof_number(sys_num, 0, 0)) = _radius - d.norm();
+            }
+            
+            _B.row(i) /= _B.row(i).sum();
+        }
+    }
+    
+    ~BuildFilter() {
+        
+        delete _filter;
+        delete _eq_sys;
+        delete _mesh;
+    }
+    
+    
+    /*!
+     *   @returns a vector of arbitrary values
+     */
+    RealVectorX input_values() const {
+        
+        RealVectorX
+        v = RealVectorX::Zero(_sys->n_dofs());
+        
+        for (unsigned int i=0; i<v.size(); i++)
+            v(i) = std::sin(1.+3.*i) + 0.1*i;
+        
+        return v;
+    }
+    
+    
+    void copy(const RealVectorX& v, libMesh::NumericVector<Real>& vec) const {
+        
+        for (libMesh::dof_id_type i=vec.first_local_index(); i<vec.last_local_index(); i++)
+            vec.set(i, v(i));
+        vec.close();
+    }
+    
+    
+    RealVectorX copy(const libMesh::NumericVector<Real>& vec) const {
+        
+        std::vector<Real> vals;
+        vec.localize(vals);
+        
+        RealVectorX
+        v = RealVectorX::Zero(vals.size());
+        for (unsigned int i=0; i<vals.size(); i++)
+            v(i) = vals[i];
+        
+        return v;
+    }
+};
+
+
+
+BOOST_FIXTURE_TEST_SUITE(LevelSetFilter, BuildFilter)
+
+
+BOOST_AUTO_TEST_CASE(FilteredValuesSerial) {
+    
+    const RealVectorX
+    x  = this->input_values(),
+    y0 = _B * x;
+    
+    std::vector<Real>
+    in (x.size(), 0.),
+    out(x.size(), 0.);
+    
+    for (unsigned int i=0; i<x.size(); i++)
+        in[i] = x(i);
+    
+    _filter->compute_filtered_values(in, out);
+    
+    RealVectorX
+    y = RealVectorX::Zero(x.size());
+    for (unsigned int i=0; i<x.size(); i++)
+        y(i) = out[i];
+    
+    BOOST_CHECK(MAST::compare_vector(y0, y, _tol));
+}
+
+
+
+BOOST_AUTO_TEST_CASE(FilteredValuesDistributed) {
+    
+    const RealVectorX
+    x  = this->input_values(),
+    y0 = _B * x;
+    
+    std::unique_ptr<libMesh::NumericVector<Real> >
+    in (_sys->solution->zero_clone().release()),
+    out(_sys->solution->zero_clone().release());
+    
+    this->copy(x, *in);
+    _filter->compute_filtered_values(*in, *out);
+    
+    BOOST_CHECK(MAST::compare_vector(y0, this->copy(*out), _tol));
+}
+
+
+
+BOOST_AUTO_TEST_CASE(FilterTransposeProduct) {
+    
+    const RealVectorX
+    x  = this->input_values(),
+    y0 = _B.transpose() * x;
+    
+    std::unique_ptr<libMesh::NumericVector<Real> >
+    in (_sys->solution->zero_clone().release()),
+    out(_sys->solution->zero_clone().release());
+    
+    this->copy(x, *in);
+    _filter->compute_filter_transpose_product(*in, *out);
+    
+    BOOST_CHECK(MAST::compare_vector(y0, this->copy(*out), _tol));
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -17,111 +17,158 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
  */
 
-//#include "numerics/fem_operator_matrix.h"
-//
-//int main_fem_operator (int argc, char* const argv[])
-//{
-//    DenseRealVector vec1, vec2, shp;
-//    DenseRealMatrix mat1, mat2, bmat1, bmat2, tmp;
-//    
-//    vec1.resize(12); shp.resize(4);
-//    
-//    for (unsigned int i=0; i<shp.size(); i++)
-//        shp(i) = i+1;
-//    
-//    for (unsigned int i=0; i<vec1.size(); i++)
-//        vec1(i) = i+100;
-//    
-//    shp.print(libMesh::out);
-//    vec1.print(libMesh::out);
-//    mat1.print(libMesh::out);
-//    
-//    MAST::FEMOperatorMatrix b1, b2;
-//    b1.reinit(3, shp); b2.reinit(3, shp);
-//    bmat1.resize(3, shp.size()*3); bmat2.resize(3, shp.size()*3);
-//    for (unsigned int i=0; i<3; i++)
-//        for (unsigned int j=0; j<shp.size(); j++) {
-//            bmat1(i, i*shp.size()+j) = shp(j);
-//            bmat2(i, i*shp.size()+j) = shp(j);
-//        }
-//    
-//    
-//    vec2.resize(3);
-//    b1.vector_mult(vec2, vec1);
-//    libMesh::out << "FEMOperator: " << std::endl; vec2.print(libMesh::out);
-//    bmat1.vector_mult(vec2, vec1);
-//    libMesh::out << "Matrix:      " << std::endl; vec2.print(libMesh::out);
-//    
-//    vec1.resize(3);
-//    for (unsigned int i=0; i<vec1.size(); i++)
-//        vec1(i) = 100+i;
-//    vec2.resize(12);
-//    b1.vector_mult_transpose(vec2, vec1);
-//    libMesh::out << "FEMOperator: " << std::endl; vec2.print(libMesh::out);
-//    bmat1.vector_mult_transpose(vec2, vec1);
-//    libMesh::out << "Matrix:      " << std::endl; vec2.print(libMesh::out);
-//    
-//    
-//    mat1.resize(5,3);
-//    mat2.resize(5, 12);
-//    for (unsigned int i=0; i<5; i++)
-//        for (unsigned int j=0; j<3; j++)
-//            mat1(i,j) = (i+1)*(j+1);
-//    libMesh::out << "multiply matrix" << std::endl;  mat1.print();
-//    b1.left_multiply(mat2, mat1);
-//    libMesh::out << "FEMOperator: " << std::endl;  mat2.print();
-//    tmp = bmat1;
-//    tmp.left_multiply(mat1);
-//    libMesh::out << "Matrix:      " << std::endl;  tmp.print();
-//    
-//    
-//    mat1.resize(5,12);
-//    mat2.resize(5, 3);
-//    for (unsigned int i=0; i<5; i++)
-//        for (unsigned int j=0; j<12; j++)
-//            mat1(i,j) = (i+1)*(j+1);
-//    libMesh::out << "multiply matrix" << std::endl;  mat1.print();
-//    b1.left_multiply_transpose(mat2, mat1);
-//    libMesh::out << "FEMOperator: " << std::endl;  mat2.print();
-//    bmat1.get_transpose(tmp);
-//    tmp.left_multiply(mat1);
-//    libMesh::out << "Matrix:      " << std::endl;  tmp.print();
-//    
-//    
-//    mat1.resize(12,5);
-//    mat2.resize(3, 5);
-//    for (unsigned int i=0; i<12; i++)
-//        for (unsigned int j=0; j<5; j++)
-//            mat1(i,j) = (i+1)*(j+1);
-//    libMesh::out << "multiply matrix" << std::endl;  mat1.print();
-//    b1.right_multiply(mat2, mat1);
-//    libMesh::out << "FEMOperator: " << std::endl;  mat2.print();
-//    tmp = bmat1;
-//    tmp.right_multiply(mat1);
-//    libMesh::out << "Matrix:      " << std::endl;  tmp.print();
-//    
-//    
-//    mat1.resize(3, 5);
-//    mat2.resize(12, 5);
-//    for (unsigned int i=0; i<3; i++)
-//        for (unsigned int j=0; j<5; j++)
-//            mat1(i,j) = (i+1)*(j+1);
-//    libMesh::out << "multiply matrix" << std::endl;  mat1.print();
-//    b1.right_multiply_transpose(mat2, mat1);
-//    libMesh::out << "FEMOperator: " << std::endl;  mat2.print();
-//    bmat1.get_transpose(tmp);
-//    tmp.right_multiply(mat1);
-//    libMesh::out << "Matrix:      " << std::endl;  tmp.print();
-//    
-//    
-//    mat2.resize(12, 12);
-//    b1.right_multiply_transpose(mat2, b1);
-//    libMesh::out << "FEMOperator: " << std::endl;  mat2.print();
-//    bmat1.get_transpose(tmp);
-//    tmp.right_multiply(bmat1);
-//    libMesh::out << "Matrix:      " << std::endl;  tmp.print();
-//    
-//    return 0;
-//}
-//
-//
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE MAST_TESTS
+#include <boost/test/unit_test.hpp>
+
+// MAST includes
+#include "base/mast_data_types.h"
+#include "numerics/fem_operator_matrix.h"
+#include "base/test_comparisons.h"
+
+
+const Real _tol = 1.e-12;
+
+
+/*!
+ *   builds an operator with three interpolated and four discrete
+ *   variables, with some zero blocks, and the equivalent dense matrix
+ */
+struct BuildOperator {
+    
+    BuildOperator():
+    n_i   (3),
+    n_d   (4),
+    n_phi (4) {
+        
+        _B.reinit(n_i, n_d, n_phi);
+        _B_dense = RealMatrixX::Zero(n_i, n_d*n_phi);
+        
+        // fixed-size vectors are used the same way the element
+        // routines use them
+        Eigen::Matrix<Real, 4, 1> phi;
+        
+        for (unsigned int i=0; i<n_i; i++)
+            for (unsigned int j=0; j<n_d; j++) {
+                
+                // leave a few blocks empty
+                if ((i+j)%3 == 1)
+                    continue;
+                
+                for (unsigned int k=0; k<n_phi; k++)
+                    phi(k) = 1. + i + 0.5*j - 0.25*k*k;
+                
+                _B.set_shape_function(i, j, phi);
+                _B_dense.block(i, j*n_phi, 1, n_phi) = phi.transpose();
+            }
+    }
+    
+    const unsigned int n_i, n_d, n_phi;
+    MAST::FEMOperatorMatrix _B;
+    RealMatrixX             _B_dense;
+};
+
+
+RealMatrixX
+test_matrix(unsigned int m, unsigned int n) {
+    
+    RealMatrixX mat = RealMatrixX::Zero(m, n);
+    
+    for (unsigned int i=0; i<m; i++)
+        for (unsigned int j=0; j<n; j++)
+            mat(i,j) = (i+1.)*(j+1.) + 0.1*j;
+    
+    return mat;
+}
+
+
+
+BOOST_FIXTURE_TEST_SUITE  (FEMOperatorMatrixProducts, BuildOperator)
+
+
+BOOST_AUTO_TEST_CASE   (VectorProducts) {
+    
+    RealVectorX
+    v    = test_matrix(n_d*n_phi, 1).col(0),
+    w    = test_matrix(n_i, 1).col(0),
+    res1 = RealVectorX::Zero(n_i),
+    res2 = RealVectorX::Zero(n_d*n_phi);
+    
+    _B.vector_mult(res1, v);
+    BOOST_CHECK(MAST::compare_vector(_B_dense*v, res1, _tol));
+    
+    _B.vector_mult_transpose(res2, w);
+    BOOST_CHECK(MAST::compare_vector(_B_dense.transpose()*w, res2, _tol));
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (MatrixProducts) {
+    
+    const unsigned int n = n_d*n_phi;
+    
+    RealMatrixX
+    m1 = test_matrix(n, 5),
+    m2 = test_matrix(n_i, 5),
+    m3 = test_matrix(5, n_i),
+    m4 = test_matrix(5, n),
+    r1 = RealMatrixX::Zero(n_i, 5),
+    r2 = RealMatrixX::Zero(n, 5),
+    r3 = RealMatrixX::Zero(5, n),
+    r4 = RealMatrixX::Zero(5, n_i),
+    r5 = RealMatrixX::Zero(n, n);
+    
+    _B.right_multiply(r1, m1);
+    BOOST_CHECK(MAST::compare_matrix(_B_dense*m1, r1, _tol));
+    
+    _B.right_multiply_transpose(r2, m2);
+    BOOST_CHECK(MAST::compare_matrix(_B_dense.transpose()*m2, r2, _tol));
+    
+    _B.left_multiply(r3, m3);
+    BOOST_CHECK(MAST::compare_matrix(m3*_B_dense, r3, _tol));
+    
+    _B.left_multiply_transpose(r4, m4);
+    BOOST_CHECK(MAST::compare_matrix(m4*_B_dense.transpose(), r4, _tol));
+    
+    _B.right_multiply_transpose(r5, _B);
+    BOOST_CHECK(MAST::compare_matrix(_B_dense.transpose()*_B_dense, r5, _tol));
+}
+
+
+
+BOOST_AUTO_TEST_CASE   (ReinitReusesOperator) {
+    
+    // reinitialize the same operator as a block-diagonal interpolation
+    // operator, as is done at each quadrature point
+    RealVectorX
+    phi  = RealVectorX::Zero(n_phi);
+    for (unsigned int k=0; k<n_phi; k++)
+        phi(k) = 0.1*(k+1);
+    
+    _B.reinit(n_i, phi);
+    
+    RealMatrixX
+    B_dense = RealMatrixX::Zero(n_i, n_i*n_phi);
+    for (unsigned int i=0; i<n_i; i++)
+        B_dense.block(i, i*n_phi, 1, n_phi) = phi.transpose();
+    
+    RealVectorX
+    v    = test_matrix(n_i*n_phi, 1).col(0),
+    res  = RealVectorX::Zero(n_i);
+    
+    BOOST_CHECK_EQUAL(_B.m(), n_i);
+    BOOST_CHECK_EQUAL(_B.n(), n_i*n_phi);
+    
+    _B.vector_mult(res, v);
+    BOOST_CHECK(MAST::compare_vector(B_dense*v, res, _tol));
+    
+    RealMatrixX
+    r    = RealMatrixX::Zero(n_i*n_phi, n_i*n_phi);
+    _B.right_multiply_transpose(r, _B);
+    BOOST_CHECK(MAST::compare_matrix(B_dense.transpose()*B_dense, r, _tol));
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
+